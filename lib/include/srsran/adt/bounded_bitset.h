@@ -96,6 +96,14 @@ struct zerobit_counter {
     }
     return ret;
   }
+  static Integer popcount(Integer value)
+  {
+    Integer ret = 0;
+    for (; value != 0; ++ret) {
+      value &= value - 1;
+    }
+    return ret;
+  }
 };
 
 #ifdef __GNUC__ // clang and gcc
@@ -110,6 +118,7 @@ struct zerobit_counter<Integer, 4> {
   {
     return (value) ? __builtin_ctz(value) : std::numeric_limits<Integer>::digits;
   }
+  static Integer popcount(Integer value) { return __builtin_popcount(value); }
 };
 
 /// Specializations for unsigned long long
@@ -123,6 +132,7 @@ struct zerobit_counter<Integer, 8> {
   {
     return (value) ? __builtin_ctzll(value) : std::numeric_limits<Integer>::digits;
   }
+  static Integer popcount(Integer value) { return __builtin_popcountll(value); }
 };
 #endif
 
@@ -218,14 +228,18 @@ public:
   bounded_bitset<N, reversed>& fill(size_t startpos, size_t endpos, bool value = true)
   {
     assert_range_bounds_(startpos, endpos);
-    // NOTE: can be optimized
-    if (value) {
-      for (size_t i = startpos; i < endpos; ++i) {
-        set_(i);
-      }
-    } else {
-      for (size_t i = startpos; i < endpos; ++i) {
-        reset_(i);
+    if (startpos == endpos) {
+      return *this;
+    }
+    to_word_range_(startpos, endpos);
+    size_t startword = startpos / bits_per_word;
+    size_t lastword  = (endpos - 1) / bits_per_word;
+    for (size_t i = startword; i <= lastword; ++i) {
+      word_t mask = get_range_mask_(i, startpos, endpos);
+      if (value) {
+        buffer[i] |= mask;
+      } else {
+        buffer[i] &= ~mask;
       }
     }
     return *this;
@@ -273,28 +287,46 @@ public:
   {
     assert_within_bounds_(start, false);
     assert_within_bounds_(stop, false);
-    // NOTE: can be optimized
-    for (size_t i = start; i < stop; ++i) {
-      if (test_(i)) {
+    if (start >= stop) {
+      return false;
+    }
+    to_word_range_(start, stop);
+    size_t startword = start / bits_per_word;
+    size_t lastword  = (stop - 1) / bits_per_word;
+    for (size_t i = startword; i <= lastword; ++i) {
+      if ((buffer[i] & get_range_mask_(i, start, stop)) != static_cast<word_t>(0)) {
         return true;
       }
     }
     return false;
   }
 
+  bool all(size_t start, size_t stop) const
+  {
+    assert_within_bounds_(start, false);
+    assert_within_bounds_(stop, false);
+    if (start >= stop) {
+      return true;
+    }
+    to_word_range_(start, stop);
+    size_t startword = start / bits_per_word;
+    size_t lastword  = (stop - 1) / bits_per_word;
+    for (size_t i = startword; i <= lastword; ++i) {
+      word_t mask = get_range_mask_(i, start, stop);
+      if ((buffer[i] & mask) != mask) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   bool none() const noexcept { return !any(); }
 
   size_t count() const noexcept
   {
     size_t result = 0;
     for (size_t i = 0; i < nof_words_(); i++) {
-      //      result += __builtin_popcountl(buffer[i]);
-      // Note: use an "int" for count triggers popcount optimization if SSE instructions are enabled.
-      int c = 0;
-      for (word_t w = buffer[i]; w > 0; c++) {
-        w &= w - 1;
-      }
-      result += c;
+      result += detail::zerobit_counter<word_t, sizeof(word_t)>::popcount(buffer[i]);
     }
     return result;
   }
@@ -459,6 +491,29 @@ private:
 
   static size_t max_nof_words_() noexcept { return (N - 1) / bits_per_word + 1; }
 
+  /// Converts a range of bit positions into the equivalent range of bit indexes in the buffer words
+  void to_word_range_(size_t& startpos, size_t& endpos) const noexcept
+  {
+    if (reversed) {
+      size_t startidx = size() - endpos;
+      endpos          = size() - startpos;
+      startpos        = startidx;
+    }
+  }
+
+  /// Mask of the bits of word "word_idx" that fall within the range of bit indexes [startidx, endidx)
+  static word_t get_range_mask_(size_t word_idx, size_t startidx, size_t endidx) noexcept
+  {
+    word_t mask = ~static_cast<word_t>(0);
+    if (word_idx == startidx / bits_per_word) {
+      mask &= mask_lsb_zeros<word_t>(startidx % bits_per_word);
+    }
+    if (word_idx == (endidx - 1) / bits_per_word) {
+      mask &= mask_lsb_ones<word_t>((endidx - 1) % bits_per_word + 1);
+    }
+    return mask;
+  }
+
   int find_last_(size_t startpos, size_t endpos, bool value) const noexcept
   {
     size_t startword = startpos / bits_per_word;
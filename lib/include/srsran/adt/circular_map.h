@@ -22,10 +22,12 @@
 #ifndef SRSRAN_ID_MAP_H
 #define SRSRAN_ID_MAP_H
 
+#include "circular_buffer.h"
 #include "detail/type_storage.h"
 #include "expected.h"
 #include "srsran/support/srsran_assert.h"
 #include <array>
+#include <vector>
 
 namespace srsran {
 
@@ -331,6 +333,122 @@ private:
   K next_id = 0;
 };
 
+/**
+ * Pool of objects that assigns the ID/key of the inserted objects, with capacity defined at construction.
+ * The objects are stored in a contiguous array whose size is the capacity rounded up to a power of 2. The lower bits
+ * of an ID are the index of the array slot and the upper bits are a generation counter, incremented every time the
+ * slot is reused. Lookups are a mask plus one comparison, and IDs of erased objects are not found even after their
+ * slot has been reused. Free slots are reused in FIFO order, to delay the reuse of IDs.
+ * Note: The ID 0 is never assigned
+ * @tparam K type of ID/key
+ * @tparam T object being inserted
+ */
+template <typename K, typename T>
+class dyn_id_obj_pool
+{
+  static_assert(std::is_integral<K>::value and std::is_unsigned<K>::value, "Pool key must be an unsigned integer");
+
+  struct slot_t {
+    K    id      = 0;
+    bool present = false;
+  };
+
+public:
+  explicit dyn_id_obj_pool(size_t capacity_) : nof_bits(1)
+  {
+    while ((size_t(1) << nof_bits) < capacity_) {
+      nof_bits++;
+    }
+    srsran_assert(nof_bits < sizeof(K) * 8, "Capacity=%zd does not leave space for ID generations", capacity_);
+    size_t N = size_t(1) << nof_bits;
+    mask     = K(N - 1);
+    slots.resize(N);
+    buffer.resize(N);
+    free_list = srsran::dyn_circular_buffer<K>(N);
+    for (size_t i = 0; i < N; ++i) {
+      slots[i].id = K(i);
+      free_list.push(K(i));
+    }
+  }
+  dyn_id_obj_pool(const dyn_id_obj_pool&) = delete;
+  dyn_id_obj_pool& operator=(const dyn_id_obj_pool&) = delete;
+  ~dyn_id_obj_pool() { clear(); }
+
+  bool contains(K id) const
+  {
+    const slot_t& slot = slots[id & mask];
+    return slot.present and slot.id == id;
+  }
+
+  /// Returns a pointer to the object with the given ID, or nullptr if it does not exist
+  T* find(K id) { return contains(id) ? &buffer[id & mask].get() : nullptr; }
+  const T* find(K id) const { return contains(id) ? &buffer[id & mask].get() : nullptr; }
+
+  T& operator[](K id)
+  {
+    srsran_assert(contains(id), "Accessing non-existent ID=%zd", (size_t)id);
+    return buffer[id & mask].get();
+  }
+  const T& operator[](K id) const
+  {
+    srsran_assert(contains(id), "Accessing non-existent ID=%zd", (size_t)id);
+    return buffer[id & mask].get();
+  }
+
+  template <typename U>
+  srsran::expected<K> insert(U&& t)
+  {
+    if (full()) {
+      return srsran::default_error_t{};
+    }
+    K       idx  = free_list.top();
+    slot_t& slot = slots[idx];
+    free_list.pop();
+
+    // next generation of the slot, skipping the generation 0 so that the ID is never 0
+    slot.id = slot.id + mask + 1;
+    if ((slot.id & ~mask) == 0) {
+      slot.id = slot.id + mask + 1;
+    }
+    buffer[idx].emplace(std::forward<U>(t));
+    slot.present = true;
+    return slot.id;
+  }
+
+  bool erase(K id)
+  {
+    if (not contains(id)) {
+      return false;
+    }
+    K idx = id & mask;
+    buffer[idx].destroy();
+    slots[idx].present = false;
+    free_list.push(idx);
+    return true;
+  }
+
+  void clear()
+  {
+    for (size_t i = 0; i < slots.size(); ++i) {
+      if (slots[i].present) {
+        erase(slots[i].id);
+      }
+    }
+  }
+
+  size_t size() const { return slots.size() - free_list.size(); }
+  bool   empty() const { return size() == 0; }
+  bool   full() const { return free_list.empty(); }
+  size_t capacity() const { return slots.size(); }
+
+private:
+  unsigned                              nof_bits;
+  K                                     mask;
+  std::vector<slot_t>                   slots;
+  std::vector<detail::type_storage<T> > buffer;
+  srsran::dyn_circular_buffer<K>        free_list;
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_ID_MAP_H
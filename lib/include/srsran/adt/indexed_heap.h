@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_INDEXED_HEAP_H
+#define SRSRAN_INDEXED_HEAP_H
+
+#include "srsran/support/srsran_assert.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Max-heap of elements identified by an integer id in [0, max_ids), each with a key of type Key. The position of every
+ * id in the heap is tracked, so the key of an element can be changed or the element removed in O(log N) without
+ * rebuilding the heap. The elements can also be visited in decreasing key order without modifying the heap, which costs
+ * O(k log k) for the first k elements visited.
+ */
+template <typename Key>
+class indexed_heap
+{
+  static const uint32_t npos = UINT32_MAX;
+
+public:
+  explicit indexed_heap(uint32_t max_ids = 0) { resize(max_ids); }
+
+  void resize(uint32_t max_ids)
+  {
+    srsran_assert(heap.empty() or max_ids >= pos.size(), "Shrinking a non-empty heap is not supported");
+    pos.resize(max_ids, npos);
+    keys.resize(max_ids);
+    heap.reserve(max_ids);
+  }
+
+  size_t   size() const { return heap.size(); }
+  bool     empty() const { return heap.empty(); }
+  uint32_t max_ids() const { return pos.size(); }
+  bool     contains(uint32_t id) const { return id < pos.size() and pos[id] != npos; }
+
+  const Key& key(uint32_t id) const { return keys[id]; }
+  uint32_t   top() const { return heap[0]; }
+
+  /// Inserts the element or updates its key, if it is already in the heap
+  void set(uint32_t id, const Key& key)
+  {
+    srsran_assert(id < pos.size(), "Invalid heap id=%d", id);
+    if (pos[id] == npos) {
+      keys[id] = key;
+      pos[id]  = heap.size();
+      heap.push_back(id);
+      sift_up(pos[id]);
+      return;
+    }
+    bool increased = keys[id] < key;
+    keys[id]       = key;
+    if (increased) {
+      sift_up(pos[id]);
+    } else {
+      sift_down(pos[id]);
+    }
+  }
+
+  void erase(uint32_t id)
+  {
+    if (not contains(id)) {
+      return;
+    }
+    uint32_t p    = pos[id];
+    pos[id]       = npos;
+    uint32_t last = heap.back();
+    heap.pop_back();
+    if (p == heap.size()) {
+      return;
+    }
+    heap[p]   = last;
+    pos[last] = p;
+    sift_up(p);
+    sift_down(pos[last]);
+  }
+
+  void pop() { erase(top()); }
+
+  void clear()
+  {
+    for (uint32_t id : heap) {
+      pos[id] = npos;
+    }
+    heap.clear();
+  }
+
+  /// Visits the elements in decreasing key order until the visitor returns false. The heap must not be modified by
+  /// the visitor
+  template <typename Visitor>
+  void visit_in_order(Visitor&& visitor)
+  {
+    if (heap.empty()) {
+      return;
+    }
+    // Best-first walk of the heap tree, the frontier is itself a heap of positions
+    auto frontier_cmp = [this](uint32_t lhs, uint32_t rhs) { return keys[heap[lhs]] < keys[heap[rhs]]; };
+    frontier.clear();
+    frontier.push_back(0);
+    while (not frontier.empty()) {
+      std::pop_heap(frontier.begin(), frontier.end(), frontier_cmp);
+      uint32_t p = frontier.back();
+      frontier.pop_back();
+      if (not visitor(heap[p])) {
+        return;
+      }
+      for (uint32_t child = 2 * p + 1; child <= 2 * p + 2 and child < heap.size(); ++child) {
+        frontier.push_back(child);
+        std::push_heap(frontier.begin(), frontier.end(), frontier_cmp);
+      }
+    }
+  }
+
+private:
+  void swap_pos(uint32_t p1, uint32_t p2)
+  {
+    std::swap(heap[p1], heap[p2]);
+    pos[heap[p1]] = p1;
+    pos[heap[p2]] = p2;
+  }
+
+  void sift_up(uint32_t p)
+  {
+    while (p > 0) {
+      uint32_t parent = (p - 1) / 2;
+      if (not(keys[heap[parent]] < keys[heap[p]])) {
+        break;
+      }
+      swap_pos(p, parent);
+      p = parent;
+    }
+  }
+
+  void sift_down(uint32_t p)
+  {
+    while (true) {
+      uint32_t best = p;
+      for (uint32_t child = 2 * p + 1; child <= 2 * p + 2 and child < heap.size(); ++child) {
+        if (keys[heap[best]] < keys[heap[child]]) {
+          best = child;
+        }
+      }
+      if (best == p) {
+        break;
+      }
+      swap_pos(p, best);
+      p = best;
+    }
+  }
+
+  std::vector<uint32_t> heap;     ///< ids ordered as a binary max-heap
+  std::vector<uint32_t> pos;      ///< position of each id in the heap, or npos
+  std::vector<Key>      keys;     ///< key of each id
+  std::vector<uint32_t> frontier; ///< scratch space of visit_in_order
+};
+
+template <typename Key>
+const uint32_t indexed_heap<Key>::npos;
+
+} // namespace srsran
+
+#endif // SRSRAN_INDEXED_HEAP_H
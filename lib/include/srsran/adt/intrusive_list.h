@@ -137,6 +137,7 @@ struct intrusive_double_linked_list_element {
 /**
  * Double Linked List of pointers of type "T" that doesn't rely on allocations.
  * Instead, it leverages T's internal pointers to store the next and previous nodes
+ * It supports push_front/push_back, insertion before a given position, removal of any node, iteration, clear, etc.
  * @tparam T node type. Must be a subclass of intrusive_double_linked_list_element<Tag>
  * @tparam Tag tag of nodes. Useful to differentiate separate intrusive lists inside the same T node
  */
@@ -175,6 +176,8 @@ class intrusive_double_linked_list
     bool operator!=(const iterator_impl<U>& other) const { return node != other.node; }
 
   private:
+    friend class intrusive_double_linked_list<T, Tag>;
+
     elem_t* node;
   };
 
@@ -188,20 +191,24 @@ public:
                   "Provided template argument T must have intrusive_forward_list_element<Tag> as base class");
   }
   intrusive_double_linked_list(const intrusive_double_linked_list&) = default;
-  intrusive_double_linked_list(intrusive_double_linked_list&& other) noexcept : node(other.node)
+  intrusive_double_linked_list(intrusive_double_linked_list&& other) noexcept : node(other.node), tail(other.tail)
   {
     other.node = nullptr;
+    other.tail = nullptr;
   }
   intrusive_double_linked_list& operator=(const intrusive_double_linked_list&) = default;
   intrusive_double_linked_list& operator=(intrusive_double_linked_list&& other) noexcept
   {
     node       = other.node;
+    tail       = other.tail;
     other.node = nullptr;
+    other.tail = nullptr;
     return *this;
   }
   ~intrusive_double_linked_list() { clear(); }
 
   T& front() const { return *static_cast<T*>(node); }
+  T& back() const { return *static_cast<T*>(tail); }
 
   void push_front(T* t)
   {
@@ -210,15 +217,50 @@ public:
     new_head->next_node = node;
     if (node != nullptr) {
       node->prev_node = new_head;
+    } else {
+      tail = new_head;
     }
     node = new_head;
   }
+  void push_back(T* t)
+  {
+    node_t* new_tail    = static_cast<node_t*>(t);
+    new_tail->prev_node = tail;
+    new_tail->next_node = nullptr;
+    if (tail != nullptr) {
+      tail->next_node = new_tail;
+    } else {
+      node = new_tail;
+    }
+    tail = new_tail;
+  }
+  /// Inserts "t" before the node pointed by "pos". If "pos" is end(), "t" is appended to the list
+  iterator insert(iterator pos, T* t)
+  {
+    if (pos.node == nullptr) {
+      push_back(t);
+      return iterator(tail);
+    }
+    node_t* new_node    = static_cast<node_t*>(t);
+    new_node->prev_node = pos.node->prev_node;
+    new_node->next_node = pos.node;
+    if (pos.node->prev_node != nullptr) {
+      pos.node->prev_node->next_node = new_node;
+    } else {
+      node = new_node;
+    }
+    pos.node->prev_node = new_node;
+    return iterator(new_node);
+  }
   void pop(T* t)
   {
     node_t* to_rem = static_cast<node_t*>(t);
     if (to_rem == node) {
       node = to_rem->next_node;
     }
+    if (to_rem == tail) {
+      tail = to_rem->prev_node;
+    }
     if (to_rem->prev_node != nullptr) {
       to_rem->prev_node->next_node = to_rem->next_node;
     }
@@ -237,6 +279,7 @@ public:
       torem->next_node = nullptr;
       torem->prev_node = nullptr;
     }
+    tail = nullptr;
   }
 
   bool empty() const { return node == nullptr; }
@@ -248,6 +291,7 @@ public:
 
 private:
   node_t* node = nullptr;
+  node_t* tail = nullptr;
 };
 
 } // namespace srsran
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_MPSC_QUEUE_H
+#define SRSRAN_MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace srsran {
+
+/**
+ * Unbounded multi-producer single-consumer queue
+ * Producers never block each other: a push is a single CAS on the head of an intrusive stack of nodes. The consumer
+ * detaches the whole stack at once and visits the elements in the order they were pushed. Elements pushed by the same
+ * producer are therefore popped in FIFO order, while the order between different producers is the order of their
+ * CAS operations.
+ * Given that the consumer always detaches the complete stack, nodes are never popped individually and the
+ * implementation is not subject to the ABA problem.
+ * @tparam T type of the queue elements
+ */
+template <typename T>
+class mpsc_queue
+{
+  struct node_t {
+    template <typename... Args>
+    explicit node_t(Args&&... args) : value(std::forward<Args>(args)...)
+    {}
+    T       value;
+    node_t* next = nullptr;
+  };
+
+public:
+  mpsc_queue() = default;
+  mpsc_queue(const mpsc_queue&) = delete;
+  mpsc_queue& operator=(const mpsc_queue&) = delete;
+  ~mpsc_queue() { clear(); }
+
+  /// Constructs a new element at the tail of the queue. Can be called concurrently from multiple threads
+  template <typename... Args>
+  void emplace(Args&&... args)
+  {
+    node_t* n = new node_t(std::forward<Args>(args)...);
+    n->next   = head.load(std::memory_order_relaxed);
+    while (not head.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+  }
+  void push(const T& t) { emplace(t); }
+  void push(T&& t) { emplace(std::move(t)); }
+
+  bool empty() const { return head.load(std::memory_order_acquire) == nullptr; }
+
+  /**
+   * Pops all the elements pushed so far and calls the visitor on each of them, in FIFO order. Elements pushed while
+   * the visitor runs are left for the next call. Only the consumer thread may call this method.
+   * @return number of popped elements
+   */
+  template <typename Visitor>
+  size_t pop_all(Visitor&& visitor)
+  {
+    // Detach the stack and reverse it to obtain the push order
+    node_t* n    = head.exchange(nullptr, std::memory_order_acquire);
+    node_t* fifo = nullptr;
+    while (n != nullptr) {
+      node_t* next = n->next;
+      n->next      = fifo;
+      fifo         = n;
+      n            = next;
+    }
+
+    size_t count = 0;
+    while (fifo != nullptr) {
+      node_t* next = fifo->next;
+      visitor(fifo->value);
+      delete fifo;
+      fifo = next;
+      count++;
+    }
+    return count;
+  }
+
+  /// Discards all the pending elements
+  void clear()
+  {
+    pop_all([](T&) {});
+  }
+
+private:
+  std::atomic<node_t*> head{nullptr};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_MPSC_QUEUE_H
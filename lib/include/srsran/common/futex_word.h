@@ -0,0 +1,134 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_FUTEX_WORD_H
+#define SRSRAN_FUTEX_WORD_H
+
+#include <atomic>
+#include <climits>
+#include <stdint.h>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // __linux__
+
+namespace srsran {
+
+/**
+ * 32-bit atomic word that threads can wait on. A waiting thread polls the word for a short time, which covers the
+ * common TTI handoff where the other thread is about to finish, and then sleeps on it with a futex. Writers only
+ * enter the kernel when some thread is actually sleeping. On platforms without futex the sleep degrades to a yield.
+ */
+class futex_word
+{
+public:
+  explicit futex_word(uint32_t init_value = 0) : value(init_value) {}
+  futex_word(const futex_word&) = delete;
+  futex_word& operator=(const futex_word&) = delete;
+
+  uint32_t load(std::memory_order order = std::memory_order_acquire) const { return value.load(order); }
+
+  /// Stores a new value and wakes up the sleeping threads
+  void store(uint32_t new_value)
+  {
+    value.store(new_value, std::memory_order_seq_cst);
+    wake_all();
+  }
+
+  /// Increments the value, wakes up the sleeping threads and returns the previous value
+  uint32_t fetch_add(uint32_t inc)
+  {
+    uint32_t ret = value.fetch_add(inc, std::memory_order_seq_cst);
+    wake_all();
+    return ret;
+  }
+
+  /**
+   * Waits while the word holds the given value
+   *
+   * @param old_value value the caller observed last
+   */
+  void wait_while(uint32_t old_value)
+  {
+    // Spin first, the write usually comes within a few microseconds
+    for (uint32_t i = 0, i_end = nof_spins(); i < i_end; i++) {
+      if (value.load(std::memory_order_acquire) != old_value) {
+        return;
+      }
+      cpu_relax();
+    }
+
+    // Sleep until a writer modifies the word
+    nof_sleepers.fetch_add(1, std::memory_order_seq_cst);
+    while (value.load(std::memory_order_seq_cst) == old_value) {
+      sleep(old_value);
+    }
+    nof_sleepers.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint32_t> value;
+  std::atomic<uint32_t> nof_sleepers = {0}; ///< Number of threads sleeping on the word
+
+  /// Number of polls of the word before the waiting thread is put to sleep, spinning is pointless on a single CPU
+  static uint32_t nof_spins()
+  {
+    static const uint32_t spins = (std::thread::hardware_concurrency() > 1) ? 2048 : 0;
+    return spins;
+  }
+
+  static void cpu_relax()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+  }
+
+  /// Puts the calling thread to sleep while the word holds the expected value. It may return spuriously.
+  void sleep(uint32_t expected)
+  {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&value), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    (void)expected;
+    std::this_thread::yield();
+#endif // __linux__
+  }
+
+  void wake_all()
+  {
+    if (nof_sleepers.load(std::memory_order_seq_cst) == 0) {
+      return;
+    }
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&value), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif // __linux__
+  }
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_FUTEX_WORD_H
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_INTERFACES_COMMON_H
 #define SRSRAN_INTERFACES_COMMON_H
 
+#include "srsran/adt/span.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/security.h"
 #include "srsran/phy/common/phy_common.h"
@@ -84,6 +85,17 @@ public:
   virtual uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t requested_bytes) = 0;
 };
 
+/// Destination of the PDUs read from a bearer in a single pass, e.g. a MAC PDU being assembled. Each PDU is written in
+/// place, in the space given by the destination
+class read_pdu_batch_interface
+{
+public:
+  /// Space where the next PDU must be written. An empty span ends the batch
+  virtual srsran::span<uint8_t> reserve_pdu() = 0;
+  /// Adds the PDU of nof_bytes written in the last reserved space
+  virtual void add_pdu(uint32_t nof_bytes) = 0;
+};
+
 
 } // namespace srsran
 
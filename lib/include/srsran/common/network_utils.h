@@ -27,6 +27,7 @@
 #include "srsran/common/threads.h"
 
 #include <arpa/inet.h>
+#include <array>
 #include <map>
 #include <mutex>
 #include <netinet/in.h>
@@ -132,7 +133,7 @@ protected:
 };
 
 /**
- * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via a select
+ * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via epoll
  *               The user can register their own (socket fd, data handler) in this class via the
  *               add_socket_handler(fd, task) API or its other variants
  */
@@ -152,9 +153,10 @@ public:
   void run_thread() override;
 
 private:
-  const int thread_prio = 65;
+  const int           thread_prio = 65;
+  static const size_t max_events  = 32;
 
-  // used to unlock select
+  // used to unlock epoll_wait
   struct ctrl_cmd_t {
     enum class cmd_id_t { EXIT, NEW_FD, RM_FD };
     cmd_id_t cmd;
@@ -162,13 +164,15 @@ private:
     bool     signal_rm_complete;
     ctrl_cmd_t() { bzero(this, sizeof(ctrl_cmd_t)); }
   };
-  std::map<int, recv_callback_t>::iterator remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd);
+  bool                                     epoll_add(int fd);
+  std::map<int, recv_callback_t>::iterator remove_socket_unprotected(int fd);
 
   // state
   std::mutex                     socket_mutex;
   std::map<int, recv_callback_t> active_sockets;
   std::atomic<bool>              running   = {false};
   int                            pipefd[2] = {-1, -1};
+  int                            epoll_fd  = -1;
   std::vector<int>               rem_fd_tmp_list;
   std::condition_variable        rem_cvar;
 };
@@ -200,6 +204,16 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 socket_manager_itf::recv_callback_t
 make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue, recvfrom_callback_t rx_callback);
 
+/**
+ * Similar to make_sdu_handler, but each time the socket has data, up to "batch_size" datagrams are read with a single
+ * recvmmsg call, directly into byte buffers of the pool, and the whole batch is dispatched to the "queue" as one task.
+ * Datagrams that do not fit in a byte buffer are dropped.
+ */
+socket_manager_itf::recv_callback_t make_batched_sdu_handler(srslog::basic_logger&      logger,
+                                                             srsran::task_queue_handle& queue,
+                                                             recvfrom_callback_t        rx_callback,
+                                                             uint32_t                   batch_size = 32);
+
 inline socket_manager& get_rx_io_manager()
 {
   static socket_manager io;
@@ -39,8 +39,8 @@
 #include <string.h>
 
 typedef struct {
-  uint32_t* lfsr;
-  uint32_t* fsm;
+  uint32_t lfsr[16];
+  uint32_t fsm[3];
 } S3G_STATE;
 
 /* Initialization.
@@ -72,6 +72,23 @@ void s3g_deinitialize(S3G_STATE* state);
 
 void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
 
+/* Multi-buffer keystream generation.
+ * Runs S3G_NOF_LANES independent SNOW 3G instances, initialization included,
+ * in parallel SIMD lanes when the CPU supports AVX2.
+ * Input k[l]: key words of lane l, as for s3g_initialize.
+ * Input iv[l]: initialization variable of lane l.
+ * Input n[l]: number of 32-bit words of keystream for lane l, may be 0.
+ * Output ks[l]: n[l] words of keystream of lane l.
+ * The output of each lane equals s3g_initialize + s3g_generate_keystream.
+ */
+
+#define S3G_NOF_LANES 8
+
+void s3g_generate_keystream_multi(const uint32_t k[S3G_NOF_LANES][4],
+                                  const uint32_t iv[S3G_NOF_LANES][4],
+                                  const uint32_t n[S3G_NOF_LANES],
+                                  uint32_t*      ks[S3G_NOF_LANES]);
+
 /* f8.
  * Input key: 128 bit Confidentiality Key.
  * Input count:32-bit Count, Frame dependent input.
@@ -101,4 +118,24 @@ void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
 
 uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir, uint8_t* data, uint64_t length);
 
+/* Key loading.
+ * Input key: 128 bit key.
+ * Output k[4]: Four 32-bit words in the order expected by s3g_initialize.
+ */
+
+void s3g_load_key(const uint8_t* key, uint32_t k[4]);
+
+/* f9 with a preloaded key.
+ * Input k[4]: key words as returned by s3g_load_key.
+ * Output mac: 32 bit MAC. Unlike s3g_f9 this function is reentrant.
+ */
+
+void s3g_f9_mac(const uint32_t k[4],
+                uint32_t       count,
+                uint32_t       fresh,
+                uint32_t       dir,
+                const uint8_t* data,
+                uint64_t       length,
+                uint8_t*       mac);
+
 #endif // SRSRAN_S3G_H
\ No newline at end of file
@@ -26,9 +26,11 @@
  * Common security header - wraps ciphering/integrity check algorithms.
  *****************************************************************************/
 
+#include "srsran/adt/span.h"
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
 
+#include <memory>
 #include <vector>
 
 #define AKA_RAND_LEN 16
@@ -309,6 +311,63 @@ uint8_t security_128_eea3(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out);
 
+/******************************************************************************
+ * Per-bearer security contexts
+ *
+ * Hold the key schedule of the configured algorithm so that it is derived once
+ * when the keys are configured and not for every PDU. All lengths are in bytes
+ * and the input may alias the output. A context is not thread-safe.
+ *****************************************************************************/
+class cipher_ctx
+{
+public:
+  struct pdu_t {
+    uint32_t       count;
+    const uint8_t* msg;
+    uint32_t       msg_len;
+    uint8_t*       msg_out;
+  };
+
+  cipher_ctx();
+  ~cipher_ctx();
+  cipher_ctx(cipher_ctx&&) noexcept;
+  cipher_ctx& operator=(cipher_ctx&&) noexcept;
+
+  /// Sets the algorithm and the 128 bit key
+  void                        set_key(CIPHERING_ALGORITHM_ID_ENUM algo, const uint8_t* key);
+  CIPHERING_ALGORITHM_ID_ENUM get_algo() const { return algo; }
+
+  void cipher(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* msg_out);
+
+  /// Ciphers several PDUs of the same bearer in one call. With EEA2 the AES blocks of consecutive PDUs are pipelined
+  void cipher_batch(uint8_t bearer, uint8_t direction, span<const pdu_t> pdus);
+
+private:
+  struct impl;
+  CIPHERING_ALGORITHM_ID_ENUM algo = CIPHERING_ALGORITHM_ID_EEA0;
+  std::unique_ptr<impl>       pimpl;
+};
+
+class integrity_ctx
+{
+public:
+  integrity_ctx();
+  ~integrity_ctx();
+  integrity_ctx(integrity_ctx&&) noexcept;
+  integrity_ctx& operator=(integrity_ctx&&) noexcept;
+
+  /// Sets the algorithm and the 128 bit key
+  void                        set_key(INTEGRITY_ALGORITHM_ID_ENUM algo, const uint8_t* key);
+  INTEGRITY_ALGORITHM_ID_ENUM get_algo() const { return algo; }
+
+  void generate(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* mac);
+
+private:
+  struct impl;
+  INTEGRITY_ALGORITHM_ID_ENUM algo = INTEGRITY_ALGORITHM_ID_EIA0;
+  std::unique_ptr<impl>       pimpl;
+};
+
 /******************************************************************************
  * Authentication
  *****************************************************************************/
@@ -19,11 +19,10 @@
  *
  */
 
-#include <assert.h>
-#include <condition_variable>
-#include <deque>
+#include "srsran/common/futex_word.h"
+#include <array>
+#include <atomic>
 #include <inttypes.h>
-#include <mutex>
 
 #ifndef SRSRAN_TTI_SEMPAHORE_H_
 #define SRSRAN_TTI_SEMPAHORE_H_
@@ -35,15 +34,21 @@ namespace srsran {
  * push) and waits until the enqueued object is the first (method wait). The first element is released by method
  * release. The method release_all waits for all the elements to be released.
  *
+ * The FIFO is a lock-free ring of N elements indexed by two counters. The waiting threads spin on the head counter for
+ * a short time and then sleep on it (see futex_word). Elements must be pushed from a single thread, the waits and releases can come from any thread.
+ *
  * @tparam T Object identifier type
+ * @tparam N Maximum number of enqueued element identifiers, a push waits while the FIFO is full
  */
-template <class T>
+template <class T, uint32_t N = 64>
 class tti_semaphore
 {
+  static_assert(N > 0 and (N & (N - 1)) == 0, "The FIFO size must be a power of two");
+
 private:
-  std::mutex              mutex; ///< Used for scope mutexes
-  std::condition_variable cvar;  ///< Used for notifying element identifier releases
-  std::deque<T>           fifo;  ///< Queue to keep order
+  std::array<std::atomic<T>, N> fifo = {};  ///< Ring buffer to keep order
+  futex_word                    head;       ///< Number of released elements, the waiting threads wait on this word
+  std::atomic<uint32_t>         tail = {0}; ///< Number of pushed elements
 
 public:
   tti_semaphore() = default;
@@ -55,12 +60,25 @@ public:
    */
   void wait(T id)
   {
-    std::unique_lock<std::mutex> lock(mutex);
-
     // While the FIFO is not empty and the front ID does not match the provided element identifier, keep waiting
-    while (not fifo.empty() and fifo.front() != id) {
+    while (true) {
+      uint32_t h = head.load(std::memory_order_acquire);
+      if (h == tail.load(std::memory_order_acquire)) {
+        return;
+      }
+
+      // Read the front and discard it if the head moved meanwhile, the slot may have been overwritten by a push
+      T front = fifo[h % N].load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (head.load(std::memory_order_relaxed) != h) {
+        continue;
+      }
+      if (front == id) {
+        return;
+      }
+
       // Wait for a release
-      cvar.wait(lock);
+      head.wait_while(h);
     }
   }
 
@@ -71,10 +89,18 @@ public:
    */
   void push(T id)
   {
-    std::unique_lock<std::mutex> lock(mutex);
+    uint32_t t = tail.load(std::memory_order_relaxed);
+
+    // Wait for space in the FIFO
+    uint32_t h = head.load(std::memory_order_acquire);
+    while (t - h >= N) {
+      head.wait_while(h);
+      h = head.load(std::memory_order_acquire);
+    }
 
-    // Append the element identifier
-    fifo.push_back(id);
+    // Append the element identifier and make it visible to the waiting threads
+    fifo[t % N].store(id, std::memory_order_relaxed);
+    tail.store(t + 1, std::memory_order_release);
   }
 
   /**
@@ -82,15 +108,13 @@ public:
    */
   void release()
   {
-    std::unique_lock<std::mutex> lock(mutex);
-
     // If the FIFO is not empty pop first element
-    if (not fifo.empty()) {
-      fifo.pop_front();
+    if (head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire)) {
+      return;
     }
 
-    // Notify release
-    cvar.notify_all();
+    // Notify release, only the sleeping threads need a system call
+    head.fetch_add(1);
   }
 
   /**
@@ -98,11 +122,12 @@ public:
    */
   void wait_all()
   {
-    std::unique_lock<std::mutex> lock(mutex);
+    uint32_t h = head.load(std::memory_order_acquire);
 
     // Wait until the FIFO is empty
-    while (not fifo.empty()) {
-      cvar.wait(lock);
+    while (h != tail.load(std::memory_order_acquire)) {
+      head.wait_while(h);
+      h = head.load(std::memory_order_acquire);
     }
   }
 };
@@ -56,4 +56,15 @@ typedef struct {
 void zuc_initialize(zuc_state_t* state, const u8* k, u8* iv);
 void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keystream);
 
+/* Runs ZUC_NOF_LANES independent instances, initialization included, in
+ * parallel SIMD lanes when the CPU supports AVX2. Lane l is keyed with k[l]
+ * and iv[l] and outputs n[l] (may be 0) keystream words to ks[l], the same as
+ * zuc_initialize + zuc_generate_keystream. */
+#define ZUC_NOF_LANES 8
+
+void zuc_generate_keystream_multi(const u8* const k[ZUC_NOF_LANES],
+                                  const u8        iv[ZUC_NOF_LANES][16],
+                                  const u32       n[ZUC_NOF_LANES],
+                                  u32*            ks[ZUC_NOF_LANES]);
+
 #endif // SRSRAN_ZUC_H
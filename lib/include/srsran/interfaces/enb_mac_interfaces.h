@@ -50,6 +50,7 @@ public:
     srsran_dci_dl_t         dci                          = {};
     uint8_t*                data[SRSRAN_MAX_TB]          = {};
     srsran_softbuffer_tx_t* softbuffer_tx[SRSRAN_MAX_TB] = {};
+    uint32_t                mu_mimo_rbg_mask             = 0; ///< RBGs superposed with another UE's PDSCH
   };
 
   /**
@@ -55,12 +55,13 @@ struct stack_metrics_t {
 };
 
 struct enb_metrics_t {
-  srsran::rf_metrics_t       rf;
-  std::vector<phy_metrics_t> phy;
-  stack_metrics_t            stack;
-  stack_metrics_t            nr_stack;
-  srsran::sys_metrics_t      sys;
-  bool                       running;
+  srsran::rf_metrics_t          rf;
+  std::vector<phy_metrics_t>    phy;
+  std::vector<phy_cc_metrics_t> phy_cc;
+  stack_metrics_t               stack;
+  stack_metrics_t               nr_stack;
+  srsran::sys_metrics_t         sys;
+  bool                          running;
 };
 
 // ENB interface
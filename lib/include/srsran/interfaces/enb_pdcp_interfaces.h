@@ -34,6 +34,8 @@ class pdcp_interface_gtpu
 public:
   virtual void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn = -1) = 0;
   virtual std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) = 0;
+  /// Whether the lower layers of the bearer are congested, in which case GTPU holds the SDUs back
+  virtual bool sdu_queue_is_congested(uint16_t rnti, uint32_t lcid) = 0;
 };
 
 // PDCP interface for RRC
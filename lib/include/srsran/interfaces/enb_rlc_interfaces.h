@@ -23,6 +23,7 @@
 #define SRSRAN_ENB_RLC_INTERFACES_H
 
 #include "srsran/common/byte_buffer.h"
+#include "srsran/common/interfaces_common.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 
 namespace srsenb {
@@ -35,6 +36,10 @@ public:
    * Segmentation happens in this function. RLC PDU is stored in payload. */
   virtual int read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) = 0;
 
+  /* MAC calls RLC to get as many RLC PDUs as fit in the batch, in a single pass.
+   * Returns the number of bytes read. */
+  virtual int read_pdus(uint16_t rnti, uint32_t lcid, srsran::read_pdu_batch_interface& batch) = 0;
+
   /* MAC calls RLC to push an RLC PDU. This function is called from an independent MAC thread.
    * PDU gets placed into the buffer and higher layer thread gets notified. */
   virtual void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) = 0;
@@ -46,11 +51,13 @@ class rlc_interface_pdcp
 public:
   /* PDCP calls RLC to push an RLC SDU. SDU gets placed into the RLC buffer and MAC pulls
    * RLC PDUs according to TB size. */
-  virtual void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) = 0;
-  virtual void discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t sn)                    = 0;
-  virtual bool rb_is_um(uint16_t rnti, uint32_t lcid)                                    = 0;
-  virtual bool sdu_queue_is_full(uint16_t rnti, uint32_t lcid)                           = 0;
-  virtual bool is_suspended(uint16_t rnti, uint32_t lcid)                                = 0;
+  virtual void     write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) = 0;
+  virtual void     discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t sn)                    = 0;
+  virtual bool     rb_is_um(uint16_t rnti, uint32_t lcid)                                    = 0;
+  virtual bool     sdu_queue_is_full(uint16_t rnti, uint32_t lcid)                           = 0;
+  virtual bool     sdu_queue_is_congested(uint16_t rnti, uint32_t lcid)                      = 0;
+  virtual uint32_t sdu_queue_free_slots(uint16_t rnti, uint32_t lcid)                        = 0;
+  virtual bool     is_suspended(uint16_t rnti, uint32_t lcid)                                = 0;
 };
 
 // RLC interface for RRC
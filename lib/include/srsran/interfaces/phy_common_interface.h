@@ -24,6 +24,7 @@
 
 #include "../radio/rf_buffer.h"
 #include "../radio/rf_timestamp.h"
+#include "srsran/common/futex_word.h"
 
 namespace srsran {
 
@@ -33,37 +34,25 @@ namespace srsran {
 class phy_common_interface
 {
 private:
-  std::mutex              tx_mutex;        ///< Protect Tx attributes
-  std::condition_variable tx_cvar;         ///< Tx condition variable
-  bool                    tx_hold = false; ///< Hold threads until the signal is transmitted
+  srsran::futex_word tx_hold; ///< Hold threads until the signal is transmitted when it is not zero
 
 protected:
-  void reset_last_worker()
-  {
-    std::unique_lock<std::mutex> lock(tx_mutex);
-    tx_hold = true;
-  }
+  void reset_last_worker() { tx_hold.store(1); }
   /**
    * @brief Waits for the last worker to call `last_worker()` to prevent that the current SF worker is released and
    * overwrites the transmit signal prior transmission
    */
   void wait_last_worker()
   {
-    std::unique_lock<std::mutex> lock(tx_mutex);
-    while (tx_hold) {
-      tx_cvar.wait(lock);
+    while (tx_hold.load() != 0) {
+      tx_hold.wait_while(1);
     }
   }
 
   /**
    * @brief Notifies the last SF worker transmitted the baseband and all the workers waiting are released
    */
-  void last_worker()
-  {
-    std::unique_lock<std::mutex> lock(tx_mutex);
-    tx_hold = false;
-    tx_cvar.notify_all();
-  }
+  void last_worker() { tx_hold.store(0); }
 
 public:
   /**
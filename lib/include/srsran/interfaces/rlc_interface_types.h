@@ -161,6 +161,7 @@ struct rlc_um_nr_config_t {
 };
 
 #define RLC_TX_QUEUE_LEN (256)
+#define RLC_TX_QUEUE_WM_SDUS (RLC_TX_QUEUE_LEN * 3 / 4)
 
 class rlc_config_t
 {
@@ -172,9 +173,20 @@ public:
   rlc_um_config_t    um;
   rlc_um_nr_config_t um_nr;
   uint32_t           tx_queue_length;
+  // Above these watermarks of the Tx SDU queue, the upper layers hold SDUs back instead of dropping them. 0 disables
+  uint32_t tx_queue_wm_sdus;
+  uint32_t tx_queue_wm_bytes;
 
   rlc_config_t() :
-    rat(srsran_rat_t::lte), rlc_mode(rlc_mode_t::tm), am(), am_nr(), um(), um_nr(), tx_queue_length(RLC_TX_QUEUE_LEN){};
+    rat(srsran_rat_t::lte),
+    rlc_mode(rlc_mode_t::tm),
+    am(),
+    am_nr(),
+    um(),
+    um_nr(),
+    tx_queue_length(RLC_TX_QUEUE_LEN),
+    tx_queue_wm_sdus(RLC_TX_QUEUE_WM_SDUS),
+    tx_queue_wm_bytes(0){};
 
   // Factory for MCH
   static rlc_config_t mch_config()
@@ -59,11 +59,12 @@ struct phy_args_t {
   float dl_freq = -1.0f;
   float ul_freq = -1.0f;
 
-  bool     ul_pwr_ctrl_en  = false;
-  float    prach_gain      = -1;
-  uint32_t pdsch_max_its   = 8;
-  bool     meas_evm        = false;
-  uint32_t nof_phy_threads = 3;
+  bool     ul_pwr_ctrl_en    = false;
+  float    prach_gain        = -1;
+  uint32_t pdsch_max_its     = 8;
+  bool     meas_evm          = false;
+  uint32_t nof_phy_threads   = 3;
+  uint32_t nof_pdsch_threads = 0; ///< Threads decoding the PDSCH of the carriers in parallel, 0 for serial decoding
 
   int worker_cpu_mask   = -1;
   int sync_cpu_affinity = -1;
@@ -61,6 +61,9 @@ public:
   ///< Allow PDCP to query SDU queue status
   virtual bool sdu_queue_is_full(uint32_t lcid) = 0;
 
+  ///< Number of SDUs that PDCP can still write before the SDU queue is full
+  virtual uint32_t sdu_queue_free_slots(uint32_t lcid) = 0;
+
   virtual bool is_suspended(const uint32_t lcid) = 0;
 };
 
@@ -80,6 +83,10 @@ public:
    * Segmentation happens in this function. RLC PDU is stored in payload. */
   virtual uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) = 0;
 
+  /* MAC calls RLC to get as many RLC PDUs as fit in the batch, in a single pass.
+   * Returns the number of bytes read. */
+  virtual uint32_t read_pdus(uint32_t lcid, srsran::read_pdu_batch_interface& batch) = 0;
+
   /* MAC calls RLC to push an RLC PDU. This function is called from an independent MAC thread.
    * PDU gets placed into the buffer and higher layer thread gets notified. */
   virtual void write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)     = 0;
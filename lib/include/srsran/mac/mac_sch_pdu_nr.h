@@ -22,8 +22,10 @@
 #ifndef SRSRAN_MAC_SCH_PDU_NR_H
 #define SRSRAN_MAC_SCH_PDU_NR_H
 
+#include "srsran/adt/span.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
+#include "srsran/common/interfaces_common.h"
 #include "srsran/config.h"
 #include "srsran/srslog/srslog.h"
 #include <memory>
@@ -63,7 +65,7 @@ public:
   // SDUs up to 256 B can use the short 8-bit L field
   static const int32_t MAC_SUBHEADER_LEN_THRESHOLD = 256;
 
-  mac_sch_subpdu_nr(mac_sch_pdu_nr* parent_) : parent(parent_), logger(&srslog::fetch_basic_logger("MAC-NR")){};
+  mac_sch_subpdu_nr(mac_sch_pdu_nr* parent_);
 
   nr_lcid_sch_t get_type();
   bool          is_sdu() const;
@@ -119,6 +121,7 @@ public:
   void set_ue_con_res_id_ce(const ue_con_res_id_t id);
 
   uint32_t write_subpdu(const uint8_t* start_);
+  uint32_t write_subheader(uint8_t* start_);
 
   // Used by BSR procedure to determine size of BSR types
   static uint32_t sizeof_ce(uint32_t lcid, bool is_ul);
@@ -221,6 +224,12 @@ public:
   uint32_t add_lbsr_ce(const std::array<mac_sch_subpdu_nr::lcg_bsr_t, mac_sch_subpdu_nr::max_num_lcg_lbsr> bsr_);
   uint32_t add_ue_con_res_id_ce(const mac_sch_subpdu_nr::ue_con_res_id_t id);
 
+  /// Reserves the subheader of an SDU within the next max_subpdu_len_ bytes of the PDU, so that the SDU can be written
+  /// in place by the caller, e.g. by RLC. Returns the space where the SDU must be written, which is empty if none fits
+  srsran::span<uint8_t> reserve_sdu(const uint32_t lcid_, const uint32_t max_subpdu_len_);
+  /// Adds the SDU of len_ bytes written in the space returned by the last reserve_sdu()
+  uint32_t add_reserved_sdu(const uint32_t len_);
+
   uint32_t get_remaing_len();
 
   void to_string(fmt::memory_buffer& buffer);
@@ -228,18 +237,47 @@ public:
   uint32_t size_header_sdu(const uint32_t lcid_, const uint32_t nbytes);
 
 private:
+  friend class mac_sch_subpdu_nr;
+
   /// Private helper that adds a subPDU to the MAC PDU
   uint32_t add_sudpdu(mac_sch_subpdu_nr& subpdu);
 
   bool                           ulsch = false;
   std::vector<mac_sch_subpdu_nr> subpdus;
 
-  byte_buffer_t*        buffer        = nullptr;
-  uint32_t              pdu_len       = 0;
-  uint32_t              remaining_len = 0;
+  byte_buffer_t*        buffer              = nullptr;
+  uint32_t              pdu_len             = 0;
+  uint32_t              remaining_len       = 0;
+  uint32_t              reserved_lcid       = 0;
+  uint32_t              reserved_header_len = 0;
+  uint32_t              reserved_sdu_len    = 0;
   srslog::basic_logger& logger;
 };
 
+/// Batch of the SDUs of one LCID, which RLC writes in place in the MAC PDU. The batch ends once less than min_len_
+/// bytes are left of the max_len_ bytes given to the LCID
+class mac_sch_sdu_batch_nr final : public read_pdu_batch_interface
+{
+public:
+  mac_sch_sdu_batch_nr(mac_sch_pdu_nr& pdu_, uint32_t lcid_, uint32_t max_len_, uint32_t min_len_) :
+    pdu(pdu_), lcid(lcid_), remaining_len(max_len_), min_len(min_len_)
+  {}
+
+  srsran::span<uint8_t> reserve_pdu() override;
+  void                  add_pdu(uint32_t nof_bytes) override;
+
+  /// Bytes left to the LCID, after the subheaders and SDUs added so far
+  uint32_t get_remaining_len() const { return remaining_len; }
+  uint32_t get_nof_sdus() const { return nof_sdus; }
+
+private:
+  mac_sch_pdu_nr& pdu;
+  uint32_t        lcid          = 0;
+  uint32_t        remaining_len = 0;
+  uint32_t        min_len       = 0;
+  uint32_t        nof_sdus      = 0;
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_MAC_SCH_PDU_NR_H
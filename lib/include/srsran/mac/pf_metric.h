@@ -0,0 +1,77 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PF_METRIC_H
+#define SRSRAN_PF_METRIC_H
+
+#include <cstdint>
+
+namespace srsran {
+
+/**
+ * Weighted proportional fair metric w * r / R^fairness_coeff of a UE in one direction, used by the LTE and NR time
+ * domain PF schedulers. w is the QoS weight, r the expected rate and R the average allocated rate, in bytes per TTI
+ * (slot in NR). R decays by (1 - alpha) every TTI, which scales the metric of every UE by the same factor.
+ * The key used to sort the UEs is the log of the metric normalized by the number of elapsed TTIs, so it only changes
+ * when r or w change or when the UE gets an allocation, not every TTI.
+ * During the first 1 / alpha TTIs of a UE, R is the plain mean of the allocations ("fast start") and the key has to
+ * be refreshed every TTI.
+ * The key is computed from the last R update in the log domain, so that R doesn't underflow to 0 when the UE is idle
+ * for a long time. R is clamped to min_avg_rate, so that UEs without allocations still get a finite key ordered by r.
+ */
+class pf_metric
+{
+public:
+  static constexpr float  exp_avg_alpha = 0.01;
+  static constexpr double min_avg_rate  = 1e-3; ///< bytes per TTI
+
+  pf_metric(float fairness_coeff_, uint64_t now) : fairness_coeff(fairness_coeff_), first_tti(now) {}
+
+  double avg_rate(uint64_t now) const;
+  bool   in_fast_start(uint64_t now) const { return now - first_tti < fast_start_len; }
+  /// The key must be refreshed every TTI until the first TTI after the fast start
+  bool   needs_refresh(uint64_t now) const { return now - first_tti <= fast_start_len; }
+  double key() const { return key_; }
+
+  /// Updates the expected rate and QoS weight and recomputes the key
+  void set_expected_rate(float rate_, uint64_t now, float weight_ = 1);
+  /// Accounts an allocation of the TTI now and recomputes the key
+  void save_alloc(uint32_t alloc_bytes, uint64_t now);
+  /// Recomputes the key for the TTI now, only needed during the fast start
+  void refresh_key(uint64_t now);
+
+private:
+  static constexpr uint32_t fast_start_len = 100; ///< 1 / exp_avg_alpha
+
+  const float    fairness_coeff;
+  const uint64_t first_tti;
+  float          rate          = 0; ///< expected rate
+  float          weight        = 1; ///< QoS weight
+  double         sum_bytes     = 0; ///< allocated bytes during the fast start
+  bool           exp_avg_start = false;
+  double         exp_avg_rate  = 0; ///< exponential average rate at the end of exp_avg_tti
+  uint64_t       exp_avg_tti   = 0;
+  double         key_          = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PF_METRIC_H
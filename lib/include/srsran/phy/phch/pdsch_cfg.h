@@ -59,6 +59,7 @@ typedef struct SRSRAN_API {
   bool                  power_scale;
   bool                  csi_enable;
   bool                  use_tbs_index_alt;
+  uint32_t              mu_mimo_rbg_mask; ///< RBGs shared with an orthogonally precoded PDSCH, in type 0 bitmap order
 
   union {
     srsran_softbuffer_tx_t* tx[SRSRAN_MAX_CODEWORDS];
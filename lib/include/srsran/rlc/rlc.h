@@ -59,17 +59,20 @@ public:
   void get_metrics(rlc_metrics_t& m, const uint32_t nof_tti);
 
   // PDCP interface
-  void write_sdu(uint32_t lcid, unique_byte_buffer_t sdu);
-  void write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu);
-  bool rb_is_um(uint32_t lcid);
-  void discard_sdu(uint32_t lcid, uint32_t discard_sn);
-  bool sdu_queue_is_full(uint32_t lcid);
+  void     write_sdu(uint32_t lcid, unique_byte_buffer_t sdu);
+  void     write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu);
+  bool     rb_is_um(uint32_t lcid);
+  void     discard_sdu(uint32_t lcid, uint32_t discard_sn);
+  bool     sdu_queue_is_full(uint32_t lcid);
+  bool     sdu_queue_is_congested(uint32_t lcid);
+  uint32_t sdu_queue_free_slots(uint32_t lcid);
 
   // MAC interface
   bool     has_data_locked(const uint32_t lcid);
   uint32_t get_buffer_state(const uint32_t lcid);
   uint32_t get_total_mch_buffer_state(uint32_t lcid);
   uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
+  uint32_t read_pdus(uint32_t lcid, read_pdu_batch_interface& batch);
   uint32_t read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
   int      get_increment_sequence_num();
   void     write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
@@ -89,6 +89,10 @@ public:
 
   bool sdu_queue_is_full() final;
 
+  bool sdu_queue_is_congested() final;
+
+  uint32_t sdu_queue_free_slots() final;
+
   /****************************************************************************
    * MAC interface
    ***************************************************************************/
@@ -150,10 +154,12 @@ public:
 
     int              write_sdu(unique_byte_buffer_t sdu);
     bool             sdu_queue_is_full();
+    bool             sdu_queue_is_congested();
+    uint32_t         sdu_queue_free_slots();
     virtual void     discard_sdu(uint32_t pdcp_sn);
     virtual uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
 
-    bool                  tx_enabled = false;
+    std::atomic<bool>     tx_enabled = {false}; // Read by the PDCP writer, which holds sdu_queue_mutex only
     byte_buffer_pool*     pool       = nullptr;
     srslog::basic_logger& logger;
     std::string           rb_name;
@@ -165,6 +171,8 @@ public:
 
     // Mutexes
     std::mutex mutex;
+    std::mutex sdu_queue_mutex; // Held by the PDCP writer, and while the Tx SDU queue is drained or resized. Never
+                                // taken by read_pdu()
   };
 
   /*******************************************************
@@ -25,6 +25,8 @@
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
+#include "srsran/adt/pool/batch_mem_pool.h"
+#include "srsran/adt/pool/cached_alloc.h"
 #include "srsran/common/buffer_pool.h"
 #include <array>
 #include <list>
@@ -111,6 +113,117 @@ private:
   std::array<rlc_am_pdu_segment_pool<HeaderType>::segment_resource, MAX_POOL_SIZE>             segments;
 };
 
+template <typename T>
+class rlc_am_node_pool;
+
+/// Base class of the nodes allocated by rlc_am_node_pool<T>. Each node keeps a pointer to the pool that allocated it,
+/// so that the lists holding the node can release it without a reference to the pool
+template <typename T>
+struct rlc_am_pool_node : public intrusive_double_linked_list_element<> {
+private:
+  friend class rlc_am_node_pool<T>;
+  rlc_am_node_pool<T>* parent_pool = nullptr;
+};
+
+/// Pool of nodes of type T. Nodes are allocated in batches and cached when released, so that adding and removing
+/// nodes does not allocate memory once the pool has grown to the number of nodes in use at a time.
+/// The pool must outlive the nodes it has allocated.
+template <typename T>
+class rlc_am_node_pool
+{
+public:
+  explicit rlc_am_node_pool(size_t nodes_per_batch = 64) : pool(nodes_per_batch, sizeof(T), alignof(T), 0)
+  {
+    static_assert(std::is_base_of<rlc_am_pool_node<T>, T>::value, "T must have rlc_am_pool_node<T> as base class");
+  }
+
+  template <typename... Args>
+  T* make_node(Args&&... args)
+  {
+    T* node           = new (pool.allocate_node()) T(std::forward<Args>(args)...);
+    node->parent_pool = this;
+    return node;
+  }
+  static void release_node(T* node)
+  {
+    rlc_am_node_pool<T>* parent = node->parent_pool;
+    node->~T();
+    parent->pool.deallocate_node(node);
+  }
+
+  /// Number of nodes allocated by the pool, including the cached ones
+  size_t size() const { return pool.size(); }
+
+private:
+  growing_batch_mem_pool pool;
+};
+
+/// Intrusive list of nodes allocated by rlc_am_node_pool<T>. The list owns its nodes and returns them to their pool
+/// when they are erased or when the list is cleared or destroyed
+template <typename T>
+class rlc_am_node_list
+{
+  using list_type = intrusive_double_linked_list<T>;
+
+  list_type list;
+  size_t    count = 0;
+
+public:
+  using iterator       = typename list_type::iterator;
+  using const_iterator = typename list_type::const_iterator;
+
+  rlc_am_node_list() = default;
+  rlc_am_node_list(rlc_am_node_list&& other) noexcept : list(std::move(other.list)), count(other.count)
+  {
+    other.count = 0;
+  }
+  rlc_am_node_list(const rlc_am_node_list&) = delete;
+  rlc_am_node_list& operator=(const rlc_am_node_list&) = delete;
+  rlc_am_node_list& operator=(rlc_am_node_list&& other) noexcept
+  {
+    clear();
+    list        = std::move(other.list);
+    count       = other.count;
+    other.count = 0;
+    return *this;
+  }
+  ~rlc_am_node_list() { clear(); }
+
+  T&     front() const { return list.front(); }
+  T&     back() const { return list.back(); }
+  bool   empty() const { return list.empty(); }
+  size_t size() const { return count; }
+
+  void push_back(T* node)
+  {
+    list.push_back(node);
+    count++;
+  }
+  /// Inserts "node" before "pos", or at the back of the list if "pos" is end()
+  iterator insert(iterator pos, T* node)
+  {
+    count++;
+    return list.insert(pos, node);
+  }
+  void erase(T* node)
+  {
+    list.pop(node);
+    count--;
+    rlc_am_node_pool<T>::release_node(node);
+  }
+  void clear()
+  {
+    while (not list.empty()) {
+      erase(&list.front());
+    }
+  }
+
+  iterator       begin() { return list.begin(); }
+  iterator       end() { return list.end(); }
+  const_iterator begin() const { return list.begin(); }
+  const_iterator end() const { return list.end(); }
+};
+
 /// Class that contains the parameters and state (e.g. segments) of a RLC PDU
 template <typename HeaderType>
 class rlc_amd_tx_pdu
@@ -462,7 +575,9 @@ private:
 template <class T>
 class pdu_retx_queue_list
 {
-  std::list<T> queue;
+  // The cached allocator reuses the nodes of the retransmissions that were popped
+  using list_type = std::list<T, cached_alloc<T> >;
+  list_type queue;
 
 public:
   ~pdu_retx_queue_list() = default;
@@ -485,7 +600,7 @@ public:
     return queue.front();
   }
 
-  const std::list<T>& get_inner_queue() const { return queue; }
+  const list_type& get_inner_queue() const { return queue; }
 
   void   clear() { queue.clear(); }
   size_t size() const { return queue.size(); }
@@ -496,7 +611,7 @@ public:
     if (queue.empty()) {
       return false;
     }
-    for (auto elem : queue) {
+    for (const auto& elem : queue) {
       if (elem.sn == sn) {
         return true;
       }
@@ -509,7 +624,7 @@ public:
     if (queue.empty()) {
       return false;
     }
-    for (auto elem : queue) {
+    for (const auto& elem : queue) {
       if (elem.sn == sn) {
         if (elem.overlaps(so)) {
           return true;
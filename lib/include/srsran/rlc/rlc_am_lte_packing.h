@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RLC_AM_LTE_PACKING_H
 #define SRSRAN_RLC_AM_LTE_PACKING_H
 
+#include "srsran/adt/pool/batch_mem_pool.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/rlc/rlc_am_base.h"
 #include "srsran/rlc/rlc_am_data_structs.h" // required for rlc_am_pdu_segment
@@ -43,8 +44,71 @@ struct rlc_amd_rx_pdu {
   explicit rlc_amd_rx_pdu(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
 };
 
-struct rlc_amd_rx_pdu_segments_t {
-  std::list<rlc_amd_rx_pdu> segments;
+/// Segment of a RLC AM PDU received from lower layers
+struct rlc_amd_rx_pdu_segment {
+  rlc_amd_pdu_header_t    header;
+  unique_byte_buffer_t    buf;
+  rlc_amd_rx_pdu_segment* next = nullptr;
+};
+
+/// Pool of RX PDU segments. Segments are allocated in batches and cached when released, so that the reception of PDU
+/// segments does not allocate memory once the pool has grown to the number of segments buffered at a time
+class rlc_amd_rx_pdu_segment_pool
+{
+public:
+  explicit rlc_amd_rx_pdu_segment_pool(size_t segments_per_batch = 16) :
+    pool(segments_per_batch, sizeof(rlc_amd_rx_pdu_segment), alignof(rlc_amd_rx_pdu_segment), 0)
+  {}
+
+  rlc_amd_rx_pdu_segment* make_segment() { return new (pool.allocate_node()) rlc_amd_rx_pdu_segment(); }
+  void                    release_segment(rlc_amd_rx_pdu_segment* segment)
+  {
+    segment->~rlc_amd_rx_pdu_segment();
+    pool.deallocate_node(segment);
+  }
+
+  /// Number of segments allocated by the pool, including the cached ones
+  size_t size() const { return pool.size(); }
+
+private:
+  growing_batch_mem_pool pool;
+};
+
+/// Segments received of a RLC AM PDU, linked in ascending order of SO. The number of bytes received without gaps from
+/// SO=0 is updated on every insertion, so that checking whether the PDU is complete does not traverse the segments
+class rlc_amd_rx_pdu_segments_t
+{
+public:
+  rlc_amd_rx_pdu_segments_t(uint32_t rlc_sn_, rlc_amd_rx_pdu_segment_pool& pool_) : rlc_sn(rlc_sn_), pool(&pool_) {}
+  rlc_amd_rx_pdu_segments_t(rlc_amd_rx_pdu_segments_t&& other) noexcept;
+  rlc_amd_rx_pdu_segments_t(const rlc_amd_rx_pdu_segments_t&) = delete;
+  rlc_amd_rx_pdu_segments_t& operator=(const rlc_amd_rx_pdu_segments_t&) = delete;
+  rlc_amd_rx_pdu_segments_t& operator=(rlc_amd_rx_pdu_segments_t&&) = delete;
+  ~rlc_amd_rx_pdu_segments_t() { clear(); }
+
+  /// Inserts a segment allocated from the pool, taking its ownership. A segment with the same SO as a received one
+  /// only replaces it if it is bigger. Segments fully overlapped by the preceding ones are released
+  void add_segment(rlc_amd_rx_pdu_segment* segment);
+  void clear();
+
+  /// All bytes of the PDU up to the segment with the LSF set have been received
+  bool complete() const { return tail != nullptr and tail->header.lsf and contiguous_bytes >= segment_end(*tail); }
+
+  const rlc_amd_rx_pdu_segment* front() const { return head; }
+  const rlc_amd_rx_pdu_segment* back() const { return tail; }
+  size_t                        size() const { return nof_segments; }
+  bool                          empty() const { return head == nullptr; }
+
+  const uint32_t rlc_sn;
+
+private:
+  static uint32_t segment_end(const rlc_amd_rx_pdu_segment& s) { return s.header.so + s.buf->N_bytes; }
+
+  rlc_amd_rx_pdu_segment_pool* pool;
+  rlc_amd_rx_pdu_segment*      head             = nullptr;
+  rlc_amd_rx_pdu_segment*      tail             = nullptr;
+  size_t                       nof_segments     = 0;
+  uint32_t                     contiguous_bytes = 0; // bytes received without gaps from SO=0
 };
 
 /****************************************************************************
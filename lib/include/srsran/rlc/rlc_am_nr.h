@@ -81,16 +81,19 @@ struct rlc_am_nr_tx_state_t {
 };
 
 struct rlc_amd_tx_pdu_nr {
-  const uint32_t         rlc_sn     = INVALID_RLC_SN;
-  uint32_t               pdcp_sn    = INVALID_RLC_SN;
-  rlc_am_nr_pdu_header_t header     = {};
-  unique_byte_buffer_t   sdu_buf    = nullptr;
-  uint32_t               retx_count = RETX_COUNT_NOT_STARTED;
-  struct pdu_segment {
+  const uint32_t         rlc_sn          = INVALID_RLC_SN;
+  uint32_t               pdcp_sn         = INVALID_RLC_SN;
+  rlc_am_nr_pdu_header_t header          = {};
+  unique_byte_buffer_t   sdu_buf         = nullptr;
+  uint32_t               retx_count      = RETX_COUNT_NOT_STARTED;
+  uint32_t               nof_queued_retx = 0; // Entries of the retx queue with this SN. Avoids searching the queue
+  struct pdu_segment : public rlc_am_pool_node<pdu_segment> {
+    pdu_segment(uint32_t so_, uint32_t payload_len_) : so(so_), payload_len(payload_len_) {}
     uint32_t so          = 0;
     uint32_t payload_len = 0;
   };
-  std::list<pdu_segment> segment_list;
+  using segment_pool_t = rlc_am_node_pool<pdu_segment>;
+  rlc_am_node_list<pdu_segment> segment_list; // Segments in ascending order of SO, allocated from the Tx segment pool
   explicit rlc_amd_tx_pdu_nr(uint32_t sn) : rlc_sn(sn) {}
 };
 
@@ -104,7 +107,7 @@ public:
   bool     configure(const rlc_config_t& cfg_) final;
   uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) final;
   void     handle_control_pdu(uint8_t* payload, uint32_t nof_bytes) final;
-  void     handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>& retx_sn_set);
+  void     handle_nack(const rlc_status_nack_t& nack, std::vector<uint32_t>& retx_sns);
 
   void reestablish() final;
   void stop() final;
@@ -160,13 +163,21 @@ private:
    * Tx state variables
    * Ref: 3GPP TS 38.322 version 16.2.0 Section 7.1
    ***************************************************************************/
-  struct rlc_am_nr_tx_state_t                              st = {};
+  struct rlc_am_nr_tx_state_t st = {};
+
+  // The segment pool must outlive the segments of the PDUs in tx_window
+  rlc_amd_tx_pdu_nr::segment_pool_t                        segment_pool;
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_tx_pdu_nr> > tx_window;
 
   // Queues, buffers and container
   pdu_retx_queue_list<rlc_amd_retx_nr_t> retx_queue;
-  uint32_t         sdu_under_segmentation_sn = INVALID_RLC_SN; // SN of the SDU currently being segmented.
-  pdcp_sn_vector_t notify_info_vec;
+  uint32_t              sdu_under_segmentation_sn = INVALID_RLC_SN; // SN of the SDU currently being segmented.
+  pdcp_sn_vector_t      notify_info_vec;
+  std::vector<uint32_t> retx_sns; // SNs of the PDUs NACKed by a status PDU, reused across status PDUs
+
+  // Status PDUs reused across status reports, so that their NACKs are not reallocated on every report
+  std::unique_ptr<rlc_am_nr_status_pdu_t> tx_status; // Built from the state of the Rx entity
+  std::unique_ptr<rlc_am_nr_status_pdu_t> rx_status; // Received from the peer
 
   // Helper constants
   uint32_t min_hdr_size = 2; // Pre-initialized for 12 bit SN, updated by configure()
@@ -252,7 +263,9 @@ public:
   bool inside_rx_window(uint32_t sn) const;
   bool valid_ack_sn(uint32_t sn) const;
   void write_to_upper_layers(uint32_t lcid, unique_byte_buffer_t sdu);
-  void insert_received_segment(rlc_amd_rx_pdu_nr segment, rlc_amd_rx_sdu_nr_t::segment_list_t& segment_list) const;
+  void insert_received_segment(const rlc_am_nr_pdu_header_t&        header,
+                               unique_byte_buffer_t                 buf,
+                               rlc_amd_rx_sdu_nr_t::segment_list_t& segment_list);
   /**
    * @brief update_segment_inventory This function updates the flags has_gap and fully_received of an SDU
    * according to the current inventory of received SDU segments
@@ -279,9 +292,13 @@ private:
   uint32_t mod_nr = cardinality(rlc_am_nr_sn_size_t());
   uint32_t rx_mod_base_nr(uint32_t sn) const;
 
-  // RX Window
+  // RX Window. The segment pool must outlive the segments of the SDUs in rx_window
+  rlc_amd_rx_sdu_nr_t::segment_pool_t                        segment_pool;
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_rx_sdu_nr_t> > rx_window;
 
+  // Status PDU reused to compute the length of the status PDU
+  std::unique_ptr<rlc_am_nr_status_pdu_t> status_len_pdu;
+
   // Mutexes
   std::mutex mutex;
 
@@ -24,7 +24,7 @@
 
 #include "srsran/common/string_helpers.h"
 #include "srsran/rlc/rlc_am_base.h"
-#include <set>
+#include "srsran/rlc/rlc_am_data_structs.h"
 
 namespace srsran {
 
@@ -54,7 +54,7 @@ struct rlc_amd_pdu_nr_t {
   unique_byte_buffer_t   buf;
 };
 
-struct rlc_amd_rx_pdu_nr {
+struct rlc_amd_rx_pdu_nr : public rlc_am_pool_node<rlc_amd_rx_pdu_nr> {
   rlc_am_nr_pdu_header_t header = {};
   unique_byte_buffer_t   buf    = nullptr;
   uint32_t               rlc_sn = {};
@@ -63,17 +63,14 @@ struct rlc_amd_rx_pdu_nr {
   explicit rlc_amd_rx_pdu_nr(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
 };
 
-struct rlc_amd_rx_pdu_nr_cmp {
-  bool operator()(const rlc_amd_rx_pdu_nr& a, const rlc_amd_rx_pdu_nr& b) const { return a.header.so < b.header.so; }
-};
-
 struct rlc_amd_rx_sdu_nr_t {
   uint32_t             rlc_sn         = 0;
   bool                 fully_received = false;
   bool                 has_gap        = false;
   unique_byte_buffer_t buf;
-  using segment_list_t = std::set<rlc_amd_rx_pdu_nr, rlc_amd_rx_pdu_nr_cmp>;
-  segment_list_t segments;
+  using segment_pool_t = rlc_am_node_pool<rlc_amd_rx_pdu_nr>;
+  using segment_list_t = rlc_am_node_list<rlc_amd_rx_pdu_nr>;
+  segment_list_t segments; // Segments in ascending order of SO, allocated from the Rx segment pool
 
   rlc_amd_rx_sdu_nr_t() = default;
   explicit rlc_amd_rx_sdu_nr_t(uint32_t rlc_sn_) : rlc_sn(rlc_sn_) {}
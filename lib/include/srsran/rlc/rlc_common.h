@@ -286,9 +286,11 @@ public:
   virtual void                 reset_metrics() = 0;
 
   // PDCP interface
-  virtual void write_sdu(unique_byte_buffer_t sdu) = 0;
-  virtual void discard_sdu(uint32_t discard_sn)    = 0;
-  virtual bool sdu_queue_is_full()                 = 0;
+  virtual void     write_sdu(unique_byte_buffer_t sdu) = 0;
+  virtual void     discard_sdu(uint32_t discard_sn)    = 0;
+  virtual bool     sdu_queue_is_full()                 = 0;
+  virtual bool     sdu_queue_is_congested()            = 0;
+  virtual uint32_t sdu_queue_free_slots()              = 0;
 
   // MAC interface
   virtual bool     has_data() = 0;
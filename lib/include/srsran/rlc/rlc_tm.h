@@ -56,9 +56,11 @@ public:
   void                 reset_metrics() override;
 
   // PDCP interface
-  void write_sdu(unique_byte_buffer_t sdu) override;
-  void discard_sdu(uint32_t discard_sn) override;
-  bool sdu_queue_is_full() override;
+  void     write_sdu(unique_byte_buffer_t sdu) override;
+  void     discard_sdu(uint32_t discard_sn) override;
+  bool     sdu_queue_is_full() override;
+  bool     sdu_queue_is_congested() override;
+  uint32_t sdu_queue_free_slots() override;
 
   // MAC interface
   bool     has_data() override;
@@ -83,7 +85,8 @@ private:
   std::mutex           metrics_mutex;
   rlc_bearer_metrics_t metrics = {};
 
-  // Thread-safe queues for MAC messages
+  // Lock-free queue for MAC messages. The MAC read and the queue flush on stop are both readers of the queue
+  std::mutex        read_mutex;
   byte_buffer_queue ul_queue;
 };
 
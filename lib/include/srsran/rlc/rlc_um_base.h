@@ -28,6 +28,7 @@
 #include "srsran/common/task_scheduler.h"
 #include "srsran/rlc/rlc_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <pthread.h>
@@ -60,9 +61,11 @@ public:
   uint32_t   get_lcid() final;
 
   // PDCP interface
-  void write_sdu(unique_byte_buffer_t sdu);
-  void discard_sdu(uint32_t discard_sn);
-  bool sdu_queue_is_full();
+  void     write_sdu(unique_byte_buffer_t sdu);
+  void     discard_sdu(uint32_t discard_sn);
+  bool     sdu_queue_is_full();
+  bool     sdu_queue_is_congested();
+  uint32_t sdu_queue_free_slots();
 
   // MAC interface
   bool     has_data();
@@ -94,6 +97,8 @@ protected:
     void             write_sdu(unique_byte_buffer_t sdu);
     void             discard_sdu(uint32_t discard_sn);
     bool             sdu_queue_is_full();
+    bool             sdu_queue_is_congested();
+    uint32_t         sdu_queue_free_slots();
     int              try_write_sdu(unique_byte_buffer_t sdu);
     void             reset_metrics();
     bool             has_data();
@@ -116,6 +121,8 @@ protected:
 
     // Mutexes
     std::mutex mutex;
+    std::mutex sdu_queue_mutex; // Held by the PDCP writer, and while the Tx SDU queue is drained or resized. Never
+                                // taken by read_pdu()
 
     // Metrics
 #ifdef ENABLE_TIMESTAMP
@@ -175,8 +182,8 @@ protected:
   std::unique_ptr<rlc_um_base_tx> tx;
   std::unique_ptr<rlc_um_base_rx> rx;
 
-  bool tx_enabled = false;
-  bool rx_enabled = false;
+  std::atomic<bool> tx_enabled = {false}; // Checked again by the Tx under sdu_queue_mutex, so no SDU outlives a stop
+  bool              rx_enabled = false;
 
   std::mutex           metrics_mutex;
   rlc_bearer_metrics_t metrics = {};
@@ -63,6 +63,19 @@ public:
   bool     has_data_locked(const uint32_t lcid) override { return false; }
   uint32_t get_buffer_state(const uint32_t lcid) override { return 0; }
   uint32_t read_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) override { return 0; }
+  uint32_t read_pdus(uint32_t lcid, srsran::read_pdu_batch_interface& batch) override
+  {
+    uint32_t nof_bytes = 0;
+    for (srsran::span<uint8_t> pdu = batch.reserve_pdu(); not pdu.empty(); pdu = batch.reserve_pdu()) {
+      uint32_t pdu_len = read_pdu(lcid, pdu.data(), pdu.size());
+      if (pdu_len == 0) {
+        break;
+      }
+      batch.add_pdu(pdu_len);
+      nof_bytes += pdu_len;
+    }
+    return nof_bytes;
+  }
   void     write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) override {}
   void     write_pdu_bcch_bch(srsran::unique_byte_buffer_t payload) override {}
   void     write_pdu_bcch_dlsch(uint8_t* payload, uint32_t nof_bytes) override {}
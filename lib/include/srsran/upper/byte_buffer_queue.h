@@ -23,106 +23,222 @@
  * @file byte_buffer_queue.h
  *
  * @brief Queue of unique pointers to byte buffers used in PDCP and RLC TX queues.
- *        Uses a blocking queue with bounded capacity to block higher layers
- *        when pushing uplink traffic
+ *        Single-producer single-consumer lock-free ring buffer. The higher layer writes SDUs and the MAC-triggered
+ *        path reads them, without any of the two sides waiting on a mutex held by the other. The number of queued
+ *        SDUs and bytes are kept in atomic counters, so the buffer state can be read from any thread. Above
+ *        configurable SDU/byte watermarks, the queue reports congestion, so that the higher layers can hold SDUs
+ *        back before the queue becomes full.
  */
 
 #ifndef SRSRAN_BYTE_BUFFERQUEUE_H
 #define SRSRAN_BYTE_BUFFERQUEUE_H
 
-#include "srsran/adt/circular_buffer.h"
-#include "srsran/common/block_queue.h"
+#include "srsran/adt/expected.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
-#include <functional>
-#include <pthread.h>
+#include "srsran/support/srsran_assert.h"
+#include <atomic>
+#include <memory>
+#include <thread>
 
 namespace srsran {
 
 class byte_buffer_queue
 {
 public:
-  byte_buffer_queue(int capacity = 128) :
-    queue(capacity, push_callback(unread_bytes, n_sdus), pop_callback(unread_bytes, n_sdus))
-  {}
+  explicit byte_buffer_queue(uint32_t capacity_ = 128) { resize(capacity_); }
+  byte_buffer_queue(const byte_buffer_queue&)            = delete;
+  byte_buffer_queue& operator=(const byte_buffer_queue&) = delete;
+  ~byte_buffer_queue() { clear(); }
 
-  void write(unique_byte_buffer_t msg) { queue.push_blocking(std::move(msg)); }
+  /// Pushes an SDU, yielding while the queue is full. Producer side
+  void write(unique_byte_buffer_t msg)
+  {
+    while (not push(msg)) {
+      std::this_thread::yield();
+    }
+  }
 
+  /// Pushes an SDU if the queue is not full. Otherwise, the SDU is returned back. Producer side
   srsran::error_type<unique_byte_buffer_t> try_write(unique_byte_buffer_t&& msg)
   {
-    return queue.try_push(std::move(msg));
+    if (not push(msg)) {
+      return std::move(msg);
+    }
+    return {};
   }
 
-  unique_byte_buffer_t read() { return queue.pop_blocking(); }
+  /// Removes the queued SDU with the given PDCP SN, unless the consumer already read it. Producer side
+  bool discard(uint32_t pdcp_sn)
+  {
+    uint64_t w = wpos.load(std::memory_order_relaxed);
+    for (uint64_t r = rpos.load(std::memory_order_acquire); r != w; ++r) {
+      slot_t& slot = slots[r % capacity];
+      if (slot.pdcp_sn != pdcp_sn) {
+        continue;
+      }
+      // The consumer may take the same SDU concurrently. Whoever takes the pointer owns the SDU
+      unique_byte_buffer_t sdu(slot.sdu.exchange(nullptr, std::memory_order_relaxed));
+      if (sdu != nullptr) {
+        remove_from_counters(slot);
+        return true;
+      }
+    }
+    return false;
+  }
 
-  bool try_read(unique_byte_buffer_t* msg) { return queue.try_pop(*msg); }
+  /// Pops the oldest entry, yielding while the queue is empty. Discarded SDUs are popped as nullptr. Consumer side
+  unique_byte_buffer_t read()
+  {
+    unique_byte_buffer_t msg;
+    while (not pop(msg)) {
+      std::this_thread::yield();
+    }
+    return msg;
+  }
 
-  void     resize(uint32_t capacity) { queue.set_size(capacity); }
-  uint32_t size() { return (uint32_t)queue.size(); }
-  uint32_t get_n_sdus() { return n_sdus; }
+  /// Pops the oldest entry, if any. Discarded SDUs are popped as nullptr. Consumer side
+  bool try_read(unique_byte_buffer_t* msg) { return pop(*msg); }
 
-  uint32_t size_bytes() { return unread_bytes; }
+  /// Pops and deletes all the entries. Consumer side
+  void clear()
+  {
+    unique_byte_buffer_t msg;
+    while (pop(msg)) {
+    }
+  }
 
-  uint32_t size_tail_bytes()
+  /// Changes the capacity of the queue. Must not be called concurrently with the producer or the consumer
+  void resize(uint32_t capacity_)
   {
-    uint32_t size_next = 0;
-    queue.try_call_on_front([&size_next](const unique_byte_buffer_t& front_val) {
-      if (front_val != nullptr) {
-        size_next += front_val->N_bytes;
-      }
-    });
-    return size_next;
+    if (capacity_ == capacity) {
+      return;
+    }
+    srsran_assert(is_empty(), "Dynamic resizes not supported when the queue is not empty");
+    capacity = std::max(capacity_, 1U);
+    slots.reset(new slot_t[capacity]);
+    rpos.store(0, std::memory_order_relaxed);
+    wpos.store(0, std::memory_order_relaxed);
   }
 
-  // This is a hack to reset N_bytes counter when queue is corrupted (see line 89)
-  void reset() { unread_bytes = 0; }
+  /**
+   * Sets the watermarks at which the queue becomes congested. The congestion clears when the queued SDUs and bytes
+   * fall back to half of the watermarks. A watermark of 0 is disabled, in which case only a full queue is congested.
+   * Must not be called concurrently with the producer or the consumer
+   */
+  void set_watermarks(uint32_t high_sdus_, uint32_t high_bytes_)
+  {
+    high_sdus  = high_sdus_;
+    high_bytes = high_bytes_;
+    congested.store(false, std::memory_order_relaxed);
+  }
 
-  bool is_empty() { return queue.empty(); }
+  /// Whether the higher layers should hold SDUs back. Concurrent calls only affect the hysteresis
+  bool is_congested()
+  {
+    uint32_t sdus  = n_sdus.load(std::memory_order_relaxed);
+    uint32_t bytes = unread_bytes.load(std::memory_order_relaxed);
+    bool     ret;
+    if (congested.load(std::memory_order_relaxed)) {
+      ret = (high_sdus > 0 and sdus > high_sdus / 2) or (high_bytes > 0 and bytes > high_bytes / 2);
+    } else {
+      ret = (high_sdus > 0 and sdus >= high_sdus) or (high_bytes > 0 and bytes >= high_bytes);
+    }
+    congested.store(ret, std::memory_order_relaxed);
+    return ret or is_full();
+  }
 
-  bool is_full() { return queue.full(); }
+  /// Number of entries, including the discarded SDUs that were not popped yet
+  uint32_t size() const
+  {
+    // rpos is read first, as it can never overtake a later read of wpos
+    uint64_t r = rpos.load(std::memory_order_acquire);
+    return (uint32_t)(wpos.load(std::memory_order_acquire) - r);
+  }
+  uint32_t get_n_sdus() const { return n_sdus.load(std::memory_order_relaxed); }
+
+  uint32_t size_bytes() const { return unread_bytes.load(std::memory_order_relaxed); }
 
-  template <typename F>
-  bool apply_first(const F& func)
+  /// Size of the SDU that the consumer reads next. Consumer side
+  uint32_t size_tail_bytes() const
   {
-    return queue.apply_first(func);
+    uint64_t r = rpos.load(std::memory_order_relaxed);
+    if (r == wpos.load(std::memory_order_acquire)) {
+      return 0;
+    }
+    const slot_t& slot = slots[r % capacity];
+    return slot.sdu.load(std::memory_order_relaxed) != nullptr ? slot.nof_bytes : 0;
+  }
+
+  bool is_empty() const { return size() == 0; }
+
+  bool is_full() const { return size() >= capacity; }
+
+  /// Number of entries that can still be pushed. It can only grow until the producer pushes again
+  uint32_t free_slots() const
+  {
+    uint32_t n = size();
+    return n < capacity ? capacity - n : 0;
   }
 
 private:
-  struct push_callback {
-    explicit push_callback(std::atomic<uint32_t>& unread_bytes_, std::atomic<uint32_t>& n_sdus_) :
-      unread_bytes(unread_bytes_), n_sdus(n_sdus_)
-    {}
-    void operator()(const unique_byte_buffer_t& msg)
-    {
-      unread_bytes.fetch_add(msg->N_bytes, std::memory_order_relaxed);
-      n_sdus.fetch_add(1, std::memory_order_relaxed);
-    }
-    std::atomic<uint32_t>& unread_bytes;
-    std::atomic<uint32_t>& n_sdus;
+  /// The SDU metadata is written by the producer before the entry is published, and stays constant until the
+  /// producer reuses the slot. It can be read without owning the SDU
+  struct slot_t {
+    std::atomic<byte_buffer_t*> sdu{nullptr};
+    uint32_t                    pdcp_sn   = 0;
+    uint32_t                    nof_bytes = 0;
   };
-  struct pop_callback {
-    explicit pop_callback(std::atomic<uint32_t>& unread_bytes_, std::atomic<uint32_t>& n_sdus_) :
-      unread_bytes(unread_bytes_), n_sdus(n_sdus_)
-    {}
-    void operator()(const unique_byte_buffer_t& msg)
-    {
-      if (msg == nullptr) {
-        return;
-      }
-      // non-atomic update of both state variables
-      unread_bytes.fetch_sub(std::min(msg->N_bytes, unread_bytes.load(std::memory_order_relaxed)),
-                             std::memory_order_relaxed);
-      n_sdus.store(std::max(0, (int32_t)(n_sdus.load(std::memory_order_relaxed)) - 1), std::memory_order_relaxed);
+
+  bool push(unique_byte_buffer_t& msg)
+  {
+    uint64_t w = wpos.load(std::memory_order_relaxed);
+    if (w - rpos.load(std::memory_order_acquire) >= capacity) {
+      return false;
     }
-    std::atomic<uint32_t>& unread_bytes;
-    std::atomic<uint32_t>& n_sdus;
-  };
+    slot_t& slot   = slots[w % capacity];
+    slot.pdcp_sn   = msg->md.pdcp_sn;
+    slot.nof_bytes = msg->N_bytes;
+    slot.sdu.store(msg.release(), std::memory_order_relaxed);
+    // The counters are updated before the entry is published, so that they never underflow when it is popped
+    unread_bytes.fetch_add(slot.nof_bytes, std::memory_order_relaxed);
+    n_sdus.fetch_add(1, std::memory_order_relaxed);
+    wpos.store(w + 1, std::memory_order_release);
+    return true;
+  }
 
-  std::atomic<uint32_t> unread_bytes = {0};
-  std::atomic<uint32_t> n_sdus       = {0};
+  bool pop(unique_byte_buffer_t& msg)
+  {
+    uint64_t r = rpos.load(std::memory_order_relaxed);
+    if (r == wpos.load(std::memory_order_acquire)) {
+      return false;
+    }
+    slot_t& slot = slots[r % capacity];
+    msg.reset(slot.sdu.exchange(nullptr, std::memory_order_relaxed));
+    if (msg != nullptr) {
+      remove_from_counters(slot);
+    }
+    rpos.store(r + 1, std::memory_order_release);
+    return true;
+  }
 
-public:
-  dyn_blocking_queue<unique_byte_buffer_t, push_callback, pop_callback> queue;
+  void remove_from_counters(const slot_t& slot)
+  {
+    unread_bytes.fetch_sub(slot.nof_bytes, std::memory_order_relaxed);
+    n_sdus.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  std::unique_ptr<slot_t[]> slots;
+  uint32_t                  capacity   = 0;
+  uint32_t                  high_sdus  = 0;
+  uint32_t                  high_bytes = 0;
+  std::atomic<bool>         congested{false};
+
+  // Positions of the next read and write. They only grow, so a position never repeats in the lifetime of the queue
+  std::atomic<uint64_t> rpos{0};
+  std::atomic<uint64_t> wpos{0};
+  std::atomic<uint32_t> unread_bytes{0};
+  std::atomic<uint32_t> n_sdus{0};
 };
 
 } // namespace srsran
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*
+ * @file pdcp_discard_timer_wheel.h
+ *
+ * @brief Discard timers of the SDUs of a PDCP bearer, on top of a single timer of the task scheduler.
+ *        All the SDUs of a bearer share the same discardTimer, so they expire in the order they were added. SNs are
+ *        kept in buckets of "tick" msec, indexed by their expiry time, and the bearer timer only runs for the earliest
+ *        non-empty bucket. The tick is discardTimer / 64 rounded down to a power of 2, so that an SN is discarded at
+ *        most 1/64 of the discardTimer late, and never early. The running timers are kept in a window of slots indexed
+ *        by SN, so that a stopped timer is only cleared from its slot, and skipped when its bucket expires.
+ */
+
+#ifndef SRSRAN_PDCP_DISCARD_TIMER_WHEEL_H
+#define SRSRAN_PDCP_DISCARD_TIMER_WHEEL_H
+
+#include "srsran/adt/move_callback.h"
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/timers.h"
+#include <vector>
+
+namespace srsran {
+
+class pdcp_discard_timer_wheel
+{
+public:
+  using expiry_callback_t = srsran::move_callback<void(uint32_t)>;
+
+  pdcp_discard_timer_wheel() = default;
+  pdcp_discard_timer_wheel(const pdcp_discard_timer_wheel&) = delete;
+  pdcp_discard_timer_wheel& operator=(const pdcp_discard_timer_wheel&) = delete;
+
+  /**
+   * Allocates the bearer timer and the buckets. "callback" is called with the SN of each expired discard timer.
+   * The window of slots grows up to "max_capacity", rounded up to a power of 2. Two SNs that are a multiple of it
+   * apart can't have their discard timers running at the same time.
+   * Calling it again on a reconfiguration keeps the running timers if the timeout and capacity are unchanged, and stops
+   * them otherwise
+   */
+  void init(task_sched_handle task_sched, uint32_t timeout_ms_, uint32_t max_capacity, expiry_callback_t callback_);
+  /// Stops all the discard timers and releases the bearer timer, so that no new timer can be started
+  void reset();
+  bool is_init() const { return timer.is_valid(); }
+
+  /// Starts the discard timer of an SN. Fails if the timer of another SN is running in the same slot
+  bool start(uint32_t sn);
+  /// Stops the discard timer of an SN. Returns false if it was not running
+  bool stop(uint32_t sn);
+  /// Stops all the discard timers
+  void clear();
+
+  bool     is_running(uint32_t sn) const { return is_init() and slots[sn & slot_mask].sn == sn; }
+  uint32_t nof_running() const { return nof_running_timers; }
+  uint32_t get_timeout() const { return timeout_ms; }
+
+private:
+  const static uint32_t invalid_sn       = -1;
+  const static uint32_t initial_capacity = 1024;
+
+  struct slot_t {
+    uint32_t sn     = invalid_sn;
+    uint32_t expiry = 0;
+  };
+
+  std::vector<uint32_t>& bucket(uint32_t expiry) { return buckets[(expiry >> tick_shift) & bucket_mask]; }
+  uint32_t               now() const { return timer.is_running() ? timer_start + timer.time_elapsed() : timer_start; }
+  void                   run_timer(uint32_t cur_time, uint32_t expiry);
+  void                   clear_buckets(uint32_t from_expiry);
+  void                   grow_slots();
+  void                   handle_expiry();
+
+  unique_timer      timer;
+  expiry_callback_t callback;
+  uint32_t          timeout_ms  = 0;
+  uint32_t          tick_shift  = 0;
+  uint32_t          bucket_mask = 0;
+  uint32_t          slot_mask   = 0;
+  uint32_t          max_slots   = 0;
+
+  // Times are in ticks of the task scheduler timers, counted from an arbitrary origin
+  uint32_t timer_start  = 0; // Time when the bearer timer was last run
+  uint32_t timer_expiry = 0; // Expiry of the bucket the bearer timer runs for
+  uint32_t last_expiry  = 0; // Expiry of the last bucket an SN was added to
+
+  uint32_t                           nof_running_timers = 0;
+  std::vector<std::vector<uint32_t>> buckets;
+  std::vector<slot_t>                slots; // SN whose discard timer is running, indexed by SN
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PDCP_DISCARD_TIMER_WHEEL_H
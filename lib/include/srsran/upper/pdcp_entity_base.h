@@ -121,6 +121,14 @@ public:
   // GW/SDAP/RRC interface
   virtual void write_sdu(unique_byte_buffer_t sdu, int sn = -1) = 0;
 
+  /// Writes several SDUs of the bearer, numbered in order. Entities that can cipher them in one batch override it
+  virtual void write_sdus(span<unique_byte_buffer_t> sdus)
+  {
+    for (unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(std::move(sdu));
+    }
+  }
+
   // RLC interface
   virtual void write_pdu(unique_byte_buffer_t pdu)               = 0;
   virtual void notify_delivery(const pdcp_sn_vector_t& pdcp_sns) = 0;
@@ -168,6 +176,8 @@ protected:
   std::string   rb_name;
 
   srsran::as_security_config_t sec_cfg = {};
+  srsran::cipher_ctx           cipher_state;
+  srsran::integrity_ctx        integrity_state;
 
   // Security functions
   void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
@@ -28,6 +28,7 @@
 #include "srsran/common/security.h"
 #include "srsran/common/threads.h"
 #include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/upper/pdcp_discard_timer_wheel.h"
 #include "srsran/upper/pdcp_entity_base.h"
 
 namespace srsue {
@@ -42,7 +43,11 @@ namespace srsran {
 class undelivered_sdus_queue
 {
 public:
-  explicit undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod);
+  /// A discard_timeout of 0 disables the discard timers
+  undelivered_sdus_queue(srsran::task_sched_handle                           task_sched,
+                         uint32_t                                            sn_mod,
+                         uint32_t                                            discard_timeout,
+                         srsran::pdcp_discard_timer_wheel::expiry_callback_t discard_callback);
 
   bool            empty() const { return count == 0; }
   bool            is_full() const { return count >= capacity; }
@@ -54,12 +59,9 @@ public:
     return sdus[sn].sdu != nullptr and sdus[sn].sdu->md.pdcp_sn == sn;
   }
   // Getter for the number of discard timers. Used for debugging.
-  size_t nof_discard_timers() const;
+  size_t nof_discard_timers() const { return discard_timers.nof_running(); }
 
-  bool add_sdu(uint32_t                              sn,
-               const srsran::unique_byte_buffer_t&   sdu,
-               uint32_t                              discard_timeout,
-               srsran::move_callback<void(uint32_t)> callback);
+  bool add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu);
 
   unique_byte_buffer_t& operator[](uint32_t sn)
   {
@@ -88,7 +90,6 @@ private:
 
   struct sdu_data {
     srsran::unique_byte_buffer_t sdu;
-    srsran::unique_timer         discard_timer;
   };
 
   uint32_t                                   count = 0;
@@ -96,6 +97,7 @@ private:
   uint32_t                                   fms   = 0; // SN of the first missing PDCP SDU
   uint32_t                                   lms   = 0;
   srsran::circular_array<sdu_data, capacity> sdus;
+  srsran::pdcp_discard_timer_wheel           discard_timers;
 };
 
 /****************************************************************************
@@ -126,6 +128,7 @@ public:
 
   // GW/RRC interface
   void write_sdu(unique_byte_buffer_t sdu, int sn = -1) override;
+  void write_sdus(span<unique_byte_buffer_t> sdus) override;
 
   // RLC interface
   void write_pdu(unique_byte_buffer_t pdu) override;
@@ -166,6 +169,13 @@ private:
   uint32_t reordering_window = 0;
   uint32_t maximum_pdcp_sn   = 0;
 
+  // TX helpers. The SDU is numbered and gets its header and MAC before being ciphered, then it is sent to the RLC
+  bool prepare_tx_pdu(unique_byte_buffer_t& sdu, int upper_sn, uint32_t* tx_count);
+  void send_tx_pdu(unique_byte_buffer_t sdu);
+
+  // PDUs ciphered together by write_sdus()
+  std::vector<cipher_ctx::pdu_t> tx_batch;
+
   // PDU handlers
   void handle_control_pdu(srsran::unique_byte_buffer_t pdu);
   void handle_srb_pdu(srsran::unique_byte_buffer_t pdu);
@@ -206,16 +216,11 @@ private:
 class pdcp_entity_lte::discard_callback
 {
 public:
-  discard_callback(pdcp_entity_lte* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
-  void operator()(uint32_t timer_id);
+  discard_callback(pdcp_entity_lte* parent_) { parent = parent_; };
+  void operator()(uint32_t discard_sn);
 
 private:
   pdcp_entity_lte* parent;
-  uint32_t         discard_sn;
 };
 
 } // namespace srsran
@@ -32,6 +32,7 @@
 #include "srsran/interfaces/ue_gw_interfaces.h"
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/interfaces/ue_rlc_interfaces.h"
+#include "srsran/upper/pdcp_discard_timer_wheel.h"
 #include <map>
 
 namespace srsran {
@@ -71,7 +72,7 @@ public:
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus() override { return {}; }
 
   // State variable getters (useful for testing)
-  uint32_t nof_discard_timers() { return discard_timers_map.size(); }
+  uint32_t nof_discard_timers() { return discard_timers.nof_running(); }
   bool     is_reordering_timer_running() { return reordering_timer.is_running(); }
 
   // State variable setters (should be used only for testing)
@@ -98,9 +99,15 @@ private:
   // Constants: 3GPP TS 38.323 v15.2.0, section 7.2
   uint32_t window_size = 0;
 
-  // Reordering Queue / Timers
-  std::map<uint32_t, unique_byte_buffer_t> reorder_queue;
-  timer_handler::unique_timer              reordering_timer;
+  // Reordering buffer, indexed by COUNT modulo its size. Received COUNTs lie in [RX_DELIV, RX_DELIV + Window_Size), so
+  // the buffer grows as needed, up to Window_Size
+  const static uint32_t             initial_reorder_buffer_size = 128;
+  std::vector<unique_byte_buffer_t> reorder_buffer;
+  uint32_t                          nof_reorder_pdus = 0;
+  timer_handler::unique_timer       reordering_timer;
+
+  unique_byte_buffer_t& reorder_slot(uint32_t count) { return reorder_buffer[count & (reorder_buffer.size() - 1)]; }
+  void                  grow_reorder_buffer();
 
   // Pass to Upper Layers Helper function
   void deliver_all_consecutive_counts();
@@ -112,7 +119,7 @@ private:
 
   // Discard callback (discardTimer)
   class discard_callback;
-  std::map<uint32_t, timer_handler::unique_timer> discard_timers_map;
+  pdcp_discard_timer_wheel discard_timers;
 
   // COUNT overflow protection
   bool tx_overflow = false;
@@ -142,16 +149,11 @@ private:
 class pdcp_entity_nr::discard_callback
 {
 public:
-  discard_callback(pdcp_entity_nr* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
-  void operator()(uint32_t timer_id);
+  discard_callback(pdcp_entity_nr* parent_) { parent = parent_; };
+  void operator()(uint32_t discard_sn);
 
 private:
   pdcp_entity_nr* parent;
-  uint32_t        discard_sn;
 };
 
 /*
@@ -505,15 +505,10 @@ LIBLTE_ERROR_ENUM liblte_security_128_eia1(const uint8* key,
   LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
 
   if (key != NULL && msg != NULL && mac != NULL) {
-    uint32_t msg_len_bits = 0;
-    uint32_t i            = 0;
-    uint8_t* m_ptr;
+    uint32_t k[4];
 
-    msg_len_bits = msg_len * 8;
-    m_ptr        = s3g_f9(key, count, bearer << 27, direction, msg, msg_len_bits);
-    for (i = 0; i < 4; i++) {
-      mac[i] = m_ptr[i];
-    }
+    s3g_load_key(key, k);
+    s3g_f9_mac(k, count, bearer << 27, direction, msg, msg_len * 8, mac);
     err = LIBLTE_SUCCESS;
   }
   return (err);
@@ -21,7 +21,9 @@
 
 #include "srsran/common/network_utils.h"
 
+#include <algorithm>
 #include <netinet/sctp.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h> // for the pipe
@@ -400,6 +402,8 @@ socket_manager::socket_manager() : thread("RXsockets"), socket_manager_itf(srslo
   // register control pipe fd
   int fd = pipe(pipefd);
   srsran_assert(fd != -1, "Failed to open control pipe");
+  epoll_fd = epoll_create1(0);
+  srsran_assert(epoll_fd != -1, "Failed to create epoll instance");
   start(thread_prio);
 }
 
@@ -431,6 +435,10 @@ void socket_manager::stop()
     pipefd[1] = -1;
     rxSockDebug("closed.");
   }
+  if (epoll_fd >= 0) {
+    close(epoll_fd);
+    epoll_fd = -1;
+  }
 }
 
 bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
@@ -495,8 +503,19 @@ bool socket_manager::remove_socket(int fd)
   return result;
 }
 
-std::map<int, socket_manager::recv_callback_t>::iterator
-socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd)
+bool socket_manager::epoll_add(int fd)
+{
+  epoll_event ev = {};
+  ev.events      = EPOLLIN;
+  ev.data.fd     = fd;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+    rxSockError("Failed to add fd=%d to epoll: %s", fd, strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+std::map<int, socket_manager::recv_callback_t>::iterator socket_manager::remove_socket_unprotected(int fd)
 {
   if (fd < 0) {
     rxSockError("fd to be removed is not valid");
@@ -504,9 +523,10 @@ socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max
   }
   auto it = active_sockets.find(fd);
   it      = active_sockets.erase(it);
-  FD_CLR(fd, total_fd_set);
-  // assumes ordering
-  *max_fd = (active_sockets.empty()) ? pipefd[0] : std::max(pipefd[0], active_sockets.rbegin()->first);
+  // the fd may have been closed already, in which case the kernel removed it from the epoll set
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == -1) {
+    rxSockDebug("Socket fd=%d was not registered in epoll: %s", fd, strerror(errno));
+  }
   rxSockDebug("Socket fd=%d has been successfully removed", fd);
   return it;
 }
@@ -514,49 +534,50 @@ socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max
 void socket_manager::run_thread()
 {
   running = true;
-  fd_set total_fd_set, read_fd_set;
-  FD_ZERO(&total_fd_set);
-  int max_fd = 0;
+  std::array<epoll_event, max_events> events;
 
-  FD_SET(pipefd[0], &total_fd_set);
-  max_fd = std::max(pipefd[0], max_fd);
+  epoll_add(pipefd[0]);
 
   while (running.load(std::memory_order_relaxed)) {
-    memcpy(&read_fd_set, &total_fd_set, sizeof(total_fd_set));
-    int n = select(max_fd + 1, &read_fd_set, nullptr, nullptr, nullptr);
+    int n = epoll_wait(epoll_fd, events.data(), events.size(), -1);
 
-    // handle select return
+    // handle epoll_wait return
     if (n == -1) {
-      rxSockError("Error from select(%d,...). Number of rx sockets: %d", max_fd + 1, (int)active_sockets.size() + 1);
+      if (errno != EINTR) {
+        rxSockError("Error from epoll_wait. Number of rx sockets: %d", (int)active_sockets.size() + 1);
+      }
       continue;
     }
     if (n == 0) {
-      rxSockDebug("No data from select.");
+      rxSockDebug("No data from epoll_wait.");
       continue;
     }
 
     // Shared state area
     std::lock_guard<std::mutex> lock(socket_mutex);
 
-    // call read callback for all SCTP/TCP/UDP connections
-    for (auto handler_it = active_sockets.begin(); handler_it != active_sockets.end();) {
-      int              fd       = handler_it->first;
-      recv_callback_t& callback = handler_it->second;
-      if (not FD_ISSET(fd, &read_fd_set)) {
-        ++handler_it;
+    // call read callback for all SCTP/TCP/UDP connections with data
+    bool ctrl_pending = false;
+    for (int i = 0; i < n; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == pipefd[0]) {
+        ctrl_pending = true;
+        continue;
+      }
+      auto handler_it = active_sockets.find(fd);
+      if (handler_it == active_sockets.end()) {
+        // removed by a previous callback or control message
         continue;
       }
-      bool socket_valid = callback(fd);
+      bool socket_valid = handler_it->second(fd);
       if (not socket_valid) {
         rxSockInfo("The socket fd=%d has been closed by peer", fd);
-        handler_it = remove_socket_unprotected(fd, &total_fd_set, &max_fd);
-      } else {
-        ++handler_it;
+        remove_socket_unprotected(fd);
       }
     }
 
     // handle ctrl messages
-    if (FD_ISSET(pipefd[0], &read_fd_set)) {
+    if (ctrl_pending) {
       ctrl_cmd_t msg;
       ssize_t    nrd = read(pipefd[0], &msg, sizeof(msg));
       if (nrd <= 0) {
@@ -569,14 +590,13 @@ void socket_manager::run_thread()
           return;
         case ctrl_cmd_t::cmd_id_t::NEW_FD:
           if (msg.new_fd >= 0) {
-            FD_SET(msg.new_fd, &total_fd_set);
-            max_fd = std::max(max_fd, msg.new_fd);
+            epoll_add(msg.new_fd);
           } else {
             rxSockError("added fd is not valid");
           }
           break;
         case ctrl_cmd_t::cmd_id_t::RM_FD:
-          remove_socket_unprotected(msg.new_fd, &total_fd_set, &max_fd);
+          remove_socket_unprotected(msg.new_fd);
           if (msg.signal_rm_complete) {
             rem_fd_tmp_list.push_back(msg.new_fd);
             rem_cvar.notify_one();
@@ -701,4 +721,116 @@ make_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& queue,
   return socket_manager_itf::recv_callback_t(recvfrom_pdu_task(logger, queue, std::move(rx_callback)));
 }
 
+/**
+ * Description: Functor for the case the received data is in the form of unique_byte_buffer, and several datagrams
+ * are read with a single recvmmsg(...) call
+ */
+class recvmmsg_pdu_task
+{
+public:
+  using callback_t = recvfrom_callback_t;
+  explicit recvmmsg_pdu_task(srslog::basic_logger&      logger,
+                             srsran::task_queue_handle& queue_,
+                             callback_t                 func_,
+                             uint32_t                   batch_size) :
+    logger(logger),
+    queue(queue_),
+    func(std::move(func_)),
+    pdus(batch_size),
+    from(batch_size),
+    iov(batch_size),
+    msgs(batch_size)
+  {}
+
+  bool operator()(int fd)
+  {
+    // Buffers that were not filled in the previous call are kept for the next one
+    uint32_t nof_bufs = 0;
+    for (; nof_bufs < pdus.size(); ++nof_bufs) {
+      if (pdus[nof_bufs] == nullptr) {
+        pdus[nof_bufs] = srsran::make_byte_buffer();
+        if (pdus[nof_bufs] == nullptr) {
+          logger.error("Unable to allocate byte buffer");
+          break;
+        }
+      }
+    }
+    if (nof_bufs == 0) {
+      return true;
+    }
+
+    // The message headers point to the buffers of this call, so they are set up every time
+    for (uint32_t i = 0; i < nof_bufs; ++i) {
+      iov[i].iov_base             = pdus[i]->msg;
+      iov[i].iov_len              = pdus[i]->get_tailroom();
+      msgs[i]                     = {};
+      msgs[i].msg_hdr.msg_name    = &from[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      msgs[i].msg_hdr.msg_iov     = &iov[i];
+      msgs[i].msg_hdr.msg_iovlen  = 1;
+    }
+
+    int n_recv = recvmmsg(fd, msgs.data(), nof_bufs, MSG_DONTWAIT, nullptr);
+    if (n_recv == -1 and errno != EAGAIN) {
+      logger.error("Error reading from socket: %s", strerror(errno));
+      return true;
+    }
+    if (n_recv == -1 and errno == EAGAIN) {
+      logger.debug("Socket timeout reached");
+      return true;
+    }
+
+    std::vector<rx_sdu_t> batch;
+    batch.reserve(n_recv);
+    for (int i = 0; i < n_recv; ++i) {
+      if (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+        logger.warning("Dropping datagram that does not fit in a byte buffer");
+        continue;
+      }
+      pdus[i]->N_bytes = msgs[i].msg_len;
+      batch.push_back(rx_sdu_t{std::move(pdus[i]), from[i]});
+    }
+    // Keep the unused buffers at the front of the array
+    std::stable_partition(pdus.begin(), pdus.end(), [](const unique_byte_buffer_t& p) { return p != nullptr; });
+
+    if (batch.empty()) {
+      return true;
+    }
+
+    // Defer handling of received packets to provided queue
+    queue.push(std::bind(
+        [this](std::vector<rx_sdu_t>& sdus) {
+          for (rx_sdu_t& sdu : sdus) {
+            func(std::move(sdu.pdu), sdu.from);
+          }
+        },
+        std::move(batch)));
+
+    return true;
+  }
+
+private:
+  struct rx_sdu_t {
+    srsran::unique_byte_buffer_t pdu;
+    sockaddr_in                  from;
+  };
+
+  srslog::basic_logger&                     logger;
+  srsran::task_queue_handle&                queue;
+  callback_t                                func;
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+  std::vector<sockaddr_in>                  from;
+  std::vector<iovec>                        iov;
+  std::vector<mmsghdr>                      msgs;
+};
+
+socket_manager_itf::recv_callback_t make_batched_sdu_handler(srslog::basic_logger&      logger,
+                                                             srsran::task_queue_handle& queue,
+                                                             recvfrom_callback_t        rx_callback,
+                                                             uint32_t                   batch_size)
+{
+  return socket_manager_itf::recv_callback_t(
+      recvmmsg_pdu_task(logger, queue, std::move(rx_callback), std::max(batch_size, 1U)));
+}
+
 } // namespace srsran
@@ -21,6 +21,10 @@
 
 #include "srsran/common/s3g.h"
 
+#if defined(__AVX2__) || defined(__PCLMUL__)
+#include <immintrin.h>
+#endif
+
 /* S-box SQ */
 static const uint8_t SQ[256] = {
     0x25, 0x24, 0x73, 0x67, 0xD7, 0xAE, 0x5C, 0x30, 0xA4, 0xEE, 0x6E, 0xCB, 0x7D, 0xB5, 0x82, 0xDB, 0xE4, 0x8E, 0x48,
@@ -160,6 +164,47 @@ void s3g_deinitialize(S3G_STATE* state);
 *********************************************************************/
 void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
 
+/*********************************************************************
+    Name: s3g_tables
+
+    Description: Lookup tables for the LFSR feedback (MULalpha and
+                 DIValpha) and for the S-Boxes S1 and S2, one table per
+                 input byte position. Built once from the functions
+                 above, so that clocking does not recompute the field
+                 multiplications.
+*********************************************************************/
+struct s3g_tables_t {
+  uint32_t mul_alpha[256];
+  uint32_t div_alpha[256];
+  uint32_t s1[4][256];
+  uint32_t s2[4][256];
+
+  s3g_tables_t()
+  {
+    for (uint32_t x = 0; x < 256; x++) {
+      mul_alpha[x] = s3g_mul_alpha(x);
+      div_alpha[x] = s3g_div_alpha(x);
+      fill_sbox(s1, x, S[x], s3g_mul_x(S[x], 0x1b));
+      fill_sbox(s2, x, SQ[x], s3g_mul_x(SQ[x], 0x69));
+    }
+  }
+
+  // Contribution of the byte x at each position of the input word, position 0 being the MSB
+  static void fill_sbox(uint32_t t[4][256], uint32_t x, uint32_t s, uint32_t m)
+  {
+    t[0][x] = (m << 24) | ((m ^ s) << 16) | (s << 8) | s;
+    t[1][x] = (s << 24) | (m << 16) | ((m ^ s) << 8) | s;
+    t[2][x] = (s << 24) | (s << 16) | (m << 8) | (m ^ s);
+    t[3][x] = ((m ^ s) << 24) | (s << 16) | (s << 8) | m;
+  }
+};
+
+static const s3g_tables_t& s3g_tables()
+{
+  static const s3g_tables_t tables;
+  return tables;
+}
+
 /*********************************************************************
     Name: s3g_mul_x
 
@@ -291,9 +336,10 @@ uint32_t s3g_s2(uint32_t w)
 *********************************************************************/
 void s3g_clock_lfsr(S3G_STATE* state, uint32_t f)
 {
-  uint32_t v = (((state->lfsr[0] << 8) & 0xffffff00) ^ (s3g_mul_alpha((uint8_t)((state->lfsr[0] >> 24) & 0xff))) ^
-                (state->lfsr[2]) ^ ((state->lfsr[11] >> 8) & 0x00ffffff) ^
-                (s3g_div_alpha((uint8_t)((state->lfsr[11]) & 0xff))) ^ (f));
+  const s3g_tables_t& t = s3g_tables();
+  uint32_t            v = (((state->lfsr[0] << 8) & 0xffffff00) ^ (t.mul_alpha[(state->lfsr[0] >> 24) & 0xff]) ^
+                (state->lfsr[2]) ^ ((state->lfsr[11] >> 8) & 0x00ffffff) ^ (t.div_alpha[state->lfsr[11] & 0xff]) ^
+                (f));
   uint8_t  i;
 
   for (i = 0; i < 15; i++) {
@@ -316,8 +362,12 @@ uint32_t s3g_clock_fsm(S3G_STATE* state)
   uint32_t f = ((state->lfsr[15] + state->fsm[0]) & 0xffffffff) ^ state->fsm[1];
   uint32_t r = (state->fsm[1] + (state->fsm[2] ^ state->lfsr[5])) & 0xffffffff;
 
-  state->fsm[2] = s3g_s2(state->fsm[1]);
-  state->fsm[1] = s3g_s1(state->fsm[0]);
+  const s3g_tables_t& t  = s3g_tables();
+  uint32_t            w1 = state->fsm[0];
+  uint32_t            w2 = state->fsm[1];
+
+  state->fsm[2] = t.s2[0][w2 >> 24] ^ t.s2[1][(w2 >> 16) & 0xff] ^ t.s2[2][(w2 >> 8) & 0xff] ^ t.s2[3][w2 & 0xff];
+  state->fsm[1] = t.s1[0][w1 >> 24] ^ t.s1[1][(w1 >> 16) & 0xff] ^ t.s1[2][(w1 >> 8) & 0xff] ^ t.s1[3][w1 & 0xff];
   state->fsm[0] = r;
 
   return f;
@@ -337,9 +387,6 @@ void s3g_initialize(S3G_STATE* state, uint32_t k[4], uint32_t iv[4])
   uint8_t  i = 0;
   uint32_t f = 0x0;
 
-  state->lfsr = (uint32_t*)calloc(16, sizeof(uint32_t));
-  state->fsm  = (uint32_t*)calloc(3, sizeof(uint32_t));
-
   state->lfsr[15] = k[3] ^ iv[0];
   state->lfsr[14] = k[2];
   state->lfsr[13] = k[1];
@@ -377,8 +424,7 @@ void s3g_initialize(S3G_STATE* state, uint32_t k[4], uint32_t iv[4])
 *********************************************************************/
 void s3g_deinitialize(S3G_STATE* state)
 {
-  free(state->lfsr);
-  free(state->fsm);
+  memset(state, 0, sizeof(S3G_STATE));
 }
 
 /*********************************************************************
@@ -408,6 +454,148 @@ void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks)
   }
 }
 
+/*********************************************************************
+    Name: s3g_generate_keystream_multi
+
+    Description: Multi-buffer generation of Keystream. With AVX2 each
+                 32-bit lane of the vectors holds one instance, the
+                 table lookups are done with gathers and the LFSR is a
+                 ring buffer to avoid shifting the 16 registers.
+
+    Document Reference: Specification of the 3GPP Confidentiality and
+                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
+                            Section 4.1 and Section 4.2
+*********************************************************************/
+#ifdef __AVX2__
+
+struct s3g_multi_state_t {
+  __m256i lfsr[16];
+  __m256i fsm[3];
+  int     head;
+};
+
+static inline __m256i s3g_multi_lookup(const uint32_t* table, __m256i w, int shift)
+{
+  __m256i idx = _mm256_and_si256(_mm256_srli_epi32(w, shift), _mm256_set1_epi32(0xff));
+  return _mm256_i32gather_epi32((const int*)table, idx, 4);
+}
+
+static inline __m256i s3g_multi_sbox(const uint32_t t[4][256], __m256i w)
+{
+  return _mm256_xor_si256(_mm256_xor_si256(s3g_multi_lookup(t[0], w, 24), s3g_multi_lookup(t[1], w, 16)),
+                          _mm256_xor_si256(s3g_multi_lookup(t[2], w, 8), s3g_multi_lookup(t[3], w, 0)));
+}
+
+static inline __m256i& s3g_multi_s(s3g_multi_state_t& st, int i)
+{
+  return st.lfsr[(st.head + i) & 15];
+}
+
+static inline __m256i s3g_multi_clock_fsm(s3g_multi_state_t& st, const s3g_tables_t& t)
+{
+  __m256i f = _mm256_xor_si256(_mm256_add_epi32(s3g_multi_s(st, 15), st.fsm[0]), st.fsm[1]);
+  __m256i r = _mm256_add_epi32(st.fsm[1], _mm256_xor_si256(st.fsm[2], s3g_multi_s(st, 5)));
+
+  st.fsm[2] = s3g_multi_sbox(t.s2, st.fsm[1]);
+  st.fsm[1] = s3g_multi_sbox(t.s1, st.fsm[0]);
+  st.fsm[0] = r;
+  return f;
+}
+
+static inline void s3g_multi_clock_lfsr(s3g_multi_state_t& st, const s3g_tables_t& t, __m256i f)
+{
+  __m256i s0  = s3g_multi_s(st, 0);
+  __m256i s11 = s3g_multi_s(st, 11);
+  __m256i v   = _mm256_xor_si256(_mm256_slli_epi32(s0, 8), s3g_multi_lookup(t.mul_alpha, s0, 24));
+  v           = _mm256_xor_si256(v, s3g_multi_s(st, 2));
+  v           = _mm256_xor_si256(v, _mm256_srli_epi32(s11, 8));
+  v           = _mm256_xor_si256(v, s3g_multi_lookup(t.div_alpha, s11, 0));
+  v           = _mm256_xor_si256(v, f);
+
+  // s0 leaves the register and v enters as s15, which takes the slot of s0
+  s3g_multi_s(st, 0) = v;
+  st.head            = (st.head + 1) & 15;
+}
+
+void s3g_generate_keystream_multi(const uint32_t k[S3G_NOF_LANES][4],
+                                  const uint32_t iv[S3G_NOF_LANES][4],
+                                  const uint32_t n[S3G_NOF_LANES],
+                                  uint32_t*      ks[S3G_NOF_LANES])
+{
+  const s3g_tables_t& t = s3g_tables();
+  s3g_multi_state_t   st;
+  uint32_t            lane_words[16][S3G_NOF_LANES];
+  uint32_t            max_n = 0;
+
+  // Load each lane as in s3g_initialize and transpose
+  for (uint32_t l = 0; l < S3G_NOF_LANES; l++) {
+    S3G_STATE init = {};
+    init.lfsr[15]  = k[l][3] ^ iv[l][0];
+    init.lfsr[14]  = k[l][2];
+    init.lfsr[13]  = k[l][1];
+    init.lfsr[12]  = k[l][0] ^ iv[l][1];
+    init.lfsr[11]  = k[l][3] ^ 0xffffffff;
+    init.lfsr[10]  = k[l][2] ^ 0xffffffff ^ iv[l][2];
+    init.lfsr[9]   = k[l][1] ^ 0xffffffff ^ iv[l][3];
+    init.lfsr[8]   = k[l][0] ^ 0xffffffff;
+    init.lfsr[7]   = k[l][3];
+    init.lfsr[6]   = k[l][2];
+    init.lfsr[5]   = k[l][1];
+    init.lfsr[4]   = k[l][0];
+    init.lfsr[3]   = k[l][3] ^ 0xffffffff;
+    init.lfsr[2]   = k[l][2] ^ 0xffffffff;
+    init.lfsr[1]   = k[l][1] ^ 0xffffffff;
+    init.lfsr[0]   = k[l][0] ^ 0xffffffff;
+    for (uint32_t i = 0; i < 16; i++) {
+      lane_words[i][l] = init.lfsr[i];
+    }
+    max_n = n[l] > max_n ? n[l] : max_n;
+  }
+  for (uint32_t i = 0; i < 16; i++) {
+    st.lfsr[i] = _mm256_loadu_si256((const __m256i*)lane_words[i]);
+  }
+  st.fsm[0] = st.fsm[1] = st.fsm[2] = _mm256_setzero_si256();
+  st.head                           = 0;
+
+  for (uint32_t i = 0; i < 32; i++) {
+    s3g_multi_clock_lfsr(st, t, s3g_multi_clock_fsm(st, t));
+  }
+
+  // Clock FSM once. Discard the output.
+  s3g_multi_clock_fsm(st, t);
+  s3g_multi_clock_lfsr(st, t, _mm256_setzero_si256());
+
+  for (uint32_t i = 0; i < max_n; i++) {
+    uint32_t z[S3G_NOF_LANES];
+    __m256i  f = s3g_multi_clock_fsm(st, t);
+    _mm256_storeu_si256((__m256i*)z, _mm256_xor_si256(f, s3g_multi_s(st, 0)));
+    s3g_multi_clock_lfsr(st, t, _mm256_setzero_si256());
+    for (uint32_t l = 0; l < S3G_NOF_LANES; l++) {
+      if (i < n[l]) {
+        ks[l][i] = z[l];
+      }
+    }
+  }
+}
+
+#else // __AVX2__
+
+void s3g_generate_keystream_multi(const uint32_t k[S3G_NOF_LANES][4],
+                                  const uint32_t iv[S3G_NOF_LANES][4],
+                                  const uint32_t n[S3G_NOF_LANES],
+                                  uint32_t*      ks[S3G_NOF_LANES])
+{
+  for (uint32_t l = 0; l < S3G_NOF_LANES; l++) {
+    if (n[l] > 0) {
+      S3G_STATE state;
+      s3g_initialize(&state, (uint32_t*)k[l], (uint32_t*)iv[l]);
+      s3g_generate_keystream(&state, n[l], ks[l]);
+    }
+  }
+}
+
+#endif // __AVX2__
+
 /* MUL64x.
  * Input V: a 64-bit input.
  * Input c: a 64-bit input.
@@ -451,14 +639,25 @@ uint64_t s3g_MUL64xPOW(uint64_t V, uint8_t i, uint64_t c)
  */
 uint64_t s3g_MUL64(uint64_t V, uint64_t P, uint64_t c)
 {
+#ifdef __PCLMUL__
+  // Carry-less product, then fold the upper 64 bits twice using x^64 = c
+  __m128i  prod = _mm_clmulepi64_si128(_mm_cvtsi64_si128(V), _mm_cvtsi64_si128(P), 0x00);
+  __m128i  cv   = _mm_cvtsi64_si128(c);
+  __m128i  fold = _mm_clmulepi64_si128(_mm_unpackhi_epi64(prod, prod), cv, 0x00);
+  __m128i  last = _mm_clmulepi64_si128(_mm_unpackhi_epi64(fold, fold), cv, 0x00);
+  uint64_t lo   = _mm_cvtsi128_si64(prod);
+  return lo ^ (uint64_t)_mm_cvtsi128_si64(fold) ^ (uint64_t)_mm_cvtsi128_si64(last);
+#else  // __PCLMUL__
   uint64_t result = 0;
   int      i      = 0;
 
   for (i = 0; i < 64; i++) {
     if ((P >> i) & 0x1)
-      result ^= s3g_MUL64xPOW(V, i, c);
+      result ^= V;
+    V = s3g_MUL64x(V, c);
   }
   return result;
+#endif // __PCLMUL__
 }
 
 /* mask8bit.
@@ -481,24 +680,47 @@ uint8_t mask8bit(int n)
  * Output  : 32 bit block used as MAC
  * Generates 32-bit MAC using UIA2 algorithm as defined in Section 4.
  */
+void s3g_load_key(const uint8_t* key, uint32_t k[4])
+{
+  for (uint32_t i = 0; i < 4; i++) {
+    k[3 - i] = (key[4 * i] << 24) ^ (key[4 * i + 1] << 16) ^ (key[4 * i + 2] << 8) ^ (key[4 * i + 3]);
+  }
+}
+
 uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir, uint8_t* data, uint64_t length)
 {
-  uint32_t       K[4], IV[4], z[5];
-  uint32_t       i        = 0, D;
+  uint32_t       K[4];
   static uint8_t MAC_I[4] = {0, 0, 0, 0}; /* static memory for the result */
-  uint64_t       EVAL;
-  uint64_t       V;
-  uint64_t       P;
-  uint64_t       Q;
-  uint64_t       c;
-  S3G_STATE      state, *state_ptr;
+
+  /* Load the Integrity Key for SNOW3G initialization as in section 4.4. */
+  s3g_load_key(key, K);
+  s3g_f9_mac(K, count, fresh, dir, data, length, MAC_I);
+
+  return MAC_I;
+}
+
+void s3g_f9_mac(const uint32_t k[4],
+                uint32_t       count,
+                uint32_t       fresh,
+                uint32_t       dir,
+                const uint8_t* data,
+                uint64_t       length,
+                uint8_t*       mac)
+{
+  uint32_t  K[4], IV[4], z[5];
+  uint32_t  i = 0, D;
+  uint64_t  EVAL;
+  uint64_t  V;
+  uint64_t  P;
+  uint64_t  Q;
+  uint64_t  c;
+  S3G_STATE state, *state_ptr;
 
   uint64_t M_D_2;
   int      rem_bits = 0;
   state_ptr         = &state;
-  /* Load the Integrity Key for SNOW3G initialization as in section 4.4. */
   for (i = 0; i < 4; i++)
-    K[3 - i] = (key[4 * i] << 24) ^ (key[4 * i + 1] << 16) ^ (key[4 * i + 2] << 8) ^ (key[4 * i + 3]);
+    K[i] = k[i];
 
   /* Prepare the Initialization Vector (IV) for SNOW3G initialization as
      in section 4.4. */
@@ -562,7 +784,5 @@ uint8_t* s3g_f9(const uint8_t* key, uint32_t count, uint32_t fresh, uint32_t dir
     /*
     MAC_I[i] = (mac32 >> (8*(3-i))) & 0xff;
     */
-    MAC_I[i] = ((EVAL >> (56 - (i * 8))) ^ (z[4] >> (24 - (i * 8)))) & 0xff;
-
-  return MAC_I;
+    mac[i] = ((EVAL >> (56 - (i * 8))) ^ (z[4] >> (24 - (i * 8)))) & 0xff;
 }
\ No newline at end of file
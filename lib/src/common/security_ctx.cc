@@ -0,0 +1,683 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/s3g.h"
+#include "srsran/common/security.h"
+#include "srsran/common/ssl.h"
+#include "srsran/common/zuc.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __AES__
+#include <immintrin.h>
+#define SECURITY_HAVE_AESNI
+#if defined(__VAES__) && defined(__AVX2__)
+#define SECURITY_HAVE_VAES
+#endif
+#endif // __AES__
+
+namespace srsran {
+
+namespace {
+
+/// Number of AES blocks encrypted in parallel by the CTR mode
+const uint32_t CTR_PARALLEL_BLOCKS = 8;
+
+void cmac_subkeys(const uint8_t L[16], uint8_t K1[16], uint8_t K2[16])
+{
+  for (uint32_t i = 0; i < 15; i++) {
+    K1[i] = (L[i] << 1) | ((L[i + 1] >> 7) & 0x01);
+  }
+  K1[15] = L[15] << 1;
+  if (L[0] & 0x80) {
+    K1[15] ^= 0x87;
+  }
+  for (uint32_t i = 0; i < 15; i++) {
+    K2[i] = (K1[i] << 1) | ((K1[i + 1] >> 7) & 0x01);
+  }
+  K2[15] = K1[15] << 1;
+  if (K1[0] & 0x80) {
+    K2[15] ^= 0x87;
+  }
+}
+
+/// Builds the first or last CMAC block of the EIA2 input COUNT|BEARER|DIRECTION|0^26|MSG, padding it if incomplete
+void cmac_edge_block(const uint8_t hdr[8], const uint8_t* msg, uint32_t msg_len, uint32_t blk_idx, uint8_t blk[16])
+{
+  uint32_t total = msg_len + 8;
+  uint32_t start = blk_idx * 16;
+  uint32_t end   = std::min(start + 16, total);
+
+  memset(blk, 0, 16);
+  for (uint32_t pos = start; pos < end; pos++) {
+    blk[pos - start] = pos < 8 ? hdr[pos] : msg[pos - 8];
+  }
+  if (end - start < 16) {
+    blk[end - start] = 0x80;
+  }
+}
+
+void cmac_header(uint32_t count, uint8_t bearer, uint8_t direction, uint8_t hdr[8])
+{
+  hdr[0] = (count >> 24) & 0xFF;
+  hdr[1] = (count >> 16) & 0xFF;
+  hdr[2] = (count >> 8) & 0xFF;
+  hdr[3] = count & 0xFF;
+  hdr[4] = (bearer << 3) | (direction << 2);
+  hdr[5] = hdr[6] = hdr[7] = 0;
+}
+
+void xor_keystream(const uint32_t* ks, const uint8_t* msg, uint32_t msg_len, uint8_t* out)
+{
+  uint32_t i = 0;
+  for (; i + 4 <= msg_len; i += 4) {
+    uint32_t w = ks[i / 4];
+    out[i + 0] = msg[i + 0] ^ ((w >> 24) & 0xFF);
+    out[i + 1] = msg[i + 1] ^ ((w >> 16) & 0xFF);
+    out[i + 2] = msg[i + 2] ^ ((w >> 8) & 0xFF);
+    out[i + 3] = msg[i + 3] ^ (w & 0xFF);
+  }
+  for (; i < msg_len; i++) {
+    out[i] = msg[i] ^ ((ks[i / 4] >> ((3 - (i % 4)) * 8)) & 0xFF);
+  }
+}
+
+void zuc_eea3_iv(uint32_t count, uint8_t bearer, uint8_t direction, uint8_t iv[16])
+{
+  iv[0] = (count >> 24) & 0xFF;
+  iv[1] = (count >> 16) & 0xFF;
+  iv[2] = (count >> 8) & 0xFF;
+  iv[3] = count & 0xFF;
+  iv[4] = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+  iv[5] = iv[6] = iv[7] = 0;
+  memcpy(&iv[8], &iv[0], 8);
+}
+
+void zuc_eia3_iv(uint32_t count, uint8_t bearer, uint8_t direction, uint8_t iv[16])
+{
+  iv[0]  = (count >> 24) & 0xFF;
+  iv[1]  = (count >> 16) & 0xFF;
+  iv[2]  = (count >> 8) & 0xFF;
+  iv[3]  = count & 0xFF;
+  iv[4]  = (bearer << 3) & 0xF8;
+  iv[5]  = iv[6] = iv[7] = 0;
+  iv[8]  = iv[0] ^ ((direction & 1) << 7);
+  iv[9]  = iv[1];
+  iv[10] = iv[2];
+  iv[11] = iv[3];
+  iv[12] = iv[4];
+  iv[13] = iv[5];
+  iv[14] = iv[6] ^ ((direction & 1) << 7);
+  iv[15] = iv[7];
+}
+
+#ifdef SECURITY_HAVE_AESNI
+
+inline __m128i aes128_expand_step(__m128i key, __m128i keygened)
+{
+  keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3, 3, 3, 3));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key      = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, keygened);
+}
+
+#define AES128_EXPAND(rk, i, rcon) rk[i] = aes128_expand_step(rk[i - 1], _mm_aeskeygenassist_si128(rk[i - 1], rcon))
+
+void aes128_expand_key(const uint8_t* key, __m128i rk[11])
+{
+  rk[0] = _mm_loadu_si128((const __m128i*)key);
+  AES128_EXPAND(rk, 1, 0x01);
+  AES128_EXPAND(rk, 2, 0x02);
+  AES128_EXPAND(rk, 3, 0x04);
+  AES128_EXPAND(rk, 4, 0x08);
+  AES128_EXPAND(rk, 5, 0x10);
+  AES128_EXPAND(rk, 6, 0x20);
+  AES128_EXPAND(rk, 7, 0x40);
+  AES128_EXPAND(rk, 8, 0x80);
+  AES128_EXPAND(rk, 9, 0x1b);
+  AES128_EXPAND(rk, 10, 0x36);
+}
+
+#undef AES128_EXPAND
+
+inline __m128i aes128_encrypt(const __m128i rk[11], __m128i blk)
+{
+  blk = _mm_xor_si128(blk, rk[0]);
+  for (uint32_t r = 1; r < 10; r++) {
+    blk = _mm_aesenc_si128(blk, rk[r]);
+  }
+  return _mm_aesenclast_si128(blk, rk[10]);
+}
+
+/// Encrypts CTR_PARALLEL_BLOCKS independent blocks, keeping all of them in flight in the AES pipeline
+void aes128_encrypt_parallel(const __m128i rk[11], const __m128i* in, __m128i* out)
+{
+#ifdef SECURITY_HAVE_VAES
+  __m256i b[CTR_PARALLEL_BLOCKS / 2];
+  __m256i k = _mm256_broadcastsi128_si256(rk[0]);
+  for (uint32_t i = 0; i < CTR_PARALLEL_BLOCKS / 2; i++) {
+    b[i] = _mm256_xor_si256(_mm256_set_m128i(in[2 * i + 1], in[2 * i]), k);
+  }
+  for (uint32_t r = 1; r < 10; r++) {
+    k = _mm256_broadcastsi128_si256(rk[r]);
+    for (uint32_t i = 0; i < CTR_PARALLEL_BLOCKS / 2; i++) {
+      b[i] = _mm256_aesenc_epi128(b[i], k);
+    }
+  }
+  k = _mm256_broadcastsi128_si256(rk[10]);
+  for (uint32_t i = 0; i < CTR_PARALLEL_BLOCKS / 2; i++) {
+    b[i]           = _mm256_aesenclast_epi128(b[i], k);
+    out[2 * i]     = _mm256_castsi256_si128(b[i]);
+    out[2 * i + 1] = _mm256_extracti128_si256(b[i], 1);
+  }
+#else  // SECURITY_HAVE_VAES
+  __m128i b[CTR_PARALLEL_BLOCKS];
+  for (uint32_t i = 0; i < CTR_PARALLEL_BLOCKS; i++) {
+    b[i] = _mm_xor_si128(in[i], rk[0]);
+  }
+  for (uint32_t r = 1; r < 10; r++) {
+    for (uint32_t i = 0; i < CTR_PARALLEL_BLOCKS; i++) {
+      b[i] = _mm_aesenc_si128(b[i], rk[r]);
+    }
+  }
+  for (uint32_t i = 0; i < CTR_PARALLEL_BLOCKS; i++) {
+    out[i] = _mm_aesenclast_si128(b[i], rk[10]);
+  }
+#endif // SECURITY_HAVE_VAES
+}
+
+#endif // SECURITY_HAVE_AESNI
+
+} // namespace
+
+/******************************************************************************
+ * Ciphering context
+ *****************************************************************************/
+
+struct cipher_ctx::impl {
+#ifdef SECURITY_HAVE_AESNI
+  __m128i rk[11];
+#else
+  aes_context aes;
+#endif
+  uint32_t              s3g_key[4];
+  uint8_t               key[16];
+  std::vector<uint32_t> ks;
+
+  void eea1(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* out);
+  void eea3(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* out);
+  void eea1_batch(uint8_t bearer, uint8_t direction, span<const pdu_t> pdus);
+  void eea3_batch(uint8_t bearer, uint8_t direction, span<const pdu_t> pdus);
+  void eea2_batch(uint8_t bearer, uint8_t direction, span<const pdu_t> pdus);
+};
+
+void cipher_ctx::impl::eea1(uint32_t       count,
+                            uint8_t        bearer,
+                            uint8_t        direction,
+                            const uint8_t* msg,
+                            uint32_t       msg_len,
+                            uint8_t*       out)
+{
+  S3G_STATE state;
+  uint32_t  iv[4];
+
+  iv[3] = count;
+  iv[2] = ((bearer & 0x1F) << 27) | ((direction & 0x01) << 26);
+  iv[1] = iv[3];
+  iv[0] = iv[2];
+
+  uint32_t nof_words = (msg_len + 3) / 4;
+  if (ks.size() < nof_words) {
+    ks.resize(nof_words);
+  }
+  s3g_initialize(&state, s3g_key, iv);
+  s3g_generate_keystream(&state, nof_words, ks.data());
+  xor_keystream(ks.data(), msg, msg_len, out);
+}
+
+void cipher_ctx::impl::eea3(uint32_t       count,
+                            uint8_t        bearer,
+                            uint8_t        direction,
+                            const uint8_t* msg,
+                            uint32_t       msg_len,
+                            uint8_t*       out)
+{
+  zuc_state_t state;
+  uint8_t     iv[16];
+
+  zuc_eea3_iv(count, bearer, direction, iv);
+
+  uint32_t nof_words = (msg_len + 3) / 4;
+  if (ks.size() < nof_words) {
+    ks.resize(nof_words);
+  }
+  zuc_initialize(&state, key, iv);
+  zuc_generate_keystream(&state, nof_words, ks.data());
+  xor_keystream(ks.data(), msg, msg_len, out);
+}
+
+/// Runs up to S3G_NOF_LANES PDUs through the multi-lane keystream generator at a time
+void cipher_ctx::impl::eea1_batch(uint8_t bearer, uint8_t direction, span<const pdu_t> pdus)
+{
+  for (size_t first = 0; first < pdus.size(); first += S3G_NOF_LANES) {
+    uint32_t  iv[S3G_NOF_LANES][4]   = {};
+    uint32_t  k[S3G_NOF_LANES][4]    = {};
+    uint32_t  n[S3G_NOF_LANES]       = {};
+    uint32_t* lane_ks[S3G_NOF_LANES] = {};
+    size_t    nof_lanes              = std::min((size_t)S3G_NOF_LANES, pdus.size() - first);
+
+    uint32_t total_words = 0;
+    for (size_t l = 0; l < nof_lanes; l++) {
+      n[l] = (pdus[first + l].msg_len + 3) / 4;
+      total_words += n[l];
+    }
+    if (ks.size() < total_words) {
+      ks.resize(total_words);
+    }
+
+    uint32_t offset = 0;
+    for (size_t l = 0; l < S3G_NOF_LANES; l++) {
+      memcpy(k[l], s3g_key, sizeof(s3g_key));
+      lane_ks[l] = ks.data() + offset;
+      if (l < nof_lanes) {
+        iv[l][3] = pdus[first + l].count;
+        iv[l][2] = ((bearer & 0x1F) << 27) | ((direction & 0x01) << 26);
+        iv[l][1] = iv[l][3];
+        iv[l][0] = iv[l][2];
+        offset += n[l];
+      }
+    }
+
+    s3g_generate_keystream_multi(k, iv, n, lane_ks);
+    for (size_t l = 0; l < nof_lanes; l++) {
+      const pdu_t& pdu = pdus[first + l];
+      xor_keystream(lane_ks[l], pdu.msg, pdu.msg_len, pdu.msg_out);
+    }
+  }
+}
+
+/// Runs up to ZUC_NOF_LANES PDUs through the multi-lane keystream generator at a time
+void cipher_ctx::impl::eea3_batch(uint8_t bearer, uint8_t direction, span<const pdu_t> pdus)
+{
+  for (size_t first = 0; first < pdus.size(); first += ZUC_NOF_LANES) {
+    uint8_t        iv[ZUC_NOF_LANES][16]  = {};
+    const uint8_t* k[ZUC_NOF_LANES]       = {};
+    uint32_t       n[ZUC_NOF_LANES]       = {};
+    uint32_t*      lane_ks[ZUC_NOF_LANES] = {};
+    size_t         nof_lanes              = std::min((size_t)ZUC_NOF_LANES, pdus.size() - first);
+
+    uint32_t total_words = 0;
+    for (size_t l = 0; l < nof_lanes; l++) {
+      n[l] = (pdus[first + l].msg_len + 3) / 4;
+      total_words += n[l];
+    }
+    if (ks.size() < total_words) {
+      ks.resize(total_words);
+    }
+
+    uint32_t offset = 0;
+    for (size_t l = 0; l < ZUC_NOF_LANES; l++) {
+      k[l]       = key;
+      lane_ks[l] = ks.data() + offset;
+      if (l < nof_lanes) {
+        zuc_eea3_iv(pdus[first + l].count, bearer, direction, iv[l]);
+        offset += n[l];
+      }
+    }
+
+    zuc_generate_keystream_multi(k, iv, n, lane_ks);
+    for (size_t l = 0; l < nof_lanes; l++) {
+      const pdu_t& pdu = pdus[first + l];
+      xor_keystream(lane_ks[l], pdu.msg, pdu.msg_len, pdu.msg_out);
+    }
+  }
+}
+
+#ifdef SECURITY_HAVE_AESNI
+
+void cipher_ctx::impl::eea2_batch(uint8_t bearer, uint8_t direction, span<const pdu_t> pdus)
+{
+  struct block_t {
+    const uint8_t* in;
+    uint8_t*       out;
+    uint32_t       len;
+  };
+  __m128i  ctr[CTR_PARALLEL_BLOCKS] = {};
+  __m128i  ks_blk[CTR_PARALLEL_BLOCKS];
+  block_t  blk[CTR_PARALLEL_BLOCKS];
+  uint32_t nof_blk = 0;
+
+  auto flush = [&]() {
+    aes128_encrypt_parallel(rk, ctr, ks_blk);
+    for (uint32_t i = 0; i < nof_blk; i++) {
+      if (blk[i].len == 16) {
+        _mm_storeu_si128((__m128i*)blk[i].out,
+                         _mm_xor_si128(_mm_loadu_si128((const __m128i*)blk[i].in), ks_blk[i]));
+      } else {
+        uint8_t tmp[16];
+        _mm_storeu_si128((__m128i*)tmp, ks_blk[i]);
+        for (uint32_t j = 0; j < blk[i].len; j++) {
+          blk[i].out[j] = blk[i].in[j] ^ tmp[j];
+        }
+      }
+    }
+    nof_blk = 0;
+  };
+
+  // The counter block is COUNT|BEARER|DIRECTION|0^26 followed by a 64 bit big-endian block counter
+  uint64_t bearer_dir = (uint64_t)(((bearer & 0x1F) << 3) | ((direction & 0x01) << 2)) << 32;
+  for (const pdu_t& pdu : pdus) {
+    uint64_t nonce = (uint64_t)__builtin_bswap32(pdu.count) | bearer_dir;
+    for (uint32_t offset = 0, j = 0; offset < pdu.msg_len; offset += 16, j++) {
+      ctr[nof_blk] = _mm_set_epi64x((long long)__builtin_bswap64(j), (long long)nonce);
+      blk[nof_blk] = {pdu.msg + offset, pdu.msg_out + offset, std::min(16u, pdu.msg_len - offset)};
+      if (++nof_blk == CTR_PARALLEL_BLOCKS) {
+        flush();
+      }
+    }
+  }
+  if (nof_blk > 0) {
+    flush();
+  }
+}
+
+#else // SECURITY_HAVE_AESNI
+
+void cipher_ctx::impl::eea2_batch(uint8_t bearer, uint8_t direction, span<const pdu_t> pdus)
+{
+  for (const pdu_t& pdu : pdus) {
+    uint8_t stream_blk[16] = {};
+    uint8_t nonce_cnt[16]  = {};
+    size_t  nc_off         = 0;
+
+    nonce_cnt[0] = (pdu.count >> 24) & 0xFF;
+    nonce_cnt[1] = (pdu.count >> 16) & 0xFF;
+    nonce_cnt[2] = (pdu.count >> 8) & 0xFF;
+    nonce_cnt[3] = pdu.count & 0xFF;
+    nonce_cnt[4] = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+    aes_crypt_ctr(&aes, pdu.msg_len, &nc_off, nonce_cnt, stream_blk, pdu.msg, pdu.msg_out);
+  }
+}
+
+#endif // SECURITY_HAVE_AESNI
+
+cipher_ctx::cipher_ctx() : pimpl(new impl) {}
+cipher_ctx::~cipher_ctx()                                = default;
+cipher_ctx::cipher_ctx(cipher_ctx&&) noexcept            = default;
+cipher_ctx& cipher_ctx::operator=(cipher_ctx&&) noexcept = default;
+
+void cipher_ctx::set_key(CIPHERING_ALGORITHM_ID_ENUM algo_, const uint8_t* key)
+{
+  algo = algo_;
+  memcpy(pimpl->key, key, sizeof(pimpl->key));
+  switch (algo) {
+    case CIPHERING_ALGORITHM_ID_128_EEA1:
+      s3g_load_key(key, pimpl->s3g_key);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA2:
+#ifdef SECURITY_HAVE_AESNI
+      aes128_expand_key(key, pimpl->rk);
+#else
+      aes_setkey_enc(&pimpl->aes, key, 128);
+#endif
+      break;
+    default:
+      break;
+  }
+}
+
+void cipher_ctx::cipher(uint32_t       count,
+                        uint8_t        bearer,
+                        uint8_t        direction,
+                        const uint8_t* msg,
+                        uint32_t       msg_len,
+                        uint8_t*       msg_out)
+{
+  switch (algo) {
+    case CIPHERING_ALGORITHM_ID_128_EEA1:
+      pimpl->eea1(count, bearer, direction, msg, msg_len, msg_out);
+      break;
+    case CIPHERING_ALGORITHM_ID_128_EEA2: {
+      pdu_t pdu = {count, msg, msg_len, msg_out};
+      pimpl->eea2_batch(bearer, direction, span<const pdu_t>(&pdu, 1));
+    } break;
+    case CIPHERING_ALGORITHM_ID_128_EEA3:
+      pimpl->eea3(count, bearer, direction, msg, msg_len, msg_out);
+      break;
+    default:
+      if (msg != msg_out) {
+        memmove(msg_out, msg, msg_len);
+      }
+      break;
+  }
+}
+
+void cipher_ctx::cipher_batch(uint8_t bearer, uint8_t direction, span<const pdu_t> pdus)
+{
+  switch (algo) {
+    case CIPHERING_ALGORITHM_ID_128_EEA1:
+      pimpl->eea1_batch(bearer, direction, pdus);
+      return;
+    case CIPHERING_ALGORITHM_ID_128_EEA2:
+      pimpl->eea2_batch(bearer, direction, pdus);
+      return;
+    case CIPHERING_ALGORITHM_ID_128_EEA3:
+      pimpl->eea3_batch(bearer, direction, pdus);
+      return;
+    default:
+      break;
+  }
+  for (const pdu_t& pdu : pdus) {
+    cipher(pdu.count, bearer, direction, pdu.msg, pdu.msg_len, pdu.msg_out);
+  }
+}
+
+/******************************************************************************
+ * Integrity context
+ *****************************************************************************/
+
+struct integrity_ctx::impl {
+#ifdef SECURITY_HAVE_AESNI
+  __m128i rk[11];
+  __m128i k1;
+  __m128i k2;
+#else
+  aes_context aes;
+  uint8_t     k1[16];
+  uint8_t     k2[16];
+#endif
+  uint32_t              s3g_key[4];
+  uint8_t               key[16];
+  std::vector<uint32_t> ks;
+
+  void eia2(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* mac);
+  void eia3(uint32_t count, uint8_t bearer, uint8_t direction, const uint8_t* msg, uint32_t msg_len, uint8_t* mac);
+};
+
+#ifdef SECURITY_HAVE_AESNI
+
+void integrity_ctx::impl::eia2(uint32_t       count,
+                               uint8_t        bearer,
+                               uint8_t        direction,
+                               const uint8_t* msg,
+                               uint32_t       msg_len,
+                               uint8_t*       mac)
+{
+  uint8_t  hdr[8];
+  uint8_t  edge[16];
+  uint32_t total = msg_len + 8;
+  uint32_t n     = (total + 15) / 16;
+  __m128i  t     = _mm_setzero_si128();
+
+  cmac_header(count, bearer, direction, hdr);
+  for (uint32_t i = 0; i < n; i++) {
+    __m128i m;
+    if (i == 0 || i == n - 1) {
+      cmac_edge_block(hdr, msg, msg_len, i, edge);
+      m = _mm_loadu_si128((const __m128i*)edge);
+    } else {
+      m = _mm_loadu_si128((const __m128i*)(msg + 16 * i - 8));
+    }
+    if (i == n - 1) {
+      m = _mm_xor_si128(m, (total % 16 == 0) ? k1 : k2);
+    }
+    t = aes128_encrypt(rk, _mm_xor_si128(t, m));
+  }
+  _mm_storeu_si128((__m128i*)edge, t);
+  memcpy(mac, edge, 4);
+}
+
+#else // SECURITY_HAVE_AESNI
+
+void integrity_ctx::impl::eia2(uint32_t       count,
+                               uint8_t        bearer,
+                               uint8_t        direction,
+                               const uint8_t* msg,
+                               uint32_t       msg_len,
+                               uint8_t*       mac)
+{
+  uint8_t  hdr[8];
+  uint8_t  blk[16];
+  uint8_t  t[16] = {};
+  uint32_t total = msg_len + 8;
+  uint32_t n     = (total + 15) / 16;
+
+  cmac_header(count, bearer, direction, hdr);
+  for (uint32_t i = 0; i < n; i++) {
+    if (i == 0 || i == n - 1) {
+      cmac_edge_block(hdr, msg, msg_len, i, blk);
+    } else {
+      memcpy(blk, msg + 16 * i - 8, 16);
+    }
+    const uint8_t* sub = (total % 16 == 0) ? k1 : k2;
+    for (uint32_t j = 0; j < 16; j++) {
+      blk[j] ^= t[j] ^ (i == n - 1 ? sub[j] : 0);
+    }
+    aes_crypt_ecb(&aes, AES_ENCRYPT, blk, t);
+  }
+  memcpy(mac, t, 4);
+}
+
+#endif // SECURITY_HAVE_AESNI
+
+void integrity_ctx::impl::eia3(uint32_t       count,
+                               uint8_t        bearer,
+                               uint8_t        direction,
+                               const uint8_t* msg,
+                               uint32_t       msg_len,
+                               uint8_t*       mac)
+{
+  zuc_state_t state;
+  uint8_t     iv[16];
+
+  zuc_eia3_iv(count, bearer, direction, iv);
+
+  uint32_t nof_bits  = msg_len * 8;
+  uint32_t nof_words = (nof_bits + 64 + 31) / 32;
+  if (ks.size() < nof_words) {
+    ks.resize(nof_words);
+  }
+  zuc_initialize(&state, key, iv);
+  zuc_generate_keystream(&state, nof_words, ks.data());
+
+  // Returns the 32 bit keystream word starting at bit i
+  auto ks_word = [this](uint32_t i) {
+    uint32_t ti = i % 32;
+    return ti == 0 ? ks[i / 32] : (ks[i / 32] << ti) | (ks[i / 32 + 1] >> (32 - ti));
+  };
+
+  uint32_t T = 0;
+  for (uint32_t i = 0; i < msg_len; i++) {
+    uint8_t b = msg[i];
+    for (uint32_t j = 0; b != 0; j++, b <<= 1) {
+      if (b & 0x80) {
+        T ^= ks_word(i * 8 + j);
+      }
+    }
+  }
+  T ^= ks_word(nof_bits);
+  T ^= ks[nof_words - 1];
+
+  mac[0] = (T >> 24) & 0xFF;
+  mac[1] = (T >> 16) & 0xFF;
+  mac[2] = (T >> 8) & 0xFF;
+  mac[3] = T & 0xFF;
+}
+
+integrity_ctx::integrity_ctx() : pimpl(new impl) {}
+integrity_ctx::~integrity_ctx()                                   = default;
+integrity_ctx::integrity_ctx(integrity_ctx&&) noexcept            = default;
+integrity_ctx& integrity_ctx::operator=(integrity_ctx&&) noexcept = default;
+
+void integrity_ctx::set_key(INTEGRITY_ALGORITHM_ID_ENUM algo_, const uint8_t* key)
+{
+  algo = algo_;
+  memcpy(pimpl->key, key, sizeof(pimpl->key));
+  switch (algo) {
+    case INTEGRITY_ALGORITHM_ID_128_EIA1:
+      s3g_load_key(key, pimpl->s3g_key);
+      break;
+    case INTEGRITY_ALGORITHM_ID_128_EIA2: {
+      uint8_t L[16] = {};
+#ifdef SECURITY_HAVE_AESNI
+      uint8_t K1[16], K2[16];
+      aes128_expand_key(key, pimpl->rk);
+      _mm_storeu_si128((__m128i*)L, aes128_encrypt(pimpl->rk, _mm_setzero_si128()));
+      cmac_subkeys(L, K1, K2);
+      pimpl->k1 = _mm_loadu_si128((const __m128i*)K1);
+      pimpl->k2 = _mm_loadu_si128((const __m128i*)K2);
+#else
+      uint8_t zero[16] = {};
+      aes_setkey_enc(&pimpl->aes, key, 128);
+      aes_crypt_ecb(&pimpl->aes, AES_ENCRYPT, zero, L);
+      cmac_subkeys(L, pimpl->k1, pimpl->k2);
+#endif
+    } break;
+    default:
+      break;
+  }
+}
+
+void integrity_ctx::generate(uint32_t       count,
+                             uint8_t        bearer,
+                             uint8_t        direction,
+                             const uint8_t* msg,
+                             uint32_t       msg_len,
+                             uint8_t*       mac)
+{
+  switch (algo) {
+    case INTEGRITY_ALGORITHM_ID_128_EIA1:
+      s3g_f9_mac(pimpl->s3g_key, count, bearer << 27, direction, msg, (uint64_t)msg_len * 8, mac);
+      break;
+    case INTEGRITY_ALGORITHM_ID_128_EIA2:
+      pimpl->eia2(count, bearer, direction, msg, msg_len, mac);
+      break;
+    case INTEGRITY_ALGORITHM_ID_128_EIA3:
+      pimpl->eia3(count, bearer, direction, msg, msg_len, mac);
+      break;
+    default:
+      memset(mac, 0, 4);
+      break;
+  }
+}
+
+} // namespace srsran
@@ -31,6 +31,10 @@
 
 #include "srsran/common/zuc.h"
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #define MAKEU32(a, b, c, d) (((u32)(a) << 24) | ((u32)(b) << 16) | ((u32)(c) << 8) | ((u32)(d)))
 #define MulByPow2(x, k) ((((x) << k) | ((x) >> (31 - k))) & 0x7FFFFFFF)
 #define MAKEU31(a, b, c) (((u32)(a) << 23) | ((u32)(b) << 8) | (u32)(c))
@@ -252,3 +256,183 @@ void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keyst
     LFSRWithWorkMode(state);
   }
 }
+
+/* multi-buffer keystream generation, one instance per 32-bit lane */
+#ifdef __AVX2__
+
+struct zuc_multi_state_t {
+  __m256i s[16];
+  __m256i r1;
+  __m256i r2;
+  int     head;
+};
+
+/* S-boxes widened to 32 bits and pre-shifted to their byte position */
+struct zuc_multi_tables_t {
+  u32 t[4][256];
+
+  zuc_multi_tables_t()
+  {
+    for (u32 x = 0; x < 256; x++) {
+      t[0][x] = (u32)S0[x] << 24;
+      t[1][x] = (u32)S1[x] << 16;
+      t[2][x] = (u32)S0[x] << 8;
+      t[3][x] = (u32)S1[x];
+    }
+  }
+};
+
+static const zuc_multi_tables_t& zuc_multi_tables()
+{
+  static const zuc_multi_tables_t tables;
+  return tables;
+}
+
+static inline __m256i& zuc_multi_lfsr(zuc_multi_state_t& st, int i)
+{
+  return st.s[(st.head + i) & 15];
+}
+
+static inline __m256i zuc_multi_rot(__m256i x, int k)
+{
+  return _mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 32 - k));
+}
+
+static inline __m256i zuc_multi_add_m(__m256i a, __m256i b)
+{
+  __m256i c = _mm256_add_epi32(a, b);
+  return _mm256_add_epi32(_mm256_and_si256(c, _mm256_set1_epi32(0x7FFFFFFF)), _mm256_srli_epi32(c, 31));
+}
+
+static inline __m256i zuc_multi_mul_pow2(__m256i x, int k)
+{
+  return _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 31 - k)),
+                          _mm256_set1_epi32(0x7FFFFFFF));
+}
+
+static inline __m256i zuc_multi_sbox(const zuc_multi_tables_t& tables, __m256i w)
+{
+  const __m256i mask = _mm256_set1_epi32(0xff);
+  __m256i       b0   = _mm256_srli_epi32(w, 24);
+  __m256i       b1   = _mm256_and_si256(_mm256_srli_epi32(w, 16), mask);
+  __m256i       b2   = _mm256_and_si256(_mm256_srli_epi32(w, 8), mask);
+  __m256i       b3   = _mm256_and_si256(w, mask);
+  return _mm256_or_si256(_mm256_or_si256(_mm256_i32gather_epi32((const int*)tables.t[0], b0, 4),
+                                         _mm256_i32gather_epi32((const int*)tables.t[1], b1, 4)),
+                         _mm256_or_si256(_mm256_i32gather_epi32((const int*)tables.t[2], b2, 4),
+                                         _mm256_i32gather_epi32((const int*)tables.t[3], b3, 4)));
+}
+
+/* BitReorganization and F. Returns W and X3 */
+static inline __m256i zuc_multi_f(zuc_multi_state_t& st, const zuc_multi_tables_t& tables, __m256i* x3)
+{
+  const __m256i lo16 = _mm256_set1_epi32(0xFFFF);
+  __m256i       x0   = _mm256_or_si256(
+      _mm256_slli_epi32(_mm256_and_si256(zuc_multi_lfsr(st, 15), _mm256_set1_epi32(0x7FFF8000)), 1),
+      _mm256_and_si256(zuc_multi_lfsr(st, 14), lo16));
+  __m256i x1 = _mm256_or_si256(_mm256_slli_epi32(zuc_multi_lfsr(st, 11), 16), _mm256_srli_epi32(zuc_multi_lfsr(st, 9), 15));
+  __m256i x2 = _mm256_or_si256(_mm256_slli_epi32(zuc_multi_lfsr(st, 7), 16), _mm256_srli_epi32(zuc_multi_lfsr(st, 5), 15));
+  *x3 = _mm256_or_si256(_mm256_slli_epi32(zuc_multi_lfsr(st, 2), 16), _mm256_srli_epi32(zuc_multi_lfsr(st, 0), 15));
+
+  __m256i w  = _mm256_add_epi32(_mm256_xor_si256(x0, st.r1), st.r2);
+  __m256i w1 = _mm256_add_epi32(st.r1, x1);
+  __m256i w2 = _mm256_xor_si256(st.r2, x2);
+  __m256i u  = _mm256_or_si256(_mm256_slli_epi32(w1, 16), _mm256_srli_epi32(w2, 16));
+  __m256i v  = _mm256_or_si256(_mm256_slli_epi32(w2, 16), _mm256_srli_epi32(w1, 16));
+
+  u = _mm256_xor_si256(_mm256_xor_si256(u, zuc_multi_rot(u, 2)),
+                       _mm256_xor_si256(_mm256_xor_si256(zuc_multi_rot(u, 10), zuc_multi_rot(u, 18)), zuc_multi_rot(u, 24)));
+  v = _mm256_xor_si256(_mm256_xor_si256(v, zuc_multi_rot(v, 8)),
+                       _mm256_xor_si256(_mm256_xor_si256(zuc_multi_rot(v, 14), zuc_multi_rot(v, 22)), zuc_multi_rot(v, 30)));
+
+  st.r1 = zuc_multi_sbox(tables, u);
+  st.r2 = zuc_multi_sbox(tables, v);
+  return w;
+}
+
+/* LFSR clocking, "u" is only added in initialisation mode */
+static inline void zuc_multi_clock_lfsr(zuc_multi_state_t& st, const __m256i* u)
+{
+  __m256i s0 = zuc_multi_lfsr(st, 0);
+  __m256i f  = zuc_multi_add_m(s0, zuc_multi_mul_pow2(s0, 8));
+  f          = zuc_multi_add_m(f, zuc_multi_mul_pow2(zuc_multi_lfsr(st, 4), 20));
+  f          = zuc_multi_add_m(f, zuc_multi_mul_pow2(zuc_multi_lfsr(st, 10), 21));
+  f          = zuc_multi_add_m(f, zuc_multi_mul_pow2(zuc_multi_lfsr(st, 13), 17));
+  f          = zuc_multi_add_m(f, zuc_multi_mul_pow2(zuc_multi_lfsr(st, 15), 15));
+  if (u != nullptr) {
+    f = zuc_multi_add_m(f, *u);
+  }
+
+  /* s0 leaves the register and f enters as s15, which takes the slot of s0 */
+  zuc_multi_lfsr(st, 0) = f;
+  st.head               = (st.head + 1) & 15;
+}
+
+void zuc_generate_keystream_multi(const u8* const k[ZUC_NOF_LANES],
+                                  const u8        iv[ZUC_NOF_LANES][16],
+                                  const u32       n[ZUC_NOF_LANES],
+                                  u32*            ks[ZUC_NOF_LANES])
+{
+  const zuc_multi_tables_t& tables = zuc_multi_tables();
+  zuc_multi_state_t         st;
+  u32                       lane_words[16][ZUC_NOF_LANES];
+  u32                       max_n = 0;
+  __m256i                   x3;
+
+  /* expand key */
+  for (u32 l = 0; l < ZUC_NOF_LANES; l++) {
+    for (u32 i = 0; i < 16; i++) {
+      lane_words[i][l] = MAKEU31(k[l][i], EK_d[i], iv[l][i]);
+    }
+    max_n = n[l] > max_n ? n[l] : max_n;
+  }
+  for (u32 i = 0; i < 16; i++) {
+    st.s[i] = _mm256_loadu_si256((const __m256i*)lane_words[i]);
+  }
+  st.r1   = _mm256_setzero_si256();
+  st.r2   = _mm256_setzero_si256();
+  st.head = 0;
+
+  for (u32 i = 0; i < 32; i++) {
+    __m256i u = _mm256_srli_epi32(zuc_multi_f(st, tables, &x3), 1);
+    zuc_multi_clock_lfsr(st, &u);
+  }
+
+  /* discard the output of F */
+  zuc_multi_f(st, tables, &x3);
+  zuc_multi_clock_lfsr(st, nullptr);
+
+  for (u32 i = 0; i < max_n; i++) {
+    u32     z[ZUC_NOF_LANES];
+    __m256i w = zuc_multi_f(st, tables, &x3);
+    _mm256_storeu_si256((__m256i*)z, _mm256_xor_si256(w, x3));
+    zuc_multi_clock_lfsr(st, nullptr);
+    for (u32 l = 0; l < ZUC_NOF_LANES; l++) {
+      if (i < n[l]) {
+        ks[l][i] = z[l];
+      }
+    }
+  }
+}
+
+#else /* __AVX2__ */
+
+void zuc_generate_keystream_multi(const u8* const k[ZUC_NOF_LANES],
+                                  const u8        iv[ZUC_NOF_LANES][16],
+                                  const u32       n[ZUC_NOF_LANES],
+                                  u32*            ks[ZUC_NOF_LANES])
+{
+  for (u32 l = 0; l < ZUC_NOF_LANES; l++) {
+    if (n[l] > 0) {
+      zuc_state_t state;
+      u8          lane_iv[16];
+      for (u32 i = 0; i < 16; i++) {
+        lane_iv[i] = iv[l][i];
+      }
+      zuc_initialize(&state, k[l], lane_iv);
+      zuc_generate_keystream(&state, n[l], ks[l]);
+    }
+  }
+}
+
+#endif /* __AVX2__ */
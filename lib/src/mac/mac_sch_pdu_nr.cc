@@ -23,6 +23,9 @@
 
 namespace srsran {
 
+// The logger is taken from the parent PDU, so that no logger lookup is done per subPDU
+mac_sch_subpdu_nr::mac_sch_subpdu_nr(mac_sch_pdu_nr* parent_) : logger(&parent_->logger), parent(parent_) {}
+
 mac_sch_subpdu_nr::nr_lcid_sch_t mac_sch_subpdu_nr::get_type()
 {
   if (lcid >= 32) {
@@ -186,6 +189,26 @@ void mac_sch_subpdu_nr::set_ue_con_res_id_ce(const mac_sch_subpdu_nr::ue_con_res
 uint32_t mac_sch_subpdu_nr::write_subpdu(const uint8_t* start_)
 {
   uint8_t* ptr = const_cast<uint8_t*>(start_);
+  ptr += write_subheader(ptr);
+
+  // copy SDU payload
+  if (sdu) {
+    memcpy(ptr, sdu.ptr(), sdu_length);
+  } else {
+    // clear memory
+    memset(ptr, 0, sdu_length);
+  }
+
+  ptr += sdu_length;
+
+  // return total length of subpdu
+  return ptr - start_;
+}
+
+// Writes the subheader only, e.g. for SDUs already written in place. Returns the length of the subheader
+uint32_t mac_sch_subpdu_nr::write_subheader(uint8_t* start_)
+{
+  uint8_t* ptr = start_;
   *ptr         = (uint8_t)((F_bit ? 1 : 0) << 6) | ((uint8_t)lcid & 0x3f);
   ptr += 1;
 
@@ -205,18 +228,6 @@ uint32_t mac_sch_subpdu_nr::write_subpdu(const uint8_t* start_)
   } else {
     logger->error("Error while packing PDU. Unsupported header length (%d)", header_length);
   }
-
-  // copy SDU payload
-  if (sdu) {
-    memcpy(ptr, sdu.ptr(), sdu_length);
-  } else {
-    // clear memory
-    memset(ptr, 0, sdu_length);
-  }
-
-  ptr += sdu_length;
-
-  // return total length of subpdu
   return ptr - start_;
 }
 
@@ -572,6 +583,61 @@ uint32_t mac_sch_pdu_nr::add_sdu(const uint32_t lcid_, const uint8_t* payload_,
   return add_sudpdu(sch_pdu);
 }
 
+srsran::span<uint8_t> mac_sch_pdu_nr::reserve_sdu(const uint32_t lcid_, const uint32_t max_subpdu_len_)
+{
+  reserved_sdu_len = 0;
+  uint32_t max_len = std::min(max_subpdu_len_, remaining_len);
+  if (max_len <= 2) {
+    return {};
+  }
+
+  // The subheader is sized for the longest SDU that fits
+  uint32_t header_len = size_header_sdu(lcid_, max_len - 2);
+  uint32_t sdu_len    = max_len - header_len;
+  if (header_len == 3 && sdu_len < mac_sch_subpdu_nr::MAC_SUBHEADER_LEN_THRESHOLD) {
+    header_len = 2;
+  }
+
+  reserved_lcid       = lcid_;
+  reserved_header_len = header_len;
+  reserved_sdu_len    = sdu_len;
+  return {buffer->msg + buffer->N_bytes + header_len, sdu_len};
+}
+
+uint32_t mac_sch_pdu_nr::add_reserved_sdu(const uint32_t len_)
+{
+  if (len_ == 0 || len_ > reserved_sdu_len) {
+    logger.error("Invalid length of reserved SDU (%d > %d)", len_, reserved_sdu_len);
+    return SRSRAN_ERROR;
+  }
+
+  // An SDU short enough for the 8-bit L field is moved next to its shorter subheader. As the SDU is short, this is
+  // cheaper than reading it into a separate buffer
+  uint8_t* start      = buffer->msg + buffer->N_bytes;
+  uint32_t header_len = size_header_sdu(reserved_lcid, len_);
+  if (header_len < reserved_header_len) {
+    memmove(start + header_len, start + reserved_header_len, len_);
+  }
+
+  // The subPDU is built in place in the list, to spare a copy per SDU
+  subpdus.emplace_back(this);
+  mac_sch_subpdu_nr& sch_pdu = subpdus.back();
+  sch_pdu.set_sdu(reserved_lcid, start + header_len, len_);
+  uint32_t subpdu_len = sch_pdu.get_total_length();
+  if (subpdu_len > reserved_header_len + reserved_sdu_len) {
+    logger.error("SubPDU exceeds reserved space (%d > %d)", subpdu_len, reserved_header_len + reserved_sdu_len);
+    subpdus.pop_back();
+    return SRSRAN_ERROR;
+  }
+  sch_pdu.write_subheader(start);
+
+  buffer->N_bytes += subpdu_len;
+  remaining_len -= subpdu_len;
+  reserved_sdu_len = 0;
+
+  return SRSRAN_SUCCESS;
+}
+
 uint32_t mac_sch_pdu_nr::add_crnti_ce(const uint16_t crnti)
 {
   mac_sch_subpdu_nr ce(this);
@@ -635,4 +701,24 @@ void mac_sch_pdu_nr::to_string(fmt::memory_buffer& fmtbuffer)
   }
 }
 
+srsran::span<uint8_t> mac_sch_sdu_batch_nr::reserve_pdu()
+{
+  if (remaining_len < min_len) {
+    return {};
+  }
+  return pdu.reserve_sdu(lcid, remaining_len);
+}
+
+void mac_sch_sdu_batch_nr::add_pdu(uint32_t nof_bytes)
+{
+  uint32_t pdu_remaining_len = pdu.get_remaing_len();
+  if (pdu.add_reserved_sdu(nof_bytes) != SRSRAN_SUCCESS) {
+    // Nothing else is added to this PDU
+    remaining_len = 0;
+    return;
+  }
+  remaining_len -= std::min(remaining_len, pdu_remaining_len - pdu.get_remaing_len());
+  nof_sdus++;
+}
+
 } // namespace srsran
@@ -0,0 +1,90 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/mac/pf_metric.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace srsran {
+
+constexpr float    pf_metric::exp_avg_alpha;
+constexpr double   pf_metric::min_avg_rate;
+constexpr uint32_t pf_metric::fast_start_len;
+
+double pf_metric::avg_rate(uint64_t now) const
+{
+  uint64_t nof_samples = now - first_tti;
+  if (nof_samples < fast_start_len) {
+    // fast start
+    return nof_samples == 0 ? 0 : sum_bytes / nof_samples;
+  }
+  double   avg = exp_avg_rate;
+  uint64_t tti = exp_avg_tti;
+  if (not exp_avg_start) {
+    avg = sum_bytes / fast_start_len;
+    tti = first_tti + fast_start_len;
+  }
+  return avg * std::pow(1.0 - exp_avg_alpha, static_cast<double>(now - tti));
+}
+
+void pf_metric::set_expected_rate(float rate_, uint64_t now, float weight_)
+{
+  rate   = rate_;
+  weight = weight_;
+  refresh_key(now);
+}
+
+void pf_metric::save_alloc(uint32_t alloc_bytes, uint64_t now)
+{
+  if (in_fast_start(now)) {
+    sum_bytes += alloc_bytes;
+  } else {
+    // avg_rate(now) already includes the decay of this TTI
+    exp_avg_rate  = avg_rate(now) + exp_avg_alpha * alloc_bytes;
+    exp_avg_tti   = now;
+    exp_avg_start = true;
+  }
+  refresh_key(now);
+}
+
+void pf_metric::refresh_key(uint64_t now)
+{
+  if (rate == 0) {
+    key_ = -std::numeric_limits<double>::infinity();
+    return;
+  }
+  // R at its last update and the TTI of that update, the decay since then is applied in the log domain below
+  double   avg = exp_avg_rate;
+  uint64_t tti = exp_avg_tti;
+  if (in_fast_start(now)) {
+    avg = now == first_tti ? 0 : sum_bytes / (now - first_tti);
+    tti = now;
+  } else if (not exp_avg_start) {
+    avg = sum_bytes / fast_start_len;
+    tti = first_tti + fast_start_len;
+  }
+  // log(w * r / R^c), plus the decay of R since the scheduler start, so that the key stays valid in the next TTIs
+  avg  = std::max(avg, min_avg_rate);
+  key_ = std::log(weight) + std::log(rate) - fairness_coeff * (std::log(avg) - tti * std::log(1.0 - exp_avg_alpha));
+}
+
+} // namespace srsran
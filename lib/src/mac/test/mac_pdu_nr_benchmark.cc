@@ -0,0 +1,219 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Benchmark of the MAC NR PDU assembly from many small RLC UM PDUs. Compares reading each RLC PDU into a separate
+ * buffer and copying it into the TB, as done before, with RLC writing all the PDUs of the LCID in one batch, in place
+ * after their reserved subheaders. Reports the TBs/s, the time per subPDU and the buffer state updates per TB of both.
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/timers.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/mac/mac_sch_pdu_nr.h"
+#include "srsran/rlc/rlc.h"
+#include <chrono>
+#include <getopt.h>
+
+static uint32_t nof_tbs = 20000;
+static uint32_t tb_len  = 9422; // Largest TB of 100 PRBs with one layer (TBS index 26)
+static uint32_t sdu_len = 64;
+
+namespace srsran {
+
+const uint32_t lcid            = 4;
+const uint32_t min_rlc_pdu_len = 5;
+
+class rlc_benchmark_tester : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
+{
+public:
+  // PDCP interface
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_bch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_dlsch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_pcch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_mch(uint32_t lcid, unique_byte_buffer_t sdu) final {}
+  void notify_delivery(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+  void notify_failure(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+
+  // RRC interface
+  void        max_retx_attempted() final {}
+  void        protocol_failure() final {}
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+};
+
+/// RLC UM NR bearer whose Tx queue is refilled with SDUs before each TB
+class rlc_bearer
+{
+public:
+  explicit rlc_bearer(const char* logname) : rlc(logname)
+  {
+    rlc.init(&tester, &tester, &timers, 0, [this](uint32_t, uint32_t, uint32_t) { nof_bsr_updates++; });
+    rlc_config_t cfg    = rlc_config_t::default_rlc_um_nr_config(12);
+    cfg.tx_queue_length = 2 * tb_len / std::min(sdu_len, tb_len) + 2;
+    rlc.add_bearer(lcid, cfg);
+  }
+
+  void fill_tx_queue()
+  {
+    while (rlc.get_buffer_state(lcid) < tb_len) {
+      unique_byte_buffer_t sdu = make_byte_buffer();
+      srsran_assert(sdu != nullptr, "Couldn't allocate SDU");
+      for (uint32_t i = 0; i < sdu_len; ++i) {
+        sdu->msg[i] = (uint8_t)(count + i);
+      }
+      sdu->N_bytes    = sdu_len;
+      sdu->md.pdcp_sn = count++;
+      rlc.write_sdu(lcid, std::move(sdu));
+    }
+    nof_bsr_updates = 0;
+  }
+
+  srsran::rlc rlc;
+  uint64_t    nof_bsr_updates = 0;
+
+private:
+  rlc_benchmark_tester tester;
+  timer_handler        timers{8};
+  uint32_t             count = 0;
+};
+
+/// Assembly with an intermediate buffer and a RLC read per RLC PDU. RLC is asked for the same sizes as in the batch
+uint32_t build_tb_copy(mac_sch_pdu_nr& pdu, byte_buffer_t& tb, byte_buffer_t& rlc_buffer, srsran::rlc& rlc)
+{
+  tb.clear();
+  pdu.init_tx(&tb, tb_len);
+  while (pdu.get_remaing_len() >= min_rlc_pdu_len) {
+    uint32_t remaining_len = pdu.get_remaing_len();
+    remaining_len -= pdu.size_header_sdu(lcid, remaining_len - 2);
+    uint32_t pdu_len = rlc.read_pdu(lcid, rlc_buffer.msg, remaining_len);
+    if (pdu_len == 0 or pdu.add_sdu(lcid, rlc_buffer.msg, pdu_len) != SRSRAN_SUCCESS) {
+      break;
+    }
+  }
+  pdu.pack();
+  return pdu.get_num_subpdus();
+}
+
+/// Assembly with all the RLC PDUs read in one batch and written in place in the TB
+uint32_t build_tb_batch(mac_sch_pdu_nr& pdu, byte_buffer_t& tb, srsran::rlc& rlc)
+{
+  tb.clear();
+  pdu.init_tx(&tb, tb_len);
+  mac_sch_sdu_batch_nr batch(pdu, lcid, pdu.get_remaing_len(), min_rlc_pdu_len);
+  rlc.read_pdus(lcid, batch);
+  pdu.pack();
+  return pdu.get_num_subpdus();
+}
+
+int run_benchmark()
+{
+  using clock = std::chrono::steady_clock;
+
+  mac_sch_pdu_nr pdu;
+  byte_buffer_t  tb, tv, rlc_buffer;
+  rlc_bearer     bearer_copy("RLC-COPY"), bearer_batch("RLC-BATCH");
+
+  // Both bearers get the same SDUs, so both assemblies must write the same TBs. They alternate TB by TB
+  std::chrono::nanoseconds copy_time{0}, batch_time{0};
+  uint64_t                 nof_subpdus = 0, bsr_updates_copy = 0, bsr_updates_batch = 0;
+  for (uint32_t i = 0; i < nof_tbs; ++i) {
+    bearer_copy.fill_tx_queue();
+    auto     start            = clock::now();
+    uint32_t nof_subpdus_copy = build_tb_copy(pdu, tv, rlc_buffer, bearer_copy.rlc);
+    copy_time += clock::now() - start;
+    bsr_updates_copy += bearer_copy.nof_bsr_updates;
+
+    bearer_batch.fill_tx_queue();
+    start = clock::now();
+    nof_subpdus += build_tb_batch(pdu, tb, bearer_batch.rlc);
+    batch_time += clock::now() - start;
+    bsr_updates_batch += bearer_batch.nof_bsr_updates;
+
+    TESTASSERT(tb.N_bytes == tb_len and tv.N_bytes == tb_len);
+    TESTASSERT(pdu.get_num_subpdus() == nof_subpdus_copy);
+    TESTASSERT(memcmp(tb.msg, tv.msg, tb_len) == 0);
+  }
+
+  double copy_ns  = copy_time.count();
+  double batch_ns = batch_time.count();
+  printf("%d TBs of %d B, SDUs of %d B (%.1f subPDUs per TB)\n",
+         nof_tbs,
+         tb_len,
+         sdu_len,
+         (double)nof_subpdus / nof_tbs);
+  printf("Copy:   %10.1f TBs/s, %6.1f ns per subPDU, %6.1f BSR updates per TB\n",
+         nof_tbs * 1e9 / copy_ns,
+         copy_ns / nof_subpdus,
+         (double)bsr_updates_copy / nof_tbs);
+  printf("Batch:  %10.1f TBs/s, %6.1f ns per subPDU, %6.1f BSR updates per TB\n",
+         nof_tbs * 1e9 / batch_ns,
+         batch_ns / nof_subpdus,
+         (double)bsr_updates_batch / nof_tbs);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nbs]\n", prog);
+  printf("\t-n number of TBs [Default %d]\n", nof_tbs);
+  printf("\t-b TB size in bytes [Default %d]\n", tb_len);
+  printf("\t-s SDU size in bytes [Default %d]\n", sdu_len);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nbs")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_tbs = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'b':
+        tb_len = std::min(std::max(16U, (uint32_t)strtol(argv[optind], NULL, 10)), (uint32_t)SRSRAN_MAX_TBSIZE_BITS / 8);
+        break;
+      case 's':
+        sdu_len = std::min(std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10)), (uint32_t)RLC_MAX_SDU_SIZE);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("MAC-NR").set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("RLC-COPY").set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("RLC-BATCH").set_level(srslog::basic_levels::warning);
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsran::run_benchmark() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
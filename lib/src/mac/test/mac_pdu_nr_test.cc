@@ -712,6 +712,60 @@ int mac_ul_sch_pdu_pack_test4()
   return SRSRAN_SUCCESS;
 }
 
+int mac_dl_sch_pdu_pack_in_place_test8()
+{
+  // MAC PDU with SDUs written in place after their reserved subheader, which must match the PDU packed from copies
+  // of the same SDUs. A 512 B SDU takes the 16-bit L field, while the short SDUs are moved next to an 8-bit L field
+  uint8_t sdu[512] = {};
+  for (uint32_t i = 0; i < sizeof(sdu); i++) {
+    sdu[i] = i % 251;
+  }
+  const uint32_t sdu_lens[] = {512, 10, 255, 256, 1};
+  const uint32_t pdu_size   = 1100;
+
+  byte_buffer_t          tx_buffer, tv_buffer;
+  srsran::mac_sch_pdu_nr tx_pdu, tv_pdu;
+  tx_pdu.init_tx(&tx_buffer, pdu_size);
+  tv_pdu.init_tx(&tv_buffer, pdu_size);
+
+  for (uint32_t len : sdu_lens) {
+    TESTASSERT(tv_pdu.add_sdu(4, sdu, len) == SRSRAN_SUCCESS);
+
+    srsran::span<uint8_t> payload = tx_pdu.reserve_sdu(4, tx_pdu.get_remaing_len());
+    TESTASSERT(payload.size() >= len);
+    memcpy(payload.data(), sdu, len);
+    TESTASSERT(tx_pdu.add_reserved_sdu(len) == SRSRAN_SUCCESS);
+    TESTASSERT(tx_pdu.get_remaing_len() == tv_pdu.get_remaing_len());
+  }
+
+  // No SDU fits in the last bytes, neither does a longer SDU than reserved
+  TESTASSERT(tx_pdu.reserve_sdu(4, 2).empty());
+  srsran::span<uint8_t> payload = tx_pdu.reserve_sdu(4, 10);
+  TESTASSERT(payload.size() == 8);
+  TESTASSERT(tx_pdu.add_reserved_sdu(9) == SRSRAN_ERROR);
+
+  tx_pdu.pack();
+  tv_pdu.pack();
+  TESTASSERT(tx_buffer.N_bytes == pdu_size);
+  TESTASSERT(tv_buffer.N_bytes == pdu_size);
+  TESTASSERT(memcmp(tx_buffer.msg, tv_buffer.msg, pdu_size) == 0);
+
+  // The packed PDU is parsed back into the same SDUs
+  srsran::mac_sch_pdu_nr rx_pdu;
+  TESTASSERT(rx_pdu.unpack(tx_buffer.msg, tx_buffer.N_bytes) == SRSRAN_SUCCESS);
+  TESTASSERT(rx_pdu.get_num_subpdus() == sizeof(sdu_lens) / sizeof(sdu_lens[0]) + 1);
+  for (uint32_t i = 0; i < sizeof(sdu_lens) / sizeof(sdu_lens[0]); i++) {
+    TESTASSERT(rx_pdu.get_subpdu(i).get_sdu_length() == sdu_lens[i]);
+    TESTASSERT(memcmp(rx_pdu.get_subpdu(i).get_sdu(), sdu, sdu_lens[i]) == 0);
+  }
+
+  if (pcap_handle) {
+    pcap_handle->write_dl_crnti_nr(tx_buffer.msg, tx_buffer.N_bytes, PCAP_CRNTI, true, PCAP_TTI);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int mac_ul_sch_pdu_unpack_test5()
 {
   // MAC PDU with UL-SCH (with normal LCID) subheader for short SDU but reserved LCID
@@ -973,6 +1027,11 @@ int main(int argc, char** argv)
     return SRSRAN_ERROR;
   }
 
+  if (mac_dl_sch_pdu_pack_in_place_test8()) {
+    fprintf(stderr, "mac_dl_sch_pdu_pack_in_place_test8() failed.\n");
+    return SRSRAN_ERROR;
+  }
+
   if (mac_ul_sch_pdu_unpack_test5()) {
     fprintf(stderr, "mac_ul_sch_pdu_unpack_test5() failed.\n");
     return SRSRAN_ERROR;
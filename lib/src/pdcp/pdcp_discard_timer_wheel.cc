@@ -0,0 +1,206 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/upper/pdcp_discard_timer_wheel.h"
+
+namespace srsran {
+
+static uint32_t ceil_pow2(uint32_t value)
+{
+  uint32_t ret = 1;
+  while (ret < value) {
+    ret <<= 1U;
+  }
+  return ret;
+}
+
+void pdcp_discard_timer_wheel::init(task_sched_handle task_sched,
+                                    uint32_t          timeout_ms_,
+                                    uint32_t          max_capacity,
+                                    expiry_callback_t callback_)
+{
+  srsran_assert(timeout_ms_ > 0, "Invalid discard timeout");
+
+  callback = std::move(callback_);
+  if (is_init()) {
+    // Reconfiguration, the slots and buckets of the running timers stay valid if the timeout and capacity don't change
+    if (timeout_ms_ == timeout_ms and ceil_pow2(max_capacity) == max_slots) {
+      return;
+    }
+    clear();
+  }
+
+  timeout_ms = timeout_ms_;
+  tick_shift = 0;
+  while ((2U << tick_shift) <= timeout_ms / 64) {
+    tick_shift++;
+  }
+
+  // Pending expiries span at most timeout / tick + 2 buckets
+  buckets.resize(ceil_pow2((timeout_ms >> tick_shift) + 3));
+  bucket_mask = buckets.size() - 1;
+
+  max_slots = ceil_pow2(max_capacity);
+  slots.assign(std::min(max_slots, initial_capacity), slot_t{});
+  slot_mask = slots.size() - 1;
+
+  if (not is_init()) {
+    timer = task_sched.get_unique_timer();
+  }
+  timer.set(timeout_ms, [this](uint32_t tid) { handle_expiry(); });
+}
+
+void pdcp_discard_timer_wheel::reset()
+{
+  clear();
+  timer.release();
+}
+
+bool pdcp_discard_timer_wheel::start(uint32_t sn)
+{
+  if (not is_init()) {
+    return false;
+  }
+  while (slots[sn & slot_mask].sn != invalid_sn) {
+    if (slots[sn & slot_mask].sn == sn or slots.size() >= max_slots) {
+      return false;
+    }
+    grow_slots();
+  }
+
+  // The SN expires in the first bucket that ends after its discard timer
+  uint32_t cur_time = now();
+  uint32_t tick     = 1U << tick_shift;
+  uint32_t expiry   = (cur_time + timeout_ms + tick - 1) & ~(tick - 1);
+
+  slot_t& slot = slots[sn & slot_mask];
+  slot.sn      = sn;
+  slot.expiry  = expiry;
+  nof_running_timers++;
+  bucket(expiry).push_back(sn);
+  last_expiry = expiry;
+
+  // Otherwise, the bearer timer already runs for an earlier bucket
+  if (not timer.is_running()) {
+    run_timer(cur_time, expiry);
+  }
+  return true;
+}
+
+bool pdcp_discard_timer_wheel::stop(uint32_t sn)
+{
+  if (not is_running(sn)) {
+    return false;
+  }
+  slots[sn & slot_mask].sn = invalid_sn;
+  nof_running_timers--;
+
+  // Once all the timers are stopped, the SNs left in the buckets are not needed
+  if (nof_running_timers == 0) {
+    clear_buckets(timer_expiry);
+    timer.stop();
+  }
+  return true;
+}
+
+void pdcp_discard_timer_wheel::clear()
+{
+  if (not is_init()) {
+    return;
+  }
+  timer.stop();
+  for (std::vector<uint32_t>& b : buckets) {
+    b.clear();
+  }
+  std::fill(slots.begin(), slots.end(), slot_t{});
+  nof_running_timers = 0;
+}
+
+void pdcp_discard_timer_wheel::run_timer(uint32_t cur_time, uint32_t expiry)
+{
+  timer_start  = cur_time;
+  timer_expiry = expiry;
+  timer.set(expiry - cur_time);
+  timer.run();
+}
+
+void pdcp_discard_timer_wheel::clear_buckets(uint32_t from_expiry)
+{
+  uint32_t tick   = 1U << tick_shift;
+  uint32_t expiry = from_expiry;
+  for (size_t i = 0; i < buckets.size() and expiry != last_expiry + tick; ++i, expiry += tick) {
+    bucket(expiry).clear();
+  }
+}
+
+void pdcp_discard_timer_wheel::grow_slots()
+{
+  std::vector<slot_t> old_slots(slots.size() * 2);
+  old_slots.swap(slots);
+  slot_mask = slots.size() - 1;
+  for (const slot_t& slot : old_slots) {
+    if (slot.sn != invalid_sn) {
+      slots[slot.sn & slot_mask] = slot;
+    }
+  }
+}
+
+void pdcp_discard_timer_wheel::handle_expiry()
+{
+  // While the callbacks of the timers run, the time of the task scheduler is one tick behind the expiry. A timer run
+  // from here only expires after duration - 1 ticks
+  uint32_t expiry = timer_expiry;
+  uint32_t tick   = 1U << tick_shift;
+  timer_start     = expiry - 1;
+
+  // The callback may stop or start other timers. A timer that was stopped, or stopped and started again for a later
+  // expiry, is skipped
+  std::vector<uint32_t>& expired = bucket(expiry);
+  for (size_t i = 0; i < expired.size(); ++i) {
+    uint32_t sn   = expired[i];
+    slot_t&  slot = slots[sn & slot_mask];
+    if (slot.sn != sn or slot.expiry != expiry) {
+      continue;
+    }
+    slot.sn = invalid_sn;
+    nof_running_timers--;
+    callback(sn);
+  }
+  expired.clear();
+
+  if (nof_running_timers == 0) {
+    clear_buckets(expiry + tick);
+    timer.stop();
+    return;
+  }
+
+  // Run the bearer timer for the next bucket with SNs
+  for (uint32_t next = expiry + tick; next != last_expiry + tick; next += tick) {
+    if (not bucket(next).empty()) {
+      if (not timer.is_running() or timer_expiry != next) {
+        run_timer(expiry - 1, next);
+      }
+      return;
+    }
+  }
+}
+
+} // namespace srsran
@@ -36,6 +36,15 @@ void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
 {
   sec_cfg = sec_cfg_;
 
+  // Derive the key schedules once, the PDU path only uses the cached contexts
+  if (is_srb()) {
+    cipher_state.set_key(sec_cfg.cipher_algo, &sec_cfg.k_rrc_enc[16]);
+    integrity_state.set_key(sec_cfg.integ_algo, &sec_cfg.k_rrc_int[16]);
+  } else {
+    cipher_state.set_key(sec_cfg.cipher_algo, &sec_cfg.k_up_enc[16]);
+    integrity_state.set_key(sec_cfg.integ_algo, &sec_cfg.k_up_int[16]);
+  }
+
   logger.info("Configuring security with %s and %s",
               integrity_algorithm_id_text[sec_cfg.integ_algo],
               ciphering_algorithm_id_text[sec_cfg.cipher_algo]);
@@ -60,20 +69,8 @@ void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32
     k_int = sec_cfg.k_up_int.data();
   }
 
-  switch (sec_cfg.integ_algo) {
-    case INTEGRITY_ALGORITHM_ID_EIA0:
-      break;
-    case INTEGRITY_ALGORITHM_ID_128_EIA1:
-      security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
-      break;
-    case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
-      break;
-    case INTEGRITY_ALGORITHM_ID_128_EIA3:
-      security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
-      break;
-    default:
-      break;
+  if (sec_cfg.integ_algo != INTEGRITY_ALGORITHM_ID_EIA0) {
+    integrity_state.generate(count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
   }
 
   logger.debug("Integrity gen input: COUNT %" PRIu32 ", Bearer ID %d, Direction %s",
@@ -98,23 +95,8 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
     k_int = sec_cfg.k_up_int.data();
   }
 
-  switch (sec_cfg.integ_algo) {
-    case INTEGRITY_ALGORITHM_ID_EIA0:
-      break;
-    case INTEGRITY_ALGORITHM_ID_128_EIA1:
-      security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
-      break;
-    case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
-      break;
-    case INTEGRITY_ALGORITHM_ID_128_EIA3:
-      security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
-      break;
-    default:
-      break;
-  }
-
   if (sec_cfg.integ_algo != INTEGRITY_ALGORITHM_ID_EIA0) {
+    integrity_state.generate(count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
     for (uint8_t i = 0; i < 4; i++) {
       if (mac[i] != mac_exp[i]) {
         is_valid = false;
@@ -138,7 +120,6 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
 void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* ct)
 {
   uint8_t* k_enc;
-  uint8_t  ct_tmp[PDCP_MAX_SDU_SIZE];
 
   // If control plane use RRC encrytion key. If data use user plane key
   if (is_srb()) {
@@ -154,23 +135,8 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
   logger.debug(k_enc, 32, "Cipher encrypt key:");
   logger.debug(msg, msg_len, "Cipher encrypt input msg");
 
-  switch (sec_cfg.cipher_algo) {
-    case CIPHERING_ALGORITHM_ID_EEA0:
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA1:
-      security_128_eea1(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA3:
-      security_128_eea3(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
-      break;
-    default:
-      break;
+  if (sec_cfg.cipher_algo != CIPHERING_ALGORITHM_ID_EEA0) {
+    cipher_state.cipher(count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct);
   }
   logger.debug(ct, msg_len, "Cipher encrypt output msg");
 }
@@ -178,7 +144,6 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
 void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t count, uint8_t* msg)
 {
   uint8_t* k_enc;
-  uint8_t  msg_tmp[PDCP_MAX_SDU_SIZE];
 
   // If control plane use RRC encrytion key. If data use user plane key
   if (is_srb()) {
@@ -194,23 +159,8 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
   logger.debug(k_enc, 32, "Cipher decrypt key:");
   logger.debug(ct, ct_len, "Cipher decrypt input msg");
 
-  switch (sec_cfg.cipher_algo) {
-    case CIPHERING_ALGORITHM_ID_EEA0:
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA1:
-      security_128_eea1(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
-      break;
-    case CIPHERING_ALGORITHM_ID_128_EEA3:
-      security_128_eea3(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
-      break;
-    default:
-      break;
+  if (sec_cfg.cipher_algo != CIPHERING_ALGORITHM_ID_EEA0) {
+    cipher_state.cipher(count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg);
   }
   logger.debug(msg, ct_len, "Cipher decrypt output msg");
 }
@@ -100,7 +100,8 @@ bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
   logger.info("Status Report Required: %s", cfg.status_report_required ? "True" : "False");
 
   if (is_drb() and not rlc->rb_is_um(lcid)) {
-    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(task_sched, maximum_pdcp_sn));
+    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(
+        task_sched, maximum_pdcp_sn, static_cast<uint32_t>(cfg.discard_timer), discard_callback(this)));
     rx_counts_info.reserve(reordering_window);
   }
 
@@ -144,20 +145,78 @@ void pdcp_entity_lte::reset()
 
 // GW/RRC interface
 void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
+{
+  uint32_t tx_count;
+  if (not prepare_tx_pdu(sdu, upper_sn, &tx_count)) {
+    return;
+  }
+
+  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+    cipher_encrypt(
+        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
+  }
+
+  send_tx_pdu(std::move(sdu));
+}
+
+void pdcp_entity_lte::write_sdus(span<unique_byte_buffer_t> sdus)
+{
+  bool do_encryption = encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX;
+  if (is_srb() or enable_security_tx_sn != -1 or not do_encryption or
+      sec_cfg.cipher_algo == CIPHERING_ALGORITHM_ID_EEA0) {
+    for (unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(std::move(sdu));
+    }
+    return;
+  }
+
+  // Only the SDUs that fit in the RLC queue are numbered and stored. The RLC queue only gets emptier while the batch
+  // is prepared, so none of them is dropped after getting its SN
+  uint32_t nof_free = rlc->sdu_queue_free_slots(lcid);
+  if (sdus.size() > nof_free) {
+    logger.info("Dropping %zd %s SDUs due to full queue", sdus.size() - nof_free, rb_name.c_str());
+    for (unique_byte_buffer_t& sdu : sdus.last(sdus.size() - nof_free)) {
+      sdu.reset();
+    }
+    sdus = sdus.first(nof_free);
+  }
+
+  // Number all the SDUs first, so that they are ciphered in one call
+  tx_batch.clear();
+  for (unique_byte_buffer_t& sdu : sdus) {
+    uint32_t tx_count;
+    if (not prepare_tx_pdu(sdu, -1, &tx_count)) {
+      sdu.reset();
+      continue;
+    }
+    uint8_t* payload = &sdu->msg[cfg.hdr_len_bytes];
+    tx_batch.push_back({tx_count, payload, sdu->N_bytes - cfg.hdr_len_bytes, payload});
+  }
+  logger.debug("Cipher encrypt batch of %zd PDUs, Bearer ID: %d", tx_batch.size(), cfg.bearer_id);
+  cipher_state.cipher_batch(cfg.bearer_id - 1, cfg.tx_direction, tx_batch);
+
+  for (unique_byte_buffer_t& sdu : sdus) {
+    if (sdu != nullptr) {
+      send_tx_pdu(std::move(sdu));
+    }
+  }
+}
+
+bool pdcp_entity_lte::prepare_tx_pdu(unique_byte_buffer_t& sdu, int upper_sn, uint32_t* tx_count_out)
 {
   if (!active) {
     logger.warning("Dropping %s SDU due to inactive bearer", rb_name.c_str());
-    return;
+    return false;
   }
 
   if (rlc->is_suspended(lcid)) {
     logger.warning("Trying to send SDU while re-establishment is in progress. Dropping SDU. LCID=%d", lcid);
-    return;
+    return false;
   }
 
   if (rlc->sdu_queue_is_full(lcid)) {
     logger.info(sdu->msg, sdu->N_bytes, "Dropping %s SDU due to full queue", rb_name.c_str());
-    return;
+    return false;
   }
 
   // Get COUNT to be used with this packet
@@ -179,7 +238,7 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     if (not store_sdu(used_sn, sdu)) {
       // Could not store the SDU, discarding
       logger.warning("Could not store SDU. Discarding SN=%d", used_sn);
-      return;
+      return false;
     }
   }
   // check for pending security config in transmit direction
@@ -202,19 +261,6 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     append_mac(sdu, mac);
   }
 
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
-    cipher_encrypt(
-        &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
-  }
-
-  logger.info(sdu->msg,
-              sdu->N_bytes,
-              "TX %s PDU, SN=%d, integrity=%s, encryption=%s",
-              rb_name.c_str(),
-              used_sn,
-              srsran_direction_text[integrity_direction],
-              srsran_direction_text[encryption_direction]);
-
   // Set SDU metadata for RLC AM
   sdu->md.pdcp_sn = used_sn;
 
@@ -227,6 +273,20 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     }
   }
 
+  *tx_count_out = tx_count;
+  return true;
+}
+
+void pdcp_entity_lte::send_tx_pdu(unique_byte_buffer_t sdu)
+{
+  logger.info(sdu->msg,
+              sdu->N_bytes,
+              "TX %s PDU, SN=%d, integrity=%s, encryption=%s",
+              rb_name.c_str(),
+              sdu->md.pdcp_sn,
+              srsran_direction_text[integrity_direction],
+              srsran_direction_text[encryption_direction]);
+
   // Pass PDU to lower layers
   metrics.num_tx_pdus++;
   metrics.num_tx_pdu_bytes += sdu->N_bytes;
@@ -718,11 +778,9 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
   }
 
   // Copy PDU contents into queue and start discard timer
-  uint32_t         discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
-  discard_callback discard_fnc(this, sn);
-  bool             ret = undelivered_sdus->add_sdu(sn, sdu, discard_timeout, discard_fnc);
-  if (ret and discard_timeout > 0) {
-    logger.debug("Discard Timer set for SN %u. Timeout: %ums", sn, discard_timeout);
+  bool ret = undelivered_sdus->add_sdu(sn, sdu);
+  if (ret and cfg.discard_timer != pdcp_discard_timer_t::infinity) {
+    logger.debug("Discard Timer set for SN %u. Timeout: %ums", sn, static_cast<uint32_t>(cfg.discard_timer));
   }
   return ret;
 }
@@ -731,7 +789,7 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
  * Discard functionality
  ***************************************************************************/
 // Discard Timer Callback (discardTimer)
-void pdcp_entity_lte::discard_callback::operator()(uint32_t timer_id)
+void pdcp_entity_lte::discard_callback::operator()(uint32_t discard_sn)
 {
   parent->logger.info("Discard timer for SN=%d expired", discard_sn);
 
@@ -873,17 +931,18 @@ void pdcp_entity_lte::reset_metrics()
 /****************************************************************************
  * Undelivered SDUs queue helpers
  ***************************************************************************/
-undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod) : sn_mod(sn_mod)
+undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle                           task_sched,
+                                               uint32_t                                            sn_mod,
+                                               uint32_t                                            discard_timeout,
+                                               srsran::pdcp_discard_timer_wheel::expiry_callback_t discard_callback) :
+  sn_mod(sn_mod)
 {
-  for (auto& e : sdus) {
-    e.discard_timer = task_sched.get_unique_timer();
+  if (discard_timeout > 0 and discard_timeout != static_cast<uint32_t>(pdcp_discard_timer_t::infinity)) {
+    discard_timers.init(task_sched, discard_timeout, capacity, std::move(discard_callback));
   }
 }
 
-bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
-                                     const srsran::unique_byte_buffer_t&   sdu,
-                                     uint32_t                              discard_timeout,
-                                     srsran::move_callback<void(uint32_t)> callback)
+bool undelivered_sdus_queue::add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu)
 {
   assert(not has_sdu(sn) && "Cannot add repeated SNs");
 
@@ -921,10 +980,7 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
   sdus[sn].sdu->md.pdcp_sn = sn;
   sdus[sn].sdu->N_bytes    = sdu->N_bytes;
   memcpy(sdus[sn].sdu->msg, sdu->msg, sdu->N_bytes);
-  if (discard_timeout > 0) {
-    sdus[sn].discard_timer.set(discard_timeout, std::move(callback));
-    sdus[sn].discard_timer.run();
-  }
+  discard_timers.start(sn);
   sdus[sn].sdu->set_timestamp(); // Metrics
   bytes += sdu->N_bytes;
   return true;
@@ -937,7 +993,7 @@ bool undelivered_sdus_queue::clear_sdu(uint32_t sn)
   }
   count--;
   bytes -= sdus[sn].sdu->N_bytes;
-  sdus[sn].discard_timer.stop();
+  discard_timers.stop(sn);
   sdus[sn].sdu.reset();
   // Find next FMS, if necessary
   if (sn == fms) {
@@ -952,16 +1008,9 @@ void undelivered_sdus_queue::clear()
   bytes = 0;
   fms   = 0;
   for (uint32_t sn = 0; sn < capacity; sn++) {
-    sdus[sn].discard_timer.stop();
     sdus[sn].sdu.reset();
   }
-}
-
-size_t undelivered_sdus_queue::nof_discard_timers() const
-{
-  return std::count_if(sdus.begin(), sdus.end(), [](const sdu_data& s) {
-    return s.sdu != nullptr and s.discard_timer.is_valid() and s.discard_timer.is_running();
-  });
+  discard_timers.clear();
 }
 
 void undelivered_sdus_queue::update_fms()
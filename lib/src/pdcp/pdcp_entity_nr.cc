@@ -34,7 +34,8 @@ pdcp_entity_nr::pdcp_entity_nr(srsue::rlc_interface_pdcp* rlc_,
   rlc(rlc_),
   rrc(rrc_),
   gw(gw_),
-  reordering_fnc(new pdcp_entity_nr::reordering_callback(this))
+  reordering_fnc(new pdcp_entity_nr::reordering_callback(this)),
+  reorder_buffer(initial_reorder_buffer_size)
 {
   lcid                 = lcid_;
   integrity_direction  = DIRECTION_NONE;
@@ -82,6 +83,14 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
   if (rlc_mode == rlc_mode_t::UM) {
     cfg.discard_timer = pdcp_discard_timer_t::infinity;
   }
+
+  // discardTimer of all the SDUs, with at most Window_Size SDUs waiting for delivery. A reconfiguration with the same
+  // discardTimer keeps the timers of the SDUs already waiting
+  if (cfg.discard_timer != pdcp_discard_timer_t::infinity) {
+    discard_timers.init(task_sched, static_cast<uint32_t>(cfg.discard_timer), window_size, discard_callback(this));
+  } else {
+    discard_timers.reset();
+  }
   return true;
 }
 
@@ -126,13 +135,12 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
   }
 
   // Start discard timer
-  if (cfg.discard_timer != pdcp_discard_timer_t::infinity) {
-    timer_handler::unique_timer discard_timer = task_sched.get_unique_timer();
-    discard_callback            discard_fnc(this, tx_next);
-    discard_timer.set(static_cast<uint32_t>(cfg.discard_timer), discard_fnc);
-    discard_timer.run();
-    discard_timers_map.insert(std::make_pair(tx_next, std::move(discard_timer)));
-    logger.debug("Discard Timer set for SN %u. Timeout: %ums", tx_next, static_cast<uint32_t>(cfg.discard_timer));
+  if (discard_timers.is_init()) {
+    if (discard_timers.start(tx_next)) {
+      logger.debug("Discard Timer set for SN %u. Timeout: %ums", tx_next, discard_timers.get_timeout());
+    } else {
+      logger.warning("Could not set Discard Timer for SN %u. Too many SDUs waiting for delivery", tx_next);
+    }
   }
 
   // Perform header compression TODO
@@ -286,13 +294,23 @@ void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
   }
 
   // Check if PDU has been received
-  if (reorder_queue.find(rcvd_count) != reorder_queue.end()) {
-    logger.debug("Duplicate PDU, dropping");
+  while (rcvd_count - rx_deliv >= reorder_buffer.size() and reorder_buffer.size() < window_size) {
+    grow_reorder_buffer();
+  }
+  unique_byte_buffer_t& slot = reorder_slot(rcvd_count);
+  if (slot != nullptr) {
+    if (slot->md.pdcp_sn == rcvd_count) {
+      logger.debug("Duplicate PDU, dropping");
+    } else {
+      logger.warning("RCVD_COUNT %u outside of the reception window. RX_DELIV %u", rcvd_count, rx_deliv);
+    }
     return; // PDU already present, drop.
   }
 
   // Store PDU in reception buffer
-  reorder_queue[rcvd_count] = std::move(pdu);
+  pdu->md.pdcp_sn = rcvd_count;
+  slot            = std::move(pdu);
+  nof_reorder_pdus++;
 
   // Update RX_NEXT
   if (rcvd_count >= rx_next) {
@@ -328,9 +346,8 @@ void pdcp_entity_nr::notify_delivery(const pdcp_sn_vector_t& pdcp_sns)
 {
   logger.debug("Received delivery notification from RLC. Nof SNs=%ld", pdcp_sns.size());
   for (uint32_t sn : pdcp_sns) {
-    // Remove timer from map
     logger.debug("Stopping discard timer for SN=%ld", sn);
-    discard_timers_map.erase(sn);
+    discard_timers.stop(sn);
   }
 }
 
@@ -347,10 +364,9 @@ void pdcp_entity_nr::notify_failure(const pdcp_sn_vector_t& pdcp_sns)
 // Update RX_NEXT after submitting to higher layers
 void pdcp_entity_nr::deliver_all_consecutive_counts()
 {
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = reorder_queue.begin();
-       it != reorder_queue.end() && it->first == rx_deliv;
-       reorder_queue.erase(it++)) {
-    logger.debug("Delivering SDU with RCVD_COUNT %u", it->first);
+  for (unique_byte_buffer_t* slot = &reorder_slot(rx_deliv); *slot != nullptr && (*slot)->md.pdcp_sn == rx_deliv;
+       slot = &reorder_slot(rx_deliv)) {
+    logger.debug("Delivering SDU with RCVD_COUNT %u", rx_deliv);
 
     // Check RX_DELIV overflow
     if (rx_overflow) {
@@ -362,13 +378,27 @@ void pdcp_entity_nr::deliver_all_consecutive_counts()
     }
 
     // Pass PDCP SDU to the next layers
-    pass_to_upper_layers(std::move(it->second));
+    nof_reorder_pdus--;
+    pass_to_upper_layers(std::move(*slot));
 
     // Update RX_DELIV
     rx_deliv = rx_deliv + 1;
   }
 }
 
+// Doubles the reordering buffer, keeping each PDU at the index of its COUNT
+void pdcp_entity_nr::grow_reorder_buffer()
+{
+  std::vector<unique_byte_buffer_t> old_buffer(reorder_buffer.size() * 2);
+  old_buffer.swap(reorder_buffer);
+  for (unique_byte_buffer_t& pdu : old_buffer) {
+    if (pdu != nullptr) {
+      unique_byte_buffer_t& slot = reorder_slot(pdu->md.pdcp_sn);
+      slot                       = std::move(pdu);
+    }
+  }
+}
+
 /*
  * Timers
  */
@@ -376,14 +406,16 @@ void pdcp_entity_nr::deliver_all_consecutive_counts()
 void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
 {
   parent->logger.info(
-      "Reordering timer expired. RX_REORD=%u, re-order queue size=%ld", parent->rx_reord, parent->reorder_queue.size());
+      "Reordering timer expired. RX_REORD=%u, re-order queue size=%d", parent->rx_reord, parent->nof_reorder_pdus);
 
   // Deliver all PDCP SDU(s) with associated COUNT value(s) < RX_REORD
-  for (std::map<uint32_t, unique_byte_buffer_t>::iterator it = parent->reorder_queue.begin();
-       it != parent->reorder_queue.end() && it->first < parent->rx_reord;
-       parent->reorder_queue.erase(it++)) {
-    // Deliver to upper layers
-    parent->pass_to_upper_layers(std::move(it->second));
+  for (uint32_t count = parent->rx_deliv; count < parent->rx_reord and parent->nof_reorder_pdus > 0; ++count) {
+    unique_byte_buffer_t& slot = parent->reorder_slot(count);
+    if (slot != nullptr and slot->md.pdcp_sn == count) {
+      // Deliver to upper layers
+      parent->nof_reorder_pdus--;
+      parent->pass_to_upper_layers(std::move(slot));
+    }
   }
 
   // Update RX_DELIV to the first PDCP SDU not delivered to the upper layers
@@ -403,16 +435,12 @@ void pdcp_entity_nr::reordering_callback::operator()(uint32_t timer_id)
 }
 
 // Discard Timer Callback (discardTimer)
-void pdcp_entity_nr::discard_callback::operator()(uint32_t timer_id)
+void pdcp_entity_nr::discard_callback::operator()(uint32_t discard_sn)
 {
   parent->logger.debug("Discard timer expired for PDU with SN=%d", discard_sn);
 
   // Notify the RLC of the discard. It's the RLC to actually discard, if no segment was transmitted yet.
   parent->rlc->discard_sdu(parent->lcid, discard_sn);
-
-  // Remove timer from map
-  // NOTE: this will delete the callback. It *must* be the last instruction.
-  parent->discard_timers_map.erase(discard_sn);
 }
 
 void pdcp_entity_nr::get_bearer_state(pdcp_lte_state_t* state)
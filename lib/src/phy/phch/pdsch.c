@@ -236,6 +236,29 @@ int srsran_pdsch_put(srsran_pdsch_t*       q,
   return srsran_pdsch_cp(q, symbols, sf_symbols, grant, lstart, subframe, true);
 }
 
+/**
+ * Restricts the PRBs of a grant to the RBGs shared with another UE in MU-MIMO. The RBG mask follows the bit order of
+ * the resource allocation type 0 bitmap
+ */
+static void pdsch_mu_mimo_grant(const srsran_pdsch_t*       q,
+                                const srsran_pdsch_grant_t* grant,
+                                uint32_t                    rbg_mask,
+                                srsran_pdsch_grant_t*       paired_grant)
+{
+  uint32_t P       = srsran_ra_type0_P(q->cell.nof_prb);
+  uint32_t nof_rbg = SRSRAN_CEIL(q->cell.nof_prb, P);
+
+  *paired_grant         = *grant;
+  paired_grant->nof_prb = 0;
+  for (uint32_t n = 0; n < q->cell.nof_prb; n++) {
+    bool shared = (rbg_mask >> (nof_rbg - n / P - 1)) & 1U;
+    for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+      paired_grant->prb_idx[s][n] = grant->prb_idx[s][n] && shared;
+    }
+    paired_grant->nof_prb += paired_grant->prb_idx[0][n] ? 1 : 0;
+  }
+}
+
 /**
  * Extracts PDSCH from slot number 1
  *
@@ -1124,9 +1147,25 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
     }
 
     /* mapping to resource elements */
-    uint32_t lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
+    uint32_t             lstart = SRSRAN_NOF_CTRL_SYMBOLS(q->cell, sf->cfi);
+    srsran_pdsch_grant_t paired_grant;
+    if (cfg->mu_mimo_rbg_mask != 0) {
+      pdsch_mu_mimo_grant(q, &cfg->grant, cfg->mu_mimo_rbg_mask, &paired_grant);
+    }
     for (i = 0; i < q->cell.nof_ports; i++) {
+      int nof_paired_re = 0;
+      if (cfg->mu_mimo_rbg_mask != 0) {
+        /* Keep the PDSCH of the co-scheduled UE in the shared RBGs, if it was already mapped */
+        nof_paired_re = srsran_pdsch_get(q, sf_symbols[i], q->x[0], &paired_grant, lstart, sf->tti % 10);
+      }
       srsran_pdsch_put(q, q->symbols[i], sf_symbols[i], &cfg->grant, lstart, sf->tti % 10);
+      if (nof_paired_re > 0) {
+        /* MU-MIMO: the power of the shared RBGs is split between the two co-scheduled UEs, which are superposed */
+        srsran_pdsch_get(q, sf_symbols[i], q->x[1], &paired_grant, lstart, sf->tti % 10);
+        srsran_vec_sc_prod_cfc(q->x[1], (float)M_SQRT1_2, q->x[1], nof_paired_re);
+        srsran_vec_sum_ccc(q->x[0], q->x[1], q->x[1], nof_paired_re);
+        srsran_pdsch_put(q, q->x[1], sf_symbols[i], &paired_grant, lstart, sf->tti % 10);
+      }
     }
 
     if (cfg->meas_time_en) {
@@ -0,0 +1,171 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+#include "srsran/support/srsran_test.h"
+#include <complex.h>
+#include <math.h>
+
+static srsran_cell_t cell = {
+    25,                 // nof_prb
+    2,                  // nof_ports
+    1,                  // cell_id
+    SRSRAN_CP_NORM,     // cyclic prefix
+    SRSRAN_PHICH_NORM,  // PHICH length
+    SRSRAN_PHICH_R_1_6, // PHICH resources
+    SRSRAN_FDD,
+};
+
+#define NOF_UES 2
+#define NOF_RBGS 13 // 25 PRBs with RBGs of 2 PRBs
+#define RBG_BIT(rbg) (1U << (NOF_RBGS - (rbg)-1U))
+
+/// Returns the type 0 bitmap of the RBGs [start, stop)
+static uint32_t rbg_bitmask(uint32_t start, uint32_t stop)
+{
+  uint32_t mask = 0;
+  for (uint32_t rbg = start; rbg < stop; rbg++) {
+    mask |= RBG_BIT(rbg);
+  }
+  return mask;
+}
+
+/// Encodes the PDSCH of a UE in TM4 rank 1 with the given RBGs and RBGs shared in MU-MIMO
+static int encode_ue(srsran_pdsch_t*         pdsch,
+                     srsran_softbuffer_tx_t* softbuffer,
+                     uint16_t                rnti,
+                     uint32_t                pmi,
+                     uint32_t                rbg_mask,
+                     uint32_t                mu_mimo_rbg_mask,
+                     uint8_t*                data,
+                     cf_t*                   sf_symbols[SRSRAN_MAX_PORTS])
+{
+  srsran_dl_sf_cfg_t dl_sf;
+  ZERO_OBJECT(dl_sf);
+  dl_sf.tti = 1;
+  dl_sf.cfi = 2;
+
+  srsran_dci_dl_t dci;
+  ZERO_OBJECT(dci);
+  dci.format                  = SRSRAN_DCI_FORMAT2;
+  dci.rnti                    = rnti;
+  dci.alloc_type              = SRSRAN_RA_ALLOC_TYPE0;
+  dci.type0_alloc.rbg_bitmask = rbg_mask;
+  dci.pinfo                   = pmi + 1;
+  dci.tb[0].mcs_idx           = 10;
+  dci.tb[0].rv                = 0;
+  dci.tb[0].cw_idx            = 0;
+  SRSRAN_DCI_TB_DISABLE(dci.tb[1]);
+
+  srsran_pdsch_cfg_t pdsch_cfg;
+  ZERO_OBJECT(pdsch_cfg);
+  TESTASSERT(srsran_ra_dl_dci_to_grant(&cell, &dl_sf, SRSRAN_TM4, false, &dci, &pdsch_cfg.grant) == SRSRAN_SUCCESS);
+  pdsch_cfg.rnti              = rnti;
+  pdsch_cfg.softbuffers.tx[0] = softbuffer;
+  pdsch_cfg.mu_mimo_rbg_mask  = mu_mimo_rbg_mask;
+
+  uint8_t* data_tb[SRSRAN_MAX_CODEWORDS] = {data, NULL};
+  TESTASSERT(srsran_pdsch_encode(pdsch, &dl_sf, &pdsch_cfg, data_tb, sf_symbols) == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
+
+/// Two UEs with orthogonal PMIs share some RBGs. The shared RBGs must carry both PDSCHs with half of the power each,
+/// while the RBGs of a single UE keep their full power
+int main(int argc, char** argv)
+{
+  srsran_pdsch_t pdsch;
+  TESTASSERT(srsran_pdsch_init_enb(&pdsch, cell.nof_prb) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran_pdsch_set_cell(&pdsch, cell) == SRSRAN_SUCCESS);
+
+  const uint16_t rntis[NOF_UES]     = {0x46, 0x47};
+  const uint32_t pmis[NOF_UES]      = {0, 1};
+  const uint32_t rbg_masks[NOF_UES] = {rbg_bitmask(0, 6), rbg_bitmask(3, 9)};
+  const uint32_t shared_rbgs        = rbg_masks[0] & rbg_masks[1];
+
+  srsran_random_t        random_gen = srsran_random_init(0x1234);
+  srsran_softbuffer_tx_t softbuffers[NOF_UES];
+  uint8_t*               data[NOF_UES];
+  cf_t*                  ref_symbols[NOF_UES][SRSRAN_MAX_PORTS] = {};
+  cf_t*                  mu_symbols[SRSRAN_MAX_PORTS]           = {};
+  const uint32_t         nof_re                                 = SRSRAN_NOF_RE(cell);
+
+  const uint32_t max_data_bytes = srsran_ra_tbs_from_idx(SRSRAN_RA_NOF_TBS_IDX - 1, cell.nof_prb) / 8;
+  for (uint32_t ue = 0; ue < NOF_UES; ue++) {
+    TESTASSERT(srsran_softbuffer_tx_init(&softbuffers[ue], cell.nof_prb) == SRSRAN_SUCCESS);
+    data[ue] = srsran_vec_u8_malloc(max_data_bytes);
+    for (uint32_t i = 0; i < max_data_bytes; i++) {
+      data[ue][i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 255);
+    }
+    for (uint32_t p = 0; p < cell.nof_ports; p++) {
+      ref_symbols[ue][p] = srsran_vec_cf_malloc(nof_re);
+      srsran_vec_cf_zero(ref_symbols[ue][p], nof_re);
+    }
+  }
+  for (uint32_t p = 0; p < cell.nof_ports; p++) {
+    mu_symbols[p] = srsran_vec_cf_malloc(nof_re);
+    srsran_vec_cf_zero(mu_symbols[p], nof_re);
+  }
+
+  // Each UE alone, and both UEs superposed in the shared RBGs
+  for (uint32_t ue = 0; ue < NOF_UES; ue++) {
+    TESTASSERT(encode_ue(&pdsch, &softbuffers[ue], rntis[ue], pmis[ue], rbg_masks[ue], 0, data[ue], ref_symbols[ue]) ==
+               SRSRAN_SUCCESS);
+  }
+  for (uint32_t ue = 0; ue < NOF_UES; ue++) {
+    TESTASSERT(encode_ue(
+                   &pdsch, &softbuffers[ue], rntis[ue], pmis[ue], rbg_masks[ue], shared_rbgs, data[ue], mu_symbols) ==
+               SRSRAN_SUCCESS);
+  }
+
+  uint32_t P = srsran_ra_type0_P(cell.nof_prb);
+  for (uint32_t p = 0; p < cell.nof_ports; p++) {
+    float shared_power = 0;
+    for (uint32_t re = 0; re < nof_re; re++) {
+      uint32_t n        = (re / SRSRAN_NRE) % cell.nof_prb;
+      bool     shared   = (shared_rbgs & RBG_BIT(n / P)) != 0;
+      cf_t     sum      = ref_symbols[0][p][re] + ref_symbols[1][p][re];
+      cf_t     expected = shared ? sum * (float)M_SQRT1_2 : sum;
+      TESTASSERT(cabsf(mu_symbols[p][re] - expected) < 1e-5f);
+      if (shared) {
+        shared_power += crealf(ref_symbols[0][p][re] * conjf(ref_symbols[0][p][re]));
+      }
+    }
+    // The shared RBGs are not empty
+    TESTASSERT(shared_power > 0);
+  }
+
+  for (uint32_t ue = 0; ue < NOF_UES; ue++) {
+    srsran_softbuffer_tx_free(&softbuffers[ue]);
+    free(data[ue]);
+    for (uint32_t p = 0; p < cell.nof_ports; p++) {
+      free(ref_symbols[ue][p]);
+    }
+  }
+  for (uint32_t p = 0; p < cell.nof_ports; p++) {
+    free(mu_symbols[p]);
+  }
+  srsran_random_free(random_gen);
+  srsran_pdsch_free(&pdsch);
+
+  printf("Ok\n");
+  return SRSRAN_SUCCESS;
+}
@@ -243,6 +243,28 @@ bool rlc::sdu_queue_is_full(uint32_t lcid)
   return false;
 }
 
+bool rlc::sdu_queue_is_congested(uint32_t lcid)
+{
+  if (valid_lcid(lcid)) {
+    return rlc_array.at(lcid)->sdu_queue_is_congested();
+  } else if (valid_lcid_mrb(lcid)) {
+    return rlc_array_mrb.at(lcid)->sdu_queue_is_congested();
+  }
+  logger.warning("RLC LCID %d doesn't exist. Ignoring queue check", lcid);
+  return false;
+}
+
+uint32_t rlc::sdu_queue_free_slots(uint32_t lcid)
+{
+  if (valid_lcid(lcid)) {
+    return rlc_array.at(lcid)->sdu_queue_free_slots();
+  } else if (valid_lcid_mrb(lcid)) {
+    return rlc_array_mrb.at(lcid)->sdu_queue_free_slots();
+  }
+  logger.warning("RLC LCID %d doesn't exist. Ignoring queue check", lcid);
+  return 0;
+}
+
 /*******************************************************************************
   MAC interface (mostly called from PHY workers, lock needs to be hold)
 *******************************************************************************/
@@ -301,6 +323,32 @@ uint32_t rlc::read_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
   return ret;
 }
 
+// The bearer lookup and the buffer state update are done once for all the PDUs of the batch
+uint32_t rlc::read_pdus(uint32_t lcid, read_pdu_batch_interface& batch)
+{
+  uint32_t ret = 0;
+
+  rwlock_read_guard lock(rwlock);
+  if (not valid_lcid(lcid)) {
+    logger.warning("LCID %d doesn't exist.", lcid);
+    return ret;
+  }
+
+  rlc_common* rlc_entity = rlc_array.at(lcid).get();
+  for (srsran::span<uint8_t> pdu = batch.reserve_pdu(); not pdu.empty(); pdu = batch.reserve_pdu()) {
+    uint32_t pdu_len = rlc_entity->read_pdu(pdu.data(), pdu.size());
+    if (pdu_len == 0) {
+      break;
+    }
+    srsran_expect(pdu_len <= pdu.size(), "Created too big RLC PDU (%d > %zd)", pdu_len, pdu.size());
+    batch.add_pdu(pdu_len);
+    ret += pdu_len;
+  }
+  update_bsr(lcid);
+
+  return ret;
+}
+
 uint32_t rlc::read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   uint32_t ret = 0;
@@ -155,6 +155,16 @@ bool rlc_am::sdu_queue_is_full()
   return tx_base->sdu_queue_is_full();
 }
 
+bool rlc_am::sdu_queue_is_congested()
+{
+  return tx_base->sdu_queue_is_congested();
+}
+
+uint32_t rlc_am::sdu_queue_free_slots()
+{
+  return tx_base->sdu_queue_free_slots();
+}
+
 /****************************************************************************
  * MAC interface
  ***************************************************************************/
@@ -229,7 +239,9 @@ void rlc_am::set_bsr_callback(bsr_callback_t callback)
  *******************************************************/
 int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  // The SDU queue is lock-free, so PDCP never waits on the Tx mutex held by the MAC opportunity. It only waits for the
+  // queue to be drained on stop, reestablishment or reconfiguration
+  std::lock_guard<std::mutex> lock(sdu_queue_mutex);
 
   if (!tx_enabled) {
     return SRSRAN_ERROR;
@@ -270,19 +282,12 @@ int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
 
 void rlc_am::rlc_am_base_tx::discard_sdu(uint32_t discard_sn)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(sdu_queue_mutex);
 
   if (!tx_enabled) {
     return;
   }
-  bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
-    if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
-      sdu = nullptr;
-      return true;
-    }
-    return false;
-  });
+  bool discarded = tx_sdu_queue.discard(discard_sn);
 
   // Discard fails when the PDCP PDU is already in Tx window.
   RlcInfo("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
@@ -293,6 +298,16 @@ bool rlc_am::rlc_am_base_tx::sdu_queue_is_full()
   return tx_sdu_queue.is_full();
 }
 
+bool rlc_am::rlc_am_base_tx::sdu_queue_is_congested()
+{
+  return tx_sdu_queue.is_congested();
+}
+
+uint32_t rlc_am::rlc_am_base_tx::sdu_queue_free_slots()
+{
+  return tx_sdu_queue.free_slots();
+}
+
 void rlc_am::rlc_am_base_tx::set_bsr_callback(bsr_callback_t callback)
 {
   bsr_callback = callback;
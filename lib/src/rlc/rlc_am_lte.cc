@@ -82,9 +82,11 @@ bool rlc_am_lte_tx::configure(const rlc_config_t& cfg_)
     poll_retx_timer.set(static_cast<uint32_t>(cfg.t_poll_retx), [this](uint32_t timerid) { timer_expired(timerid); });
   }
 
-  // make sure Tx queue is empty before attempting to resize
+  // make sure Tx queue is empty before attempting to resize, with PDCP held back from writing to it
+  std::lock_guard<std::mutex> sdu_lock(sdu_queue_mutex);
   empty_queue_nolock();
   tx_sdu_queue.resize(cfg_.tx_queue_length);
+  tx_sdu_queue.set_watermarks(cfg_.tx_queue_wm_sdus, cfg_.tx_queue_wm_bytes);
 
   tx_enabled = true;
 
@@ -99,9 +101,12 @@ void rlc_am_lte_tx::stop()
 
 void rlc_am_lte_tx::stop_nolock()
 {
-  empty_queue_nolock();
-
-  tx_enabled = false;
+  {
+    // Disable PDCP writes before draining, so that no SDU written concurrently is left in the queue
+    std::lock_guard<std::mutex> sdu_lock(sdu_queue_mutex);
+    tx_enabled = false;
+    empty_queue_nolock();
+  }
 
   if (parent->timers != nullptr && poll_retx_timer.is_valid()) {
     poll_retx_timer.stop();
@@ -1369,8 +1374,6 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
 
 void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes, rlc_amd_pdu_header_t& header)
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-
   RlcHexInfo(payload,
              nof_bytes,
              "Rx data PDU segment of SN=%d (%d B), SO=%d, N_li=%d",
@@ -1390,9 +1393,8 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
     return;
   }
 
-  rlc_amd_rx_pdu segment;
-  segment.buf = srsran::make_byte_buffer();
-  if (segment.buf == NULL) {
+  unique_byte_buffer_t buf = srsran::make_byte_buffer();
+  if (buf == NULL) {
 #ifdef RLC_AM_BUFFER_DEBUG
     srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu_segment().\n");
     exit(-1);
@@ -1402,34 +1404,36 @@ void rlc_am_lte_rx::handle_data_pdu_segment(uint8_t* payload, uint32_t nof_bytes
 #endif
   }
 
-  if (segment.buf->get_tailroom() < nof_bytes) {
+  if (buf->get_tailroom() < nof_bytes) {
     RlcInfo("Dropping corrupted segment SN=%d, not enough space to fit %d B", header.sn, nof_bytes);
     return;
   }
 
-  memcpy(segment.buf->msg, payload, nof_bytes);
-  segment.buf->N_bytes = nof_bytes;
-  segment.header       = header;
+  memcpy(buf->msg, payload, nof_bytes);
+  buf->N_bytes = nof_bytes;
+
+  rlc_amd_rx_pdu_segment* segment = segment_pool.make_segment();
+  segment->buf                    = std::move(buf);
+  segment->header                 = header;
 
   // Check if we already have a segment from the same PDU
-  it = rx_segments.find(header.sn);
-  if (rx_segments.end() != it) {
+  if (rx_segments.contains(header.sn)) {
     if (header.p) {
       RlcInfo("Status packet requested through polling bit");
       do_status = true;
     }
 
     // Add segment to PDU list and check for complete
-    // NOTE: MAY MOVE. Preference would be to capture by value, and then move; but header is stack allocated
-    if (add_segment_and_check(&it->second, &segment)) {
-      rx_segments.erase(it);
-    }
+    add_segment_and_check(&rx_segments[header.sn], segment);
 
   } else {
     // Create new PDU segment list and write to rx_segments
-    rlc_amd_rx_pdu_segments_t pdu;
-    pdu.segments.push_back(std::move(segment));
-    rx_segments[header.sn] = std::move(pdu);
+    if (not rx_segments.insert(header.sn, rlc_amd_rx_pdu_segments_t(header.sn, segment_pool)).has_value()) {
+      RlcError("Dropping segment SN=%d, couldn't create its segment list", header.sn);
+      segment_pool.release_segment(segment);
+      return;
+    }
+    rx_segments[header.sn].add_segment(segment);
 
     // Update vr_h
     if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1585,19 +1589,16 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
     // Move the rx_window
     RlcDebug("Erasing SN=%d.", vr_r);
     // also erase any segments of this SN
-    std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-    it = rx_segments.find(vr_r);
-    if (rx_segments.end() != it) {
+    if (rx_segments.contains(vr_r)) {
       RlcDebug("Erasing segments of SN=%d", vr_r);
-      std::list<rlc_amd_rx_pdu>::iterator segit;
-      for (segit = it->second.segments.begin(); segit != it->second.segments.end(); ++segit) {
+      for (const rlc_amd_rx_pdu_segment* segit = rx_segments[vr_r].front(); segit != nullptr; segit = segit->next) {
         RlcDebug(" Erasing segment of SN=%d SO=%d Len=%d N_li=%d",
                  segit->header.sn,
                  segit->header.so,
                  segit->buf->N_bytes,
                  segit->header.N_li);
       }
-      it->second.segments.clear();
+      rx_segments.erase(vr_r);
     }
     rx_window.remove_pdu(vr_r);
     vr_r  = (vr_r + 1) % MOD;
@@ -1733,12 +1734,13 @@ int rlc_am_lte_rx::get_status_pdu_length()
 
 void rlc_am_lte_rx::print_rx_segments()
 {
-  std::map<uint32_t, rlc_amd_rx_pdu_segments_t>::iterator it;
-  std::stringstream                                       ss;
+  std::stringstream ss;
   ss << "rx_segments:" << std::endl;
-  for (it = rx_segments.begin(); it != rx_segments.end(); it++) {
-    std::list<rlc_amd_rx_pdu>::iterator segit;
-    for (segit = it->second.segments.begin(); segit != it->second.segments.end(); segit++) {
+  for (uint32_t i = vr_r; RX_MOD_BASE(i) < RX_MOD_BASE(vr_mr); i = (i + 1) % MOD) {
+    if (not rx_segments.contains(i)) {
+      continue;
+    }
+    for (const rlc_amd_rx_pdu_segment* segit = rx_segments[i].front(); segit != nullptr; segit = segit->next) {
       ss << "    SN=" << segit->header.sn << " SO:" << segit->header.so << " N:" << segit->buf->N_bytes
          << " N_li: " << segit->header.N_li << std::endl;
     }
@@ -1746,59 +1748,11 @@ void rlc_am_lte_rx::print_rx_segments()
   RlcDebug("%s", ss.str().c_str());
 }
 
-// NOTE: Preference would be to capture by value, and then move; but header is stack allocated
-bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu* segment)
+bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_amd_rx_pdu_segment* segment)
 {
-  // Find segment insertion point in the list of segments
-  auto it1 = pdu->segments.begin();
-  while (it1 != pdu->segments.end() && (*it1).header.so < segment->header.so) {
-    // Increment iterator
-    it1++;
-  }
-
-  // Check if the insertion point was found
-  if (it1 != pdu->segments.end()) {
-    // Found insertion point
-    rlc_amd_rx_pdu& s = *it1;
-    if (s.header.so == segment->header.so) {
-      // Same Segment offset
-      if (segment->buf->N_bytes > s.buf->N_bytes) {
-        // replace if the new one is bigger
-        s = std::move(*segment);
-      } else {
-        // Ignore otherwise
-      }
-    } else if (s.header.so > segment->header.so) {
-      pdu->segments.insert(it1, std::move(*segment));
-    }
-  } else {
-    // Either the new segment is the latest or the only one, push back
-    pdu->segments.push_back(std::move(*segment));
-  }
-
-  // Check for complete
-  uint32_t                            so = 0;
-  std::list<rlc_amd_rx_pdu>::iterator it, tmpit;
-  for (it = pdu->segments.begin(); it != pdu->segments.end(); /* Do not increment */) {
-    // Check that there is no gap between last segment and current; overlap allowed
-    if (so < it->header.so) {
-      // return
-      return false;
-    }
-
-    // Check if segment is overlapped
-    if (it->header.so + it->buf->N_bytes <= so) {
-      // completely overlapped with previous segments, erase
-      it = pdu->segments.erase(it); // Returns next iterator
-    } else {
-      // Update segment offset it shall not go backwards
-      so = SRSRAN_MAX(so, it->header.so + it->buf->N_bytes);
-      it++; // Increments iterator
-    }
-  }
-
-  // Check for last segment flag available
-  if (!pdu->segments.back().header.lsf) {
+  // Insert the segment in order of SO, and check for complete
+  pdu->add_segment(segment);
+  if (not pdu->complete()) {
     return false;
   }
 
@@ -1808,23 +1762,23 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
   header.rf   = 0;
   header.p    = 0;
   header.fi   = RLC_FI_FIELD_START_AND_END_ALIGNED;
-  header.sn   = pdu->segments.front().header.sn;
+  header.sn   = pdu->front()->header.sn;
   header.lsf  = 0;
   header.so   = 0;
   header.N_li = 0;
 
   // Reconstruct fi field
-  header.fi |= (pdu->segments.front().header.fi & RLC_FI_FIELD_NOT_START_ALIGNED);
-  header.fi |= (pdu->segments.back().header.fi & RLC_FI_FIELD_NOT_END_ALIGNED);
+  header.fi |= (pdu->front()->header.fi & RLC_FI_FIELD_NOT_START_ALIGNED);
+  header.fi |= (pdu->back()->header.fi & RLC_FI_FIELD_NOT_END_ALIGNED);
 
-  RlcDebug("Starting header reconstruction of %zd segments", pdu->segments.size());
+  RlcDebug("Starting header reconstruction of %zd segments", pdu->size());
 
   // Reconstruct li fields
   uint16_t count          = 0;
   uint16_t carryover      = 0;
   uint16_t consumed_bytes = 0; // rolling sum of all allocated LIs during segment reconstruction
 
-  for (it = pdu->segments.begin(); it != pdu->segments.end(); ++it) {
+  for (const rlc_amd_rx_pdu_segment* it = pdu->front(); it != nullptr; it = it->next) {
     RlcDebug(" Handling %d PDU segments", it->header.N_li);
     for (uint32_t i = 0; i < it->header.N_li; i++) {
       // variable marks total offset of each _processed_ LI of this segment
@@ -1879,8 +1833,7 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
                header.li[header.N_li]);
     }
 
-    tmpit = it;
-    if (rlc_am_end_aligned(it->header.fi) && ++tmpit != pdu->segments.end()) {
+    if (rlc_am_end_aligned(it->header.fi) && it->next != nullptr) {
       RlcDebug("Header is end-aligned, overwrite header.li[%d]=%d", header.N_li, carryover);
       header.li[header.N_li] = carryover;
       header.N_li++;
@@ -1893,7 +1846,7 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
     header.p |= it->header.p;
   }
 
-  RlcDebug("Finished header reconstruction of %zd segments", pdu->segments.size());
+  RlcDebug("Finished header reconstruction of %zd segments", pdu->size());
 
   // Copy data
   unique_byte_buffer_t full_pdu = srsran::make_byte_buffer();
@@ -1906,7 +1859,7 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
     return false;
 #endif
   }
-  for (it = pdu->segments.begin(); it != pdu->segments.end(); it++) {
+  for (const rlc_amd_rx_pdu_segment* it = pdu->front(); it != nullptr; it = it->next) {
     // By default, the segment is not copied. It could be it is fully overlapped with previous segments
     uint32_t overlap = 0;
     uint32_t n       = 0;
@@ -1923,6 +1876,9 @@ bool rlc_am_lte_rx::add_segment_and_check(rlc_amd_rx_pdu_segments_t* pdu, rlc_am
     full_pdu->N_bytes += n;
   }
 
+  // The segments are not needed anymore
+  rx_segments.erase(header.sn);
+
   handle_data_pdu_full(full_pdu->msg, full_pdu->N_bytes, header);
   return true;
 }
@@ -318,4 +318,93 @@ bool rlc_am_not_start_aligned(const uint8_t fi)
   return (fi == RLC_FI_FIELD_NOT_START_ALIGNED || fi == RLC_FI_FIELD_NOT_START_OR_END_ALIGNED);
 }
 
+/****************************************************************************
+ * Rx PDU segments
+ ***************************************************************************/
+
+rlc_amd_rx_pdu_segments_t::rlc_amd_rx_pdu_segments_t(rlc_amd_rx_pdu_segments_t&& other) noexcept :
+  rlc_sn(other.rlc_sn),
+  pool(other.pool),
+  head(other.head),
+  tail(other.tail),
+  nof_segments(other.nof_segments),
+  contiguous_bytes(other.contiguous_bytes)
+{
+  other.head             = nullptr;
+  other.tail             = nullptr;
+  other.nof_segments     = 0;
+  other.contiguous_bytes = 0;
+}
+
+void rlc_amd_rx_pdu_segments_t::add_segment(rlc_amd_rx_pdu_segment* segment)
+{
+  // Find the insertion point, and the highest received byte of the segments before it
+  rlc_amd_rx_pdu_segment* prev     = nullptr;
+  rlc_amd_rx_pdu_segment* it       = head;
+  uint32_t                prev_end = 0;
+  while (it != nullptr and it->header.so < segment->header.so) {
+    prev_end = std::max(prev_end, segment_end(*it));
+    prev     = it;
+    it       = it->next;
+  }
+
+  if (it != nullptr and it->header.so == segment->header.so) {
+    // Same segment offset. Replace if the new one is bigger, ignore otherwise
+    if (segment->buf->N_bytes <= it->buf->N_bytes) {
+      pool->release_segment(segment);
+      return;
+    }
+    segment->next = it->next;
+    if (tail == it) {
+      tail = segment;
+    }
+    pool->release_segment(it);
+    nof_segments--;
+  } else {
+    segment->next = it;
+    if (it == nullptr) {
+      tail = segment;
+    }
+  }
+  (prev == nullptr ? head : prev->next) = segment;
+  nof_segments++;
+
+  if (segment->header.so > contiguous_bytes) {
+    // There is a gap before the new segment
+    return;
+  }
+
+  // Extend the received bytes without gaps. Segments fully overlapped by the previous ones are erased
+  uint32_t so = prev_end;
+  it          = segment;
+  while (it != nullptr and it->header.so <= so) {
+    rlc_amd_rx_pdu_segment* next = it->next;
+    if (segment_end(*it) <= so) {
+      (prev == nullptr ? head : prev->next) = next;
+      if (tail == it) {
+        tail = prev;
+      }
+      pool->release_segment(it);
+      nof_segments--;
+    } else {
+      so   = segment_end(*it);
+      prev = it;
+    }
+    it = next;
+  }
+  contiguous_bytes = so;
+}
+
+void rlc_amd_rx_pdu_segments_t::clear()
+{
+  while (head != nullptr) {
+    rlc_amd_rx_pdu_segment* next = head->next;
+    pool->release_segment(head);
+    head = next;
+  }
+  tail             = nullptr;
+  nof_segments     = 0;
+  contiguous_bytes = 0;
+}
+
 } // namespace srsran
@@ -26,8 +26,8 @@
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/rlc/rlc_am_nr_packing.h"
 #include "srsran/srslog/event_trace.h"
+#include <algorithm>
 #include <iostream>
-#include <set>
 
 namespace srsran {
 
@@ -76,9 +76,17 @@ bool rlc_am_nr_tx::configure(const rlc_config_t& cfg_)
 
   max_hdr_size = min_hdr_size + so_size;
 
-  // make sure Tx queue is empty before attempting to resize
-  empty_queue_no_lock();
-  tx_sdu_queue.resize(cfg_.tx_queue_length);
+  // Status PDUs
+  tx_status = std::unique_ptr<rlc_am_nr_status_pdu_t>(new rlc_am_nr_status_pdu_t(cfg.rx_sn_field_length));
+  rx_status = std::unique_ptr<rlc_am_nr_status_pdu_t>(new rlc_am_nr_status_pdu_t(cfg.tx_sn_field_length));
+
+  // make sure Tx queue is empty before attempting to resize, with PDCP held back from writing to it
+  {
+    std::lock_guard<std::mutex> sdu_lock(sdu_queue_mutex);
+    empty_queue_no_lock();
+    tx_sdu_queue.resize(cfg_.tx_queue_length);
+    tx_sdu_queue.set_watermarks(cfg_.tx_queue_wm_sdus, cfg_.tx_queue_wm_bytes);
+  }
 
   // Check timers are valid
   if (not poll_retransmit_timer.is_valid()) {
@@ -313,9 +321,7 @@ uint32_t rlc_am_nr_tx::build_new_sdu_segment(rlc_amd_tx_pdu_nr& tx_pdu, uint8_t*
   memcpy(&payload[hdr_len], tx_pdu.sdu_buf->msg, segment_payload_len);
 
   // Store Segment Info
-  rlc_amd_tx_pdu_nr::pdu_segment segment_info;
-  segment_info.payload_len = segment_payload_len;
-  tx_pdu.segment_list.push_back(segment_info);
+  tx_pdu.segment_list.push_back(segment_pool.make_node(0, segment_payload_len));
   return hdr_len + segment_payload_len;
 }
 
@@ -412,10 +418,7 @@ uint32_t rlc_am_nr_tx::build_continuation_sdu_segment(rlc_amd_tx_pdu_nr& tx_pdu,
   memcpy(&payload[hdr_len], &tx_pdu.sdu_buf->msg[last_byte], segment_payload_len);
 
   // Store PDU segment info into tx_window
-  rlc_amd_tx_pdu_nr::pdu_segment segment_info = {};
-  segment_info.so                             = last_byte;
-  segment_info.payload_len                    = segment_payload_len;
-  tx_pdu.segment_list.push_back(segment_info);
+  tx_pdu.segment_list.push_back(segment_pool.make_node(last_byte, segment_payload_len));
 
   if (si == rlc_nr_si_field_t::neither_first_nor_last_segment) {
     RlcInfo("grant is not large enough for full SDU."
@@ -452,19 +455,16 @@ uint32_t rlc_am_nr_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
     return 0;
   }
 
-  rlc_amd_retx_nr_t& retx = retx_queue.front();
-
   // Sanity check - drop any retx SNs not present in tx_window
-  while (not tx_window->has_sn(retx.sn)) {
-    RlcInfo("SN=%d not in tx window, probably already ACKed. Skip and remove from retx queue", retx.sn);
+  while (not tx_window->has_sn(retx_queue.front().sn)) {
+    RlcInfo("SN=%d not in tx window, probably already ACKed. Skip and remove from retx queue", retx_queue.front().sn);
     retx_queue.pop();
-    if (!retx_queue.empty()) {
-      retx = retx_queue.front();
-    } else {
+    if (retx_queue.empty()) {
       RlcInfo("empty retx queue, cannot provide any retx PDU");
       return 0;
     }
   }
+  rlc_amd_retx_nr_t& retx = retx_queue.front();
 
   RlcDebug("RETX - SN=%d, is_segment=%s, current_so=%d, so_start=%d, segment_length=%d",
            retx.sn,
@@ -554,6 +554,9 @@ rlc_am_nr_tx::build_retx_pdu_without_segmentation(const rlc_amd_retx_nr_t retx,
   // Update RETX queue. This must be done before calculating
   // the polling bit, to make sure the poll bit is calculated correctly
   retx_queue.pop();
+  if (tx_pdu.nof_queued_retx > 0) {
+    tx_pdu.nof_queued_retx--;
+  }
 
   // Write header to payload
   rlc_am_nr_pdu_header_t new_header = tx_pdu.header;
@@ -663,39 +666,32 @@ uint32_t rlc_am_nr_tx::build_retx_pdu_with_segmentation(rlc_amd_retx_nr_t& retx,
   RlcDebug("Updating RETX segment info. SN=%d, is_segment=%s", retx.sn, retx.is_segment ? "true" : "false");
   if (!retx.is_segment) {
     // Retx is not a segment yet
-    rlc_amd_tx_pdu_nr::pdu_segment seg1 = {};
-    seg1.so                             = retx.current_so;
-    seg1.payload_len                    = retx_pdu_payload_size;
-    rlc_amd_tx_pdu_nr::pdu_segment seg2 = {};
-    seg2.so                             = retx.current_so + retx_pdu_payload_size;
-    seg2.payload_len                    = retx.segment_length - retx_pdu_payload_size;
+    rlc_amd_tx_pdu_nr::pdu_segment* seg1 = segment_pool.make_node(retx.current_so, retx_pdu_payload_size);
+    rlc_amd_tx_pdu_nr::pdu_segment* seg2 = segment_pool.make_node(retx.current_so + retx_pdu_payload_size,
+                                                                  retx.segment_length - retx_pdu_payload_size);
     tx_pdu.segment_list.push_back(seg1);
     tx_pdu.segment_list.push_back(seg2);
-    RlcDebug("New segment: SN=%d, SO=%d len=%d", retx.sn, seg1.so, seg1.payload_len);
-    RlcDebug("New segment: SN=%d, SO=%d len=%d", retx.sn, seg2.so, seg2.payload_len);
+    RlcDebug("New segment: SN=%d, SO=%d len=%d", retx.sn, seg1->so, seg1->payload_len);
+    RlcDebug("New segment: SN=%d, SO=%d len=%d", retx.sn, seg2->so, seg2->payload_len);
   } else {
     // Retx is already a segment
     // Find current segment in segment list.
-    std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator it;
-    for (it = tx_pdu.segment_list.begin(); it != tx_pdu.segment_list.end(); ++it) {
+    auto it = tx_pdu.segment_list.begin();
+    for (; it != tx_pdu.segment_list.end(); ++it) {
       if (it->so == retx.current_so) {
         break;
       }
     }
     if (it != tx_pdu.segment_list.end()) {
-      rlc_amd_tx_pdu_nr::pdu_segment seg1 = {};
-      seg1.so                             = it->so;
-      seg1.payload_len                    = retx_pdu_payload_size;
-      rlc_amd_tx_pdu_nr::pdu_segment seg2 = {};
-      seg2.so                             = it->so + retx_pdu_payload_size;
-      seg2.payload_len                    = it->payload_len - retx_pdu_payload_size;
-
-      std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator begin_it   = tx_pdu.segment_list.erase(it);
-      std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator insert_it  = tx_pdu.segment_list.insert(begin_it, seg2);
-      std::list<rlc_amd_tx_pdu_nr::pdu_segment>::iterator insert_it2 = tx_pdu.segment_list.insert(insert_it, seg1);
+      // Split the current segment in place: it keeps the retransmitted bytes and the rest goes into a new segment
+      rlc_amd_tx_pdu_nr::pdu_segment& seg1 = *it;
+      rlc_amd_tx_pdu_nr::pdu_segment* seg2 =
+          segment_pool.make_node(seg1.so + retx_pdu_payload_size, seg1.payload_len - retx_pdu_payload_size);
+      seg1.payload_len = retx_pdu_payload_size;
+      tx_pdu.segment_list.insert(++it, seg2);
       RlcDebug("Old segment SN=%d, SO=%d len=%d", retx.sn, retx.current_so, retx.segment_length);
       RlcDebug("New segment SN=%d, SO=%d len=%d", retx.sn, seg1.so, seg1.payload_len);
-      RlcDebug("New segment SN=%d, SO=%d len=%d", retx.sn, seg2.so, seg2.payload_len);
+      RlcDebug("New segment SN=%d, SO=%d len=%d", retx.sn, seg2->so, seg2->payload_len);
     } else {
       RlcDebug("Could not find segment. SN=%d, SO=%d length=%d", retx.sn, retx.current_so, retx.segment_length);
     }
@@ -763,8 +759,8 @@ uint32_t rlc_am_nr_tx::get_retx_expected_hdr_len(const rlc_amd_retx_nr_t& retx)
 uint32_t rlc_am_nr_tx::build_status_pdu(byte_buffer_t* payload, uint32_t nof_bytes)
 {
   RlcInfo("generating status PDU. Bytes available:%d", nof_bytes);
-  rlc_am_nr_status_pdu_t status(cfg.rx_sn_field_length); // carries status of RX entity, hence use SN length of RX
-  int                    pdu_len = rx->get_status_pdu(&status, nof_bytes);
+  rlc_am_nr_status_pdu_t& status  = *tx_status; // carries status of RX entity, hence uses SN length of RX
+  int                     pdu_len = rx->get_status_pdu(&status, nof_bytes);
   if (pdu_len == SRSRAN_ERROR) {
     RlcDebug("deferred status PDU. Cause: Failed to acquire rx lock");
     pdu_len = 0;
@@ -787,7 +783,7 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   }
 
   std::lock_guard<std::mutex> lock(mutex);
-  rlc_am_nr_status_pdu_t      status(cfg.tx_sn_field_length);
+  rlc_am_nr_status_pdu_t&     status = *rx_status;
   RlcHexDebug(payload, nof_bytes, "%s Rx control PDU", parent->rb_name);
   rlc_am_nr_read_status_pdu(payload, nof_bytes, cfg.tx_sn_field_length, &status);
   log_rlc_am_nr_status_pdu_to_string(logger.info, "RX status PDU: %s", &status, parent->rb_name);
@@ -858,7 +854,7 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   RlcDebug("Processed status report ACKs. ACK_SN=%d. Tx_Next_Ack=%d", status.ack_sn, st.tx_next_ack);
 
   // Process N_nacks
-  std::set<uint32_t> retx_sn_set; // Set of PDU SNs added for retransmission (no duplicates)
+  retx_sns.clear(); // PDU SNs added for retransmission
   for (uint32_t nack_idx = 0; nack_idx < status.nacks.size(); nack_idx++) {
     if (status.nacks[nack_idx].has_nack_range) {
       for (uint32_t range_sn = status.nacks[nack_idx].nack_sn;
@@ -878,15 +874,18 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
           // Enable has_so only if the offsets do not span the whole SDU
           nack.has_so = (nack.so_start != 0) || (nack.so_end != rlc_status_nack_t::so_end_of_sdu);
         }
-        handle_nack(nack, retx_sn_set);
+        handle_nack(nack, retx_sns);
       }
     } else {
-      handle_nack(status.nacks[nack_idx], retx_sn_set);
+      handle_nack(status.nacks[nack_idx], retx_sns);
     }
   }
+  // Sort and remove duplicates, as the NACKs of several segments of an SDU add its SN more than once
+  std::sort(retx_sns.begin(), retx_sns.end());
+  retx_sns.erase(std::unique(retx_sns.begin(), retx_sns.end()), retx_sns.end());
 
   // Process retx_count and inform upper layers if needed
-  for (uint32_t retx_sn : retx_sn_set) {
+  for (uint32_t retx_sn : retx_sns) {
     auto& pdu = (*tx_window)[retx_sn];
     // Increment retx_count
     if (pdu.retx_count == RETX_COUNT_NOT_STARTED) {
@@ -908,7 +907,7 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   notify_info_vec.clear();
 }
 
-void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>& retx_sn_set)
+void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::vector<uint32_t>& retx_sns)
 {
   if (tx_mod_base_nr(st.tx_next_ack) <= tx_mod_base_nr(nack.nack_sn) &&
       tx_mod_base_nr(nack.nack_sn) <= tx_mod_base_nr(st.tx_next)) {
@@ -925,14 +924,15 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
         bool segment_found = false;
         for (const rlc_amd_tx_pdu_nr::pdu_segment& segm : pdu.segment_list) {
           if (segm.so >= nack.so_start && segm.so <= nack.so_end) {
-            if (not retx_queue.has_sn(nack.nack_sn, segm.so)) {
+            if (pdu.nof_queued_retx == 0 or not retx_queue.has_sn(nack.nack_sn, segm.so)) {
               rlc_amd_retx_nr_t& retx = retx_queue.push();
               retx.sn                 = nack.nack_sn;
               retx.is_segment         = true;
               retx.so_start           = segm.so;
               retx.current_so         = segm.so;
               retx.segment_length     = segm.payload_len;
-              retx_sn_set.insert(nack.nack_sn);
+              pdu.nof_queued_retx++;
+              retx_sns.push_back(nack.nack_sn);
               RlcInfo("Scheduled RETX of SDU segment SN=%d, so_start=%d, segment_length=%d",
                       retx.sn,
                       retx.so_start,
@@ -958,7 +958,7 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
       } else {
         // NACK'ing full SDU.
         // add to retx queue if it's not already there
-        if (not retx_queue.has_sn(nack.nack_sn)) {
+        if (pdu.nof_queued_retx == 0 or not retx_queue.has_sn(nack.nack_sn)) {
           // Have we segmented the SDU already?
           if ((*tx_window)[nack.nack_sn].segment_list.empty()) {
             rlc_amd_retx_nr_t& retx = retx_queue.push();
@@ -967,18 +967,20 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
             retx.so_start           = 0;
             retx.current_so         = 0;
             retx.segment_length     = pdu.sdu_buf->N_bytes;
-            retx_sn_set.insert(nack.nack_sn);
+            pdu.nof_queued_retx++;
+            retx_sns.push_back(nack.nack_sn);
             RlcInfo("Scheduled RETX of SDU SN=%d", retx.sn);
           } else {
             RlcInfo("Scheduled RETX of SDU SN=%d", nack.nack_sn);
-            retx_sn_set.insert(nack.nack_sn);
-            for (auto segm : (*tx_window)[nack.nack_sn].segment_list) {
+            retx_sns.push_back(nack.nack_sn);
+            for (const rlc_amd_tx_pdu_nr::pdu_segment& segm : (*tx_window)[nack.nack_sn].segment_list) {
               rlc_amd_retx_nr_t& retx = retx_queue.push();
               retx.sn                 = nack.nack_sn;
               retx.is_segment         = true;
               retx.so_start           = segm.so;
               retx.current_so         = segm.so;
               retx.segment_length     = segm.payload_len;
+              pdu.nof_queued_retx++;
               RlcInfo("Scheduled RETX of SDU Segment. SN=%d, SO=%d, len=%d", retx.sn, segm.so, segm.payload_len);
             }
           }
@@ -1219,7 +1221,12 @@ void rlc_am_nr_tx::empty_queue_no_lock()
 void rlc_am_nr_tx::stop()
 {
   std::lock_guard<std::mutex> lock(mutex);
-  empty_queue_no_lock();
+  {
+    // Disable PDCP writes before draining, so that no SDU written concurrently is left in the queue
+    std::lock_guard<std::mutex> sdu_lock(sdu_queue_mutex);
+    tx_enabled = false;
+    empty_queue_no_lock();
+  }
 
   if (parent->timers != nullptr && poll_retransmit_timer.is_valid()) {
     poll_retransmit_timer.stop();
@@ -1234,8 +1241,6 @@ void rlc_am_nr_tx::stop()
 
   // Drop all messages in RETX queue
   retx_queue.clear();
-
-  tx_enabled = false;
 }
 
 void rlc_am_nr_tx::timer_expired(uint32_t timeout_id)
@@ -1291,8 +1296,9 @@ void rlc_am_nr_tx::timer_expired(uint32_t timeout_id)
         retx.is_segment     = true;
         retx.so_start       = 0;
         retx.current_so     = 0;
-        retx.segment_length = (*tx_window)[st.tx_next_ack].segment_list.begin()->payload_len;
+        retx.segment_length = (*tx_window)[st.tx_next_ack].segment_list.front().payload_len;
       }
+      (*tx_window)[st.tx_next_ack].nof_queued_retx++;
       RlcDebug("Retransmission because of t-PollRetransmit. RETX SN=%d, is_segment=%s, so_start=%d, segment_length=%d",
                retx.sn,
                retx.is_segment ? "true" : "false",
@@ -1406,6 +1412,7 @@ bool rlc_am_nr_rx::configure(const rlc_config_t& cfg_)
       RlcError("attempt to configure unsupported rx_sn_field_length %s", to_string(cfg.rx_sn_field_length));
       return false;
   }
+  status_len_pdu = std::unique_ptr<rlc_am_nr_status_pdu_t>(new rlc_am_nr_status_pdu_t(cfg.rx_sn_field_length));
 
   RlcDebug("RLC AM NR configured rx entity.");
 
@@ -1682,19 +1689,17 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
   // Add a new SDU to the RX window if necessary
   rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window->has_sn(header.sn) ? (*rx_window)[header.sn] : rx_window->add_pdu(header.sn);
 
-  // Create PDU segment info, to be stored later
-  rlc_amd_rx_pdu_nr pdu_segment = {};
-  pdu_segment.header            = header;
-  pdu_segment.buf               = srsran::make_byte_buffer();
-  if (pdu_segment.buf == nullptr) {
+  // Copy the PDU segment payload, to be stored later
+  unique_byte_buffer_t segment_buf = srsran::make_byte_buffer();
+  if (segment_buf == nullptr) {
     RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
     return SRSRAN_ERROR;
   }
-  memcpy(pdu_segment.buf->msg, payload + hdr_len, nof_bytes - hdr_len); // Don't copy header
-  pdu_segment.buf->N_bytes = nof_bytes - hdr_len;
+  memcpy(segment_buf->msg, payload + hdr_len, nof_bytes - hdr_len); // Don't copy header
+  segment_buf->N_bytes = nof_bytes - hdr_len;
 
   // Store SDU segment. Sort by SO and check for duplicate bytes.
-  insert_received_segment(std::move(pdu_segment), rx_sdu.segments);
+  insert_received_segment(header, std::move(segment_buf), rx_sdu.segments);
 
   // Check weather all segments have been received
   update_segment_inventory(rx_sdu);
@@ -1751,7 +1756,7 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
         RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
         uint32_t last_so         = 0;
         bool     last_segment_rx = false;
-        for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); segm++) {
+        for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); ++segm) {
           if (segm->header.so != last_so) {
             // Some bytes were not received
             rlc_status_nack_t nack;
@@ -1763,7 +1768,7 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
             if (nack.so_start > nack.so_end) {
               // Print segment list
               for (auto segm_it = (*rx_window)[i].segments.begin(); segm_it != (*rx_window)[i].segments.end();
-                   segm_it++) {
+                   ++segm_it) {
                 RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf->N_bytes);
               }
               RlcError("Error: SO_start=%d > SO_end=%d. NACK_SN=%d. SO_start=%d, SO_end=%d, seg.so=%d",
@@ -1836,9 +1841,8 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
 
 uint32_t rlc_am_nr_rx::get_status_pdu_length()
 {
-  rlc_am_nr_status_pdu_t tmp_status(cfg.rx_sn_field_length);
-  get_status_pdu(&tmp_status, UINT32_MAX);
-  return tmp_status.get_packed_size();
+  get_status_pdu(status_len_pdu.get(), UINT32_MAX);
+  return status_len_pdu->get_packed_size();
 }
 
 bool rlc_am_nr_rx::get_do_status()
@@ -1925,10 +1929,26 @@ void rlc_am_nr_rx::write_to_upper_layers(uint32_t lcid, unique_byte_buffer_t sdu
 /*
  * Segment Helpers
  */
-void rlc_am_nr_rx::insert_received_segment(rlc_amd_rx_pdu_nr                                   segment,
-                                           std::set<rlc_amd_rx_pdu_nr, rlc_amd_rx_pdu_nr_cmp>& segment_list) const
+void rlc_am_nr_rx::insert_received_segment(const rlc_am_nr_pdu_header_t&        header,
+                                           unique_byte_buffer_t                 buf,
+                                           rlc_amd_rx_sdu_nr_t::segment_list_t& segment_list)
 {
-  segment_list.insert(std::move(segment));
+  // Segments are usually received in order of SO, so check the back of the list first
+  auto pos = segment_list.end();
+  if (not segment_list.empty() and segment_list.back().header.so >= header.so) {
+    pos = segment_list.begin();
+    while (pos != segment_list.end() and pos->header.so < header.so) {
+      ++pos;
+    }
+    if (pos != segment_list.end() and pos->header.so == header.so) {
+      // Keep the segment received first with this SO
+      return;
+    }
+  }
+  rlc_amd_rx_pdu_nr* segment = segment_pool.make_node();
+  segment->header            = header;
+  segment->buf               = std::move(buf);
+  segment_list.insert(pos, segment);
 }
 
 void rlc_am_nr_rx::update_segment_inventory(rlc_amd_rx_sdu_nr_t& rx_sdu) const
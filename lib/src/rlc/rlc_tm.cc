@@ -51,10 +51,8 @@ bool rlc_tm::configure(const rlc_config_t& cnfg)
 void rlc_tm::empty_queue()
 {
   // Drop all messages in TX queue
-  unique_byte_buffer_t buf;
-  while (ul_queue.try_read(&buf)) {
-  }
-  ul_queue.reset();
+  std::lock_guard<std::mutex> lock(read_mutex);
+  ul_queue.clear();
 }
 
 void rlc_tm::reestablish()
@@ -117,6 +115,16 @@ bool rlc_tm::sdu_queue_is_full()
   return ul_queue.is_full();
 }
 
+bool rlc_tm::sdu_queue_is_congested()
+{
+  return ul_queue.is_congested();
+}
+
+uint32_t rlc_tm::sdu_queue_free_slots()
+{
+  return ul_queue.free_slots();
+}
+
 // MAC interface
 bool rlc_tm::has_data()
 {
@@ -155,7 +163,8 @@ void rlc_tm::reset_metrics()
 
 uint32_t rlc_tm::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  uint32_t pdu_size = ul_queue.size_tail_bytes();
+  std::lock_guard<std::mutex> lock(read_mutex);
+  uint32_t                    pdu_size = ul_queue.size_tail_bytes();
   if (pdu_size > nof_bytes) {
     RlcInfo("Tx PDU size larger than MAC opportunity (%d > %d)", pdu_size, nof_bytes);
     return 0;
@@ -172,15 +181,10 @@ uint32_t rlc_tm::read_pdu(uint8_t* payload, uint32_t nof_bytes)
                ul_queue.size(),
                ul_queue.size_bytes());
 
-    std::lock_guard<std::mutex> lock(metrics_mutex);
+    std::lock_guard<std::mutex> metrics_lock(metrics_mutex);
     metrics.num_tx_pdu_bytes += pdu_size;
     return pdu_size;
   }
-
-  if (ul_queue.size_bytes() > 0) {
-    RlcWarning("Corrupted queue: empty but size_bytes > 0. Resetting queue");
-    ul_queue.reset();
-  }
   return 0;
 }
 
@@ -123,6 +123,16 @@ bool rlc_um_base::sdu_queue_is_full()
   return tx->sdu_queue_is_full();
 }
 
+bool rlc_um_base::sdu_queue_is_congested()
+{
+  return tx->sdu_queue_is_congested();
+}
+
+uint32_t rlc_um_base::sdu_queue_free_slots()
+{
+  return tx->sdu_queue_free_slots();
+}
+
 /****************************************************************************
  * MAC interface
  ***************************************************************************/
@@ -252,6 +262,7 @@ void rlc_um_base::rlc_um_base_tx::reestablish()
 void rlc_um_base::rlc_um_base_tx::empty_queue()
 {
   std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> sdu_lock(sdu_queue_mutex);
 
   // deallocate all SDUs in transmit queue
   while (not tx_sdu_queue.is_empty()) {
@@ -274,6 +285,7 @@ void rlc_um_base::rlc_um_base_tx::set_bsr_callback(bsr_callback_t callback)
 
 void rlc_um_base::rlc_um_base_tx::write_sdu(unique_byte_buffer_t sdu)
 {
+  std::lock_guard<std::mutex> lock(sdu_queue_mutex);
   if (sdu) {
     RlcHexInfo(sdu->msg, sdu->N_bytes, "Tx SDU (%d B, tx_sdu_queue_len=%d)", sdu->N_bytes, tx_sdu_queue.size());
     tx_sdu_queue.write(std::move(sdu));
@@ -284,6 +296,11 @@ void rlc_um_base::rlc_um_base_tx::write_sdu(unique_byte_buffer_t sdu)
 
 int rlc_um_base::rlc_um_base_tx::try_write_sdu(unique_byte_buffer_t sdu)
 {
+  // The bearer may have been stopped after the caller checked it, the queue is not drained again
+  std::lock_guard<std::mutex> lock(sdu_queue_mutex);
+  if (not parent->tx_enabled) {
+    return SRSRAN_ERROR;
+  }
   if (sdu) {
     uint8_t*                                 msg_ptr   = sdu->msg;
     uint32_t                                 nof_bytes = sdu->N_bytes;
@@ -307,15 +324,8 @@ int rlc_um_base::rlc_um_base_tx::try_write_sdu(unique_byte_buffer_t sdu)
 
 void rlc_um_base::rlc_um_base_tx::discard_sdu(uint32_t discard_sn)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
-  bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
-    if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
-      sdu = nullptr;
-    }
-    return false;
-  });
+  std::lock_guard<std::mutex> lock(sdu_queue_mutex);
+  bool                        discarded = tx_sdu_queue.discard(discard_sn);
 
   // Discard fails when the PDCP PDU is already in Tx window.
   RlcInfo("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
@@ -326,6 +336,16 @@ bool rlc_um_base::rlc_um_base_tx::sdu_queue_is_full()
   return tx_sdu_queue.is_full();
 }
 
+bool rlc_um_base::rlc_um_base_tx::sdu_queue_is_congested()
+{
+  return tx_sdu_queue.is_congested();
+}
+
+uint32_t rlc_um_base::rlc_um_base_tx::sdu_queue_free_slots()
+{
+  return tx_sdu_queue.free_slots();
+}
+
 uint32_t rlc_um_base::rlc_um_base_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   unique_byte_buffer_t pdu;
@@ -129,7 +129,12 @@ bool rlc_um_nr::rlc_um_nr_tx::configure(const rlc_config_t& cnfg_, std::string r
   header.so        = 1;
   head_len_segment = rlc_um_nr_packed_length(header);
 
-  tx_sdu_queue.resize(cnfg_.tx_queue_length);
+  {
+    // PDCP is held back from writing to the Tx queue while it is resized
+    std::lock_guard<std::mutex> sdu_lock(sdu_queue_mutex);
+    tx_sdu_queue.resize(cnfg_.tx_queue_length);
+    tx_sdu_queue.set_watermarks(cnfg_.tx_queue_wm_sdus, cnfg_.tx_queue_wm_bytes);
+  }
 
   rb_name = rb_name_;
 
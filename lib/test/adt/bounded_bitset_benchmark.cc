@@ -0,0 +1,202 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/bounded_bitset.h"
+#include "srsran/config.h"
+#include "srsran/support/srsran_test.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <vector>
+
+static uint32_t nof_iterations = 100000;
+
+namespace {
+
+using steady_clock = std::chrono::steady_clock;
+
+/// Bit by bit implementations of the range operations, kept as the benchmark reference
+template <size_t N, bool reversed>
+void legacy_fill(srsran::bounded_bitset<N, reversed>& bitset, size_t start, size_t stop)
+{
+  for (size_t i = start; i < stop; ++i) {
+    bitset.set(i);
+  }
+}
+
+template <size_t N, bool reversed>
+bool legacy_any(const srsran::bounded_bitset<N, reversed>& bitset, size_t start, size_t stop)
+{
+  for (size_t i = start; i < stop; ++i) {
+    if (bitset.test(i)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <size_t N, bool reversed>
+size_t legacy_count(const srsran::bounded_bitset<N, reversed>& bitset)
+{
+  size_t count = 0;
+  for (size_t i = 0; i < bitset.size(); ++i) {
+    count += bitset.test(i) ? 1 : 0;
+  }
+  return count;
+}
+
+/// Start of the first run of "len" empty positions, searched bit by bit
+template <size_t N, bool reversed>
+int legacy_find_empty_run(const srsran::bounded_bitset<N, reversed>& bitset, size_t len)
+{
+  size_t run = 0;
+  for (size_t i = 0; i < bitset.size(); ++i) {
+    run = bitset.test(i) ? 0 : run + 1;
+    if (run == len) {
+      return i + 1 - len;
+    }
+  }
+  return -1;
+}
+
+/// Start of the first run of "len" empty positions, searched a word at a time with find_lowest
+template <size_t N, bool reversed>
+int find_empty_run(const srsran::bounded_bitset<N, reversed>& bitset, size_t len)
+{
+  for (int pos = bitset.find_lowest(0, bitset.size(), false); pos >= 0;) {
+    size_t stop = std::min(bitset.size(), pos + len);
+    int    next = bitset.find_lowest(pos, stop, true);
+    if (next < 0) {
+      return stop - pos == len ? pos : -1;
+    }
+    pos = bitset.find_lowest(next, bitset.size(), false);
+  }
+  return -1;
+}
+
+/// Runs "func" over the set of masks "nof_iterations" times, and returns the average time per call in nanoseconds
+template <typename Bitset, typename Func>
+double measure(const std::vector<Bitset>& masks, Func&& func)
+{
+  size_t sink  = 0;
+  auto   start = steady_clock::now();
+  for (uint32_t i = 0; i < nof_iterations; ++i) {
+    sink += func(masks[i % masks.size()]);
+  }
+  auto end = steady_clock::now();
+  TESTASSERT(sink != std::numeric_limits<size_t>::max());
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / (double)nof_iterations;
+}
+
+void print_result(const char* oper, size_t size, double legacy_ns, double word_ns)
+{
+  printf("%-12s size=%-3zd bit-by-bit=%7.1f ns, word-level=%7.1f ns, speedup=%.1fx\n",
+         oper,
+         size,
+         legacy_ns,
+         word_ns,
+         legacy_ns / word_ns);
+}
+
+} // namespace
+
+/// Benchmarks the bounded_bitset operations used by the schedulers, for an LTE RBG mask and LTE and NR PRB masks
+template <size_t N>
+void run_benchmark(size_t size, std::mt19937& rgen)
+{
+  using bitset_t = srsran::bounded_bitset<N, true>;
+
+  // Masks with a few allocations of random position and length, as the scheduler grids
+  std::vector<bitset_t> masks(64, bitset_t(size));
+  for (bitset_t& mask : masks) {
+    for (uint32_t n = 0; n < 3; ++n) {
+      size_t start = std::uniform_int_distribution<size_t>{0, size - 1}(rgen);
+      size_t stop  = std::uniform_int_distribution<size_t>{start, std::min(size, start + size / 4)}(rgen);
+      mask.fill(start, stop);
+    }
+  }
+  size_t start = size / 8, stop = size - size / 8, len = size / 8;
+
+  // The word-level operations must match the bit by bit ones
+  for (const bitset_t& mask : masks) {
+    TESTASSERT(mask.any(start, stop) == legacy_any(mask, start, stop));
+    TESTASSERT(mask.count() == legacy_count(mask));
+    TESTASSERT(find_empty_run(mask, len) == legacy_find_empty_run(mask, len));
+    bitset_t mask1 = mask, mask2 = mask;
+    mask1.fill(start, stop);
+    legacy_fill(mask2, start, stop);
+    TESTASSERT(mask1 == mask2);
+  }
+
+  print_result("fill",
+               size,
+               measure(masks,
+                       [start, stop](bitset_t m) {
+                         legacy_fill(m, start, stop);
+                         return m.test(start);
+                       }),
+               measure(masks, [start, stop](bitset_t m) { return m.fill(start, stop).test(start); }));
+  print_result("any(range)",
+               size,
+               measure(masks, [start, stop](const bitset_t& m) { return legacy_any(m, start, stop); }),
+               measure(masks, [start, stop](const bitset_t& m) { return m.any(start, stop); }));
+  print_result("count",
+               size,
+               measure(masks, [](const bitset_t& m) { return legacy_count(m); }),
+               measure(masks, [](const bitset_t& m) { return m.count(); }));
+  print_result("empty run",
+               size,
+               measure(masks, [len](const bitset_t& m) { return legacy_find_empty_run(m, len); }),
+               measure(masks, [len](const bitset_t& m) { return find_empty_run(m, len); }));
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [n]\n", prog);
+  printf("\t-n number of iterations per operation [Default %d]\n", nof_iterations);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "n")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_iterations = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  std::mt19937 rgen(0);
+  run_benchmark<25>(25, rgen);
+  run_benchmark<100>(100, rgen);
+  run_benchmark<275>(275, rgen);
+
+  return SRSRAN_SUCCESS;
+}
@@ -278,6 +278,37 @@ void test_bitset_find()
   }
 }
 
+template <bool reversed>
+void test_bitset_range_oper()
+{
+  // Compare the word-level range operations with a bit by bit reference, including ranges that cross word boundaries
+  srsran::bounded_bitset<275, reversed> bitset(275);
+  const size_t                          size = bitset.size();
+  for (size_t start = 0; start < size; start += 7) {
+    for (size_t stop = start; stop <= size; stop += 13) {
+      bitset.reset();
+      bitset.fill(start, stop);
+      TESTASSERT(bitset.count() == stop - start);
+      for (size_t i = 0; i < size; ++i) {
+        TESTASSERT(bitset.test(i) == (i >= start and i < stop));
+      }
+      TESTASSERT(bitset.all(start, stop));
+      TESTASSERT(bitset.any(start, stop) == (stop > start));
+      TESTASSERT(not bitset.any(0, start) and not bitset.any(stop, size));
+      TESTASSERT(bitset.all(0, size) == (start == 0 and stop == size));
+      if (stop > start) {
+        TESTASSERT(bitset.any(stop - 1, stop + (stop < size ? 1 : 0)));
+        TESTASSERT(start == 0 or not bitset.all(start - 1, stop));
+      }
+
+      bitset.flip();
+      bitset.fill(start, stop, false);
+      TESTASSERT(bitset.count() == size - (stop - start));
+      TESTASSERT(not bitset.any(start, stop));
+    }
+  }
+}
+
 int main()
 {
   test_bit_operations();
@@ -289,6 +320,8 @@ int main()
   TESTASSERT(test_bitset_resize() == SRSRAN_SUCCESS);
   test_bitset_find<false>();
   test_bitset_find<true>();
+  test_bitset_range_oper<false>();
+  test_bitset_range_oper<true>();
   printf("Success\n");
   return 0;
 }
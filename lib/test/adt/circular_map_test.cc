@@ -140,6 +140,61 @@ void test_correct_destruction()
   TESTASSERT(C::count == 0);
 }
 
+void test_dyn_id_obj_pool()
+{
+  dyn_id_obj_pool<uint32_t, std::string> pool(3);
+  TESTASSERT(pool.capacity() == 4);
+  TESTASSERT(pool.size() == 0 and pool.empty() and not pool.full());
+  TESTASSERT(not pool.contains(0) and pool.find(0) == nullptr);
+
+  // Fill pool
+  std::vector<uint32_t> ids;
+  for (uint32_t i = 0; i < 4; ++i) {
+    srsran::expected<uint32_t> id = pool.insert(std::to_string(i));
+    TESTASSERT(id.has_value() and id.value() != 0);
+    TESTASSERT(pool.contains(id.value()) and pool[id.value()] == std::to_string(i));
+    ids.push_back(id.value());
+  }
+  TESTASSERT(pool.full() and pool.size() == 4);
+  TESTASSERT(not pool.insert("4").has_value());
+
+  // TEST: IDs of removed objects are not found, even after their slot is reused
+  TESTASSERT(pool.erase(ids[1]));
+  TESTASSERT(not pool.erase(ids[1]));
+  TESTASSERT(not pool.contains(ids[1]) and pool.find(ids[1]) == nullptr);
+  srsran::expected<uint32_t> id = pool.insert("5");
+  TESTASSERT(id.has_value() and id.value() != ids[1]);
+  TESTASSERT((id.value() & 3) == (ids[1] & 3));
+  TESTASSERT(not pool.contains(ids[1]));
+  TESTASSERT(pool.find(id.value()) != nullptr and *pool.find(id.value()) == "5");
+
+  // TEST: Generations wrap around without ever assigning ID 0
+  dyn_id_obj_pool<uint8_t, std::string> small_pool(64);
+  for (uint32_t i = 0; i < 1000; ++i) {
+    srsran::expected<uint8_t> small_id = small_pool.insert(std::to_string(i));
+    TESTASSERT(small_id.has_value() and small_id.value() != 0);
+    TESTASSERT(small_pool.erase(small_id.value()));
+  }
+  TESTASSERT(small_pool.empty());
+
+  pool.clear();
+  TESTASSERT(pool.empty());
+}
+
+void test_dyn_id_obj_pool_destruction()
+{
+  TESTASSERT(C::count == 0);
+  {
+    dyn_id_obj_pool<uint32_t, C> pool(4);
+    uint32_t                     id = pool.insert(C{}).value();
+    pool.insert(C{});
+    TESTASSERT(C::count == 2);
+    TESTASSERT(pool.erase(id));
+    TESTASSERT(C::count == 1);
+  }
+  TESTASSERT(C::count == 0);
+}
+
 } // namespace srsran
 
 int main(int argc, char** argv)
@@ -152,6 +207,8 @@ int main(int argc, char** argv)
   srsran::test_id_map();
   srsran::test_id_map_wraparound();
   srsran::test_correct_destruction();
+  srsran::test_dyn_id_obj_pool();
+  srsran::test_dyn_id_obj_pool_destruction();
 
   printf("Success\n");
   return SRSRAN_SUCCESS;
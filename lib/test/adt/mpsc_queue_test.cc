@@ -0,0 +1,100 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/mpsc_queue.h"
+#include "srsran/common/test_common.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+void test_mpsc_queue_fifo()
+{
+  mpsc_queue<std::unique_ptr<int> > q;
+  TESTASSERT(q.empty());
+  TESTASSERT(q.pop_all([](std::unique_ptr<int>&) {}) == 0);
+
+  // TEST: elements are popped in push order, and move-only types are supported
+  for (int i = 0; i < 10; ++i) {
+    q.emplace(new int(i));
+  }
+  TESTASSERT(not q.empty());
+  int next = 0;
+  TESTASSERT(q.pop_all([&next](std::unique_ptr<int>& v) { TESTASSERT(*v == next++); }) == 10);
+  TESTASSERT(q.empty());
+
+  // TEST: elements pushed by the visitor are left for the next pop
+  q.emplace(new int(0));
+  TESTASSERT(q.pop_all([&q](std::unique_ptr<int>& v) { q.emplace(new int(*v + 1)); }) == 1);
+  TESTASSERT(q.pop_all([](std::unique_ptr<int>& v) { TESTASSERT(*v == 1); }) == 1);
+
+  // TEST: clear discards pending elements
+  q.emplace(new int(5));
+  q.clear();
+  TESTASSERT(q.empty());
+}
+
+void test_mpsc_queue_multiple_producers()
+{
+  const uint32_t nof_producers = 4, nof_pushes = 100000;
+  struct elem_t {
+    uint32_t producer;
+    uint32_t seq;
+  };
+  mpsc_queue<elem_t> q;
+
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&q, p]() {
+      for (uint32_t i = 0; i < nof_pushes; ++i) {
+        q.push(elem_t{p, i});
+      }
+    });
+  }
+
+  // TEST: No element is lost and the elements of each producer are popped in FIFO order
+  std::vector<uint32_t> next_seq(nof_producers, 0);
+  size_t                nof_popped = 0;
+  while (nof_popped < nof_producers * nof_pushes) {
+    nof_popped += q.pop_all([&next_seq](elem_t& e) { TESTASSERT(next_seq[e.producer]++ == e.seq); });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  TESTASSERT(q.empty());
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    TESTASSERT(next_seq[p] == nof_pushes);
+  }
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+
+  srsran::test_mpsc_queue_fifo();
+  srsran::test_mpsc_queue_multiple_producers();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
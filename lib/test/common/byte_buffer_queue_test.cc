@@ -22,6 +22,7 @@
 #define NMSGS 1000000
 
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include <stdio.h>
 
@@ -80,7 +81,90 @@ int test_concurrent_writeread()
   return result;
 }
 
+unique_byte_buffer_t make_sdu(uint32_t pdcp_sn, uint32_t nof_bytes)
+{
+  unique_byte_buffer_t b = srsran::make_byte_buffer();
+  b->N_bytes             = nof_bytes;
+  b->md.pdcp_sn          = pdcp_sn;
+  return b;
+}
+
+int test_discard()
+{
+  byte_buffer_queue    q(4);
+  unique_byte_buffer_t b;
+
+  for (uint32_t sn = 0; sn < 4; sn++) {
+    TESTASSERT(q.try_write(make_sdu(sn, 10 + sn)).has_value());
+  }
+  TESTASSERT(q.is_full());
+  TESTASSERT(not q.try_write(make_sdu(4, 10)).has_value());
+
+  // Discarded SDUs leave the counters at once, but keep their slot until the reader pops them
+  TESTASSERT(q.discard(1));
+  TESTASSERT(not q.discard(1));
+  TESTASSERT(not q.discard(7));
+  TESTASSERT(q.get_n_sdus() == 3);
+  TESTASSERT(q.size_bytes() == 10 + 12 + 13);
+  TESTASSERT(q.size() == 4);
+
+  TESTASSERT(q.size_tail_bytes() == 10);
+  TESTASSERT(q.try_read(&b) and b != nullptr and b->md.pdcp_sn == 0);
+  TESTASSERT(q.size_tail_bytes() == 0);
+  TESTASSERT(q.try_read(&b) and b == nullptr);
+  TESTASSERT(q.try_read(&b) and b != nullptr and b->md.pdcp_sn == 2);
+
+  // An SDU already read cannot be discarded
+  TESTASSERT(not q.discard(2));
+  q.clear();
+  TESTASSERT(q.is_empty() and q.get_n_sdus() == 0 and q.size_bytes() == 0);
+  return SRSRAN_SUCCESS;
+}
+
+int test_watermarks()
+{
+  byte_buffer_queue    q(16);
+  unique_byte_buffer_t b;
+
+  // Without watermarks, only a full queue is congested
+  for (uint32_t sn = 0; sn < 16; sn++) {
+    TESTASSERT(not q.is_congested());
+    q.write(make_sdu(sn, 100));
+  }
+  TESTASSERT(q.is_congested());
+  q.clear();
+
+  // SDU watermark, with the congestion clearing at half of it
+  q.set_watermarks(8, 0);
+  for (uint32_t sn = 0; sn < 8; sn++) {
+    TESTASSERT(not q.is_congested());
+    q.write(make_sdu(sn, 100));
+  }
+  TESTASSERT(q.is_congested());
+  for (uint32_t i = 0; i < 3; i++) {
+    b = q.read();
+    TESTASSERT(q.is_congested());
+  }
+  b = q.read();
+  TESTASSERT(not q.is_congested());
+  q.clear();
+
+  // Byte watermark
+  q.set_watermarks(0, 1000);
+  q.write(make_sdu(0, 600));
+  TESTASSERT(not q.is_congested());
+  q.write(make_sdu(1, 400));
+  TESTASSERT(q.is_congested());
+  TESTASSERT(q.discard(1));
+  TESTASSERT(q.is_congested());
+  b = q.read();
+  TESTASSERT(not q.is_congested());
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
+  TESTASSERT(test_discard() == SRSRAN_SUCCESS);
+  TESTASSERT(test_watermarks() == SRSRAN_SUCCESS);
   return test_concurrent_writeread();
 }
@@ -130,6 +130,60 @@ int test_socket_handler()
   return 0;
 }
 
+int test_batched_udp_socket_handler()
+{
+  auto& logger = srslog::fetch_basic_logger("GTPU", false);
+
+  std::atomic<int> counter = {0};
+  std::atomic<int> errors  = {0};
+
+  srsran::unique_socket  server_socket, client_socket;
+  srsran::socket_manager sockhandler;
+  int                    server_port = 2152;
+  const char*            server_addr = "127.0.100.1";
+  using namespace srsran::net_utils;
+
+  TESTASSERT(server_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(server_socket.bind_addr(server_addr, server_port));
+  TESTASSERT(client_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(client_socket.bind_addr("127.0.0.1", 0));
+
+  // register server Rx handler with a batch smaller than the burst
+  auto pdu_handler = [&counter, &errors](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+    // datagrams arrive in order and with the length they were sent with
+    if (pdu->N_bytes != (uint32_t)counter + 1 or pdu->msg[0] != counter) {
+      errors++;
+    }
+    counter++;
+  };
+  rx_thread_tester rx_tester;
+  sockhandler.add_socket_handler(server_socket.fd(),
+                                 srsran::make_batched_sdu_handler(logger, rx_tester.task_queue, pdu_handler, 4));
+
+  uint8_t     buf[128]      = {};
+  int32_t     nof_counts    = 50;
+  sockaddr_in server_addrin = server_socket.get_addr_in();
+  for (int32_t i = 0; i < nof_counts; ++i) {
+    buf[0]         = i;
+    ssize_t n_sent = sendto(client_socket.fd(), buf, i + 1, 0, (struct sockaddr*)&server_addrin, sizeof(server_addrin));
+    TESTASSERT(n_sent == i + 1);
+  }
+
+  uint32_t time_elapsed = 0;
+  while (counter != nof_counts) {
+    usleep(100);
+    time_elapsed += 100;
+    if (time_elapsed > 3000000) {
+      // too much time has passed
+      return -1;
+    }
+  }
+  TESTASSERT(errors == 0);
+  TESTASSERT(sockhandler.remove_socket(server_socket.fd()));
+
+  return 0;
+}
+
 int test_sctp_bind_error()
 {
   srsran::unique_socket sock;
@@ -157,6 +211,7 @@ int main()
   srslog::init();
 
   TESTASSERT(test_socket_handler() == 0);
+  TESTASSERT(test_batched_udp_socket_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
 
   return 0;
@@ -24,6 +24,7 @@
 #include <sys/time.h>
 
 #include "srsran/common/liblte_security.h"
+#include "srsran/common/s3g.h"
 #include "srsran/common/test_common.h"
 #include "srsran/srsran.h"
 
@@ -43,6 +44,47 @@ int32 arrcmp(uint8_t const* const a, uint8_t const* const b, uint32 len)
   return 0;
 }
 
+/*
+ * Runs the test vector through every lane of the multi-buffer keystream
+ * generator. Lane l outputs a prefix of (l + 1) / S3G_NOF_LANES of the
+ * keystream, which must match msg ^ ct.
+ */
+int test_multi_lane(uint8_t* key,
+                    uint32_t count,
+                    uint8_t  bearer,
+                    uint8_t  direction,
+                    uint8_t* msg,
+                    uint8_t* ct,
+                    uint32_t len_bits)
+{
+  uint32_t  k[S3G_NOF_LANES][4];
+  uint32_t  iv[S3G_NOF_LANES][4];
+  uint32_t  n[S3G_NOF_LANES];
+  uint32_t* ks[S3G_NOF_LANES];
+  uint32_t  nof_words = (len_bits + 31) / 32;
+
+  for (uint32_t l = 0; l < S3G_NOF_LANES; l++) {
+    s3g_load_key(key, k[l]);
+    iv[l][3] = count;
+    iv[l][2] = ((bearer & 0x1F) << 27) | ((direction & 0x01) << 26);
+    iv[l][1] = iv[l][3];
+    iv[l][0] = iv[l][2];
+    n[l]     = nof_words * (l + 1) / S3G_NOF_LANES;
+    ks[l]    = (uint32_t*)calloc(nof_words, sizeof(uint32_t));
+  }
+
+  s3g_generate_keystream_multi(k, iv, n, ks);
+
+  for (uint32_t l = 0; l < S3G_NOF_LANES; l++) {
+    uint32_t nof_bytes = SRSRAN_MIN(n[l] * 4, len_bits / 8);
+    for (uint32_t i = 0; i < nof_bytes; i++) {
+      TESTASSERT(((ks[l][i / 4] >> ((3 - (i % 4)) * 8)) & 0xFF) == (uint32_t)(msg[i] ^ ct[i]));
+    }
+    free(ks[l]);
+  }
+  return SRSRAN_SUCCESS;
+}
+
 /*
  * Tests
  *
@@ -84,6 +126,8 @@ int test_set_1()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -129,6 +173,8 @@ int test_set_2()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -168,6 +214,8 @@ int test_set_3()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -217,6 +265,8 @@ int test_set_4()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -270,6 +320,8 @@ int test_set_5()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -369,6 +421,8 @@ int test_set_6()
   err_cmp = arrcmp(msg, out, len_bytes);
   TESTASSERT(err_cmp == 0);
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
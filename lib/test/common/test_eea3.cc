@@ -23,6 +23,7 @@
 #include <stdlib.h>
 
 #include "srsran/common/liblte_security.h"
+#include "srsran/common/zuc.h"
 #include "srsran/common/test_common.h"
 #include "srsran/srsran.h"
 
@@ -38,6 +39,52 @@ int32 arrcmp(uint8_t const* const a, uint8_t const* const b, uint32 len)
   return 0;
 }
 
+/*
+ * Runs the test vector through every lane of the multi-buffer keystream
+ * generator. Lane l outputs a prefix of (l + 1) / ZUC_NOF_LANES of the
+ * keystream, which must match msg ^ ct.
+ */
+int test_multi_lane(uint8_t* key,
+                    uint32_t count,
+                    uint8_t  bearer,
+                    uint8_t  direction,
+                    uint8_t* msg,
+                    uint8_t* ct,
+                    uint32_t len_bits)
+{
+  const uint8_t* k[ZUC_NOF_LANES];
+  uint8_t        iv[ZUC_NOF_LANES][16];
+  uint32_t       n[ZUC_NOF_LANES];
+  uint32_t*      ks[ZUC_NOF_LANES];
+  uint32_t       nof_words = (len_bits + 31) / 32;
+
+  for (uint32_t l = 0; l < ZUC_NOF_LANES; l++) {
+    k[l]     = key;
+    iv[l][0] = (count >> 24) & 0xFF;
+    iv[l][1] = (count >> 16) & 0xFF;
+    iv[l][2] = (count >> 8) & 0xFF;
+    iv[l][3] = count & 0xFF;
+    iv[l][4] = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
+    iv[l][5] = iv[l][6] = iv[l][7] = 0;
+    for (uint32_t i = 0; i < 8; i++) {
+      iv[l][8 + i] = iv[l][i];
+    }
+    n[l]  = nof_words * (l + 1) / ZUC_NOF_LANES;
+    ks[l] = (uint32_t*)calloc(nof_words, sizeof(uint32_t));
+  }
+
+  zuc_generate_keystream_multi(k, iv, n, ks);
+
+  for (uint32_t l = 0; l < ZUC_NOF_LANES; l++) {
+    uint32_t nof_bytes = SRSRAN_MIN(n[l] * 4, len_bits / 8);
+    for (uint32_t i = 0; i < nof_bytes; i++) {
+      TESTASSERT(((ks[l][i / 4] >> ((3 - (i % 4)) * 8)) & 0xFF) == (uint32_t)(msg[i] ^ ct[i]));
+    }
+    free(ks[l]);
+  }
+  return SRSRAN_SUCCESS;
+}
+
 /*
  * Tests
  *
@@ -95,6 +142,8 @@ int test_set_1()
     printf("Test Set 1 Decryption: Failed\n");
   }
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -155,6 +204,8 @@ int test_set_2()
     printf("Test Set 2 Decryption: Failed\n");
   }
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -228,6 +279,8 @@ int test_set_3()
     printf("Test Set 3 Decryption: Failed\n");
   }
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -317,6 +370,8 @@ int test_set_4()
     printf("Test Set 4 Decryption: Failed\n");
   }
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
@@ -422,6 +477,8 @@ int test_set_5()
     printf("Test Set 5 Decryption: Failed\n");
   }
 
+  TESTASSERT(test_multi_lane(key, count, bearer, direction, msg, ct, len_bits) == SRSRAN_SUCCESS);
+
   free(out);
   return SRSRAN_SUCCESS;
 }
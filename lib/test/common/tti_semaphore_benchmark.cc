@@ -0,0 +1,204 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/tti_sempahore.h"
+#include "srsran/config.h"
+#include "srsran/support/srsran_test.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <getopt.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static uint32_t nof_iterations = 20000;
+static uint32_t nof_workers    = 4;
+static uint32_t work_us        = 0;
+
+namespace {
+
+/// Mutex and condition variable implementation of the TTI semaphore, kept as the benchmark reference
+template <class T>
+class legacy_tti_semaphore
+{
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  std::deque<T>           fifo;
+
+public:
+  void wait(T id)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (not fifo.empty() and fifo.front() != id) {
+      cvar.wait(lock);
+    }
+  }
+  void push(T id)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    fifo.push_back(id);
+  }
+  void release()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (not fifo.empty()) {
+      fifo.pop_front();
+    }
+    cvar.notify_all();
+  }
+  void wait_all()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (not fifo.empty()) {
+      cvar.wait(lock);
+    }
+  }
+};
+
+using steady_clock = std::chrono::steady_clock;
+
+int64_t now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+/// Busy waits in the calling thread, emulates the processing of a TTI
+void busy_wait_us(uint32_t us)
+{
+  auto end = steady_clock::now() + std::chrono::microseconds(us);
+  while (steady_clock::now() < end) {
+  }
+}
+
+} // namespace
+
+/**
+ * The workers pass the semaphore around in TTI order. The wake-up latency is the time between the release of TTI n
+ * and the return of the wait of TTI n + 1 in another thread.
+ */
+template <class semaphore_t>
+std::vector<int64_t> run_benchmark()
+{
+  semaphore_t           sem;
+  std::atomic<int64_t>  release_ns = {0};
+  std::atomic<uint32_t> next_tti   = {0};
+  std::atomic<uint32_t> nof_pushed = {0};
+  std::vector<int64_t>  latencies(nof_iterations);
+
+  auto worker_func = [&](uint32_t worker_id) {
+    for (uint32_t tti = worker_id; tti < nof_iterations; tti += nof_workers) {
+      // The TTI is dispatched to the worker after it was enqueued, as the PHY does
+      while (nof_pushed.load(std::memory_order_acquire) <= tti) {
+        std::this_thread::yield();
+      }
+
+      busy_wait_us(work_us);
+      sem.wait(tti);
+      int64_t wake_ns = now_ns();
+
+      // The semaphore must hand over in TTI order
+      TESTASSERT(next_tti.load(std::memory_order_relaxed) == tti);
+      latencies[tti] = (tti == 0) ? 0 : wake_ns - release_ns.load(std::memory_order_relaxed);
+      next_tti.store(tti + 1, std::memory_order_relaxed);
+
+      release_ns.store(now_ns(), std::memory_order_relaxed);
+      sem.release();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    workers.emplace_back(worker_func, i);
+  }
+  for (uint32_t tti = 0; tti < nof_iterations; tti++) {
+    sem.push(tti);
+    nof_pushed.store(tti + 1, std::memory_order_release);
+  }
+
+  sem.wait_all();
+  for (std::thread& t : workers) {
+    t.join();
+  }
+  TESTASSERT(next_tti == nof_iterations);
+
+  latencies.erase(latencies.begin());
+  std::sort(latencies.begin(), latencies.end());
+  return latencies;
+}
+
+void print_latencies(const char* name, const std::vector<int64_t>& latencies)
+{
+  if (latencies.empty()) {
+    return;
+  }
+  auto percentile = [&latencies](double p) {
+    return latencies[std::min(latencies.size() - 1, (size_t)(p * latencies.size()))] / 1000.0;
+  };
+  printf("%-10s wake-up latency (us): p50=%.2f p90=%.2f p99=%.2f p99.9=%.2f max=%.2f\n",
+         name,
+         percentile(0.5),
+         percentile(0.9),
+         percentile(0.99),
+         percentile(0.999),
+         latencies.back() / 1000.0);
+}
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nwt]\n", prog);
+  printf("\t-n number of TTIs [Default %d]\n", nof_iterations);
+  printf("\t-w number of workers [Default %d]\n", nof_workers);
+  printf("\t-t processing time of each TTI in microseconds [Default %d]\n", work_us);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nwt")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_iterations = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'w':
+        nof_workers = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 't':
+        work_us = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  printf("%d TTIs, %d workers, %d us per TTI\n", nof_iterations, nof_workers, work_us);
+  print_latencies("mutex", run_benchmark<legacy_tti_semaphore<uint32_t> >());
+  print_latencies("lock-free", run_benchmark<srsran::tti_semaphore<uint32_t> >());
+
+  return SRSRAN_SUCCESS;
+}
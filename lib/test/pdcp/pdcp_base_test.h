@@ -30,6 +30,7 @@
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/interfaces/ue_rlc_interfaces.h"
 #include <iostream>
+#include <limits>
 
 int compare_two_packets(const srsran::unique_byte_buffer_t& msg1, const srsran::unique_byte_buffer_t& msg2)
 {
@@ -74,7 +75,8 @@ private:
   srsran::unique_byte_buffer_t last_pdcp_pdu;
 
   bool rb_is_um(uint32_t lcid) { return false; }
-  bool sdu_queue_is_full(uint32_t lcid) { return false; };
+  bool     sdu_queue_is_full(uint32_t lcid) { return false; };
+  uint32_t sdu_queue_free_slots(uint32_t lcid) { return std::numeric_limits<uint32_t>::max(); }
 };
 
 class rrc_dummy : public srsue::rrc_interface_pdcp
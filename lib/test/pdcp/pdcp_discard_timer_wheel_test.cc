@@ -0,0 +1,244 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/upper/pdcp_discard_timer_wheel.h"
+#include <map>
+
+/// Records the time at which the discard timer of each SN expires
+struct expiry_recorder {
+  uint32_t                     now = 0;
+  std::map<uint32_t, uint32_t> expiries;
+  uint32_t                     nof_expiries = 0;
+
+  srsran::pdcp_discard_timer_wheel::expiry_callback_t callback()
+  {
+    return [this](uint32_t sn) {
+      expiries[sn] = now;
+      nof_expiries++;
+    };
+  }
+};
+
+static void run_ms(srsran::task_scheduler& task_sched, expiry_recorder& rec, uint32_t nof_ms)
+{
+  for (uint32_t i = 0; i < nof_ms; ++i) {
+    rec.now++;
+    task_sched.tic();
+  }
+}
+
+int test_expiry_bounds()
+{
+  for (uint32_t timeout : {1U, 10U, 50U, 100U, 300U, 1500U}) {
+    srsran::task_scheduler           task_sched{5, 0};
+    srsran::pdcp_discard_timer_wheel timers;
+    expiry_recorder                  rec;
+    timers.init(&task_sched, timeout, 4096, rec.callback());
+
+    // Start timers at every msec of the first timeout, so that they fall anywhere within a bucket
+    std::map<uint32_t, uint32_t> starts;
+    for (uint32_t sn = 0; sn < timeout + 3; ++sn) {
+      TESTASSERT(timers.start(sn));
+      starts[sn] = rec.now;
+      run_ms(task_sched, rec, 1);
+    }
+    TESTASSERT(timers.nof_running() + rec.nof_expiries == timeout + 3);
+    run_ms(task_sched, rec, 2 * timeout + 2);
+
+    // A timer never expires early, and at most timeout / 64 late
+    TESTASSERT(timers.nof_running() == 0);
+    TESTASSERT(rec.expiries.size() == timeout + 3);
+    for (const auto& e : rec.expiries) {
+      uint32_t elapsed = e.second - starts[e.first];
+      TESTASSERT(elapsed >= timeout);
+      TESTASSERT(elapsed <= timeout + timeout / 64);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_stop_restart()
+{
+  srsran::task_scheduler           task_sched{5, 0};
+  srsran::pdcp_discard_timer_wheel timers;
+  expiry_recorder                  rec;
+  const uint32_t                   timeout = 100;
+  timers.init(&task_sched, timeout, 4096, rec.callback());
+
+  // A running timer can't be started twice
+  TESTASSERT(timers.start(5));
+  TESTASSERT(not timers.start(5));
+  TESTASSERT(timers.is_running(5));
+  TESTASSERT(timers.start(6));
+
+  // Stopped timers don't expire
+  run_ms(task_sched, rec, 50);
+  TESTASSERT(timers.stop(5));
+  TESTASSERT(not timers.stop(5));
+  TESTASSERT(not timers.is_running(5));
+  TESTASSERT(timers.nof_running() == 1);
+
+  // A restarted timer expires one timeout after the restart, while the bucket of the first start is skipped
+  TESTASSERT(timers.start(5));
+  uint32_t restart = rec.now;
+  run_ms(task_sched, rec, timeout - 1);
+  TESTASSERT(rec.nof_expiries == 1);
+  TESTASSERT(rec.expiries.count(6) == 1);
+  TESTASSERT(timers.is_running(5));
+  run_ms(task_sched, rec, timeout);
+  TESTASSERT(rec.nof_expiries == 2);
+  TESTASSERT(rec.expiries[5] - restart >= timeout);
+  TESTASSERT(rec.expiries[5] - restart <= timeout + timeout / 64);
+
+  // Stopping all the timers stops the bearer timer, new timers run from the current time
+  TESTASSERT(timers.start(7));
+  run_ms(task_sched, rec, 10);
+  TESTASSERT(timers.stop(7));
+  TESTASSERT(timers.nof_running() == 0);
+  run_ms(task_sched, rec, 3 * timeout);
+  TESTASSERT(rec.nof_expiries == 2);
+  TESTASSERT(timers.start(7));
+  uint32_t start = rec.now;
+  run_ms(task_sched, rec, 2 * timeout);
+  TESTASSERT(rec.nof_expiries == 3);
+  TESTASSERT(rec.expiries[7] - start >= timeout);
+
+  // clear() stops all the timers
+  for (uint32_t sn = 0; sn < 10; ++sn) {
+    TESTASSERT(timers.start(sn));
+  }
+  timers.clear();
+  TESTASSERT(timers.nof_running() == 0);
+  run_ms(task_sched, rec, 2 * timeout);
+  TESTASSERT(rec.nof_expiries == 3);
+  return SRSRAN_SUCCESS;
+}
+
+int test_grow_slots()
+{
+  srsran::task_scheduler           task_sched{5, 0};
+  srsran::pdcp_discard_timer_wheel timers;
+  expiry_recorder                  rec;
+  const uint32_t                   timeout = 50;
+  timers.init(&task_sched, timeout, 1U << 18U, rec.callback());
+
+  // More running timers than the initial slots, with some already stopped when the slots grow
+  const uint32_t nof_sns = 10000;
+  for (uint32_t sn = 0; sn < nof_sns; ++sn) {
+    TESTASSERT(timers.start(sn));
+    if (sn % 3 == 0) {
+      TESTASSERT(timers.stop(sn));
+    }
+    if (sn % 1000 == 999) {
+      run_ms(task_sched, rec, 1);
+    }
+  }
+  TESTASSERT(timers.nof_running() == nof_sns - (nof_sns + 2) / 3);
+  for (uint32_t sn = 0; sn < nof_sns; ++sn) {
+    TESTASSERT(timers.is_running(sn) == (sn % 3 != 0));
+  }
+
+  run_ms(task_sched, rec, 2 * timeout);
+  TESTASSERT(timers.nof_running() == 0);
+  TESTASSERT(rec.nof_expiries == nof_sns - (nof_sns + 2) / 3);
+  for (uint32_t sn = 0; sn < nof_sns; ++sn) {
+    TESTASSERT(rec.expiries.count(sn) == (sn % 3 != 0 ? 1 : 0));
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_slot_collision()
+{
+  srsran::task_scheduler           task_sched{5, 0};
+  srsran::pdcp_discard_timer_wheel timers;
+  expiry_recorder                  rec;
+  const uint32_t                   timeout = 50;
+
+  // The capacity is rounded up to a power of 2, SNs that are a multiple of it apart share the same slot
+  timers.init(&task_sched, timeout, 1000, rec.callback());
+  TESTASSERT(timers.start(3));
+  TESTASSERT(not timers.start(3 + 1024));
+  TESTASSERT(not timers.is_running(3 + 1024));
+  TESTASSERT(timers.start(3 + 1023));
+  TESTASSERT(timers.nof_running() == 2);
+
+  // Once the timer in the slot is stopped, the other SN can use it
+  TESTASSERT(timers.stop(3));
+  TESTASSERT(timers.start(3 + 1024));
+  run_ms(task_sched, rec, 2 * timeout);
+  TESTASSERT(rec.nof_expiries == 2);
+  TESTASSERT(rec.expiries.count(3) == 0);
+  TESTASSERT(rec.expiries.count(3 + 1024) == 1);
+  return SRSRAN_SUCCESS;
+}
+
+int test_reconfiguration()
+{
+  srsran::task_scheduler           task_sched{5, 0};
+  srsran::pdcp_discard_timer_wheel timers;
+  expiry_recorder                  rec;
+  TESTASSERT(not timers.start(0));
+  timers.init(&task_sched, 100, 4096, rec.callback());
+  TESTASSERT(timers.start(0));
+  TESTASSERT(timers.start(1));
+
+  // Same timeout and capacity, the running timers are kept
+  timers.init(&task_sched, 100, 4096, rec.callback());
+  TESTASSERT(timers.nof_running() == 2);
+  TESTASSERT(timers.is_running(0));
+
+  // New timeout, the running timers are stopped and the new ones use it
+  run_ms(task_sched, rec, 10);
+  timers.init(&task_sched, 20, 4096, rec.callback());
+  TESTASSERT(timers.nof_running() == 0);
+  TESTASSERT(timers.get_timeout() == 20);
+  TESTASSERT(timers.start(1));
+  uint32_t start = rec.now;
+  run_ms(task_sched, rec, 200);
+  TESTASSERT(rec.nof_expiries == 1);
+  TESTASSERT(rec.expiries[1] - start == 20);
+
+  // Reset, no timer can be started until the next init
+  TESTASSERT(timers.start(2));
+  timers.reset();
+  TESTASSERT(not timers.is_init());
+  TESTASSERT(not timers.start(3));
+  run_ms(task_sched, rec, 200);
+  TESTASSERT(rec.nof_expiries == 1);
+  timers.init(&task_sched, 100, 4096, rec.callback());
+  TESTASSERT(timers.start(3));
+  run_ms(task_sched, rec, 200);
+  TESTASSERT(rec.nof_expiries == 2);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  TESTASSERT(test_expiry_bounds() == SRSRAN_SUCCESS);
+  TESTASSERT(test_stop_restart() == SRSRAN_SUCCESS);
+  TESTASSERT(test_grow_slots() == SRSRAN_SUCCESS);
+  TESTASSERT(test_slot_collision() == SRSRAN_SUCCESS);
+  TESTASSERT(test_reconfiguration() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
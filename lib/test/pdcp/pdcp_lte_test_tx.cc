@@ -0,0 +1,184 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "pdcp_lte_test.h"
+
+// RLC dummy that keeps all the PDUs written by the PDCP
+class rlc_recorder : public rlc_dummy
+{
+public:
+  explicit rlc_recorder(srslog::basic_logger& logger) : rlc_dummy(logger) {}
+
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) override
+  {
+    TESTASSERT(pdus.size() < queue_size);
+    pdus.push_back(std::move(sdu));
+  }
+  bool     sdu_queue_is_full(uint32_t lcid) override { return pdus.size() >= queue_size; }
+  uint32_t sdu_queue_free_slots(uint32_t lcid) override { return queue_size - pdus.size(); }
+
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+  uint32_t                                  queue_size = std::numeric_limits<uint32_t>::max();
+};
+
+srsran::unique_byte_buffer_t make_sdu(uint32_t i)
+{
+  srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  uint32_t                     len = 1 + (i * 97) % 1500;
+  for (uint32_t j = 0; j < len; ++j) {
+    sdu->msg[j] = (uint8_t)(i + 3 * j);
+  }
+  sdu->N_bytes = len;
+  return sdu;
+}
+
+// Writes the SDUs into a DRB one by one or as one batch, and returns the PDUs written into the RLC
+std::vector<srsran::unique_byte_buffer_t> tx_pdus(const std::vector<srsran::unique_byte_buffer_t>& sdus,
+                                                  const srsran::as_security_config_t&              sec_cfg_,
+                                                  const srsran::pdcp_lte_state_t&                  init_state,
+                                                  bool                                             batch,
+                                                  srslog::basic_logger&                            logger)
+{
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::infinity,
+                               false,
+                               srsran::srsran_rat_t::lte};
+
+  rlc_recorder            rlc(logger);
+  rrc_dummy               rrc(logger);
+  gw_dummy                gw(logger);
+  srsue::stack_test_dummy stack;
+  srsran::pdcp_entity_lte pdcp(&rlc, &rrc, &gw, &stack.task_sched, logger, 3);
+  pdcp.configure(cfg);
+  pdcp.config_security(sec_cfg_);
+  pdcp.enable_encryption(srsran::DIRECTION_TXRX);
+  pdcp.set_bearer_state(init_state, false);
+
+  std::vector<srsran::unique_byte_buffer_t> copies;
+  for (const srsran::unique_byte_buffer_t& sdu : sdus) {
+    copies.push_back(srsran::make_byte_buffer());
+    *copies.back() = *sdu;
+  }
+  if (batch) {
+    pdcp.write_sdus(copies);
+  } else {
+    for (srsran::unique_byte_buffer_t& sdu : copies) {
+      pdcp.write_sdu(std::move(sdu));
+    }
+  }
+  return std::move(rlc.pdus);
+}
+
+// A batch of SDUs ciphered in one call gives the same PDUs as SDUs written one by one, also across an HFN increment
+int test_tx_batch(srslog::basic_logger& logger)
+{
+  std::vector<srsran::unique_byte_buffer_t> sdus;
+  for (uint32_t i = 0; i < 21; ++i) {
+    sdus.push_back(make_sdu(i));
+  }
+
+  srsran::pdcp_lte_state_t init_state = {};
+  init_state.next_pdcp_tx_sn          = 4085;
+  init_state.tx_hfn                   = 7;
+
+  for (srsran::CIPHERING_ALGORITHM_ID_ENUM algo : {srsran::CIPHERING_ALGORITHM_ID_EEA0,
+                                                   srsran::CIPHERING_ALGORITHM_ID_128_EEA1,
+                                                   srsran::CIPHERING_ALGORITHM_ID_128_EEA2,
+                                                   srsran::CIPHERING_ALGORITHM_ID_128_EEA3}) {
+    srsran::as_security_config_t algo_sec_cfg = sec_cfg;
+    algo_sec_cfg.cipher_algo                  = algo;
+
+    std::vector<srsran::unique_byte_buffer_t> expected = tx_pdus(sdus, algo_sec_cfg, init_state, false, logger);
+    std::vector<srsran::unique_byte_buffer_t> batched  = tx_pdus(sdus, algo_sec_cfg, init_state, true, logger);
+    TESTASSERT(expected.size() == sdus.size());
+    TESTASSERT(batched.size() == sdus.size());
+    for (uint32_t i = 0; i < sdus.size(); ++i) {
+      TESTASSERT(batched[i]->N_bytes == sdus[i]->N_bytes + 2);
+      TESTASSERT(batched[i]->md.pdcp_sn == (init_state.next_pdcp_tx_sn + i) % 4096);
+      TESTASSERT(compare_two_packets(batched[i], expected[i]) == 0);
+      if (algo != srsran::CIPHERING_ALGORITHM_ID_EEA0) {
+        TESTASSERT(memcmp(&batched[i]->msg[2], sdus[i]->msg, sdus[i]->N_bytes) != 0);
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+// A batch larger than the free space of the RLC queue only numbers and stores the SDUs that fit, without SN gaps
+int test_tx_batch_full_queue(srslog::basic_logger& logger)
+{
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::infinity,
+                               false,
+                               srsran::srsran_rat_t::lte};
+
+  rlc_recorder            rlc(logger);
+  rrc_dummy               rrc(logger);
+  gw_dummy                gw(logger);
+  srsue::stack_test_dummy stack;
+  srsran::pdcp_entity_lte pdcp(&rlc, &rrc, &gw, &stack.task_sched, logger, 3);
+  pdcp.configure(cfg);
+  pdcp.config_security(sec_cfg);
+  pdcp.enable_encryption(srsran::DIRECTION_TXRX);
+
+  rlc.queue_size = 5;
+  for (uint32_t batch = 0; batch < 3; ++batch) {
+    std::vector<srsran::unique_byte_buffer_t> sdus;
+    for (uint32_t i = 0; i < 8; ++i) {
+      sdus.push_back(make_sdu(i));
+    }
+    pdcp.write_sdus(sdus);
+    rlc.queue_size += 4;
+  }
+
+  // Each batch only fits 4 SDUs, except the first one, which fits 5
+  TESTASSERT(rlc.pdus.size() == 13);
+  for (uint32_t i = 0; i < rlc.pdus.size(); ++i) {
+    TESTASSERT(rlc.pdus[i]->md.pdcp_sn == i);
+  }
+  srsran::pdcp_lte_state_t state;
+  pdcp.get_bearer_state(&state);
+  TESTASSERT(state.next_pdcp_tx_sn == 13);
+  TESTASSERT(pdcp.get_buffered_pdus().size() == 13);
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  auto& logger = srslog::fetch_basic_logger("PDCP LTE Test TX", false);
+  logger.set_level(srslog::basic_levels::info);
+  logger.set_hex_dump_max_size(32);
+
+  TESTASSERT(test_tx_batch(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(test_tx_batch_full_queue(logger) == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,246 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Benchmark of a PDCP NR AM bearer. In Tx, every SDU runs a discard timer, that is stopped once RLC notifies the
+ * delivery of the SDU, "nof_inflight" SDUs later. In Rx, PDUs are received in blocks of "nof_inflight" COUNTs in
+ * reverse order, so that all but one of them wait in the reordering buffer. Reports the SDUs/s and the heap
+ * allocations per SDU of both.
+ */
+
+#include "pdcp_base_test.h"
+#include "srsran/test/ue_test_interfaces.h"
+#include "srsran/upper/pdcp_entity_nr.h"
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <new>
+
+static uint32_t nof_sdus     = 200000;
+static uint32_t sdu_len      = 100;
+static uint32_t sdus_per_ms  = 100;
+static uint32_t nof_inflight = 512;
+
+static std::atomic<uint64_t> nof_allocs{0};
+
+void* operator new(std::size_t sz)
+{
+  nof_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(sz);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t sz) noexcept
+{
+  std::free(ptr);
+}
+
+namespace srsran {
+
+/// Keeps the PDUs written by PDCP, up to "nof_inflight" of them
+class rlc_benchmark_dummy : public srsue::rlc_interface_pdcp
+{
+public:
+  void write_sdu(uint32_t lcid, unique_byte_buffer_t sdu) final
+  {
+    if (pdus.size() < nof_inflight) {
+      pdus.push_back(std::move(sdu));
+    }
+    nof_written++;
+  }
+  void discard_sdu(uint32_t lcid, uint32_t discard_sn) final { nof_discarded++; }
+  bool rb_is_um(uint32_t lcid) final { return false; }
+  bool     sdu_queue_is_full(uint32_t lcid) final { return false; }
+  uint32_t sdu_queue_free_slots(uint32_t lcid) final { return nof_inflight; }
+  bool is_suspended(uint32_t lcid) final { return false; }
+
+  std::vector<unique_byte_buffer_t> pdus;
+  uint64_t                          nof_written   = 0;
+  uint64_t                          nof_discarded = 0;
+};
+
+struct pdcp_nr_bearer {
+  pdcp_nr_bearer(srslog::basic_logger& logger, pdcp_discard_timer_t discard_timer) :
+    rrc(logger), gw(logger), pdcp(&rlc, &rrc, &gw, &stack.task_sched, logger, 1)
+  {
+    pdcp_config_t cfg = {1,
+                         PDCP_RB_IS_DRB,
+                         SECURITY_DIRECTION_DOWNLINK,
+                         SECURITY_DIRECTION_UPLINK,
+                         PDCP_SN_LEN_18,
+                         pdcp_t_reordering_t::ms100,
+                         discard_timer,
+                         false,
+                         srsran_rat_t::nr};
+    pdcp.configure(cfg);
+  }
+
+  rlc_benchmark_dummy     rlc;
+  rrc_dummy               rrc;
+  gw_dummy                gw;
+  srsue::stack_test_dummy stack;
+  pdcp_entity_nr          pdcp;
+};
+
+unique_byte_buffer_t make_sdu(uint32_t count)
+{
+  unique_byte_buffer_t sdu = make_byte_buffer();
+  srsran_assert(sdu != nullptr, "Couldn't allocate SDU");
+  memset(sdu->msg, (uint8_t)count, sdu_len);
+  sdu->N_bytes = sdu_len;
+  return sdu;
+}
+
+void print_rate(const char* name, std::chrono::nanoseconds time, uint64_t allocs)
+{
+  double us = time.count() / 1000.0;
+  printf("%s %10.1f SDUs/s (%.1f Mbps), %.2f allocations per SDU\n",
+         name,
+         nof_sdus * 1e6 / us,
+         (double)nof_sdus * sdu_len * 8 / us,
+         (double)allocs / nof_sdus);
+}
+
+int run_tx_benchmark(srslog::basic_logger& logger)
+{
+  pdcp_nr_bearer   bearer(logger, pdcp_discard_timer_t::ms100);
+  pdcp_sn_vector_t acked_sns;
+  uint32_t         nof_acked = 0;
+
+  uint64_t allocs_start = nof_allocs.load();
+  auto     start        = std::chrono::steady_clock::now();
+  for (uint32_t count = 0; count < nof_sdus; ++count) {
+    bearer.pdcp.write_sdu(make_sdu(count));
+
+    // RLC notifies the delivery of the SDUs in batches
+    if (count >= nof_inflight) {
+      acked_sns.push_back(count - nof_inflight);
+    }
+    if (acked_sns.size() == 16) {
+      bearer.pdcp.notify_delivery(acked_sns);
+      nof_acked += acked_sns.size();
+      acked_sns.clear();
+    }
+    if ((count + 1) % sdus_per_ms == 0) {
+      bearer.stack.run_tti();
+    }
+  }
+  auto     time   = std::chrono::steady_clock::now() - start;
+  uint64_t allocs = nof_allocs.load() - allocs_start;
+
+  // The SDUs that were not delivered expire
+  TESTASSERT(bearer.pdcp.nof_discard_timers() <= nof_sdus - nof_acked);
+  for (uint32_t i = 0; i < static_cast<uint32_t>(pdcp_discard_timer_t::ms100); ++i) {
+    bearer.stack.run_tti();
+  }
+  TESTASSERT(bearer.pdcp.nof_discard_timers() == 0);
+  TESTASSERT(bearer.rlc.nof_written == nof_sdus);
+  TESTASSERT(bearer.rlc.nof_discarded == nof_sdus - nof_acked);
+
+  print_rate("Tx:", time, allocs);
+  return SRSRAN_SUCCESS;
+}
+
+int run_rx_benchmark(srslog::basic_logger& logger)
+{
+  pdcp_nr_bearer tx(logger, pdcp_discard_timer_t::infinity), rx(logger, pdcp_discard_timer_t::infinity);
+
+  std::chrono::nanoseconds time{0};
+  uint64_t                 allocs = 0;
+  for (uint32_t count = 0; count < nof_sdus; count += nof_inflight) {
+    uint32_t nof_pdus = std::min(nof_inflight, nof_sdus - count);
+    tx.rlc.pdus.clear();
+    for (uint32_t i = 0; i < nof_pdus; ++i) {
+      tx.pdcp.write_sdu(make_sdu(count + i));
+    }
+
+    uint64_t allocs_start = nof_allocs.load();
+    auto     start        = std::chrono::steady_clock::now();
+    for (uint32_t i = nof_pdus; i > 0; --i) {
+      rx.pdcp.write_pdu(std::move(tx.rlc.pdus[i - 1]));
+    }
+    time += std::chrono::steady_clock::now() - start;
+    allocs += nof_allocs.load() - allocs_start;
+
+    TESTASSERT(rx.gw.rx_count == count + nof_pdus);
+    TESTASSERT(not rx.pdcp.is_reordering_timer_running());
+    rx.stack.run_tti();
+  }
+
+  print_rate("Rx:", time, allocs);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nlrw]\n", prog);
+  printf("\t-n number of SDUs [Default %d]\n", nof_sdus);
+  printf("\t-l SDU size in bytes [Default %d]\n", sdu_len);
+  printf("\t-r SDUs per msec [Default %d]\n", sdus_per_ms);
+  printf("\t-w number of SDUs waiting for delivery or reordering [Default %d]\n", nof_inflight);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nlrw")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_sdus = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'l':
+        sdu_len = std::min(std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10)), (uint32_t)PDCP_MAX_SDU_SIZE);
+        break;
+      case 'r':
+        sdus_per_ms = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'w':
+        nof_inflight = std::min(std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10)), 2048U);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  auto& logger = srslog::fetch_basic_logger("PDCP", false);
+  logger.set_level(srslog::basic_levels::warning);
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsran::run_tx_benchmark(logger) == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::run_rx_benchmark(logger) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
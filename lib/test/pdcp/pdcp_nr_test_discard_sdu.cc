@@ -79,6 +79,61 @@ int test_tx_sdu_discard(const pdcp_initial_state&    init_state,
   return 0;
 }
 
+/*
+ * Configuring the bearer again after a reset, with the same discardTimer, keeps the running discard timers
+ */
+int test_tx_sdu_discard_reconfig(srslog::basic_logger& logger)
+{
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::ms50,
+                               false,
+                               srsran::srsran_rat_t::nr};
+
+  pdcp_nr_test_helper      pdcp_hlp(cfg, sec_cfg, logger);
+  srsran::pdcp_entity_nr*  pdcp  = &pdcp_hlp.pdcp;
+  rlc_dummy*               rlc   = &pdcp_hlp.rlc;
+  srsue::stack_test_dummy* stack = &pdcp_hlp.stack;
+
+  pdcp_hlp.set_pdcp_initial_state(normal_init_state);
+
+  srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  sdu->append_bytes(sdu1, sizeof(sdu1));
+  pdcp->write_sdu(std::move(sdu));
+
+  for (uint32_t i = 0; i < 25; ++i) {
+    stack->run_tti();
+  }
+  pdcp->reset();
+  TESTASSERT(pdcp->configure(cfg));
+  TESTASSERT(pdcp->nof_discard_timers() == 1);
+
+  for (uint32_t i = 0; i < 25; ++i) {
+    stack->run_tti();
+  }
+  TESTASSERT(rlc->discard_count == 1);
+  TESTASSERT(pdcp->nof_discard_timers() == 0);
+
+  // A new discardTimer applies to the SDUs written after the reconfiguration
+  cfg.discard_timer = srsran::pdcp_discard_timer_t::ms100;
+  pdcp->reset();
+  TESTASSERT(pdcp->configure(cfg));
+  sdu = srsran::make_byte_buffer();
+  sdu->append_bytes(sdu1, sizeof(sdu1));
+  pdcp->write_sdu(std::move(sdu));
+  for (uint32_t i = 0; i < 99; ++i) {
+    stack->run_tti();
+  }
+  TESTASSERT(rlc->discard_count == 1);
+  stack->run_tti();
+  TESTASSERT(rlc->discard_count == 2);
+  return 0;
+}
+
 /*
  * TX Test: PDCP Entity with SN LEN = 12 and 18.
  * PDCP entity configured with EIA2 and EEA2
@@ -108,6 +163,7 @@ int run_all_tests()
   logger.set_hex_dump_max_size(128);
 
   TESTASSERT(test_tx_discard_all(logger) == 0);
+  TESTASSERT(test_tx_sdu_discard_reconfig(logger) == 0);
   return 0;
 }
 
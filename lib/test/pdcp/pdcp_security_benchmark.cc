@@ -0,0 +1,228 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security.h"
+#include "srsran/config.h"
+#include "srsran/support/srsran_test.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+#include <vector>
+
+static uint32_t nof_pdus   = 20000;
+static uint32_t pdu_len    = 1500;
+static uint32_t batch_size = 16;
+
+namespace {
+
+using steady_clock = std::chrono::steady_clock;
+
+const uint8_t bearer    = 2;
+const uint8_t direction = srsran::SECURITY_DIRECTION_DOWNLINK;
+
+using legacy_cipher_func_t = uint8_t (*)(uint8_t*, uint32_t, uint8_t, uint8_t, uint8_t*, uint32_t, uint8_t*);
+using legacy_integ_func_t = uint8_t (*)(const uint8_t*, uint32_t, uint32_t, uint8_t, uint8_t*, uint32_t, uint8_t*);
+
+legacy_cipher_func_t legacy_cipher_func(srsran::CIPHERING_ALGORITHM_ID_ENUM algo)
+{
+  switch (algo) {
+    case srsran::CIPHERING_ALGORITHM_ID_128_EEA1:
+      return srsran::security_128_eea1;
+    case srsran::CIPHERING_ALGORITHM_ID_128_EEA2:
+      return srsran::security_128_eea2;
+    default:
+      return srsran::security_128_eea3;
+  }
+}
+
+legacy_integ_func_t legacy_integ_func(srsran::INTEGRITY_ALGORITHM_ID_ENUM algo)
+{
+  switch (algo) {
+    case srsran::INTEGRITY_ALGORITHM_ID_128_EIA1:
+      return srsran::security_128_eia1;
+    case srsran::INTEGRITY_ALGORITHM_ID_128_EIA2:
+      return srsran::security_128_eia2;
+    default:
+      return srsran::security_128_eia3;
+  }
+}
+
+/// Runs "func" for every PDU index and returns the throughput in Mbps
+template <typename Func>
+double measure(uint32_t len, Func&& func)
+{
+  auto start = steady_clock::now();
+  for (uint32_t i = 0; i < nof_pdus; ++i) {
+    func(i);
+  }
+  auto   end = steady_clock::now();
+  double us  = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / 1000.0;
+  return (double)nof_pdus * len * 8 / us;
+}
+
+/// The cached contexts must match the per-PDU functions for every length, including partial AES blocks
+void test_bit_exact(uint8_t* key, std::mt19937& rgen)
+{
+  const uint32_t lengths[] = {1, 3, 8, 15, 16, 17, 24, 31, 32, 40, 100, 127, 128, 129, 1500, 9000};
+
+  std::vector<uint8_t> msg(9000), out_legacy(msg.size()), out_ctx(msg.size());
+  for (uint8_t& b : msg) {
+    b = rgen();
+  }
+
+  for (uint32_t a = srsran::CIPHERING_ALGORITHM_ID_128_EEA1; a <= srsran::CIPHERING_ALGORITHM_ID_128_EEA3; ++a) {
+    auto               algo = (srsran::CIPHERING_ALGORITHM_ID_ENUM)a;
+    srsran::cipher_ctx ctx;
+    ctx.set_key(algo, key);
+    for (uint32_t len : lengths) {
+      uint32_t count = rgen();
+      legacy_cipher_func(algo)(key, count, bearer, direction, msg.data(), len, out_legacy.data());
+      ctx.cipher(count, bearer, direction, msg.data(), len, out_ctx.data());
+      TESTASSERT(memcmp(out_legacy.data(), out_ctx.data(), len) == 0);
+
+      // In place
+      memcpy(out_ctx.data(), msg.data(), len);
+      ctx.cipher(count, bearer, direction, out_ctx.data(), len, out_ctx.data());
+      TESTASSERT(memcmp(out_legacy.data(), out_ctx.data(), len) == 0);
+    }
+
+    // One batch with all the lengths back to back
+    std::vector<srsran::cipher_ctx::pdu_t> pdus;
+    std::vector<uint8_t>                   out_batch(out_ctx.size() * 2);
+    uint32_t                               offset = 0;
+    for (uint32_t len : lengths) {
+      pdus.push_back({(uint32_t)rgen(), msg.data(), len, out_batch.data() + offset});
+      offset += len;
+    }
+    ctx.cipher_batch(bearer, direction, pdus);
+    for (const auto& pdu : pdus) {
+      legacy_cipher_func(algo)(key, pdu.count, bearer, direction, msg.data(), pdu.msg_len, out_legacy.data());
+      TESTASSERT(memcmp(out_legacy.data(), pdu.msg_out, pdu.msg_len) == 0);
+    }
+  }
+
+  for (uint32_t a = srsran::INTEGRITY_ALGORITHM_ID_128_EIA1; a <= srsran::INTEGRITY_ALGORITHM_ID_128_EIA3; ++a) {
+    auto                  algo = (srsran::INTEGRITY_ALGORITHM_ID_ENUM)a;
+    srsran::integrity_ctx ctx;
+    ctx.set_key(algo, key);
+    for (uint32_t len : lengths) {
+      uint32_t count         = rgen();
+      uint8_t  mac_legacy[4] = {};
+      uint8_t  mac_ctx[4]    = {};
+      legacy_integ_func(algo)(key, count, bearer, direction, msg.data(), len, mac_legacy);
+      ctx.generate(count, bearer, direction, msg.data(), len, mac_ctx);
+      TESTASSERT(memcmp(mac_legacy, mac_ctx, 4) == 0);
+    }
+  }
+}
+
+void run_benchmark(uint8_t* key)
+{
+  std::vector<uint8_t> buffer(pdu_len * batch_size);
+  std::vector<uint8_t> out(buffer.size());
+
+  printf("PDU size %d bytes, batches of %d PDUs. Throughput in Mbps\n", pdu_len, batch_size);
+  for (uint32_t a = srsran::CIPHERING_ALGORITHM_ID_128_EEA1; a <= srsran::CIPHERING_ALGORITHM_ID_128_EEA3; ++a) {
+    auto               algo = (srsran::CIPHERING_ALGORITHM_ID_ENUM)a;
+    srsran::cipher_ctx ctx;
+    ctx.set_key(algo, key);
+
+    double legacy = measure(pdu_len, [&](uint32_t i) {
+      legacy_cipher_func(algo)(key, i, bearer, direction, buffer.data(), pdu_len, out.data());
+    });
+    double cached = measure(pdu_len, [&](uint32_t i) {
+      ctx.cipher(i, bearer, direction, buffer.data(), pdu_len, buffer.data());
+    });
+    std::vector<srsran::cipher_ctx::pdu_t> pdus(batch_size);
+    double batched = measure(pdu_len, [&](uint32_t i) {
+      pdus[i % batch_size] = {i, &buffer[(i % batch_size) * pdu_len], pdu_len, &buffer[(i % batch_size) * pdu_len]};
+      if (i % batch_size == batch_size - 1) {
+        ctx.cipher_batch(bearer, direction, pdus);
+      }
+    });
+    printf("%-9s per-PDU key setup=%8.1f, cached key=%8.1f, batched=%8.1f\n",
+           srsran::ciphering_algorithm_id_text[algo],
+           legacy,
+           cached,
+           batched);
+  }
+
+  for (uint32_t a = srsran::INTEGRITY_ALGORITHM_ID_128_EIA1; a <= srsran::INTEGRITY_ALGORITHM_ID_128_EIA3; ++a) {
+    auto                  algo = (srsran::INTEGRITY_ALGORITHM_ID_ENUM)a;
+    srsran::integrity_ctx ctx;
+    ctx.set_key(algo, key);
+    uint8_t mac[4];
+
+    double legacy = measure(pdu_len, [&](uint32_t i) {
+      legacy_integ_func(algo)(key, i, bearer, direction, buffer.data(), pdu_len, mac);
+    });
+    double cached =
+        measure(pdu_len, [&](uint32_t i) { ctx.generate(i, bearer, direction, buffer.data(), pdu_len, mac); });
+    printf("%-9s per-PDU key setup=%8.1f, cached key=%8.1f\n",
+           srsran::integrity_algorithm_id_text[algo],
+           legacy,
+           cached);
+  }
+}
+
+} // namespace
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nsb]\n", prog);
+  printf("\t-n number of PDUs per algorithm [Default %d]\n", nof_pdus);
+  printf("\t-s PDU size in bytes [Default %d]\n", pdu_len);
+  printf("\t-b number of PDUs per batch [Default %d]\n", batch_size);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nsb")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_pdus = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 's':
+        pdu_len = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'b':
+        batch_size = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  uint8_t key[16] = {0xd3, 0xc5, 0xd5, 0x92, 0x32, 0x7f, 0xb1, 0x1c, 0x40, 0x35, 0xc6, 0x68, 0x0a, 0xf8, 0xc6, 0xd1};
+
+  std::mt19937 rgen(0);
+  test_bit_exact(key, rgen);
+  run_benchmark(key);
+
+  return SRSRAN_SUCCESS;
+}
@@ -179,11 +179,12 @@ int work_enb(srsran_enb_dl_t*         enb_dl,
   }
 
   // Enable power allocation
-  pdsch_cfg.power_scale  = true;
-  pdsch_cfg.p_a          = 0.0f;                                     // 0 dB
-  pdsch_cfg.p_b          = (transmission_mode > SRSRAN_TM1) ? 1 : 0; // 0 dB
-  pdsch_cfg.rnti         = rnti;
-  pdsch_cfg.meas_time_en = false;
+  pdsch_cfg.power_scale      = true;
+  pdsch_cfg.p_a              = 0.0f;                                     // 0 dB
+  pdsch_cfg.p_b              = (transmission_mode > SRSRAN_TM1) ? 1 : 0; // 0 dB
+  pdsch_cfg.rnti             = rnti;
+  pdsch_cfg.meas_time_en     = false;
+  pdsch_cfg.mu_mimo_rbg_mask = 0;
 
   if (srsran_enb_dl_put_pdsch(enb_dl, &pdsch_cfg, data_tx) < 0) {
     ERROR("Error putting PDSCH sf_idx=%d", dl_sf->tti);
@@ -0,0 +1,218 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Benchmark of the RLC AM LTE receiver. PDUs are delivered as re-segmented retransmissions, in reverse order of SO
+ * and interleaved with the segments of the other PDUs in flight, so that the receiver buffers the segments of many SNs
+ * at a time. Reports the received PDUs/s and the heap allocations per PDU.
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/timers.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/rlc/rlc_am_base.h"
+#include "srsran/rlc/rlc_am_lte_packing.h"
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <new>
+
+static uint32_t nof_pdus     = 200000;
+static uint32_t pdu_len      = 1500;
+static uint32_t nof_segments = 8;
+static uint32_t nof_inflight = 64;
+
+static std::atomic<uint64_t> nof_allocs{0};
+
+void* operator new(std::size_t sz)
+{
+  nof_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(sz);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t sz) noexcept
+{
+  std::free(ptr);
+}
+
+namespace srsran {
+
+class rlc_am_benchmark_tester : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
+{
+public:
+  // PDCP interface
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t sdu) final
+  {
+    // The SDU of SN n is filled with the byte n
+    if (sdu->N_bytes != pdu_len or sdu->msg[0] != (uint8_t)nof_sdus or sdu->msg[pdu_len - 1] != (uint8_t)nof_sdus) {
+      nof_errors++;
+    }
+    nof_sdus++;
+  }
+  void write_pdu_bcch_bch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_dlsch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_pcch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_mch(uint32_t lcid, unique_byte_buffer_t sdu) final {}
+  void notify_delivery(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+  void notify_failure(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+
+  // RRC interface
+  void        max_retx_attempted() final {}
+  void        protocol_failure() final {}
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+
+  uint32_t nof_sdus   = 0;
+  uint32_t nof_errors = 0;
+};
+
+/// Writes segment "seg_idx" of the PDU with SN "count", carrying one SDU of pdu_len bytes, into "pdu"
+void make_pdu_segment(uint32_t count, uint32_t seg_idx, byte_buffer_t& pdu)
+{
+  uint32_t seg_len = (pdu_len + nof_segments - 1) / nof_segments;
+  uint32_t so      = seg_idx * seg_len;
+  uint32_t len     = std::min(seg_len, pdu_len - so);
+
+  rlc_amd_pdu_header_t header = {};
+  header.dc                   = RLC_DC_FIELD_DATA_PDU;
+  header.sn                   = count % 1024;
+  if (nof_segments > 1) {
+    header.rf  = 1;
+    header.so  = so;
+    header.lsf = (so + len == pdu_len);
+    header.fi  = (so > 0 ? RLC_FI_FIELD_NOT_START_ALIGNED : 0) | (header.lsf ? 0 : RLC_FI_FIELD_NOT_END_ALIGNED);
+  }
+
+  pdu.clear();
+  rlc_am_write_data_pdu_header(&header, &pdu);
+  memset(pdu.msg + pdu.N_bytes, (uint8_t)count, len);
+  pdu.N_bytes += len;
+}
+
+int run_benchmark()
+{
+  rlc_am_benchmark_tester tester;
+  timer_handler           timers(8);
+  byte_buffer_t           pdu;
+
+  rlc_am rlc(srsran_rat_t::lte, srslog::fetch_basic_logger("RLC"), 1, &tester, &tester, &timers);
+  TESTASSERT(rlc.configure(rlc_config_t::default_rlc_am_config()));
+
+  // Delivers the segments of "nof_inflight" PDUs, with the segments of each PDU in reverse order of SO
+  auto deliver_pdus = [&](uint32_t first_count, uint32_t nof) {
+    for (uint32_t seg = nof_segments; seg > 0; --seg) {
+      for (uint32_t count = first_count; count < first_count + nof; ++count) {
+        make_pdu_segment(count, seg - 1, pdu);
+        rlc.write_pdu(pdu.msg, pdu.N_bytes);
+      }
+    }
+  };
+
+  // The first PDUs grow the buffers of the receiver
+  uint32_t count = std::min(nof_pdus, nof_inflight);
+  deliver_pdus(0, count);
+
+  uint64_t allocs_start = nof_allocs.load();
+  auto     start        = std::chrono::steady_clock::now();
+  uint32_t first        = count;
+  for (; count < nof_pdus; count += nof_inflight) {
+    deliver_pdus(count, std::min(nof_inflight, nof_pdus - count));
+  }
+  auto     end    = std::chrono::steady_clock::now();
+  uint64_t allocs = nof_allocs.load() - allocs_start;
+  double   us     = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+  TESTASSERT(tester.nof_sdus == nof_pdus);
+  TESTASSERT(tester.nof_errors == 0);
+
+  uint32_t nof_measured = nof_pdus - first;
+  if (nof_measured > 0 and us > 0) {
+    printf("%d PDUs of %d bytes, %d segments per PDU, %d PDUs in flight\n",
+           nof_measured,
+           pdu_len,
+           nof_segments,
+           nof_inflight);
+    printf("Rx rate:              %10.1f PDUs/s (%.1f Mbps)\n",
+           nof_measured * 1e6 / us,
+           (double)nof_measured * pdu_len * 8 / us);
+    printf("Rx rate:              %10.1f segments/s\n", (double)nof_measured * nof_segments * 1e6 / us);
+    printf("Allocations per PDU:  %10.2f\n", (double)allocs / nof_measured);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nlsw]\n", prog);
+  printf("\t-n number of PDUs [Default %d]\n", nof_pdus);
+  printf("\t-l PDU size in bytes [Default %d]\n", pdu_len);
+  printf("\t-s number of segments per PDU [Default %d]\n", nof_segments);
+  printf("\t-w number of PDUs in flight [Default %d]\n", nof_inflight);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nlsw")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_pdus = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'l':
+        pdu_len = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 's':
+        nof_segments = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'w':
+        nof_inflight = std::min(std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10)), (uint32_t)RLC_AM_WINDOW_SIZE);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  // Every segment carries at least one byte
+  uint32_t seg_len = (pdu_len + nof_segments - 1) / nof_segments;
+  nof_segments     = (pdu_len + seg_len - 1) / seg_len;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("RLC").set_level(srslog::basic_levels::warning);
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsran::run_benchmark() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -4082,6 +4082,69 @@ bool full_window_check_wraparound_test()
 
   return SRSRAN_SUCCESS;
 }
+bool rx_pdu_segments_test()
+{
+  rlc_amd_rx_pdu_segment_pool pool(4);
+
+  auto make_segment = [&pool](uint32_t so, uint32_t len, bool lsf) {
+    rlc_amd_rx_pdu_segment* segment = pool.make_segment();
+    segment->header.sn              = 7;
+    segment->header.so              = so;
+    segment->header.lsf             = lsf;
+    segment->buf                    = srsran::make_byte_buffer();
+    segment->buf->N_bytes           = len;
+    return segment;
+  };
+
+  {
+    rlc_amd_rx_pdu_segments_t pdu(7, pool);
+
+    // Segments out of order, with a gap at the start of the PDU
+    pdu.add_segment(make_segment(40, 20, true));
+    pdu.add_segment(make_segment(10, 10, false));
+    TESTASSERT(not pdu.complete());
+    TESTASSERT_EQ(pdu.size(), 2);
+    TESTASSERT_EQ(pdu.front()->header.so, 10);
+    TESTASSERT_EQ(pdu.back()->header.so, 40);
+
+    // A smaller segment with the same SO is ignored, a bigger one replaces the received one
+    pdu.add_segment(make_segment(10, 5, false));
+    TESTASSERT_EQ(pdu.front()->buf->N_bytes, 10);
+    pdu.add_segment(make_segment(10, 20, false));
+    TESTASSERT_EQ(pdu.size(), 2);
+    TESTASSERT_EQ(pdu.front()->buf->N_bytes, 20);
+
+    // Filling the start of the PDU leaves the gap [30, 40)
+    pdu.add_segment(make_segment(0, 10, false));
+    TESTASSERT(not pdu.complete());
+    TESTASSERT_EQ(pdu.size(), 3);
+
+    // A segment overlapping the gap and the last segment completes the PDU
+    pdu.add_segment(make_segment(25, 20, false));
+    TESTASSERT(pdu.complete());
+    TESTASSERT_EQ(pdu.size(), 4);
+
+    // Segments fully overlapped by the previous ones are discarded
+    pdu.add_segment(make_segment(0, 45, false));
+    TESTASSERT(pdu.complete());
+    TESTASSERT_EQ(pdu.size(), 2);
+    TESTASSERT_EQ(pdu.front()->buf->N_bytes, 45);
+    TESTASSERT_EQ(pdu.back()->header.so, 40);
+    TESTASSERT(pdu.back()->header.lsf);
+  }
+
+  // The segments are owned by the moved-to object. The pool asserts on destruction that all were returned
+  {
+    rlc_amd_rx_pdu_segments_t pdu(8, pool);
+    pdu.add_segment(make_segment(0, 10, false));
+    rlc_amd_rx_pdu_segments_t moved(std::move(pdu));
+    TESTASSERT(pdu.empty());
+    TESTASSERT_EQ(moved.size(), 1);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char** argv)
 {
   // Setup the log message spy to intercept error and warning log entries from RLC
@@ -4301,5 +4364,10 @@ int main(int argc, char** argv)
     printf("full_window_check_wraparound_test failed\n");
     exit(-1);
   };
+
+  if (rx_pdu_segments_test()) {
+    printf("rx_pdu_segments_test failed\n");
+    exit(-1);
+  };
   return SRSRAN_SUCCESS;
 }
@@ -0,0 +1,393 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Benchmark of the RLC AM NR entities. Measures:
+ * - the segmentation of SDUs into PDU segments by the transmitter,
+ * - the reassembly of SDUs by the receiver, with the segments of the SDUs in flight received in reverse order,
+ * - the generation and handling of status PDUs with many NACK ranges, and the retransmission of the NACKed SDUs.
+ * Reports the rates and the heap allocations of each step.
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/common/timers.h"
+#include "srsran/interfaces/ue_pdcp_interfaces.h"
+#include "srsran/interfaces/ue_rrc_interfaces.h"
+#include "srsran/rlc/rlc_am_nr.h"
+#include <atomic>
+#include <chrono>
+#include <getopt.h>
+#include <new>
+
+static uint32_t nof_sdus        = 100000;
+static uint32_t sdu_len         = 1500;
+static uint32_t nof_segments    = 4;
+static uint32_t nof_inflight    = 128;
+static uint32_t nof_nack_ranges = 500;
+static uint32_t nof_status      = 20;
+static uint32_t sn_size         = 18;
+
+static std::atomic<uint64_t> nof_allocs{0};
+
+void* operator new(std::size_t sz)
+{
+  nof_allocs.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(sz);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t sz) noexcept
+{
+  std::free(ptr);
+}
+
+namespace srsran {
+
+using steady_clock = std::chrono::steady_clock;
+
+class rlc_am_nr_benchmark_tester : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
+{
+public:
+  // PDCP interface
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t sdu) final
+  {
+    // Every SDU is filled with the same byte. NR RLC delivers the SDUs out of order, so the byte is not checked
+    if (sdu->N_bytes != expected_len or sdu->msg[0] != sdu->msg[expected_len / 2] or
+        sdu->msg[0] != sdu->msg[expected_len - 1]) {
+      nof_errors++;
+    }
+    nof_rx_sdus++;
+  }
+  void write_pdu_bcch_bch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_dlsch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_pcch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_mch(uint32_t lcid, unique_byte_buffer_t sdu) final {}
+  void notify_delivery(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final { nof_acked_sdus += pdcp_sns.size(); }
+  void notify_failure(uint32_t lcid, const pdcp_sn_vector_t& pdcp_sns) final {}
+
+  // RRC interface
+  void        max_retx_attempted() final {}
+  void        protocol_failure() final {}
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+
+  uint32_t expected_len   = sdu_len;
+  uint32_t nof_rx_sdus    = 0;
+  uint32_t nof_acked_sdus = 0;
+  uint32_t nof_errors     = 0;
+};
+
+/// Accumulated duration and heap allocations of a step of the benchmark
+struct step_meas {
+  double   us     = 0;
+  uint64_t allocs = 0;
+
+  template <typename Func>
+  void run(Func&& func)
+  {
+    uint64_t allocs_start = nof_allocs.load();
+    auto     start        = steady_clock::now();
+    func();
+    us += std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start).count() / 1000.0;
+    allocs += nof_allocs.load() - allocs_start;
+  }
+};
+
+rlc_config_t benchmark_config()
+{
+  rlc_config_t cfg = rlc_config_t::default_rlc_am_nr_config(sn_size);
+  // The timers are not stepped, so that no PDU is retransmitted and no status PDU is prohibited by them
+  cfg.am_nr.t_status_prohibit = 0;
+  cfg.am_nr.max_retx_thresh   = 32;
+  cfg.tx_queue_length         = 256;
+  return cfg;
+}
+
+unique_byte_buffer_t make_sdu(uint32_t count, uint32_t len)
+{
+  unique_byte_buffer_t sdu = make_byte_buffer();
+  srsran_assert(sdu != nullptr, "Couldn't allocate SDU");
+  memset(sdu->msg, (uint8_t)count, len);
+  sdu->N_bytes    = len;
+  sdu->md.pdcp_sn = count;
+  return sdu;
+}
+
+/// Transfers the status PDU of "rx_rlc" to "tx_rlc"
+void transfer_status(rlc_am& rx_rlc, rlc_am& tx_rlc, byte_buffer_t& pdu)
+{
+  pdu.N_bytes = rx_rlc.read_pdu(pdu.msg, pdu.get_tailroom());
+  if (pdu.N_bytes > 0) {
+    tx_rlc.write_pdu(pdu.msg, pdu.N_bytes);
+  }
+}
+
+int run_segmentation_benchmark()
+{
+  rlc_am_nr_benchmark_tester tester;
+  timer_handler              timers(8);
+  byte_buffer_t              status_pdu;
+
+  rlc_am tx_rlc(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_TX"), 1, &tester, &tester, &timers);
+  rlc_am rx_rlc(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_RX"), 1, &tester, &tester, &timers);
+  TESTASSERT(tx_rlc.configure(benchmark_config()));
+  TESTASSERT(rx_rlc.configure(benchmark_config()));
+
+  // Every SDU is segmented in nof_segments PDUs of at most seg_len bytes of payload
+  uint32_t                   seg_len = (sdu_len + nof_segments - 1) / nof_segments;
+  uint32_t                   grant   = seg_len + 5;
+  std::vector<byte_buffer_t> pdus(nof_inflight * (nof_segments + 1));
+
+  step_meas tx_meas, rx_meas, status_meas;
+  uint32_t  nof_pdus = 0, nof_meas_sdus = 0;
+  for (uint32_t count = 0; count < nof_sdus; count += nof_inflight) {
+    uint32_t nof = std::min(nof_inflight, nof_sdus - count);
+    if (count == nof_inflight) {
+      // The first round grows the buffer pool, the segment pools and the windows, and is not measured
+      tx_meas       = {};
+      rx_meas       = {};
+      status_meas   = {};
+      nof_meas_sdus = 0;
+    }
+    nof_meas_sdus += nof;
+
+    // Segment the SDUs of this round
+    uint32_t n = 0;
+    tx_meas.run([&]() {
+      for (uint32_t i = count; i < count + nof; ++i) {
+        tx_rlc.write_sdu(make_sdu(i, sdu_len));
+      }
+      while (n < pdus.size() and (pdus[n].N_bytes = tx_rlc.read_pdu(pdus[n].msg, grant)) > 0) {
+        n++;
+      }
+    });
+    TESTASSERT(tx_rlc.get_buffer_state() == 0);
+    nof_pdus += n;
+
+    // Reassemble the SDUs from the segments, received in reverse order
+    rx_meas.run([&]() {
+      for (uint32_t i = n; i > 0; --i) {
+        rx_rlc.write_pdu(pdus[i - 1].msg, pdus[i - 1].N_bytes);
+      }
+    });
+
+    // ACK the SDUs of this round
+    status_meas.run([&]() { transfer_status(rx_rlc, tx_rlc, status_pdu); });
+  }
+
+  TESTASSERT(tester.nof_rx_sdus == nof_sdus);
+  TESTASSERT(tester.nof_acked_sdus == nof_sdus);
+  TESTASSERT(tester.nof_errors == 0);
+
+  // After the first round, the Tx and Rx paths don't allocate
+  if (nof_sdus > nof_inflight) {
+    TESTASSERT(tx_meas.allocs == 0);
+    TESTASSERT(rx_meas.allocs == 0);
+  }
+
+  printf("%d SDUs of %d bytes in %d PDUs (%.1f PDUs per SDU), %d SDUs in flight, %d bit SN\n",
+         nof_sdus,
+         sdu_len,
+         nof_pdus,
+         (double)nof_pdus / nof_sdus,
+         nof_inflight,
+         sn_size);
+  printf("Tx segmentation:      %10.1f SDUs/s (%7.1f Mbps), %6.2f allocations per SDU\n",
+         nof_meas_sdus * 1e6 / tx_meas.us,
+         (double)nof_meas_sdus * sdu_len * 8 / tx_meas.us,
+         (double)tx_meas.allocs / nof_meas_sdus);
+  printf("Rx reassembly:        %10.1f SDUs/s (%7.1f Mbps), %6.2f allocations per SDU\n",
+         nof_meas_sdus * 1e6 / rx_meas.us,
+         (double)nof_meas_sdus * sdu_len * 8 / rx_meas.us,
+         (double)rx_meas.allocs / nof_meas_sdus);
+  printf("Status (ACK only):    %10.1f us per status PDU, %6.2f allocations per status PDU\n",
+         status_meas.us * nof_inflight / nof_meas_sdus,
+         (double)status_meas.allocs * nof_inflight / nof_meas_sdus);
+  return SRSRAN_SUCCESS;
+}
+
+int run_status_benchmark()
+{
+  rlc_am_nr_benchmark_tester tester;
+  timer_handler              timers(8);
+  byte_buffer_t              pdu, status_pdu;
+
+  rlc_am tx_rlc(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_TX"), 1, &tester, &tester, &timers);
+  rlc_am rx_rlc(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_RX"), 1, &tester, &tester, &timers);
+  TESTASSERT(tx_rlc.configure(benchmark_config()));
+  TESTASSERT(rx_rlc.configure(benchmark_config()));
+  rlc_am_nr_sn_size_t sn_field = benchmark_config().am_nr.rx_sn_field_length;
+  rlc_am_nr_rx*       rx       = dynamic_cast<rlc_am_nr_rx*>(rx_rlc.get_rx());
+  TESTASSERT(rx != nullptr);
+
+  // Out of every 3 SDUs, the first is received and the other two are lost, so that every gap is NACKed with a range.
+  // The lost SDUs are segmented, so that the SO of the NACKs is also handled.
+  uint32_t      small_sdu_len = 100;
+  uint32_t      grant         = small_sdu_len / 2 + 5;
+  uint32_t      nof_tx_sdus   = nof_nack_ranges * 3;
+  byte_buffer_t received_pdu;
+  tester.expected_len = small_sdu_len;
+  for (uint32_t count = 0; count < nof_tx_sdus;) {
+    for (uint32_t i = 0; i < 255 and count < nof_tx_sdus; ++i, ++count) {
+      tx_rlc.write_sdu(make_sdu(count, small_sdu_len));
+    }
+    while ((pdu.N_bytes = tx_rlc.read_pdu(pdu.msg, grant)) > 0) {
+      rlc_am_nr_pdu_header_t header = {};
+      rlc_am_nr_read_data_pdu_header(&pdu, sn_field, &header);
+      if (header.sn % 3 == 0) {
+        rx_rlc.write_pdu(pdu.msg, pdu.N_bytes);
+        received_pdu = pdu;
+      }
+    }
+  }
+
+  // Report all the gaps, without waiting for t-Reassembly
+  rlc_am_nr_rx_state_t st = rx->get_rx_state();
+  st.rx_highest_status    = st.rx_next_highest;
+  rx->set_rx_state(st);
+
+  // A received PDU with the poll bit set triggers a status PDU
+  received_pdu.msg[0] |= 0x40U;
+
+  step_meas status_meas, nack_meas, retx_meas;
+  uint32_t  nof_nacks = 0, nof_retx_pdus = 0;
+  for (uint32_t i = 0; i <= nof_status; ++i) {
+    if (i == 1) {
+      // The first status PDU grows the buffers of the retx queue and of the NACK vectors, and is not measured
+      status_meas   = {};
+      nack_meas     = {};
+      retx_meas     = {};
+      nof_retx_pdus = 0;
+    }
+    rx_rlc.write_pdu(received_pdu.msg, received_pdu.N_bytes);
+
+    // Build the status PDU, including the buffer state query of the MAC
+    status_meas.run([&]() {
+      TESTASSERT(rx_rlc.get_buffer_state() > 0);
+      status_pdu.N_bytes = rx_rlc.read_pdu(status_pdu.msg, status_pdu.get_tailroom());
+    });
+    rlc_am_nr_status_pdu_t status(sn_field);
+    rlc_am_nr_read_status_pdu(&status_pdu, sn_field, &status);
+    nof_nacks = status.nacks.size();
+
+    // Handle the NACKs and retransmit the NACKed SDUs, which are lost again
+    nack_meas.run([&]() { tx_rlc.write_pdu(status_pdu.msg, status_pdu.N_bytes); });
+    retx_meas.run([&]() {
+      while ((pdu.N_bytes = tx_rlc.read_pdu(pdu.msg, grant)) > 0) {
+        nof_retx_pdus++;
+      }
+    });
+  }
+  TESTASSERT(nof_nacks == nof_nack_ranges - 1);
+  TESTASSERT(tester.nof_errors == 0);
+
+  // After the first status PDU, handling the NACKs doesn't allocate
+  TESTASSERT(nack_meas.allocs == 0);
+
+  printf("%d status PDUs with %d NACK ranges (%d B), %d SDUs of %d bytes, %d bit SN\n",
+         nof_status,
+         nof_nacks,
+         status_pdu.N_bytes,
+         nof_tx_sdus,
+         small_sdu_len,
+         sn_size);
+  printf("Status generation:    %10.1f us per status PDU, %6.2f allocations per status PDU\n",
+         status_meas.us / nof_status,
+         (double)status_meas.allocs / nof_status);
+  printf("Status handling:      %10.1f us per status PDU, %6.2f allocations per status PDU\n",
+         nack_meas.us / nof_status,
+         (double)nack_meas.allocs / nof_status);
+  printf("Retransmission:       %10.1f PDUs/s, %6.2f allocations per PDU\n",
+         nof_retx_pdus * 1e6 / retx_meas.us,
+         (double)retx_meas.allocs / nof_retx_pdus);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
+
+void usage(char* prog)
+{
+  printf("Usage: %s [nlswkrb]\n", prog);
+  printf("\t-n number of SDUs [Default %d]\n", nof_sdus);
+  printf("\t-l SDU size in bytes [Default %d]\n", sdu_len);
+  printf("\t-s number of segments per SDU [Default %d]\n", nof_segments);
+  printf("\t-w number of SDUs in flight [Default %d]\n", nof_inflight);
+  printf("\t-k number of NACK ranges per status PDU [Default %d]\n", nof_nack_ranges);
+  printf("\t-r number of status PDUs [Default %d]\n", nof_status);
+  printf("\t-b SN size in bits, 12 or 18 [Default %d]\n", sn_size);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nlswkrb")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_sdus = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'l':
+        sdu_len = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 's':
+        nof_segments = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'w':
+        nof_inflight = std::min(std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10)), 255U);
+        break;
+      case 'k':
+        nof_nack_ranges = std::max(2U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'r':
+        nof_status = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'b':
+        sn_size = strtol(argv[optind], NULL, 10) == 12 ? 12 : 18;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  // The SDUs with NACKs must fit in the Tx window
+  srsran::rlc_am_nr_sn_size_t sn_field =
+      sn_size == 12 ? srsran::rlc_am_nr_sn_size_t::size12bits : srsran::rlc_am_nr_sn_size_t::size18bits;
+  nof_nack_ranges = std::min(nof_nack_ranges, srsran::am_window_size(sn_field) / 3);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("RLC_TX").set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("RLC_RX").set_level(srslog::basic_levels::warning);
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsran::run_segmentation_benchmark() == SRSRAN_SUCCESS);
+  TESTASSERT(srsran::run_status_benchmark() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
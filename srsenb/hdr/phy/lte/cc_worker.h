@@ -22,6 +22,8 @@
 #ifndef SRSENB_CC_WORKER_H
 #define SRSENB_CC_WORKER_H
 
+#include <array>
+#include <chrono>
 #include <string.h>
 
 #include "../phy_common.h"
@@ -35,6 +37,9 @@ namespace lte {
 class cc_worker
 {
 public:
+  /// Maximum number of subframes of the worker in flight in the pipeline, each uses its own slot for the UL to DL state
+  const static uint32_t max_stage_slots = 4;
+
   cc_worker(srslog::basic_logger& logger);
   ~cc_worker();
   void init(phy_common* phy, uint32_t cc_idx);
@@ -55,13 +60,17 @@ public:
   int  read_pucch_d(cf_t* pusch_d);
   void start_plot();
 
-  void work_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_t& ul_grants);
+  /// The UL and DL processing of different subframes can run concurrently. The PHICH of the DL processing uses the
+  /// PUSCH resources decoded by the UL processing with the same slot
+  void work_ul(const srsran_ul_sf_cfg_t& ul_sf, stack_interface_phy_lte::ul_sched_t& ul_grants, uint32_t slot = 0);
   void work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                stack_interface_phy_lte::dl_sched_t& dl_grants,
                stack_interface_phy_lte::ul_sched_t& ul_grants,
-               srsran_mbsfn_cfg_t*                  mbsfn_cfg);
+               srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+               uint32_t                             slot = 0);
 
-  uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
+  uint32_t         get_metrics(std::vector<phy_metrics_t>& metrics);
+  phy_cc_metrics_t get_cc_metrics();
 
 private:
   constexpr static float PUSCH_RL_SNR_DB_TH = 1.0f;
@@ -77,6 +86,7 @@ private:
   int  encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_grants);
   int  decode_pucch();
+  void metrics_proc_time(std::chrono::steady_clock::time_point t_start, bool is_ul);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -85,16 +95,21 @@ private:
 
   cf_t*    signal_buffer_rx[SRSRAN_MAX_PORTS] = {};
   cf_t*    signal_buffer_tx[SRSRAN_MAX_PORTS] = {};
-  uint32_t tti_rx = 0, tti_tx_dl = 0, tti_tx_ul = 0;
+  uint32_t tti_rx = 0; ///< DL processing takes its TTI from the DL subframe configuration
 
   srsran_enb_dl_t enb_dl = {};
   srsran_enb_ul_t enb_ul = {};
 
-  srsran_dl_sf_cfg_t dl_sf = {};
-  srsran_ul_sf_cfg_t ul_sf = {};
+  srsran_dl_sf_cfg_t dl_sf   = {};
+  srsran_ul_sf_cfg_t ul_sf   = {};
+  uint32_t           dl_slot = 0;
+  uint32_t           ul_slot = 0;
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
 
+  // Carrier processing time, the UL and DL times are protected by the UL and DL mutexes respectively
+  phy_cc_metrics_t cc_metrics = {};
+
   // Class to store user information
   class ue
   {
@@ -104,7 +119,7 @@ private:
       // Do nothing
     }
 
-    srsran_phich_grant_t phich_grant = {};
+    std::array<srsran_phich_grant_t, max_stage_slots> phich_grant = {};
 
     void     metrics_read(phy_metrics_t* metrics);
     void     metrics_dl(uint32_t mcs);
@@ -121,8 +136,10 @@ private:
   uint32_t cc_idx = 0;
 
   // Each worker keeps a local copy of the user database. Uses more memory but more efficient to manage concurrency
+  // The UL and DL processing lock each their own mutex. Changes to the user database lock both
   std::map<uint16_t, ue*> ue_db;
-  std::mutex              mutex;
+  std::mutex              ul_mutex;
+  std::mutex              dl_mutex;
 };
 
 } // namespace lte
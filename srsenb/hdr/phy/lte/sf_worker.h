@@ -22,6 +22,8 @@
 #ifndef SRSENB_PHCH_WORKER_H
 #define SRSENB_PHCH_WORKER_H
 
+#include <condition_variable>
+#include <functional>
 #include <mutex>
 #include <string.h>
 
@@ -38,7 +40,7 @@ class sf_worker : public srsran::thread_pool::worker
 public:
   sf_worker(srslog::basic_logger& logger) : logger(logger) {}
   ~sf_worker();
-  void init(phy_common* phy);
+  void init(phy_common* phy, int prio = -1, srsran::task_thread_pool* cc_pool = nullptr);
 
   cf_t* get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx);
   void  set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
@@ -57,9 +59,39 @@ public:
   void     start_plot();
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
+  void     get_cc_metrics(std::vector<phy_cc_metrics_t>& metrics);
+
+  /// Blocks until the pipeline stages (if any) have finished processing all the subframes handed over to them
+  void wait_pipeline();
+
+  /// Finishes the subframes in the pipeline stages and stops their threads. The carrier pool must still be running
+  void stop_pipeline();
 
 private:
+  /// Subframe state handed over from one pipeline stage to the next
+  struct stage_ctxt_t {
+    srsran::phy_common_interface::worker_context_t w_ctx     = {};
+    srsran_dl_sf_cfg_t                             dl_sf     = {};
+    srsran_mbsfn_cfg_t                             mbsfn_cfg = {};
+    uint32_t                                       tti_tx_dl = 0;
+    uint32_t                                       tti_tx_ul = 0;
+    uint32_t                                       slot      = 0;
+    stack_interface_phy_lte::dl_sched_list_t       dl_grants;
+    stack_interface_phy_lte::ul_sched_list_t       ul_grants_tx;
+  };
+
   void work_imp() final;
+  /// Runs the MAC scheduling and DL encoding of the subframe in the given slot, in the stage threads if pipelined.
+  /// Without scheduling, the subframe is ended without transmission
+  void run_tx_stages(uint32_t slot, bool schedule);
+  bool work_mac_stage(stage_ctxt_t& ctxt);
+  void work_dl_stage(stage_ctxt_t& ctxt);
+  void skip_dl_stage(stage_ctxt_t& ctxt);
+  void release_stage_slot();
+
+  /// Runs the given task for every carrier, fanning the carriers out to the carrier pool when it is available. It
+  /// returns once all the carriers have been processed.
+  void run_carriers(const std::function<void(uint32_t)>& task);
 
   /* Common objects */
   srslog::basic_logger& logger;
@@ -73,6 +105,20 @@ private:
   srsran::phy_common_interface::worker_context_t context = {};
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+
+  // Pool shared by all workers for processing the component carriers in parallel
+  srsran::task_thread_pool* cc_pool = nullptr;
+
+  // Pipeline, only used when the UL processing, the MAC scheduling and the DL encoding run in different threads. Each
+  // subframe takes one of the stage context slots until it is transmitted, so that at most the pipeline depth
+  // subframes of this worker are in flight
+  std::unique_ptr<srsran::task_worker> mac_stage;
+  std::unique_ptr<srsran::task_worker> dl_stage;
+  std::vector<stage_ctxt_t>            stage_ctxts;
+  uint32_t                             stage_seq      = 0; ///< Number of subframes that entered the pipeline
+  uint32_t                             nof_busy_slots = 0;
+  std::mutex                           stage_mutex;
+  std::condition_variable              stage_cvar;
 };
 
 } // namespace lte
@@ -22,11 +22,14 @@
 #ifndef SRSENB_NR_SLOT_WORKER_H
 #define SRSENB_NR_SLOT_WORKER_H
 
+#include "srsenb/hdr/phy/phy_metrics.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/gnb_interfaces.h"
 #include "srsran/interfaces/phy_common_interface.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
+#include <chrono>
+#include <condition_variable>
 
 namespace srsenb {
 namespace nr {
@@ -68,6 +71,7 @@ public:
     uint32_t                    pusch_max_its    = 10;
     float                       pusch_min_snr_dB = -10.0f;
     double                      srate_hz         = 0.0;
+    srsran::task_thread_pool*   task_pool        = nullptr; ///< Runs the UL processing as a separate task if set
   };
 
   slot_worker(srsran::phy_common_interface& common_,
@@ -88,6 +92,9 @@ public:
   uint32_t get_buffer_len();
   void     set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
 
+  /* Metrics interface, the processing times are reset after reading */
+  void get_metrics(phy_cc_metrics_t& m);
+
 private:
   /**
    * @brief Inherited from thread_pool::worker. Function called every slot to run the DL/UL processing
@@ -100,12 +107,42 @@ private:
    */
   bool work_ul();
 
+  /**
+   * @brief Retrieves the UL scheduling results, demodulates the slot and decodes the UCI (PUCCH and the PUSCH carrying
+   * UCI), so that HARQ-ACK and CSI feedback reaches the stack before the DL scheduling of the same slot
+   * @return True if no error occurs, false otherwise
+   */
+  bool work_ul_uci();
+
+  /**
+   * @brief Decodes the PUSCH transmissions without UCI retrieved by work_ul_uci()
+   * @return True if no error occurs, false otherwise
+   */
+  bool work_ul_data();
+
+  /**
+   * @brief Decodes a PUSCH transmission and informs the stack
+   * @return True if no error occurs, false otherwise
+   */
+  bool decode_pusch(stack_interface_phy_nr::pusch_t& pusch);
+
   /**
    * @brief Retrieves the scheduling results for the DL processing and performs transmission
    * @return True if no error occurs, false otherwise
    */
   bool work_dl();
 
+  /**
+   * @brief Decodes the UL feedback, then runs the UL data decoding in the task pool and the DL processing in the
+   * calling thread. The DL is handed to the radio as soon as it is ready, without waiting for the UL data decoding
+   */
+  void work_tasks(srsran::rf_buffer_t& tx_rf_buffer);
+
+  /**
+   * @brief Accumulates the processing time of the UL or DL processing since the given start time
+   */
+  void metrics_proc_time(std::chrono::steady_clock::time_point t_start, bool is_ul);
+
   srsran::phy_common_interface& common;
   stack_interface_phy_nr&       stack;
   srslog::basic_logger&         logger;
@@ -123,6 +160,20 @@ private:
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
+
+  // Task mode, the UL data decoding runs in the task pool while the DL processing runs in the worker thread
+  srsran::task_thread_pool* task_pool  = nullptr;
+  bool                      ul_pending = false;
+  std::mutex                ul_mutex;
+  std::condition_variable   ul_cvar;
+
+  // UL scheduling of the current slot, shared between the UCI and the data decoding
+  stack_interface_phy_nr::ul_sched_t* ul_sched    = nullptr;
+  std::chrono::steady_clock::duration ul_uci_time = {};
+
+  // Processing time metrics
+  std::mutex       metrics_mutex;
+  phy_cc_metrics_t metrics = {};
 };
 
 } // namespace nr
@@ -92,6 +92,7 @@ private:
   srslog::sink&                              log_sink;
   srsran::thread_pool                        pool;
   std::vector<std::unique_ptr<slot_worker> > workers;
+  srsran::task_thread_pool                   task_pool; ///< Runs the UL processing tasks in task mode
   prach_worker_pool                          prach;
   uint32_t                                   current_tti = 0; ///< Current TTI, read and write from same thread
   srslog::basic_logger&                      logger;
@@ -107,6 +108,7 @@ public:
     uint32_t               prio              = 52;
     uint32_t               pusch_max_its     = 10;
     float                  pusch_min_snr_dB  = -10;
+    bool                   slot_tasks        = false; ///< Process UL and DL of a slot as independent tasks
     srsran::phy_log_args_t log               = {};
   };
   slot_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
@@ -121,6 +123,7 @@ public:
   void         start_worker(slot_worker* w);
   void         stop();
   int          set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common_cfg);
+  void         get_metrics(phy_cc_metrics_t& m);
 };
 
 } // namespace nr
@@ -66,6 +66,12 @@ struct phy_args_t {
   bool                    pusch_8bit_decoder  = false;
   float                   tx_amplitude        = 1.0f;
   uint32_t                nof_phy_threads     = 1;
+  bool                    lte_pipeline        = false;
+  uint32_t                lte_pipeline_depth  = 2;
+  uint32_t                lte_mac_stage_mask  = 255;
+  uint32_t                lte_dl_stage_mask   = 255;
+  uint32_t                nof_phy_cc_threads  = 0;
+  bool                    nr_slot_tasks       = false;
   std::string             equalizer_mode      = "mmse";
   float                   estimator_fil_w     = 1.0f;
   bool                    pusch_meas_epre     = true;
@@ -23,6 +23,7 @@
 #define SRSENB_PHY_METRICS_H
 
 #include <limits>
+#include <stdint.h>
 
 namespace srsenb {
 
@@ -53,6 +54,17 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// PHY processing time metrics per carrier
+
+struct phy_cc_metrics_t {
+  float ul_time_us;     ///< Average UL processing time per subframe
+  float ul_max_time_us; ///< Maximum UL processing time
+  float dl_time_us;     ///< Average DL processing time per subframe
+  float dl_max_time_us; ///< Maximum DL processing time
+  int   ul_n_samples;
+  int   dl_n_samples;
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
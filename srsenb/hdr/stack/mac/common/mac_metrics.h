@@ -72,6 +72,8 @@ struct mac_metrics_t {
   std::vector<mac_cc_info_t> cc_info;
   /// Per UE MAC metrics.
   std::vector<mac_ue_metrics_t> ues;
+  /// Number of TTIs whose scheduling result was not ready when fetched by the PHY (scheduler look-ahead).
+  uint32_t nof_late_sched_results;
 };
 
 } // namespace srsenb
@@ -24,10 +24,13 @@
 
 #include "sched_grid.h"
 #include "sched_interface.h"
+#include "sched_trace.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/adt/circular_array.h"
 #include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 
 namespace srsenb {
@@ -89,12 +92,18 @@ public:
   std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_activ_cc_map(uint16_t rnti) final;
   int                                  ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes) final;
   int                                  metrics_read(uint16_t rnti, mac_ue_metrics_t& metrics);
+  uint32_t                             get_nof_late_results() const { return nof_late_results; }
 
   class carrier_sched;
+  class ue_event_manager;
+  class lookahead_worker;
 
 protected:
-  void new_tti(srsran::tti_point tti_rx);
-  bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
+  const sf_sched_result* get_tti_result(srsran::tti_point tti_rx);
+  void                   generate_tti(srsran::tti_point tti_rx);
+  void                   new_tti(srsran::tti_point tti_rx);
+  bool                   is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
+  bool                   is_ready(srsran::tti_point tti_rx) const;
   // Helper methods
   template <typename Func>
   int ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
@@ -106,12 +115,26 @@ protected:
 
   rnti_map_t<std::unique_ptr<sched_ue> > ue_db;
 
+  // buffer state and CSI updates, applied to ue_db at the start of the next TTI
+  std::unique_ptr<ue_event_manager> ue_events;
+
   // independent schedulers for each carrier
   std::vector<std::unique_ptr<carrier_sched> > carrier_schedulers;
 
   // Storage of past scheduling results
   sched_result_ringbuffer sched_results;
 
+  // TTIs whose results are complete and can be read by the PHY without the sched lock
+  srsran::circular_array<std::atomic<uint32_t>, TTIMOD_SZ> ready_ttis;
+
+  // Generation of the results of future TTIs in the background, when sched_cfg.lookahead_ttis > 0
+  std::unique_ptr<lookahead_worker> lookahead;
+  std::atomic<uint32_t>             nof_late_results{0};
+
+  // Recording of the scheduler inputs, when sched_cfg.trace_filename is set. Written under sched_mutex, when the
+  // inputs are applied to the scheduler state, so that the trace keeps their order relative to the TTI generation
+  sched_trace_writer trace;
+
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
@@ -30,6 +30,7 @@
 #include "srsran/adt/bounded_bitset.h"
 #include "srsran/adt/circular_array.h"
 #include "srsran/srslog/srslog.h"
+#include <array>
 #include <vector>
 
 namespace srsenb {
@@ -83,6 +84,16 @@ private:
   srsran::circular_array<sf_sched_result, TTIMOD_SZ> results;
 };
 
+/// Number of rank-1 codebook entries for 2 antenna ports (TS 36.211, Table 6.3.4.2.3-1)
+constexpr uint32_t nof_mu_mimo_pmis = 4;
+
+/// Returns the rank-1 PMI whose precoder is orthogonal to the one of the given PMI, for 2 antenna ports
+inline uint32_t get_orthogonal_pmi(uint32_t pmi)
+{
+  static constexpr std::array<uint32_t, nof_mu_mimo_pmis> orth_pmi_table = {1, 0, 3, 2};
+  return orth_pmi_table[pmi];
+}
+
 /// manages a subframe grid resources, namely CCE and DL/UL RB allocations
 class sf_grid_t
 {
@@ -92,7 +103,7 @@ public:
   void         init(const sched_cell_params_t& cell_params_);
   void         new_tti(tti_point tti_rx);
   alloc_result alloc_dl_ctrl(uint32_t aggr_lvl, rbg_interval rbg_range, alloc_type_t alloc_type);
-  alloc_result alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, bool has_pusch_grant);
+  alloc_result alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, bool has_pusch_grant, bool is_newtx);
   bool         reserve_dl_rbgs(uint32_t start_rbg, uint32_t end_rbg);
   void         rem_last_alloc_dl(rbg_interval rbgs);
 
@@ -107,13 +118,20 @@ public:
   uint32_t                get_cfi() const { return pdcch_alloc.get_cfi(); }
   const sf_cch_allocator& get_pdcch_grid() const { return pdcch_alloc; }
   uint32_t                get_pucch_width() const { return pucch_nrb; }
+  const rbgmask_t&        get_dl_paired_mask() const { return dl_paired_mask; }
+
+  // MU-MIMO
+  int       get_pairing_pmi(sched_ue* user) const;
+  rbgmask_t get_dl_mask(sched_ue* user) const;
+  bool      is_dl_full() const;
 
 private:
   alloc_result alloc_dl(uint32_t     aggr_lvl,
                         alloc_type_t alloc_type,
                         rbgmask_t    alloc_mask,
                         sched_ue*    user            = nullptr,
-                        bool         has_pusch_grant = false);
+                        bool         has_pusch_grant = false,
+                        int          pmi             = -1);
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -129,6 +147,10 @@ private:
   tti_point tti_rx;
   rbgmask_t dl_mask = {};
   prbmask_t ul_mask = {};
+
+  // MU-MIMO state. RBGs allocated to a rank-1 TM4 UE are pairable with a UE that reported the orthogonal PMI
+  std::array<rbgmask_t, nof_mu_mimo_pmis> dl_pairable_masks = {};
+  rbgmask_t                               dl_paired_mask    = {};
 };
 
 /** Description: Stores the RAR, broadcast, paging, DL data, UL data allocations for the given subframe
@@ -207,6 +229,8 @@ public:
   tti_point                       get_tti_tx_dl() const { return to_tx_dl(tti_rx); }
   uint32_t                        get_nof_ctrl_symbols() const;
   const rbgmask_t&                get_dl_mask() const { return tti_alloc.get_dl_mask(); }
+  rbgmask_t                       get_dl_mask(sched_ue* user) const { return tti_alloc.get_dl_mask(user); }
+  bool                            is_dl_full() const { return tti_alloc.is_dl_full(); }
   alloc_result                    alloc_ul_user(sched_ue* user, prb_interval alloc);
   const prbmask_t&                get_ul_mask() const { return tti_alloc.get_ul_mask(); }
   tti_point                       get_tti_tx_ul() const { return to_tx_ul(tti_rx); }
@@ -80,6 +80,10 @@ public:
     int         init_dl_cqi               = 5;
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    uint32_t    max_pdcch_search_nodes    = 1024;
+    bool        mu_mimo_enabled           = false;
+    uint32_t    lookahead_ttis            = 0;
+    std::string trace_filename;           ///< If not empty, the scheduler inputs are recorded to this file
   };
 
   struct cell_cfg_t {
@@ -194,6 +198,7 @@ public:
     uint32_t        tbs[SRSRAN_MAX_TB];
     bool            mac_ce_ta;
     bool            mac_ce_rnti;
+    uint32_t        mu_mimo_rbg_mask; ///< RBGs shared with another UE's PDSCH precoded with an orthogonal PMI
     uint32_t        nof_pdu_elems[SRSRAN_MAX_TB];
     dl_sched_pdu_t  pdu[SRSRAN_MAX_TB][MAX_RLC_PDU_LIST];
   };
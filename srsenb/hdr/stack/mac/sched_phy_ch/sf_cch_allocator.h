@@ -62,6 +62,9 @@ public:
 
   void rem_last_dci();
 
+  /// Number of DFS nodes visited in the last call to alloc_dci
+  uint32_t last_search_nof_nodes() const { return nof_search_nodes; }
+
   // getters
   uint32_t    get_cfi() const { return current_cfix + 1; }
   void        get_allocs(alloc_result_t* vec = nullptr, pdcch_mask_t* tot_mask = nullptr, size_t idx = 0) const;
@@ -78,10 +81,12 @@ private:
     sched_ue*    user;
   };
   const cce_cfi_position_table* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
+  bool                          is_known_failure(const alloc_record& record) const;
+  bool                          search_budget_exceeded() const;
 
   // PDCCH allocation algorithm
   bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
-  bool get_next_dfs();
+  bool get_next_dfs(uint32_t min_nof_cces);
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -94,6 +99,11 @@ private:
   uint32_t                  current_max_cfix = 0;
   std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
   std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+  uint32_t                  nof_alloc_cces = 0; ///< Sum of the CCEs occupied by the allocations in dci_record_list
+  /// DCI allocations that failed after an exhaustive search. Given that the PDCCH only gets fuller during the TTI,
+  /// an identical request is bound to fail again
+  std::vector<alloc_record> failed_record_list;
+  uint32_t                  nof_search_nodes = 0; ///< DFS nodes visited by the ongoing/last alloc_dci call
 };
 
 // Helper methods
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_TRACE_H
+#define SRSRAN_SCHED_TRACE_H
+
+#include "sched_interface.h"
+#include "srsran/common/tti_point.h"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace srsenb {
+
+struct sf_sched_result;
+
+/// Types of the records of a scheduler trace
+enum class sched_trace_ev : uint8_t {
+  sched_args,
+  cell_cfg,
+  reset,
+  ue_cfg,
+  ue_rem,
+  phy_cfg,
+  bearer_cfg,
+  bearer_rem,
+  dl_rlc_buffer_state,
+  dl_mac_buffer_state,
+  dl_ack_info,
+  ul_crc_info,
+  dl_ri_info,
+  dl_pmi_info,
+  dl_cqi_info,
+  dl_sb_cqi_info,
+  dl_rach_info,
+  ul_snr_info,
+  ul_sr_info,
+  ul_bsr,
+  ul_buffer_add,
+  ul_phr,
+  dl_tti_mask,
+  pdcch_order,
+  tti_result,
+  nulltype
+};
+
+/// Summary of the scheduling decision of a TTI, used to compare the recorded and replayed decisions
+struct sched_trace_result {
+  struct grant_t {
+    uint16_t                            rnti;
+    uint32_t                            ncce;
+    uint32_t                            alloc; ///< RBG bitmask for DL type0 allocations, RIV otherwise
+    std::array<uint32_t, SRSRAN_MAX_TB> tbs;
+
+    bool operator==(const grant_t& other) const
+    {
+      return rnti == other.rnti and ncce == other.ncce and alloc == other.alloc and tbs == other.tbs;
+    }
+    bool operator!=(const grant_t& other) const { return not(*this == other); }
+  };
+  struct cc_result_t {
+    uint32_t             cfi      = 0;
+    uint32_t             nof_bcch = 0;
+    uint32_t             nof_rar  = 0;
+    uint32_t             nof_po   = 0;
+    std::vector<grant_t> dl_grants;
+    std::vector<grant_t> ul_grants;
+    std::vector<uint16_t> phich_nacks;
+
+    bool operator==(const cc_result_t& other) const
+    {
+      return cfi == other.cfi and nof_bcch == other.nof_bcch and nof_rar == other.nof_rar and nof_po == other.nof_po and
+             dl_grants == other.dl_grants and ul_grants == other.ul_grants and phich_nacks == other.phich_nacks;
+    }
+    bool operator!=(const cc_result_t& other) const { return not(*this == other); }
+  };
+
+  srsran::tti_point        tti_rx;
+  std::vector<cc_result_t> cc_list;
+};
+
+/// Summarizes the scheduling decision of all carriers for the TTI of sf_res
+sched_trace_result make_sched_trace_result(const sf_sched_result& sf_res);
+
+/**
+ * Records the inputs of the LTE scheduler (configurations, buffer states, CSI and HARQ feedback) and a summary of its
+ * decisions to a binary trace, in the order they reach the scheduler. The trace encodes the structures in the host
+ * byte order and layout, so it is meant to be replayed by a build of the same platform. The trace header carries a
+ * signature of that layout and every record its version, so that traces of another build are rejected.
+ * The methods are thread-safe, as the inputs reach the scheduler from the PHY, RLC and stack threads. The records are
+ * only buffered, the file is written by flush(), which the scheduler calls outside of its lock.
+ */
+class sched_trace_writer
+{
+public:
+  ~sched_trace_writer() { close(); }
+
+  bool open(const char* filename, const sched_interface::sched_args_t& sched_args);
+  void close();
+  bool is_open() const { return fd.load(std::memory_order_relaxed) != nullptr; }
+  /// Writes the buffered records to the file
+  void flush();
+
+  void cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg);
+  void reset();
+  void ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg);
+  void ue_rem(uint16_t rnti);
+  void phy_config_enabled(uint16_t rnti, bool enabled);
+  void bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, const mac_lc_ch_cfg_t& cfg);
+  void bearer_ue_rem(uint16_t rnti, uint32_t lc_id);
+  void dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue);
+  void dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds);
+  void dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack);
+  void ul_crc_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, bool crc);
+  void dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value);
+  void dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value);
+  void dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value);
+  void dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value);
+  void dl_rach_info(uint32_t enb_cc_idx, const sched_interface::dl_sched_rar_info_t& rar_info);
+  void ul_snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code);
+  void ul_sr_info(uint32_t tti, uint16_t rnti);
+  void ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr);
+  void ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes);
+  void ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb);
+  void set_dl_tti_mask(const uint8_t* tti_mask, uint32_t nof_sfs);
+  void set_pdcch_order(uint32_t enb_cc_idx, const sched_interface::dl_sched_po_info_t& pdcch_order_info);
+  /// Records the generation of the decision of a TTI. Replaying it triggers the generation of the same TTI
+  void tti_result(const sf_sched_result& sf_res);
+
+private:
+  template <typename... Args>
+  void write(sched_trace_ev type, const Args&... args);
+
+  std::mutex           mutex;      ///< protects the pending records
+  std::mutex           file_mutex; ///< keeps the order of the records when several threads flush
+  std::atomic<FILE*>   fd{nullptr};
+  std::vector<uint8_t> pending, flushing;
+};
+
+/// Reads a scheduler trace, forwarding the recorded scheduler inputs to a sched_interface
+class sched_trace_reader
+{
+public:
+  /// Handler of the recorded events that are not part of sched_interface
+  class handler
+  {
+  public:
+    virtual ~handler()                                                      = default;
+    virtual void on_sched_args(const sched_interface::sched_args_t& args)  = 0;
+    virtual void on_phy_config_enabled(uint16_t rnti, bool enabled)        = 0;
+    virtual void on_tti_result(const sched_trace_result& recorded_result) = 0;
+  };
+
+  ~sched_trace_reader() { close(); }
+
+  bool open(const char* filename);
+  void close();
+
+  /// Reads the next record of the trace and forwards it to sched or to h
+  /// @return type of the record, or sched_trace_ev::nulltype at the end of the trace or if the record is invalid
+  sched_trace_ev read_next(sched_interface& sched, handler& h);
+
+private:
+  FILE*                fd = nullptr;
+  std::vector<uint8_t> buffer;
+};
+
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_TRACE_H
@@ -81,6 +81,7 @@ public:
   uint16_t                  get_rnti() const { return rnti; }
   std::pair<bool, uint32_t> get_active_cell_index(uint32_t enb_cc_idx) const;
   const ue_cfg_t&           get_ue_cfg() const { return cfg; }
+  uint32_t                  get_cfg_version() const { return cfg_version; } ///< Incremented by every set_cfg()
   uint32_t                  get_aggr_level(uint32_t enb_cc_idx, uint32_t nof_bits);
   void                      ul_buffer_add(uint8_t lcid, uint32_t bytes);
   void                      metrics_read(mac_ue_metrics_t& metrics);
@@ -166,7 +167,8 @@ private:
                                tti_point              tti_tx_dl,
                                const rbgmask_t&       rbgs,
                                uint32_t               cfi,
-                               const srsran_dci_dl_t& dci);
+                               const srsran_dci_dl_t& dci,
+                               int                    cqi_offset);
 
   bool needs_cqi(uint32_t tti, uint32_t enb_cc_idx, bool will_send = false);
 
@@ -202,8 +204,9 @@ private:
                        const rbgmask_t&                  user_mask);
 
   /* Args */
-  ue_cfg_t                   cfg  = {};
-  srsran_cell_t              cell = {};
+  ue_cfg_t                   cfg         = {};
+  uint32_t                   cfg_version = 0;
+  srsran_cell_t              cell        = {};
   srslog::basic_logger&      logger;
   const sched_cell_params_t* main_cc_params = nullptr;
 
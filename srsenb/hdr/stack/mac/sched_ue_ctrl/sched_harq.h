@@ -33,7 +33,7 @@ class harq_proc
 {
 public:
   harq_proc();
-  void init(uint32_t id);
+  void init(uint32_t id, uint32_t feedback_delay_ = 0);
   void reset(uint32_t tb_idx);
 
   uint32_t get_id() const { return id; }
@@ -56,16 +56,17 @@ protected:
 
   enum ack_t { NACK, ACK };
 
-  srslog::basic_logger*               logger    = nullptr;
-  std::array<bool, SRSRAN_MAX_TB>     ack_state = {};
-  std::array<bool, SRSRAN_MAX_TB>     active    = {};
-  std::array<bool, SRSRAN_MAX_TB>     ndi       = {};
-  uint32_t                            id        = 0;
-  uint32_t                            max_retx  = 5;
-  std::array<uint32_t, SRSRAN_MAX_TB> n_rtx     = {};
-  std::array<uint32_t, SRSRAN_MAX_TB> tx_cnt    = {};
-  std::array<int, SRSRAN_MAX_TB>      last_mcs  = {};
-  std::array<int, SRSRAN_MAX_TB>      last_tbs  = {};
+  srslog::basic_logger*               logger         = nullptr;
+  std::array<bool, SRSRAN_MAX_TB>     ack_state      = {};
+  std::array<bool, SRSRAN_MAX_TB>     active         = {};
+  std::array<bool, SRSRAN_MAX_TB>     ndi            = {};
+  uint32_t                            id             = 0;
+  uint32_t                            max_retx       = 5;
+  uint32_t                            feedback_delay = 0;
+  std::array<uint32_t, SRSRAN_MAX_TB> n_rtx          = {};
+  std::array<uint32_t, SRSRAN_MAX_TB> tx_cnt         = {};
+  std::array<int, SRSRAN_MAX_TB>      last_mcs       = {};
+  std::array<int, SRSRAN_MAX_TB>      last_tbs       = {};
   srsran::tti_point                   tti;
 };
 
@@ -100,7 +101,7 @@ private:
 class ul_harq_proc : public harq_proc
 {
 public:
-  void new_tti();
+  void new_tti(srsran::tti_point tti_rx);
 
   void new_tx(srsran::tti_point tti, int mcs, int tbs, prb_interval alloc, uint32_t max_retx_, bool is_msg3);
   void new_retx(srsran::tti_point tti_, int* mcs, int* tbs, prb_interval alloc);
@@ -109,6 +110,8 @@ public:
 
   prb_interval get_alloc() const;
   bool         has_pending_retx() const;
+  /// Checks whether the CRC of the last PUSCH is still unknown when scheduling tti_rx (scheduler look-ahead)
+  bool         has_pending_crc(srsran::tti_point tti_rx) const;
   bool         is_msg3() const { return is_msg3_; }
 
   void     reset_pending_data();
@@ -131,7 +134,7 @@ class harq_entity
 public:
   static const bool is_async = ASYNC_DL_SCHED;
 
-  harq_entity(size_t nof_dl_harqs, size_t nof_ul_harqs);
+  harq_entity(size_t nof_dl_harqs, size_t nof_ul_harqs, uint32_t feedback_delay = 0);
 
   void reset();
   void new_tti(tti_point tti_rx);
@@ -117,12 +117,17 @@ private:
  *                    TBS/MCS derivation
  ************************************************************/
 
+/// CQI backoff of a PDSCH sharing RBGs in MU-MIMO. Its power in those RBGs is halved, which lowers the SINR by 3 dB,
+/// and the CQIs of TS 36.213, Table 7.2.3-1 are roughly 2 dB apart
+constexpr int mu_mimo_dl_cqi_offset = -2;
+
 /// Compute DL grant optimal TBS and MCS given UE cell context and DL grant parameters
 tbs_info cqi_to_tbs_dl(const sched_ue_cell& cell,
                        const rbgmask_t&     rbgs,
                        uint32_t             nof_re,
                        srsran_dci_format_t  dci_format,
-                       uint32_t             req_bytes = std::numeric_limits<uint32_t>::max());
+                       uint32_t             req_bytes  = std::numeric_limits<uint32_t>::max(),
+                       int                  cqi_offset = 0);
 
 /// Compute UL grant optimal TBS and MCS given UE cell context and UL grant parameters
 tbs_info
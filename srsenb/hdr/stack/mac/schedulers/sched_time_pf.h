@@ -25,7 +25,8 @@
 #include "sched_base.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/circular_map.h"
-#include <queue>
+#include "srsran/adt/indexed_heap.h"
+#include "srsran/mac/pf_metric.h"
 
 namespace srsenb {
 
@@ -45,49 +46,48 @@ private:
   float                      fairness_coeff = 1;
 
   srsran::tti_point current_tti_rx;
+  uint64_t          tti_count = 0; ///< TTIs elapsed since the scheduler was created
 
   struct ue_ctxt {
-    ue_ctxt(uint16_t rnti_, float fairness_coeff_) : rnti(rnti_), fairness_coeff(fairness_coeff_) {}
-    float    dl_avg_rate() const { return dl_nof_samples == 0 ? 0 : dl_avg_rate_; }
-    float    ul_avg_rate() const { return ul_nof_samples == 0 ? 0 : ul_avg_rate_; }
-    uint32_t dl_count() const { return dl_nof_samples; }
-    uint32_t ul_count() const { return ul_nof_samples; }
-    void     new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
-    void     save_dl_alloc(uint32_t alloc_bytes, float alpha);
-    void     save_ul_alloc(uint32_t alloc_bytes, float alpha);
+    ue_ctxt(uint16_t rnti_, uint32_t id_, float fairness_coeff_, uint64_t now) :
+      rnti(rnti_), id(id_), dl(fairness_coeff_, now), ul(fairness_coeff_, now)
+    {}
+    void new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched, uint64_t now);
 
     const uint16_t rnti;
-    const float    fairness_coeff;
-
-    int                 ue_cc_idx  = 0;
-    float               dl_prio    = 0;
-    float               ul_prio    = 0;
-    const dl_harq_proc* dl_retx_h  = nullptr;
-    const dl_harq_proc* dl_newtx_h = nullptr;
-    const ul_harq_proc* ul_h       = nullptr;
-
-  private:
-    float    dl_avg_rate_   = 0;
-    float    ul_avg_rate_   = 0;
-    uint32_t dl_nof_samples = 0;
-    uint32_t ul_nof_samples = 0;
+    const uint32_t id; ///< index in the priority heaps
+
+    int                 ue_cc_idx      = 0;
+    const dl_harq_proc* dl_retx_h      = nullptr;
+    const dl_harq_proc* dl_newtx_h     = nullptr;
+    const ul_harq_proc* ul_h           = nullptr;
+    bool                dl_key_changed = false;
+    bool                ul_key_changed = false;
+    uint64_t            ul_visit_tti   = UINT64_MAX;
+    int                 dl_cqi         = -1; ///< CQI, RI and PMI used to derive the DL expected rate
+    uint32_t            dl_ri          = 0;
+    uint32_t            dl_pmi         = 0;
+    int                 ul_cqi         = -1; ///< CQI used to derive the UL expected rate
+    uint32_t            cfg_version    = 0; ///< UE configuration used to derive the expected rates
+
+    srsran::pf_metric dl;
+    srsran::pf_metric ul;
   };
 
-  rnti_map_t<ue_ctxt> ue_history_db;
+  rnti_map_t<ue_ctxt>   ue_history_db;
+  std::vector<ue_ctxt*> ue_by_id;
+  std::vector<uint32_t> free_ids;
 
-  struct ue_dl_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
-  };
-  struct ue_ul_prio_compare {
-    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
-  };
-
-  using ue_dl_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_dl_prio_compare>;
-  using ue_ul_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_ul_prio_compare>;
+  // UEs with new transmissions ordered by PF key, the retransmissions go first and are sorted every TTI
+  srsran::indexed_heap<double> dl_heap;
+  srsran::indexed_heap<double> ul_heap;
+  std::vector<ue_ctxt*>        dl_retx_list;
+  std::vector<ue_ctxt*>        ul_retx_list;
 
-  ue_dl_queue_t dl_queue;
-  ue_ul_queue_t ul_queue;
+  std::vector<std::pair<ue_ctxt*, uint32_t> > tti_allocs;
 
+  void     save_dl_allocs();
+  void     save_ul_allocs();
   uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
   uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
 };
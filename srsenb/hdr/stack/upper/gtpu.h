@@ -60,7 +60,12 @@ public:
   // A UE should have <= 3 DRBs active, and each DRB should have two tunnels active at the same time at most
   const static size_t MAX_TUNNELS_PER_UE = 10;
 
-  enum class tunnel_state { pdcp_active, buffering, forward_to, forwarded_from, inactive };
+  // Period at which a congested tunnel without new SDUs checks whether PDCP can accept the SDUs held back. A timer
+  // re-armed with 1 msec from its own callback would only expire after a full turn of the timer wheel
+  static const uint32_t congestion_poll_period_ms = 2;
+
+  /// In the congested state, the SDUs are held back while the RLC Tx queue of the bearer is above its watermarks
+  enum class tunnel_state { pdcp_active, buffering, congested, forward_to, forwarded_from, inactive };
 
   struct tunnel {
     uint16_t rnti          = SRSRAN_INVALID_RNTI;
@@ -71,6 +76,7 @@ public:
 
     tunnel_state                                    state = tunnel_state::pdcp_active;
     srsran::unique_timer                            rx_timer;
+    srsran::unique_timer                            congestion_timer;
     srsran::byte_buffer_pool_ptr<buffered_sdu_list> buffer;
     tunnel*                                         fwd_tunnel = nullptr; ///< forward Rx SDUs to this TEID
     srsran::move_callback<void()>                   on_removal;
@@ -103,7 +109,8 @@ public:
 
   explicit gtpu_tunnel_manager(srsran::task_sched_handle task_sched_,
                                srslog::basic_logger&     logger,
-                               srsran::srsran_rat_t      ran_type_);
+                               srsran::srsran_rat_t      ran_type_,
+                               size_t                    max_tunnels = SRSENB_MAX_UES * MAX_TUNNELS_PER_UE);
   void init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_);
 
   bool                           has_teid(uint32_t teid) const { return tunnels.contains(teid); }
@@ -120,14 +127,16 @@ public:
   void set_tunnel_priority(uint32_t first_teid, uint32_t second_teid);
   void handle_rx_pdcp_sdu(uint32_t teid);
   void buffer_pdcp_sdu(uint32_t teid, uint32_t pdcp_sn, srsran::unique_byte_buffer_t sdu);
+  void set_tunnel_congested(uint32_t teid);
+  void flush_congested_tunnel(uint32_t teid);
   void setup_forwarding(uint32_t rx_teid, uint32_t tx_teid);
 
   bool remove_tunnel(uint32_t teid);
   bool remove_rnti(uint16_t rnti);
 
 private:
-  using tunnel_list_t  = srsran::static_id_obj_pool<uint32_t, tunnel, SRSENB_MAX_UES * MAX_TUNNELS_PER_UE>;
-  using tunnel_ctxt_it = typename tunnel_list_t::iterator;
+  // TEID In -> tunnel. The TEID In indexes the tunnel array directly, so the per-packet lookup does not hash
+  using tunnel_list_t = srsran::dyn_id_obj_pool<uint32_t, tunnel>;
 
   // Used to differentiate whether GTPU is used in NR or LTE context.
   srsran::srsran_rat_t ran_type;
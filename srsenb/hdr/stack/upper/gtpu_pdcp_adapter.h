@@ -24,6 +24,7 @@
 
 #include "srsran/common/bearer_manager.h"
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
+#include "srsran/interfaces/enb_pdcp_interfaces.h"
 #include "srsran/srslog/logger.h"
 
 namespace srsenb {
@@ -73,6 +74,16 @@ public:
     logger.error("Bearer rnti=0x%x, eps-BearerID=%d not found", rnti, eps_bearer_id);
     return {};
   }
+  bool sdu_queue_is_congested(uint16_t rnti, uint32_t eps_bearer_id) override
+  {
+    auto bearer = bearers->get_radio_bearer(rnti, eps_bearer_id);
+    if (bearer.rat == srsran::srsran_rat_t::lte) {
+      return pdcp_lte_obj->sdu_queue_is_congested(rnti, bearer.lcid);
+    } else if (bearer.rat == srsran::srsran_rat_t::nr) {
+      return pdcp_nr_obj->sdu_queue_is_congested(rnti, bearer.lcid);
+    }
+    return false;
+  }
 
 private:
   srslog::basic_logger& logger;
@@ -20,6 +20,8 @@
  */
 
 #include "srsenb/hdr/common/rnti_pool.h"
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/common/timers.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_pdcp_interfaces.h"
@@ -27,7 +29,10 @@
 #include "srsran/interfaces/ue_rlc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/upper/pdcp.h"
+#include <functional>
 #include <map>
+#include <mutex>
+#include <pthread.h>
 
 #ifndef SRSENB_PDCP_H
 #define SRSENB_PDCP_H
@@ -42,9 +47,13 @@ class pdcp : public pdcp_interface_rlc, public pdcp_interface_gtpu, public pdcp_
 {
 public:
   pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger);
-  virtual ~pdcp() {}
-  void init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_);
+  virtual ~pdcp();
+  void init(rlc_interface_pdcp*  rlc_,
+            rrc_interface_pdcp*  rrc_,
+            gtpu_interface_pdcp* gtpu_,
+            uint32_t             nof_workers = 0);
   void stop();
+  void tic();
 
   // pdcp_interface_rlc
   void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) override;
@@ -71,6 +80,7 @@ public:
 
   // pdcp_interface_gtpu
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t lcid) override;
+  bool                                             sdu_queue_is_congested(uint16_t rnti, uint32_t lcid) override;
 
   // Metrics
   void get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti);
@@ -82,11 +92,12 @@ private:
     uint16_t                    rnti;
     srsenb::rlc_interface_pdcp* rlc;
     // rlc_interface_pdcp
-    void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu);
-    void discard_sdu(uint32_t lcid, uint32_t discard_sn);
-    bool rb_is_um(uint32_t lcid);
-    bool sdu_queue_is_full(uint32_t lcid);
-    bool is_suspended(uint32_t lcid);
+    void     write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu);
+    void     discard_sdu(uint32_t lcid, uint32_t discard_sn);
+    bool     rb_is_um(uint32_t lcid);
+    bool     sdu_queue_is_full(uint32_t lcid);
+    uint32_t sdu_queue_free_slots(uint32_t lcid);
+    bool     is_suspended(uint32_t lcid);
   };
 
   class user_interface_gtpu : public srsue::gw_interface_pdcp
@@ -123,9 +134,42 @@ private:
     unique_rnti_ptr<srsran::pdcp> pdcp;
   };
 
+  /// Set of UEs whose DRB SDUs are processed by the same worker thread. The shard mutex serializes the worker with
+  /// the calls of the stack thread (control plane, UL PDUs) on the UEs of the shard.
+  struct ue_shard {
+    explicit ue_shard(uint32_t idx);
+
+    struct pending_sdu {
+      uint16_t                     rnti;
+      uint32_t                     lcid;
+      int                          pdcp_sn;
+      srsran::unique_byte_buffer_t sdu;
+    };
+
+    std::mutex             mutex;
+    srsran::task_scheduler task_sched; ///< timers of the PDCP entities of the shard, stepped by the worker
+    srsran::task_worker    worker;
+
+    /// DRB SDUs received since the worker last drained them. The SDUs of a bearer are ciphered as one batch
+    std::mutex                                sdu_mutex;
+    std::vector<pending_sdu>                  pending_sdus;
+    std::vector<pending_sdu>                  worker_sdus;  ///< only used by the worker
+    std::vector<srsran::unique_byte_buffer_t> bearer_batch; ///< only used by the worker
+  };
+
+  ue_shard*                    get_shard(uint16_t rnti);
+  std::unique_lock<std::mutex> lock_shard(uint16_t rnti);
+  void                         run_in_ue_worker(uint16_t rnti, const std::function<void()>& task);
+  void                         write_pending_sdus(ue_shard* shard);
+  void write_sdu_unlocked(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn);
+
   void clear_user(user_interface* ue);
 
   std::map<uint32_t, user_interface> users;
+  pthread_rwlock_t                   rwlock;
+
+  // Empty when the user plane runs in the stack thread
+  std::vector<std::unique_ptr<ue_shard> > shards;
 
   rlc_interface_pdcp*       rlc  = nullptr;
   rrc_interface_pdcp*       rrc  = nullptr;
@@ -71,9 +71,12 @@ public:
   bool        rb_is_um(uint16_t rnti, uint32_t lcid);
   const char* get_rb_name(uint32_t lcid);
   bool        sdu_queue_is_full(uint16_t rnti, uint32_t lcid);
+  bool        sdu_queue_is_congested(uint16_t rnti, uint32_t lcid);
+  uint32_t    sdu_queue_free_slots(uint16_t rnti, uint32_t lcid);
 
   // rlc_interface_mac
   int  read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
+  int  read_pdus(uint16_t rnti, uint32_t lcid, srsran::read_pdu_batch_interface& batch);
   void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
 
 private:
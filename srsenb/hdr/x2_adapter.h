@@ -140,6 +140,13 @@ public:
     }
     return nr_stack->get_buffered_pdus(rnti, lcid);
   }
+  bool sdu_queue_is_congested(uint16_t rnti, uint32_t lcid) override
+  {
+    if (nr_stack == nullptr) {
+      return false;
+    }
+    return nr_stack->sdu_queue_is_congested(rnti, lcid);
+  }
 
   // gtpu_interface_pdcp
   void write_pdu(uint16_t rnti, uint32_t bearer_id, srsran::unique_byte_buffer_t pdu) override
@@ -181,6 +181,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.init_dl_cqi", bpo::value<int>(&args->stack.mac.sched.init_dl_cqi)->default_value(5), "DL CQI value used before any CQI report is available to the eNB")
     ("scheduler.max_sib_coderate", bpo::value<float>(&args->stack.mac.sched.max_sib_coderate)->default_value(0.8), "Upper bound on SIB and RAR grants coderate")
     ("scheduler.pdcch_cqi_offset", bpo::value<int>(&args->stack.mac.sched.pdcch_cqi_offset)->default_value(0), "CQI offset in derivation of PDCCH aggregation level")
+    ("scheduler.max_pdcch_search_nodes", bpo::value<uint32_t>(&args->stack.mac.sched.max_pdcch_search_nodes)->default_value(1024), "Maximum number of DCI placements explored per PDCCH allocation attempt (0 for unlimited)")
+    ("scheduler.mu_mimo", bpo::value<bool>(&args->stack.mac.sched.mu_mimo_enabled)->default_value(false), "Pair TM4 rank-1 UEs reporting orthogonal PMIs on the same RBGs (MU-MIMO)")
+    ("scheduler.lookahead_ttis", bpo::value<uint32_t>(&args->stack.mac.sched.lookahead_ttis)->default_value(0), "Number of TTIs scheduled ahead of the PHY in a separate thread (0 to schedule synchronously, max 4)")
+    ("scheduler.trace_filename", bpo::value<string>(&args->stack.mac.sched.trace_filename)->default_value(""), "Records the scheduler inputs and decisions to a trace that can be replayed offline (empty to disable)")
 
     /*Slicing conifguration*/
     ("slicing.enable_eMBB", bpo::value<bool>(&args->nr_stack.ngap.nssai[0].active)->default_value(true), "Enables enhanced mobile broadband (eMBB) slice in the gNodeB")
@@ -255,6 +259,12 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
+    ("expert.lte_phy_pipeline", bpo::value<bool>(&args->phy.lte_pipeline)->default_value(false), "Runs the LTE MAC scheduling and DL encoding of each PHY worker in separate threads, pipelined with the UL processing.")
+    ("expert.lte_phy_pipeline_depth", bpo::value<uint32_t>(&args->phy.lte_pipeline_depth)->default_value(2), "Maximum number of subframes of each PHY worker in the LTE pipeline (1 to 4).")
+    ("expert.lte_phy_mac_stage_mask", bpo::value<uint32_t>(&args->phy.lte_mac_stage_mask)->default_value(255), "CPU mask for the pipelined LTE MAC scheduling threads.")
+    ("expert.lte_phy_dl_stage_mask", bpo::value<uint32_t>(&args->phy.lte_dl_stage_mask)->default_value(255), "CPU mask for the pipelined LTE DL encoding threads.")
+    ("expert.nr_slot_tasks", bpo::value<bool>(&args->phy.nr_slot_tasks)->default_value(false), "Processes the NR UL and DL of each slot as independent tasks, so the DL transmission does not wait for the UL decoding.")
+    ("expert.nof_phy_cc_threads", bpo::value<uint32_t>(&args->phy.nof_phy_cc_threads)->default_value(0), "Number of threads processing LTE component carriers in parallel (0 for serial processing).")
     ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
@@ -278,6 +288,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.max_mac_dl_kos", bpo::value<uint32_t>(&args->general.max_mac_dl_kos)->default_value(100), "Maximum number of consecutive KOs in DL before triggering the UE's release (default 100).")
     ("expert.max_mac_ul_kos", bpo::value<uint32_t>(&args->general.max_mac_ul_kos)->default_value(100), "Maximum number of consecutive KOs in UL before triggering the UE's release (default 100).")
     ("expert.gtpu_tunnel_timeout", bpo::value<uint32_t>(&args->stack.gtpu_indirect_tunnel_timeout_msec)->default_value(0), "Maximum time that GTPU takes to release indirect forwarding tunnel since the last received GTPU PDU (0 for infinity).")
+    ("expert.nof_up_workers", bpo::value<uint32_t>(&args->stack.nof_up_workers)->default_value(0), "Number of threads the DRB SDUs are distributed to, by RNTI (0 processes them in the stack thread).")
     ("expert.rlf_release_timer_ms", bpo::value<uint32_t>(&args->general.rlf_release_timer_ms)->default_value(4000), "Time taken by eNB to release UE context after it detects an RLF.")
     ("expert.extended_cp", bpo::value<bool>(&args->phy.extended_cp)->default_value(false), "Use extended cyclic prefix")
     ("expert.ts1_reloc_prep_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_prep_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocPrep Expiry Timeout value in milliseconds.")
@@ -303,6 +314,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_max_pdcch_search_nodes", bpo::value<uint32_t>(&args->nr_stack.mac.sched_cfg.max_pdcch_search_nodes)->default_value(1024), "Maximum number of NR DCI placements explored per PDCCH allocation attempt (0 for unlimited)")
+    ("scheduler.nr_policy", bpo::value<string>(&args->nr_stack.mac.sched_cfg.policy)->default_value("time_rr"), "NR DL and UL data scheduling policy (E.g. time_rr, time_pf)")
+    ("scheduler.nr_policy_args", bpo::value<string>(&args->nr_stack.mac.sched_cfg.policy_args)->default_value("1"), "NR scheduler policy-specific arguments")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
   ;
 
@@ -92,8 +92,21 @@ DECLARE_METRIC_SET("ue_container",
 DECLARE_METRIC("carrier_id", metric_carrier_id, uint32_t, "");
 DECLARE_METRIC("pci", metric_pci, uint32_t, "");
 DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
+DECLARE_METRIC("ul_proc_time", metric_ul_proc_time, float, "us");
+DECLARE_METRIC("ul_proc_time_max", metric_ul_proc_time_max, float, "us");
+DECLARE_METRIC("dl_proc_time", metric_dl_proc_time, float, "us");
+DECLARE_METRIC("dl_proc_time_max", metric_dl_proc_time_max, float, "us");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
-DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
+DECLARE_METRIC_SET("cell_container",
+                   mset_cell_container,
+                   metric_carrier_id,
+                   metric_pci,
+                   metric_nof_rach,
+                   metric_ul_proc_time,
+                   metric_ul_proc_time_max,
+                   metric_dl_proc_time,
+                   metric_dl_proc_time_max,
+                   mlist_ues);
 
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
@@ -222,6 +235,12 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     cell.write<metric_carrier_id>(cc_idx);
     cell.write<metric_nof_rach>(m.stack.mac.cc_info[cc_idx].cc_rach_counter);
     cell.write<metric_pci>(m.stack.mac.cc_info[cc_idx].pci);
+    if (cc_idx < m.phy_cc.size()) {
+      cell.write<metric_ul_proc_time>(m.phy_cc[cc_idx].ul_time_us);
+      cell.write<metric_ul_proc_time_max>(m.phy_cc[cc_idx].ul_max_time_us);
+      cell.write<metric_dl_proc_time>(m.phy_cc[cc_idx].dl_time_us);
+      cell.write<metric_dl_proc_time_max>(m.phy_cc[cc_idx].dl_max_time_us);
+    }
 
     // For each UE in this cell...
     for (unsigned i = 0; i != m.stack.rrc.ues.size(); ++i) {
@@ -181,14 +181,14 @@ cf_t* cc_worker::get_buffer_tx(uint32_t antenna_idx)
 
 void cc_worker::set_tti(uint32_t tti_)
 {
-  tti_rx    = tti_;
-  tti_tx_dl = TTI_ADD(tti_rx, FDD_HARQ_DELAY_UL_MS);
-  tti_tx_ul = TTI_RX_ACK(tti_rx);
+  tti_rx = tti_;
 }
 
 int cc_worker::add_rnti(uint16_t rnti)
 {
-  std::unique_lock<std::mutex> lock(mutex);
+  std::lock(ul_mutex, dl_mutex);
+  std::lock_guard<std::mutex> ul_lock(ul_mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> dl_lock(dl_mutex, std::adopt_lock);
 
   // Create user unless already exists
   if (ue_db.count(rnti) == 0) {
@@ -199,7 +199,9 @@ int cc_worker::add_rnti(uint16_t rnti)
 
 void cc_worker::rem_rnti(uint16_t rnti)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock(ul_mutex, dl_mutex);
+  std::lock_guard<std::mutex> ul_lock(ul_mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> dl_lock(dl_mutex, std::adopt_lock);
   if (ue_db.count(rnti)) {
     delete ue_db[rnti];
     ue_db.erase(rnti);
@@ -208,14 +210,18 @@ void cc_worker::rem_rnti(uint16_t rnti)
 
 uint32_t cc_worker::get_nof_rnti()
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock_guard<std::mutex> lock(ul_mutex);
   return ue_db.size();
 }
 
-void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy_lte::ul_sched_t& ul_grants)
+void cc_worker::work_ul(const srsran_ul_sf_cfg_t&            ul_sf_cfg,
+                        stack_interface_phy_lte::ul_sched_t& ul_grants,
+                        uint32_t                             slot)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  ul_sf = ul_sf_cfg;
+  std::lock_guard<std::mutex> lock(ul_mutex);
+  auto                        t_start = std::chrono::steady_clock::now();
+  ul_sf                               = ul_sf_cfg;
+  ul_slot                             = slot % max_stage_slots;
   logger.set_context(ul_sf.tti);
 
   // Process UL signal
@@ -226,15 +232,20 @@ void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy
 
   // Decode remaining PUCCH ACKs not associated with PUSCH transmission and SR signals
   decode_pucch();
+
+  metrics_proc_time(t_start, true);
 }
 
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                         stack_interface_phy_lte::dl_sched_t& dl_grants,
                         stack_interface_phy_lte::ul_sched_t& ul_grants,
-                        srsran_mbsfn_cfg_t*                  mbsfn_cfg)
+                        srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+                        uint32_t                             slot)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  dl_sf = dl_sf_cfg;
+  std::lock_guard<std::mutex> lock(dl_mutex);
+  auto                        t_start = std::chrono::steady_clock::now();
+  dl_sf                               = dl_sf_cfg;
+  dl_slot                             = slot % max_stage_slots;
 
   // Put base signals (references, PBCH, PCFICH and PSS/SSS) into the resource grid
   srsran_enb_dl_put_base(&enb_dl, &dl_sf);
@@ -281,6 +292,8 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
     // clear measurement flag on cell
     phy->clear_cell_measure_trigger(cc_idx);
   }
+
+  metrics_proc_time(t_start, false);
 }
 
 bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
@@ -348,8 +361,8 @@ bool cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     }
   }
   // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
-  ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
-  ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
+  ue_db[rnti]->phich_grant[ul_slot].n_prb_lowest = grant.n_prb_tilde[0];
+  ue_db[rnti]->phich_grant[ul_slot].n_dmrs       = ul_grant.dci.n_dmrs;
 
   float snr_db = enb_ul.chest_res.snr_db;
 
@@ -478,14 +491,14 @@ int cc_worker::encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint3
 {
   for (uint32_t i = 0; i < nof_acks; i++) {
     if (acks[i].rnti && ue_db.count(acks[i].rnti)) {
-      srsran_enb_dl_put_phich(&enb_dl, &ue_db[acks[i].rnti]->phich_grant, acks[i].ack);
+      srsran_enb_dl_put_phich(&enb_dl, &ue_db[acks[i].rnti]->phich_grant[dl_slot], acks[i].ack);
 
       Info("PHICH: rnti=0x%x, hi=%d, I_lowest=%d, n_dmrs=%d, tti_tx_dl=%d",
            acks[i].rnti,
            acks[i].ack,
-           ue_db[acks[i].rnti]->phich_grant.n_prb_lowest,
-           ue_db[acks[i].rnti]->phich_grant.n_dmrs,
-           tti_tx_dl);
+           ue_db[acks[i].rnti]->phich_grant[dl_slot].n_prb_lowest,
+           ue_db[acks[i].rnti]->phich_grant[dl_slot].n_dmrs,
+           dl_sf.tti);
     }
   }
   return SRSRAN_SUCCESS;
@@ -519,7 +532,7 @@ int cc_worker::encode_pdcch_ul(stack_interface_phy_lte::ul_sched_grant_t* grants
       if (logger.info.enabled()) {
         char str[512];
         srsran_dci_ul_info(&grants[i].dci, str, 512);
-        logger.info("PDCCH: cc=%d, rnti=0x%x, %s, tti_tx_dl=%d", cc_idx, grants[i].dci.rnti, str, tti_tx_dl);
+        logger.info("PDCCH: cc=%d, rnti=0x%x, %s, tti_tx_dl=%d", cc_idx, grants[i].dci.rnti, str, dl_sf.tti);
       }
     }
   }
@@ -556,7 +569,7 @@ int cc_worker::encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants
         // Logging
         char str[512];
         srsran_dci_dl_info(&grants[i].dci, str, 512);
-        logger.info("PDCCH: cc=%d, rnti=0x%x, %s, tti_tx_dl=%d", cc_idx, grants[i].dci.rnti, str, tti_tx_dl);
+        logger.info("PDCCH: cc=%d, rnti=0x%x, %s, tti_tx_dl=%d", cc_idx, grants[i].dci.rnti, str, dl_sf.tti);
       }
     }
   }
@@ -619,6 +632,7 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
       for (uint32_t j = 0; j < SRSRAN_MAX_CODEWORDS; j++) {
         dl_cfg.pdsch.softbuffers.tx[j] = grants[i].softbuffer_tx[j];
       }
+      dl_cfg.pdsch.mu_mimo_rbg_mask = grants[i].mu_mimo_rbg_mask;
 
       // Encode PDSCH
       if (srsran_enb_dl_put_pdsch(&enb_dl, &dl_cfg.pdsch, grants[i].data)) {
@@ -628,15 +642,15 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
 
       // Save pending ACK
       if (SRSRAN_RNTI_ISUSER(rnti)) {
-        // Push whole DCI
-        phy->ue_db.set_ack_pending(tti_tx_ul, cc_idx, grants[i].dci);
+        // Push whole DCI, the ACK is expected FDD_HARQ_DELAY_DL_MS after the DL transmission
+        phy->ue_db.set_ack_pending(TTI_TX(dl_sf.tti), cc_idx, grants[i].dci);
       }
 
       if (LOG_THIS(rnti) and logger.info.enabled()) {
         // Logging
         char str[512];
         srsran_pdsch_tx_info(&dl_cfg.pdsch, str, 512);
-        logger.info("PDSCH: cc=%d, %s, tti_tx_dl=%d", cc_idx, str, tti_tx_dl);
+        logger.info("PDSCH: cc=%d, %s, tti_tx_dl=%d", cc_idx, str, dl_sf.tti);
       }
 
       // Save metrics stats
@@ -654,7 +668,9 @@ int cc_worker::encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, u
 /************ METRICS interface ********************/
 uint32_t cc_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
-  std::lock_guard<std::mutex> lock(mutex);
+  std::lock(ul_mutex, dl_mutex);
+  std::lock_guard<std::mutex> ul_lock(ul_mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> dl_lock(dl_mutex, std::adopt_lock);
   uint32_t                    cnt = 0;
   metrics.resize(ue_db.size());
   for (auto& ue : ue_db) {
@@ -666,6 +682,32 @@ uint32_t cc_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
   return cnt;
 }
 
+phy_cc_metrics_t cc_worker::get_cc_metrics()
+{
+  std::lock(ul_mutex, dl_mutex);
+  std::lock_guard<std::mutex> ul_lock(ul_mutex, std::adopt_lock);
+  std::lock_guard<std::mutex> dl_lock(dl_mutex, std::adopt_lock);
+  phy_cc_metrics_t            ret = cc_metrics;
+  cc_metrics                      = {};
+  return ret;
+}
+
+void cc_worker::metrics_proc_time(std::chrono::steady_clock::time_point t_start, bool is_ul)
+{
+  float t_us =
+      std::chrono::duration_cast<std::chrono::duration<float, std::micro> >(std::chrono::steady_clock::now() - t_start)
+          .count();
+  if (is_ul) {
+    cc_metrics.ul_time_us     = SRSRAN_VEC_CMA(t_us, cc_metrics.ul_time_us, cc_metrics.ul_n_samples);
+    cc_metrics.ul_max_time_us = std::max(cc_metrics.ul_max_time_us, t_us);
+    cc_metrics.ul_n_samples++;
+  } else {
+    cc_metrics.dl_time_us     = SRSRAN_VEC_CMA(t_us, cc_metrics.dl_time_us, cc_metrics.dl_n_samples);
+    cc_metrics.dl_max_time_us = std::max(cc_metrics.dl_max_time_us, t_us);
+    cc_metrics.dl_n_samples++;
+  }
+}
+
 void cc_worker::ue::metrics_read(phy_metrics_t* metrics_)
 {
   if (metrics_) {
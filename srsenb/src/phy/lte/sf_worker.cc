@@ -21,6 +21,8 @@
 
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
+#include <atomic>
+#include <memory>
 
 #include "srsenb/hdr/phy/lte/sf_worker.h"
 
@@ -72,9 +74,49 @@ namespace lte {
 FILE* f;
 #endif
 
-void sf_worker::init(phy_common* phy_)
+namespace {
+
+/// Carriers of a subframe fanned out into the carrier pool. The carriers are claimed one by one by the pool tasks and
+/// by the calling thread, which processes all the carriers left. So a task that runs late, or never because the pool
+/// is stopped or full, does not hold the join
+struct carrier_join_t {
+  explicit carrier_join_t(uint32_t nof_cc_) : nof_cc(nof_cc_) {}
+
+  void run(const std::function<void(uint32_t)>& task)
+  {
+    for (uint32_t cc = next_cc++; cc < nof_cc; cc = next_cc++) {
+      task(cc);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      nof_done++;
+      if (nof_done == nof_cc) {
+        cvar.notify_one();
+      }
+    }
+  }
+
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (nof_done < nof_cc) {
+      cvar.wait(lock);
+    }
+  }
+
+private:
+  std::atomic<uint32_t>   next_cc{0};
+  const uint32_t          nof_cc;
+  uint32_t                nof_done = 0;
+  std::mutex              mutex;
+  std::condition_variable cvar;
+};
+
+} // namespace
+
+void sf_worker::init(phy_common* phy_, int prio, srsran::task_thread_pool* cc_pool_)
 {
-  phy = phy_;
+  phy     = phy_;
+  cc_pool = cc_pool_;
 
   // Initialise each component carrier workers
   for (uint32_t i = 0; i < phy->get_nof_carriers_lte(); i++) {
@@ -95,6 +137,19 @@ void sf_worker::init(phy_common* phy_)
 
   srsran_softbuffer_tx_reset(&temp_mbsfn_softbuffer);
 
+  // Optionally, pipeline the UL processing, the MAC scheduling and the DL encoding in different threads, so that a
+  // heavy UL subframe does not hold back the DL of the following ones
+  if (phy->params.lte_pipeline) {
+    uint32_t depth = std::min(std::max(phy->params.lte_pipeline_depth, 1U), cc_worker::max_stage_slots);
+    mac_stage      = std::unique_ptr<srsran::task_worker>(
+        new srsran::task_worker("PHY_MAC", depth, false, prio, phy->params.lte_mac_stage_mask));
+    dl_stage = std::unique_ptr<srsran::task_worker>(
+        new srsran::task_worker("PHY_DL", depth, false, prio, phy->params.lte_dl_stage_mask));
+    stage_ctxts.resize(depth);
+  } else {
+    stage_ctxts.resize(1);
+  }
+
   Info("Worker %d configured cell %d PRB", get_id(), phy->get_nof_prb(0));
 
   initiated = true;
@@ -151,30 +206,35 @@ void sf_worker::work_imp()
 {
   std::lock_guard<std::mutex> lock(work_mutex);
 
-  srsran_ul_sf_cfg_t ul_sf = {};
-  srsran_dl_sf_cfg_t dl_sf = {};
+  // Take a free stage context slot. When all of them are in flight, the pipeline is full and the UL stage waits
+  uint32_t slot = 0;
+  {
+    std::unique_lock<std::mutex> stage_lock(stage_mutex);
+    while (nof_busy_slots == stage_ctxts.size()) {
+      stage_cvar.wait(stage_lock);
+    }
+    nof_busy_slots++;
+    slot = stage_seq++ % stage_ctxts.size();
+  }
 
-  // Get Transmission buffers
-  srsran::rf_buffer_t tx_buffer = {};
-  tx_buffer.set_nof_samples(SRSRAN_SF_LEN_PRB(phy->get_nof_prb(0)));
+  srsran_ul_sf_cfg_t ul_sf = {};
+  stage_ctxt_t&      ctxt  = stage_ctxts[slot];
+  ctxt.w_ctx.copy(context);
+  ctxt.slot      = slot;
+  ctxt.tti_tx_dl = tti_tx_dl;
+  ctxt.tti_tx_ul = tti_tx_ul;
+  ctxt.dl_grants.resize(phy->get_nof_carriers_lte());
+  for (auto& dl_grant : ctxt.dl_grants) {
+    dl_grant = {};
+  }
 
   if (!running) {
-    phy->worker_end(context, true, tx_buffer);
+    run_tx_stages(slot, false);
     return;
   }
 
-  srsran_mbsfn_cfg_t mbsfn_cfg;
-  srsran_sf_t        sf_type = phy->is_mbsfn_sf(&mbsfn_cfg, tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
-
   // Uplink grants to receive this TTI
   stack_interface_phy_lte::ul_sched_list_t ul_grants = phy->get_ul_grants(tti_rx);
-  // Uplink grants to transmit this tti and receive in the future
-  stack_interface_phy_lte::ul_sched_list_t ul_grants_tx = phy->get_ul_grants(tti_tx_ul);
-
-  // Downlink grants to transmit this TTI
-  stack_interface_phy_lte::dl_sched_list_t dl_grants(phy->get_nof_carriers_lte());
-
-  stack_interface_phy_lte* stack = phy->stack;
 
   logger.set_context(tti_rx);
 
@@ -189,55 +249,99 @@ void sf_worker::work_imp()
   }
 
   // Process UL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
-    cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
+  run_carriers(
+      [this, &ul_sf, &ul_grants, slot](uint32_t cc) { cc_workers[cc]->work_ul(ul_sf, ul_grants[cc], slot); });
+
+  run_tx_stages(slot, true);
+}
+
+void sf_worker::run_tx_stages(uint32_t slot, bool schedule)
+{
+  if (mac_stage == nullptr) {
+    if (schedule and work_mac_stage(stage_ctxts[slot])) {
+      work_dl_stage(stage_ctxts[slot]);
+    } else {
+      skip_dl_stage(stage_ctxts[slot]);
+    }
+    release_stage_slot();
+    return;
   }
 
+  // Hand over the subframe to the MAC stage, so this worker becomes available for the next UL subframe. The MAC
+  // scheduling needs the HARQ feedback decoded by the UL stage. Each stage processes the subframes in order, and only
+  // the DL stage ends them, so that the subframes of this worker are transmitted in order too
+  mac_stage->push_task([this, slot, schedule]() {
+    bool tx_enable = schedule and work_mac_stage(stage_ctxts[slot]);
+    dl_stage->push_task([this, slot, tx_enable]() {
+      if (tx_enable) {
+        work_dl_stage(stage_ctxts[slot]);
+      } else {
+        skip_dl_stage(stage_ctxts[slot]);
+      }
+      release_stage_slot();
+    });
+  });
+}
+
+bool sf_worker::work_mac_stage(stage_ctxt_t& ctxt)
+{
+  stack_interface_phy_lte* stack = phy->stack;
+
+  srsran_sf_t sf_type = phy->is_mbsfn_sf(&ctxt.mbsfn_cfg, ctxt.tti_tx_dl) ? SRSRAN_SF_MBSFN : SRSRAN_SF_NORM;
+
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
-    if (stack->get_dl_sched(tti_tx_dl, dl_grants) < 0) {
+    if (stack->get_dl_sched(ctxt.tti_tx_dl, ctxt.dl_grants) < 0) {
       Error("Getting DL scheduling from MAC");
-      phy->worker_end(context, true, tx_buffer);
-      return;
+      return false;
     }
   } else {
-    dl_grants[0].cfi = mbsfn_cfg.non_mbsfn_region_length;
-    if (stack->get_mch_sched(tti_tx_dl, mbsfn_cfg.is_mcch, dl_grants)) {
+    ctxt.dl_grants[0].cfi = ctxt.mbsfn_cfg.non_mbsfn_region_length;
+    if (stack->get_mch_sched(ctxt.tti_tx_dl, ctxt.mbsfn_cfg.is_mcch, ctxt.dl_grants)) {
       Error("Getting MCH packets from MAC");
-      phy->worker_end(context, true, tx_buffer);
-      return;
+      return false;
     }
   }
 
-  // Get UL scheduling for the TX TTI from MAC
-  if (stack->get_ul_sched(tti_tx_ul, ul_grants_tx) < 0) {
+  // Get UL scheduling for the TX TTI from MAC, on top of the grants to transmit this tti and receive in the future
+  ctxt.ul_grants_tx = phy->get_ul_grants(ctxt.tti_tx_ul);
+  if (stack->get_ul_sched(ctxt.tti_tx_ul, ctxt.ul_grants_tx) < 0) {
     Error("Getting UL scheduling from MAC");
-    phy->worker_end(context, true, tx_buffer);
-    return;
+    return false;
   }
 
   // Configure DL subframe
-  dl_sf.tti              = tti_tx_dl;
-  dl_sf.sf_type          = sf_type;
-  dl_sf.non_mbsfn_region = mbsfn_cfg.non_mbsfn_region_length;
+  ctxt.dl_sf                  = {};
+  ctxt.dl_sf.tti              = ctxt.tti_tx_dl;
+  ctxt.dl_sf.sf_type          = sf_type;
+  ctxt.dl_sf.non_mbsfn_region = ctxt.mbsfn_cfg.non_mbsfn_region_length;
 
   // Prepare for receive ACK for DL grants in t_tx_dl+4
-  phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
+  phy->ue_db.clear_tti_pending_ack(ctxt.tti_tx_ul);
+  return true;
+}
+
+void sf_worker::work_dl_stage(stage_ctxt_t& ctxt)
+{
+  logger.set_context(ctxt.dl_sf.tti);
 
   // Process DL
-  for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+  run_carriers([this, &ctxt](uint32_t cc) {
     // Select CFI and make sure it is in the right range
-    dl_sf.cfi = dl_grants[cc].cfi;
-    dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
-    dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
+    srsran_dl_sf_cfg_t dl_sf = ctxt.dl_sf;
+    dl_sf.cfi                = ctxt.dl_grants[cc].cfi;
+    dl_sf.cfi                = SRSRAN_MAX(dl_sf.cfi, 1);
+    dl_sf.cfi                = SRSRAN_MIN(dl_sf.cfi, 3);
 
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
-  }
+    cc_workers[cc]->work_dl(dl_sf, ctxt.dl_grants[cc], ctxt.ul_grants_tx[cc], &ctxt.mbsfn_cfg, ctxt.slot);
+  });
 
   // Save grants
-  phy->set_ul_grants(tti_tx_ul, ul_grants_tx);
+  phy->set_ul_grants(ctxt.tti_tx_ul, ctxt.ul_grants_tx);
 
   // Set or combine RF ports
+  srsran::rf_buffer_t tx_buffer = {};
+  tx_buffer.set_nof_samples(SRSRAN_SF_LEN_PRB(phy->get_nof_prb(0)));
   for (uint32_t cc = 0; cc < phy->get_nof_carriers_lte(); cc++) {
     for (uint32_t ant = 0; ant < phy->get_nof_ports(0); ant++) {
       tx_buffer.set_combine(phy->get_rf_port(cc), ant, phy->get_nof_ports(0), cc_workers[cc]->get_buffer_tx(ant));
@@ -245,14 +349,14 @@ void sf_worker::work_imp()
   }
 
   Debug("Sending to radio");
-  phy->worker_end(context, true, tx_buffer);
+  phy->worker_end(ctxt.w_ctx, true, tx_buffer);
 
 #ifdef DEBUG_WRITE_FILE
   fwrite(signal_buffer_tx, SRSRAN_SF_LEN_PRB(phy->cell.nof_prb) * sizeof(cf_t), 1, f);
 #endif
 
 #ifdef DEBUG_WRITE_FILE
-  if (tti_tx_dl == 10) {
+  if (ctxt.dl_sf.tti == 10) {
     fclose(f);
     exit(-1);
   }
@@ -266,6 +370,59 @@ void sf_worker::work_imp()
 #endif
 }
 
+void sf_worker::skip_dl_stage(stage_ctxt_t& ctxt)
+{
+  srsran::rf_buffer_t tx_buffer = {};
+  tx_buffer.set_nof_samples(SRSRAN_SF_LEN_PRB(phy->get_nof_prb(0)));
+  phy->worker_end(ctxt.w_ctx, true, tx_buffer);
+}
+
+void sf_worker::run_carriers(const std::function<void(uint32_t)>& task)
+{
+  // Serial processing when there is no carrier pool or a single carrier
+  if (cc_pool == nullptr or cc_workers.size() < 2) {
+    for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
+      task(cc);
+    }
+    return;
+  }
+
+  // The UL and DL stages may fan out their carriers at the same time, so each call joins on its own barrier
+  std::shared_ptr<carrier_join_t> join = std::make_shared<carrier_join_t>(cc_workers.size());
+  for (uint32_t cc = 1; cc < cc_workers.size(); cc++) {
+    // The task is only referenced while a carrier is claimed, that is, while this thread waits for it
+    cc_pool->push_task([join, &task]() { join->run(task); });
+  }
+  join->run(task);
+
+  // Join barrier, all carriers must be processed before moving on
+  join->wait();
+}
+
+void sf_worker::release_stage_slot()
+{
+  std::lock_guard<std::mutex> stage_lock(stage_mutex);
+  nof_busy_slots--;
+  stage_cvar.notify_all();
+}
+
+void sf_worker::wait_pipeline()
+{
+  std::unique_lock<std::mutex> lock(stage_mutex);
+  while (nof_busy_slots > 0) {
+    stage_cvar.wait(lock);
+  }
+}
+
+void sf_worker::stop_pipeline()
+{
+  if (mac_stage != nullptr) {
+    wait_pipeline();
+    mac_stage->stop();
+    dl_stage->stop();
+  }
+}
+
 /************ METRICS interface ********************/
 uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
@@ -297,6 +454,20 @@ uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
   return cnt;
 }
 
+void sf_worker::get_cc_metrics(std::vector<phy_cc_metrics_t>& metrics)
+{
+  for (uint32_t cc = 0; cc < cc_workers.size() and cc < metrics.size(); cc++) {
+    phy_cc_metrics_t  m_ = cc_workers[cc]->get_cc_metrics();
+    phy_cc_metrics_t* m  = &metrics[cc];
+    m->ul_time_us        = SRSRAN_VEC_SAFE_PMA(m->ul_time_us, m->ul_n_samples, m_.ul_time_us, m_.ul_n_samples);
+    m->dl_time_us        = SRSRAN_VEC_SAFE_PMA(m->dl_time_us, m->dl_n_samples, m_.dl_time_us, m_.dl_n_samples);
+    m->ul_max_time_us    = std::max(m->ul_max_time_us, m_.ul_max_time_us);
+    m->dl_max_time_us    = std::max(m->dl_max_time_us, m_.dl_max_time_us);
+    m->ul_n_samples += m_.ul_n_samples;
+    m->dl_n_samples += m_.dl_n_samples;
+  }
+}
+
 void sf_worker::start_plot()
 {
 #ifdef ENABLE_GUI
@@ -342,6 +513,7 @@ int sf_worker::read_pucch_d(uint32_t cc_idx, cf_t* pdsch_d)
 
 sf_worker::~sf_worker()
 {
+  stop_pipeline();
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
 }
 
@@ -23,10 +23,18 @@
 namespace srsenb {
 namespace lte {
 
-worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
+worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers), cc_pool(0, true) {}
 
 bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
 {
+  // Start the carrier pool if the carriers are processed in parallel
+  srsran::task_thread_pool* cc_pool_ptr = nullptr;
+  if (args.nof_phy_cc_threads > 0 and common->get_nof_carriers_lte() > 1) {
+    cc_pool.set_nof_workers(args.nof_phy_cc_threads);
+    cc_pool.start(prio);
+    cc_pool_ptr = &cc_pool;
+  }
+
   // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
@@ -35,7 +43,7 @@ bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink&
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
     auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
+    w->init(common, prio, cc_pool_ptr);
     pool.init_worker(i, w.get(), prio);
     workers.push_back(std::move(w));
   }
@@ -61,6 +69,13 @@ sf_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+
+  // The pipeline stages of the workers fan out the carriers of their subframes into the carrier pool, so they finish
+  // before it stops
+  for (auto& w : workers) {
+    w->stop_pipeline();
+  }
+  cc_pool.stop();
 }
 
 }; // namespace lte
@@ -20,6 +20,7 @@
  */
 
 #include "srsenb/hdr/phy/nr/slot_worker.h"
+#include "srsran/adt/scope_exit.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 
@@ -52,6 +53,7 @@ bool slot_worker::init(const args_t& args)
   // Copy common configurations
   cell_index = args.cell_index;
   rf_port    = args.rf_port;
+  task_pool  = args.task_pool;
 
   // Allocate Tx buffers
   tx_buffer.resize(args.nof_tx_ports);
@@ -166,7 +168,16 @@ void slot_worker::set_context(const srsran::phy_common_interface::worker_context
 
 bool slot_worker::work_ul()
 {
-  stack_interface_phy_nr::ul_sched_t* ul_sched = stack.get_ul_sched(ul_slot_cfg);
+  return work_ul_uci() and work_ul_data();
+}
+
+bool slot_worker::work_ul_uci()
+{
+  auto t_start = std::chrono::steady_clock::now();
+  auto on_exit =
+      srsran::make_scope_exit([this, t_start]() { ul_uci_time = std::chrono::steady_clock::now() - t_start; });
+
+  ul_sched = stack.get_ul_sched(ul_slot_cfg);
   if (ul_sched == nullptr) {
     logger.error("Error retrieving UL scheduling");
     return false;
@@ -234,49 +245,78 @@ bool slot_worker::work_ul()
     }
   }
 
-  // For each PUSCH...
+  // For each PUSCH carrying UCI...
   for (stack_interface_phy_nr::pusch_t& pusch : ul_sched->pusch) {
-    // Prepare PUSCH
-    stack_interface_phy_nr::pusch_info_t pusch_info = {};
-    pusch_info.uci_cfg                              = pusch.sch.uci;
-    pusch_info.pid                                  = pusch.pid;
-    pusch_info.rnti                                 = pusch.sch.grant.rnti;
-    pusch_info.pdu                                  = srsran::make_byte_buffer();
-    if (pusch_info.pdu == nullptr) {
-      logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+    if (srsran_uci_nr_total_bits(&pusch.sch.uci) > 0 and not decode_pusch(pusch)) {
       return false;
     }
-    pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
-    pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
+  }
 
-    // Decode PUSCH
-    if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
-        SRSRAN_SUCCESS) {
-      logger.error("Error getting PUSCH");
-      return false;
-    }
+  return true;
+}
 
-    // Extract DMRS information
-    pusch_info.csi = gnb_ul.dmrs.csi;
+bool slot_worker::work_ul_data()
+{
+  // Account the UCI decoding time too, so that the UL time covers the whole UL processing
+  auto t_start = std::chrono::steady_clock::now() - ul_uci_time;
+  auto on_exit = srsran::make_scope_exit([this, t_start]() { metrics_proc_time(t_start, true); });
 
-    // Inform stack
-    if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
-      logger.error("Error pushing PUSCH information to stack");
+  if (ul_sched == nullptr) {
+    return false;
+  }
+
+  // For each PUSCH without UCI...
+  for (stack_interface_phy_nr::pusch_t& pusch : ul_sched->pusch) {
+    if (srsran_uci_nr_total_bits(&pusch.sch.uci) == 0 and not decode_pusch(pusch)) {
       return false;
     }
+  }
 
-    // Log PUSCH decoding
-    if (logger.info.enabled()) {
-      std::array<char, 512> str;
-      srsran_gnb_ul_pusch_info(&gnb_ul, &pusch.sch, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
+  return true;
+}
 
-      if (logger.debug.enabled()) {
-        std::array<char, 1024> str_extra = {};
-        srsran_sch_cfg_nr_info(&pusch.sch, str_extra.data(), (uint32_t)str_extra.size());
-        logger.info("PUSCH: %s\n%s", str.data(), str_extra.data());
-      } else {
-        logger.info("PUSCH: %s", str.data());
-      }
+bool slot_worker::decode_pusch(stack_interface_phy_nr::pusch_t& pusch)
+{
+  // Prepare PUSCH
+  stack_interface_phy_nr::pusch_info_t pusch_info = {};
+  pusch_info.uci_cfg                              = pusch.sch.uci;
+  pusch_info.pid                                  = pusch.pid;
+  pusch_info.rnti                                 = pusch.sch.grant.rnti;
+  pusch_info.pdu                                  = srsran::make_byte_buffer();
+  if (pusch_info.pdu == nullptr) {
+    logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+    return false;
+  }
+  pusch_info.pdu->N_bytes             = pusch.sch.grant.tb[0].tbs / 8;
+  pusch_info.pusch_data.tb[0].payload = pusch_info.pdu->data();
+
+  // Decode PUSCH
+  if (srsran_gnb_ul_get_pusch(&gnb_ul, &ul_slot_cfg, &pusch.sch, &pusch.sch.grant, &pusch_info.pusch_data) <
+      SRSRAN_SUCCESS) {
+    logger.error("Error getting PUSCH");
+    return false;
+  }
+
+  // Extract DMRS information
+  pusch_info.csi = gnb_ul.dmrs.csi;
+
+  // Inform stack
+  if (stack.pusch_info(ul_slot_cfg, pusch_info) < SRSRAN_SUCCESS) {
+    logger.error("Error pushing PUSCH information to stack");
+    return false;
+  }
+
+  // Log PUSCH decoding
+  if (logger.info.enabled()) {
+    std::array<char, 512> str;
+    srsran_gnb_ul_pusch_info(&gnb_ul, &pusch.sch, &pusch_info.pusch_data, str.data(), (uint32_t)str.size());
+
+    if (logger.debug.enabled()) {
+      std::array<char, 1024> str_extra = {};
+      srsran_sch_cfg_nr_info(&pusch.sch, str_extra.data(), (uint32_t)str_extra.size());
+      logger.info("PUSCH: %s\n%s", str.data(), str_extra.data());
+    } else {
+      logger.info("PUSCH: %s", str.data());
     }
   }
 
@@ -299,6 +339,9 @@ bool slot_worker::work_dl()
     return false;
   }
 
+  auto t_start = std::chrono::steady_clock::now();
+  auto on_exit = srsran::make_scope_exit([this, t_start]() { metrics_proc_time(t_start, false); });
+
   if (srsran_gnb_dl_base_zero(&gnb_dl) < SRSRAN_SUCCESS) {
     logger.error("Error zeroing RE grid");
     return false;
@@ -414,6 +457,12 @@ void slot_worker::work_imp()
     tx_rf_buffer.set(rf_port, a, nof_ant, tx_buffer[a]);
   }
 
+  // Process uplink and downlink as independent tasks
+  if (task_pool != nullptr) {
+    work_tasks(tx_rf_buffer);
+    return;
+  }
+
   // Process uplink
   if (not work_ul()) {
     // Wait and release synchronization
@@ -442,6 +491,74 @@ void slot_worker::work_imp()
 #endif
 }
 
+void slot_worker::work_tasks(srsran::rf_buffer_t& tx_rf_buffer)
+{
+  // The HARQ-ACK and CSI carried in this UL slot must reach the stack before the DL scheduling of the slot
+  if (not work_ul_uci()) {
+    logger.error("Error processing UL slot %d", ul_slot_cfg.idx);
+
+    // Keep the scheduler sequence, the next worker waits for this one
+    sync.wait(this);
+    sync.release();
+    common.worker_end(context, false, tx_rf_buffer);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(ul_mutex);
+    ul_pending = true;
+  }
+  task_pool->push_task([this]() {
+    if (not work_ul_data()) {
+      logger.error("Error processing UL slot %d", ul_slot_cfg.idx);
+    }
+
+    std::lock_guard<std::mutex> lock(ul_mutex);
+    ul_pending = false;
+    ul_cvar.notify_one();
+  });
+
+  // The DL does not depend on the UL shared channel data of the same slot, transmit as soon as it is ready
+  bool dl_ok = work_dl();
+  common.worker_end(context, dl_ok, tx_rf_buffer);
+
+  // The worker can not be released until the UL processing has finished with the Rx buffers
+  std::unique_lock<std::mutex> lock(ul_mutex);
+  while (ul_pending) {
+    ul_cvar.wait(lock);
+  }
+}
+
+void slot_worker::metrics_proc_time(std::chrono::steady_clock::time_point t_start, bool is_ul)
+{
+  float t_us =
+      std::chrono::duration_cast<std::chrono::duration<float, std::micro> >(std::chrono::steady_clock::now() - t_start)
+          .count();
+
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  if (is_ul) {
+    metrics.ul_time_us     = SRSRAN_VEC_CMA(t_us, metrics.ul_time_us, metrics.ul_n_samples);
+    metrics.ul_max_time_us = std::max(metrics.ul_max_time_us, t_us);
+    metrics.ul_n_samples++;
+  } else {
+    metrics.dl_time_us     = SRSRAN_VEC_CMA(t_us, metrics.dl_time_us, metrics.dl_n_samples);
+    metrics.dl_max_time_us = std::max(metrics.dl_max_time_us, t_us);
+    metrics.dl_n_samples++;
+  }
+}
+
+void slot_worker::get_metrics(phy_cc_metrics_t& m)
+{
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  m.ul_time_us     = SRSRAN_VEC_SAFE_PMA(m.ul_time_us, m.ul_n_samples, metrics.ul_time_us, metrics.ul_n_samples);
+  m.dl_time_us     = SRSRAN_VEC_SAFE_PMA(m.dl_time_us, m.dl_n_samples, metrics.dl_time_us, metrics.dl_n_samples);
+  m.ul_max_time_us = std::max(m.ul_max_time_us, metrics.ul_max_time_us);
+  m.dl_max_time_us = std::max(m.dl_max_time_us, metrics.dl_max_time_us);
+  m.ul_n_samples += metrics.ul_n_samples;
+  m.dl_n_samples += metrics.dl_n_samples;
+  metrics = {};
+}
+
 bool slot_worker::set_common_cfg(const srsran_carrier_nr_t&   carrier,
                                  const srsran_pdcch_cfg_nr_t& pdcch_cfg_,
                                  const srsran_ssb_cfg_t&      ssb_cfg_)
@@ -29,6 +29,7 @@ worker_pool::worker_pool(srsran::phy_common_interface& common_,
                          srslog::sink&                 log_sink_,
                          uint32_t                      max_workers) :
   pool(max_workers, "NR-"),
+  task_pool(max_workers, true),
   common(common_),
   stack(stack_),
   log_sink(log_sink_),
@@ -53,6 +54,11 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   logger.set_level(log_level);
 
+  // Start the task pool, one task thread per worker is enough since each worker pushes one UL task per slot
+  if (args.slot_tasks) {
+    task_pool.start(args.prio);
+  }
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
     auto& log = srslog::fetch_basic_logger(fmt::format("{}PHY{}-NR", args.log.id_preamble, i), log_sink);
@@ -73,6 +79,7 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
+    w_args.task_pool               = args.slot_tasks ? &task_pool : nullptr;
 
     if (not w->init(w_args)) {
       return false;
@@ -113,9 +120,17 @@ slot_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+  task_pool.stop();
   prach.stop();
 }
 
+void worker_pool::get_metrics(phy_cc_metrics_t& m)
+{
+  for (auto& w : workers) {
+    w->get_metrics(m);
+  }
+}
+
 int worker_pool::set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common_cfg)
 {
   // Best effort to convert NR carrier into LTE cell
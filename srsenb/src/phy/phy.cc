@@ -286,6 +286,22 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
   }
 }
 
+void phy::get_cc_metrics(std::vector<phy_cc_metrics_t>& metrics)
+{
+  metrics.clear();
+  metrics.resize(workers_common.get_nof_carriers_lte(), phy_cc_metrics_t{});
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    lte_workers[i]->get_cc_metrics(metrics);
+  }
+
+  // NR carrier goes after the LTE carriers
+  if (nr_workers != nullptr) {
+    metrics.emplace_back();
+    metrics.back() = {};
+    nr_workers->get_metrics(metrics.back());
+  }
+}
+
 void phy::cmd_cell_gain(uint32_t cell_id, float gain_db)
 {
   Info("set_cell_gain: cell_id=%d, gain_db=%.2f", cell_id, gain_db);
@@ -376,6 +392,7 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.slot_tasks              = args.nr_slot_tasks;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
@@ -134,7 +134,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
     return SRSRAN_ERROR;
   }
   rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
-  pdcp.init(&rlc, &rrc, gtpu_adapter.get());
+  pdcp.init(&rlc, &rrc, gtpu_adapter.get(), args.nof_up_workers);
   if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize RRC");
     return SRSRAN_ERROR;
@@ -172,6 +172,7 @@ void enb_stack_lte::tti_clock()
 void enb_stack_lte::tti_clock_impl()
 {
   task_sched.tic();
+  pdcp.tic();
   rrc.tti_clock();
 }
 
@@ -190,8 +191,8 @@ void enb_stack_lte::stop_impl()
   s1ap.stop();
   gtpu.stop();
   mac.stop();
-  rlc.stop();
   pdcp.stop();
+  rlc.stop();
   rrc.stop();
 
   if (args.mac_pcap.enable) {
@@ -264,6 +264,7 @@ void mac::get_metrics(mac_metrics_t& metrics)
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].cell.id : 0;
   }
+  metrics.nof_late_sched_results = scheduler.get_nof_late_results();
 }
 
 void mac::toggle_padding()
@@ -670,7 +671,8 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 
       if (ue_db.contains(rnti)) {
         // Copy dci info
-        dl_sched_res->pdsch[n].dci = sched_result.data[i].dci;
+        dl_sched_res->pdsch[n].dci              = sched_result.data[i].dci;
+        dl_sched_res->pdsch[n].mu_mimo_rbg_mask = sched_result.data[i].mu_mimo_rbg_mask;
 
         for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
           dl_sched_res->pdsch[n].softbuffer_tx[tb] =
@@ -722,7 +724,8 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
     // Copy RAR grants
     for (uint32_t i = 0; i < sched_result.rar.size(); i++) {
       // Copy dci info
-      dl_sched_res->pdsch[n].dci = sched_result.rar[i].dci;
+      dl_sched_res->pdsch[n].dci              = sched_result.rar[i].dci;
+      dl_sched_res->pdsch[n].mu_mimo_rbg_mask = 0;
 
       // Set softbuffer (there are no retx in RAR but a softbuffer is required)
       dl_sched_res->pdsch[n].softbuffer_tx[0] = &common_buffers[enb_cc_idx].rar_softbuffer_tx;
@@ -757,7 +760,8 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
     // Copy SI and Paging grants
     for (uint32_t i = 0; i < sched_result.bc.size(); i++) {
       // Copy dci info
-      dl_sched_res->pdsch[n].dci = sched_result.bc[i].dci;
+      dl_sched_res->pdsch[n].dci              = sched_result.bc[i].dci;
+      dl_sched_res->pdsch[n].mu_mimo_rbg_mask = 0;
 
       // Set softbuffer
       if (sched_result.bc[i].type == sched_interface::dl_sched_bc_t::BCCH) {
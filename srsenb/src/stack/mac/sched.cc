@@ -25,43 +25,273 @@
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsenb/hdr/stack/mac/sched_carrier.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/adt/mpsc_queue.h"
+#include "srsran/adt/pool/cached_alloc.h"
+#include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 
 #define Console(fmt, ...) srsran::console(fmt, ##__VA_ARGS__)
 #define Error(fmt, ...) srslog::fetch_basic_logger("MAC").error(fmt, ##__VA_ARGS__)
+#define Warning(fmt, ...) srslog::fetch_basic_logger("MAC").warning(fmt, ##__VA_ARGS__)
 
 using srsran::tti_point;
 
 namespace srsenb {
 
+/*******************************************************
+ *
+ * UE event queues
+ *
+ *******************************************************/
+
+/// Queues the UE buffer state and CSI updates coming from the PHY and RLC threads, so that they do not contend with
+/// the TTI generation for the scheduler lock. The queues are lock-free and sharded by RNTI, which keeps the events of a
+/// UE in order. The events are applied under the scheduler lock, at the start of a TTI or before any synchronous access
+/// to the UE.
+/// Every UE added to the scheduler gets a new generation, and each event is tagged with the generation of its RNTI
+/// when it is queued. The events of a removed UE are dropped, even if the RNTI is reused before they are applied.
+class sched::ue_event_manager
+{
+public:
+  using ue_db_t = rnti_map_t<std::unique_ptr<sched_ue> >;
+
+  ue_event_manager()
+  {
+    for (std::atomic<uint32_t>& gen : generations) {
+      gen.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /// Queues an event for a UE. Can be called from any thread. Fails if the RNTI is not known to the scheduler
+  int enqueue(uint16_t rnti, const char* event_name, srsran::move_callback<void(sched_ue&)> ev)
+  {
+    uint32_t gen = generations[rnti].load(std::memory_order_acquire);
+    if (gen == 0) {
+      Error("SCHED: User rnti=0x%x not found. Failed to call %s.", rnti, event_name);
+      return SRSRAN_ERROR;
+    }
+    shards[rnti % nof_shards].emplace(rnti, gen, event_name, std::move(ev));
+    return SRSRAN_SUCCESS;
+  }
+
+  /// Called under the scheduler lock when a UE is added to the scheduler
+  void add_ue(uint16_t rnti)
+  {
+    next_generation = std::max(next_generation + 1, 1U);
+    generations[rnti].store(next_generation, std::memory_order_release);
+  }
+
+  /// Called under the scheduler lock when a UE is removed from the scheduler
+  void rem_ue(uint16_t rnti) { generations[rnti].store(0, std::memory_order_release); }
+
+  /// Applies the pending events of all UEs
+  void process_all(ue_db_t& ue_db)
+  {
+    for (uint32_t i = 0; i < nof_shards; ++i) {
+      process_shard(ue_db, i);
+    }
+  }
+
+  /// Applies the pending events of the UEs sharing a shard with the given RNTI
+  void process_ue(ue_db_t& ue_db, uint16_t rnti) { process_shard(ue_db, rnti % nof_shards); }
+
+  void clear()
+  {
+    for (uint32_t i = 0; i < generations.size(); ++i) {
+      generations[i].store(0, std::memory_order_release);
+    }
+    for (srsran::mpsc_queue<event_t>& shard : shards) {
+      shard.clear();
+    }
+  }
+
+private:
+  static const uint32_t nof_shards = 16;
+
+  struct event_t {
+    uint16_t                               rnti;
+    uint32_t                               generation;
+    const char*                            event_name;
+    srsran::move_callback<void(sched_ue&)> callback;
+    event_t(uint16_t rnti_, uint32_t generation_, const char* event_name_, srsran::move_callback<void(sched_ue&)> c) :
+      rnti(rnti_), generation(generation_), event_name(event_name_), callback(std::move(c))
+    {}
+  };
+
+  /// Only called under the scheduler lock, which makes it the single consumer of the shard
+  void process_shard(ue_db_t& ue_db, uint32_t shard_idx)
+  {
+    shards[shard_idx].pop_all([this, &ue_db](event_t& ev) {
+      auto it = ue_db.find(ev.rnti);
+      if (it == ue_db.end() or generations[ev.rnti].load(std::memory_order_relaxed) != ev.generation) {
+        // The UE was removed, and possibly added again, after the event was queued
+        return;
+      }
+      ev.callback(*it->second);
+    });
+  }
+
+  std::array<srsran::mpsc_queue<event_t>, nof_shards> shards;
+  std::array<std::atomic<uint32_t>, 1U << 16U>        generations; ///< Generation of each RNTI, 0 if not in use
+  uint32_t                                             next_generation = 0;
+};
+
+/*******************************************************
+ *
+ * Scheduler look-ahead
+ *
+ *******************************************************/
+
+/// Generates the scheduling results of the TTIs that follow the last TTI fetched by the PHY, so that the PHY workers
+/// only have to copy ready results. Each TTI is generated under the scheduler lock, released between TTIs.
+class sched::lookahead_worker final : public srsran::thread
+{
+public:
+  lookahead_worker(sched* parent_, uint32_t nof_ttis_) : thread("SCHED_LOOKAHEAD"), parent(parent_), nof_ttis(nof_ttis_)
+  {
+    start();
+  }
+  ~lookahead_worker() override { stop(); }
+
+  /// Changes the number of TTIs generated ahead of the PHY. With 0, no TTI is generated anymore
+  void set_nof_ttis(uint32_t nof_ttis_)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    nof_ttis   = nof_ttis_;
+    target_tti = {};
+  }
+
+  /// Forgets the TTIs fetched by the PHY, after a scheduler reset
+  void reset()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    next_tti   = {};
+    target_tti = {};
+  }
+
+  /// Called when the PHY fetches the results of tti_rx. Triggers the generation of the next nof_ttis TTIs
+  void push_fetched_tti(tti_point tti_rx)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (target_tti.is_valid() and tti_rx + nof_ttis <= target_tti) {
+      return;
+    }
+    target_tti = tti_rx + nof_ttis;
+    if (not next_tti.is_valid() or next_tti <= tti_rx) {
+      // First TTI or the worker fell behind the PHY
+      next_tti = tti_rx + 1;
+    }
+    cvar.notify_one();
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (not running) {
+        return;
+      }
+      running = false;
+    }
+    cvar.notify_one();
+    wait_thread_finish();
+  }
+
+private:
+  void run_thread() override
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+      if (not next_tti.is_valid() or target_tti < next_tti) {
+        cvar.wait(lock);
+        continue;
+      }
+      tti_point tti_rx = next_tti++;
+      lock.unlock();
+      parent->generate_tti(tti_rx);
+      lock.lock();
+    }
+  }
+
+  sched*   parent;
+  uint32_t nof_ttis;
+
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  bool                    running = true;
+  tti_point               next_tti;
+  tti_point               target_tti;
+};
+
 /*******************************************************
  *
  * Initialization and sched configuration functions
  *
  *******************************************************/
 
-sched::sched() {}
+sched::sched() : ue_events(new ue_event_manager{})
+{
+  for (std::atomic<uint32_t>& tti : ready_ttis) {
+    tti = tti_point{}.to_uint();
+  }
+}
 
-sched::~sched() {}
+sched::~sched()
+{
+  // The look-ahead worker accesses the scheduler state, so it is stopped first
+  lookahead.reset();
+}
 
 void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
 {
   rrc       = rrc_;
   sched_cfg = sched_cfg_;
 
+  // The HARQ feedback delay of the look-ahead has to stay well below the HARQ RTT
+  if (not ASYNC_DL_SCHED and sched_cfg.lookahead_ttis > 0) {
+    Warning("SCHED: Scheduler look-ahead requires asynchronous DL HARQs. Disabling it");
+    sched_cfg.lookahead_ttis = 0;
+  } else if (sched_cfg.lookahead_ttis > TX_ENB_DELAY) {
+    Warning("SCHED: Scheduler look-ahead of %d TTIs is too large. Setting it to %d TTIs",
+            sched_cfg.lookahead_ttis,
+            TX_ENB_DELAY);
+    sched_cfg.lookahead_ttis = TX_ENB_DELAY;
+  }
+
   // Initialize first carrier scheduler
   carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
 
   reset();
+
+  if (not sched_cfg.trace_filename.empty()) {
+    trace.open(sched_cfg.trace_filename.c_str(), sched_cfg);
+  }
+
+  if (sched_cfg.lookahead_ttis > 0) {
+    lookahead.reset(new lookahead_worker{this, sched_cfg.lookahead_ttis});
+  }
 }
 
 int sched::reset()
 {
+  if (lookahead != nullptr) {
+    lookahead->reset();
+  }
+
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.reset();
   for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
     c->reset();
   }
+  ue_events->clear();
   ue_db.clear();
+
+  // The results published before the reset are stale
+  for (std::atomic<uint32_t>& tti : ready_ttis) {
+    tti.store(tti_point{}.to_uint(), std::memory_order_release);
+  }
   return 0;
 }
 
@@ -69,6 +299,26 @@ int sched::reset()
 int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.cell_cfg(cell_cfg);
+
+  // The RAR window starts 3 TTIs after the PRACH (TS 36.321 Sec. 5.1.4), but the RAR of a PRACH reported in TTI n
+  // can only be allocated from TTI n + TX_ENB_DELAY + lookahead_ttis + 1 onwards. The look-ahead is shortened so that
+  // the RAR window of every cell can still be met
+  for (const sched_interface::cell_cfg_t& cc_cfg : cell_cfg) {
+    uint32_t max_lookahead =
+        cc_cfg.prach_rar_window + 1 > TX_ENB_DELAY ? cc_cfg.prach_rar_window + 1 - TX_ENB_DELAY : 0;
+    if (sched_cfg.lookahead_ttis > max_lookahead) {
+      Warning("SCHED: The RAR window of %d TTIs is too short for a scheduler look-ahead of %d TTIs. Setting it to %d",
+              cc_cfg.prach_rar_window,
+              sched_cfg.lookahead_ttis,
+              max_lookahead);
+      sched_cfg.lookahead_ttis = max_lookahead;
+      if (lookahead != nullptr) {
+        lookahead->set_nof_ttis(max_lookahead);
+      }
+    }
+  }
+
   // Setup derived config params
   sched_cell_params.resize(cell_cfg.size());
   for (uint32_t cc_idx = 0; cc_idx < cell_cfg.size(); ++cc_idx) {
@@ -106,8 +356,10 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   {
     // config existing user
     std::lock_guard<std::mutex> lock(sched_mutex);
-    auto                        it = ue_db.find(rnti);
+    ue_events->process_ue(ue_db, rnti);
+    auto it = ue_db.find(rnti);
     if (it != ue_db.end()) {
+      trace.ue_cfg(rnti, ue_cfg);
       it->second->set_cfg(ue_cfg);
       return SRSRAN_SUCCESS;
     }
@@ -116,15 +368,20 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   // Add new user case
   std::unique_ptr<sched_ue>   ue{new sched_ue(rnti, sched_cell_params, ue_cfg)};
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.ue_cfg(rnti, ue_cfg);
   ue_db.insert(rnti, std::move(ue));
+  ue_events->add_ue(rnti);
   return SRSRAN_SUCCESS;
 }
 
 int sched::ue_rem(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  ue_events->process_ue(ue_db, rnti);
   if (ue_db.contains(rnti)) {
+    trace.ue_rem(rnti);
     ue_db.erase(rnti);
+    ue_events->rem_ue(rnti);
   } else {
     Error("User rnti=0x%x not found", rnti);
     return SRSRAN_ERROR;
@@ -142,17 +399,28 @@ void sched::phy_config_enabled(uint16_t rnti, bool enabled)
 {
   // TODO: Check if correct use of last_tti
   ue_db_access_locked(
-      rnti, [this, enabled](sched_ue& ue) { ue.phy_config_enabled(last_tti, enabled); }, __PRETTY_FUNCTION__);
+      rnti,
+      [this, rnti, enabled](sched_ue& ue) {
+        trace.phy_config_enabled(rnti, enabled);
+        ue.phy_config_enabled(last_tti, enabled);
+      },
+      __PRETTY_FUNCTION__);
 }
 
 int sched::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, const mac_lc_ch_cfg_t& cfg_)
 {
-  return ue_db_access_locked(rnti, [lc_id, cfg_](sched_ue& ue) { ue.set_bearer_cfg(lc_id, cfg_); });
+  return ue_db_access_locked(rnti, [this, rnti, lc_id, cfg_](sched_ue& ue) {
+    trace.bearer_ue_cfg(rnti, lc_id, cfg_);
+    ue.set_bearer_cfg(lc_id, cfg_);
+  });
 }
 
 int sched::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
 {
-  return ue_db_access_locked(rnti, [lc_id](sched_ue& ue) { ue.rem_bearer(lc_id); });
+  return ue_db_access_locked(rnti, [this, rnti, lc_id](sched_ue& ue) {
+    trace.bearer_ue_rem(rnti, lc_id);
+    ue.rem_bearer(lc_id);
+  });
 }
 
 uint32_t sched::get_dl_buffer(uint16_t rnti)
@@ -176,12 +444,18 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
 
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
 {
-  return ue_db_access_locked(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue); });
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, rnti, lc_id, tx_queue, prio_tx_queue](sched_ue& ue) {
+    trace.dl_rlc_buffer_state(rnti, lc_id, tx_queue, prio_tx_queue);
+    ue.dl_buffer_state(lc_id, tx_queue, prio_tx_queue);
+  });
 }
 
 int sched::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
 {
-  return ue_db_access_locked(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, rnti, ce_code, nof_cmds](sched_ue& ue) {
+    trace.dl_mac_buffer_state(rnti, ce_code, nof_cmds);
+    ue.mac_buffer_state(ce_code, nof_cmds);
+  });
 }
 
 int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
@@ -189,38 +463,50 @@ int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint
   int ret = -1;
   ue_db_access_locked(
       rnti,
-      [&](sched_ue& ue) { ret = ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack); },
+      [&](sched_ue& ue) {
+        trace.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
+        ret = ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack);
+      },
       __PRETTY_FUNCTION__);
   return ret;
 }
 
 int sched::ul_crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
 {
-  return ue_db_access_locked(
-      rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc); });
+  return ue_db_access_locked(rnti, [this, tti_rx, rnti, enb_cc_idx, crc](sched_ue& ue) {
+    trace.ul_crc_info(tti_rx, rnti, enb_cc_idx, crc);
+    ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc);
+  });
 }
 
 int sched::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, ri_value](sched_ue& ue) { ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value); });
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, tti, rnti, enb_cc_idx, ri_value](sched_ue& ue) {
+    trace.dl_ri_info(tti, rnti, enb_cc_idx, ri_value);
+    ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value);
+  });
 }
 
 int sched::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, pmi_value](sched_ue& ue) { ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value); });
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, tti, rnti, enb_cc_idx, pmi_value](sched_ue& ue) {
+    trace.dl_pmi_info(tti, rnti, enb_cc_idx, pmi_value);
+    ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value);
+  });
 }
 
 int sched::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) { ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value); });
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, tti, rnti, enb_cc_idx, cqi_value](sched_ue& ue) {
+    trace.dl_cqi_info(tti, rnti, enb_cc_idx, cqi_value);
+    ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value);
+  });
 }
 
 int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t sb_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(rnti, [tti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, tti, rnti, enb_cc_idx, cqi_value, sb_idx](sched_ue& ue) {
+    trace.dl_sb_cqi_info(tti, rnti, enb_cc_idx, sb_idx, cqi_value);
     ue.set_dl_sb_cqi(tti_point{tti}, enb_cc_idx, sb_idx, cqi_value);
   });
 }
@@ -228,40 +514,54 @@ int sched::dl_sb_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint
 int sched::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.dl_rach_info(enb_cc_idx, rar_info);
   return carrier_schedulers[enb_cc_idx]->dl_rach_info(rar_info);
 }
 
 int sched::ul_snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code)
 {
-  return ue_db_access_locked(rnti,
-                             [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, tti_rx, rnti, enb_cc_idx, snr, ul_ch_code](sched_ue& ue) {
+    trace.ul_snr_info(tti_rx, rnti, enb_cc_idx, snr, ul_ch_code);
+    ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code);
+  });
 }
 
 int sched::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
-  return ue_db_access_locked(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, rnti, lcg_id, bsr](sched_ue& ue) {
+    trace.ul_bsr(rnti, lcg_id, bsr);
+    ue.ul_buffer_state(lcg_id, bsr);
+  });
 }
 
 int sched::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
 {
-  return ue_db_access_locked(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, rnti, lcid, bytes](sched_ue& ue) {
+    trace.ul_buffer_add(rnti, lcid, bytes);
+    ue.ul_buffer_add(lcid, bytes);
+  });
 }
 
 int sched::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
 {
-  return ue_db_access_locked(
-      rnti, [phr, ul_nof_prb](sched_ue& ue) { ue.ul_phr(phr, ul_nof_prb); }, __PRETTY_FUNCTION__);
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, rnti, phr, ul_nof_prb](sched_ue& ue) {
+    trace.ul_phr(rnti, phr, ul_nof_prb);
+    ue.ul_phr(phr, ul_nof_prb);
+  });
 }
 
 int sched::ul_sr_info(uint32_t tti, uint16_t rnti)
 {
-  return ue_db_access_locked(
-      rnti, [](sched_ue& ue) { ue.set_sr(); }, __PRETTY_FUNCTION__);
+  return ue_events->enqueue(rnti, __PRETTY_FUNCTION__, [this, tti, rnti](sched_ue& ue) {
+    trace.ul_sr_info(tti, rnti);
+    ue.set_sr();
+  });
 }
 
 void sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.set_dl_tti_mask(tti_mask, nof_sfs);
   carrier_schedulers[0]->set_dl_tti_mask(tti_mask, nof_sfs);
 }
 
@@ -304,6 +604,7 @@ std::array<int, SRSRAN_MAX_CARRIERS> sched::get_enb_ue_activ_cc_map(uint16_t rnt
 int sched::set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_info)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
+  trace.set_pdcch_order(enb_cc_idx, pdcch_order_info);
   return carrier_schedulers[enb_cc_idx]->pdcch_order_info(pdcch_order_info);
 }
 
@@ -316,19 +617,18 @@ int sched::set_pdcch_order(uint32_t enb_cc_idx, dl_sched_po_info_t pdcch_order_i
 // Downlink Scheduler API
 int sched::dl_sched(uint32_t tti_tx_dl, uint32_t enb_cc_idx, sched_interface::dl_sched_res_t& sched_result)
 {
-  std::lock_guard<std::mutex> lock(sched_mutex);
-  if (not configured) {
-    return 0;
-  }
   if (enb_cc_idx >= carrier_schedulers.size()) {
     return 0;
   }
 
-  tti_point tti_rx = tti_point{tti_tx_dl} - TX_ENB_DELAY;
-  new_tti(tti_rx);
+  tti_point              tti_rx = tti_point{tti_tx_dl} - TX_ENB_DELAY;
+  const sf_sched_result* sf_res = get_tti_result(tti_rx);
+  if (sf_res == nullptr) {
+    return 0;
+  }
 
   // copy result
-  sched_result = sched_results.get_sf(tti_rx)->get_cc(enb_cc_idx)->dl_sched_result;
+  sched_result = sf_res->get_cc(enb_cc_idx)->dl_sched_result;
 
   return 0;
 }
@@ -336,24 +636,58 @@ int sched::dl_sched(uint32_t tti_tx_dl, uint32_t enb_cc_idx, sched_interface::dl
 // Uplink Scheduler API
 int sched::ul_sched(uint32_t tti, uint32_t enb_cc_idx, srsenb::sched_interface::ul_sched_res_t& sched_result)
 {
-  std::lock_guard<std::mutex> lock(sched_mutex);
-  if (not configured) {
-    return 0;
-  }
   if (enb_cc_idx >= carrier_schedulers.size()) {
     return 0;
   }
 
-  // Compute scheduling Result for tti_rx
-  tti_point tti_rx = tti_point{tti} - TX_ENB_DELAY - FDD_HARQ_DELAY_DL_MS;
-  new_tti(tti_rx);
+  // Fetch scheduling Result for tti_rx
+  tti_point              tti_rx = tti_point{tti} - TX_ENB_DELAY - FDD_HARQ_DELAY_DL_MS;
+  const sf_sched_result* sf_res = get_tti_result(tti_rx);
+  if (sf_res == nullptr) {
+    return 0;
+  }
 
   // copy result
-  sched_result = sched_results.get_sf(tti_rx)->get_cc(enb_cc_idx)->ul_sched_result;
+  sched_result = sf_res->get_cc(enb_cc_idx)->ul_sched_result;
 
   return SRSRAN_SUCCESS;
 }
 
+/// Get the scheduling result of tti_rx for all CCs, generating it if it is not ready yet
+/// NOTE: A ready result is not modified until its slot in sched_results is reused, so it can be read without locking.
+///       With look-ahead enabled, a result that still has to be generated by the PHY is accounted as late.
+const sf_sched_result* sched::get_tti_result(tti_point tti_rx)
+{
+  if (not is_ready(tti_rx)) {
+    std::lock_guard<std::mutex> lock(sched_mutex);
+    if (not configured) {
+      return nullptr;
+    }
+    if (sched_cfg.lookahead_ttis > 0 and not is_generated(tti_rx, 0)) {
+      nof_late_results++;
+    }
+    new_tti(tti_rx);
+  }
+  trace.flush();
+
+  if (lookahead != nullptr) {
+    lookahead->push_fetched_tti(tti_rx);
+  }
+  return sched_results.get_sf(tti_rx);
+}
+
+/// Generate the scheduling decision for a future tti_rx. Called by the look-ahead worker
+void sched::generate_tti(tti_point tti_rx)
+{
+  {
+    std::lock_guard<std::mutex> lock(sched_mutex);
+    if (configured) {
+      new_tti(tti_rx);
+    }
+  }
+  trace.flush();
+}
+
 /// Generate scheduling decision for tti_rx, if it wasn't already generated
 /// NOTE: The scheduling decision is made for all CCs in a single call/lock, otherwise the UE can have different
 ///       configurations (e.g. different set of activated SCells) in different CC decisions
@@ -361,6 +695,9 @@ void sched::new_tti(tti_point tti_rx)
 {
   last_tti = std::max(last_tti, tti_rx);
 
+  // Apply the buffer state and CSI updates received since the last TTI
+  ue_events->process_all(ue_db);
+
   // Generate sched results for all CCs, if not yet generated
   for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
@@ -368,6 +705,11 @@ void sched::new_tti(tti_point tti_rx)
       carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
     }
   }
+
+  trace.tti_result(*sched_results.get_sf(tti_rx));
+
+  // Publish the result to the PHY
+  ready_ttis[tti_rx.to_uint()].store(tti_rx.to_uint(), std::memory_order_release);
 }
 
 /// Check if TTI result is generated
@@ -376,6 +718,12 @@ bool sched::is_generated(srsran::tti_point tti_rx, uint32_t enb_cc_idx) const
   return sched_results.has_sf(tti_rx) and sched_results.get_sf(tti_rx)->is_generated(enb_cc_idx);
 }
 
+/// Check if the TTI result of all CCs was published to the PHY
+bool sched::is_ready(srsran::tti_point tti_rx) const
+{
+  return ready_ttis[tti_rx.to_uint()].load(std::memory_order_acquire) == tti_rx.to_uint();
+}
+
 int sched::metrics_read(uint16_t rnti, mac_ue_metrics_t& metrics)
 {
   return ue_db_access_locked(
@@ -387,7 +735,8 @@ template <typename Func>
 int sched::ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
-  auto                        it = ue_db.find(rnti);
+  ue_events->process_ue(ue_db, rnti);
+  auto it = ue_db.find(rnti);
   if (it != ue_db.end()) {
     f(*it->second);
   } else {
@@ -82,6 +82,10 @@ void sf_grid_t::init(const sched_cell_params_t& cell_params_)
 
   dl_mask.resize(nof_rbgs);
   ul_mask.resize(cc_cfg->nof_prb());
+  for (rbgmask_t& pairable_mask : dl_pairable_masks) {
+    pairable_mask.resize(nof_rbgs);
+  }
+  dl_paired_mask.resize(nof_rbgs);
 
   pdcch_alloc.init(*cc_cfg);
 
@@ -110,6 +114,10 @@ void sf_grid_t::new_tti(tti_point tti_rx_)
 
   dl_mask.reset();
   ul_mask.reset();
+  for (rbgmask_t& pairable_mask : dl_pairable_masks) {
+    pairable_mask.reset();
+  }
+  dl_paired_mask.reset();
 
   // Reserve PRBs for PUCCH
   ul_mask |= pucch_mask;
@@ -135,10 +143,12 @@ alloc_result sf_grid_t::alloc_dl(uint32_t     aggr_idx,
                                  alloc_type_t alloc_type,
                                  rbgmask_t    alloc_mask,
                                  sched_ue*    user,
-                                 bool         has_pusch_grant)
+                                 bool         has_pusch_grant,
+                                 int          pmi)
 {
-  // Check RBG collision
-  if ((dl_mask & alloc_mask).any()) {
+  // Check RBG collision. RBGs pairable with the user's PMI can be reused
+  rbgmask_t paired_rbgs = pmi >= 0 ? alloc_mask & dl_pairable_masks[get_orthogonal_pmi(pmi)] : rbgmask_t(nof_rbgs);
+  if ((dl_mask & alloc_mask & ~paired_rbgs).any()) {
     logger.debug("SCHED: Provided RBG mask collides with allocation previously made.\n");
     return alloc_result::sch_collision;
   }
@@ -159,6 +169,12 @@ alloc_result sf_grid_t::alloc_dl(uint32_t     aggr_idx,
   }
 
   // Allocate RBGs
+  if (pmi >= 0) {
+    // Each RBG is shared by at most two UEs
+    dl_pairable_masks[get_orthogonal_pmi(pmi)] &= ~paired_rbgs;
+    dl_pairable_masks[pmi] |= alloc_mask & ~paired_rbgs;
+    dl_paired_mask |= paired_rbgs;
+  }
   dl_mask |= alloc_mask;
 
   return alloc_result::success;
@@ -184,16 +200,60 @@ alloc_result sf_grid_t::alloc_dl_ctrl(uint32_t aggr_idx, rbg_interval rbg_range,
 }
 
 //! Allocates CCEs and RBs for a user DL data alloc.
-alloc_result sf_grid_t::alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, bool has_pusch_grant)
+alloc_result sf_grid_t::alloc_dl_data(sched_ue* user, const rbgmask_t& user_mask, bool has_pusch_grant, bool is_newtx)
 {
   srsran_dci_format_t dci_format = user->get_dci_format();
   uint32_t            nof_bits   = srsran_dci_format_sizeof(&cc_cfg->cfg.cell, nullptr, nullptr, dci_format);
   uint32_t            aggr_idx   = user->get_aggr_level(cc_cfg->enb_cc_idx, nof_bits);
-  alloc_result        ret        = alloc_dl(aggr_idx, alloc_type_t::DL_DATA, user_mask, user, has_pusch_grant);
+
+  // Retransmissions keep the MCS of the first transmission, which doesn't account for the MU-MIMO power split. They
+  // are neither paired nor pairable
+  int          pmi = is_newtx ? get_pairing_pmi(user) : -1;
+  alloc_result ret = alloc_dl(aggr_idx, alloc_type_t::DL_DATA, user_mask, user, has_pusch_grant, pmi);
 
   return ret;
 }
 
+/// Returns the PMI used to pair the user in MU-MIMO, or -1 if the user is not eligible for MU-MIMO.
+/// Only UEs in TM4 reporting rank 1 and a PMI are paired, as their PDSCH precoding follows the reported PMI
+int sf_grid_t::get_pairing_pmi(sched_ue* user) const
+{
+  if (not cc_cfg->sched_cfg->mu_mimo_enabled or cc_cfg->cfg.cell.nof_ports != 2 or
+      user->get_dci_format() != SRSRAN_DCI_FORMAT2) {
+    return -1;
+  }
+  const sched_ue_cell* ue_cc = user->find_ue_carrier(cc_cfg->enb_cc_idx);
+  if (ue_cc == nullptr or ue_cc->dl_ri != 0 or not ue_cc->dl_pmi_tti_rx.is_valid() or
+      ue_cc->dl_pmi >= nof_mu_mimo_pmis) {
+    return -1;
+  }
+  return ue_cc->dl_pmi;
+}
+
+/// Returns the DL RBGs that are not available for the given user, taking into account MU-MIMO pairing
+rbgmask_t sf_grid_t::get_dl_mask(sched_ue* user) const
+{
+  int pmi = get_pairing_pmi(user);
+  if (pmi < 0) {
+    return dl_mask;
+  }
+  return dl_mask & ~dl_pairable_masks[get_orthogonal_pmi(pmi)];
+}
+
+/// Checks whether all DL RBGs are occupied and none can be reused by MU-MIMO pairing
+bool sf_grid_t::is_dl_full() const
+{
+  if (not dl_mask.all()) {
+    return false;
+  }
+  for (const rbgmask_t& pairable_mask : dl_pairable_masks) {
+    if (pairable_mask.any()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 alloc_result sf_grid_t::alloc_ul_data(sched_ue* user, prb_interval alloc, bool needs_pdcch, bool strict)
 {
   if (alloc.stop() > ul_mask.size()) {
@@ -559,7 +619,7 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
   }
 
   // Try to allocate RBGs, PDCCH, and PUCCH
-  alloc_result ret = tti_alloc.alloc_dl_data(user, user_mask, has_pusch_grant);
+  alloc_result ret = tti_alloc.alloc_dl_data(user, user_mask, has_pusch_grant, h.is_empty());
 
   if (ret == alloc_result::no_cch_space and not has_pusch_grant and not data_allocs.empty() and
       user->get_ul_harq(get_tti_tx_ul(), get_enb_cc_idx())->is_empty()) {
@@ -569,7 +629,7 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
     tti_alloc.find_ul_alloc(L, &alloc);
     has_pusch_grant = alloc.length() > 0 and alloc_ul_user(user, alloc) == alloc_result::success;
     if (has_pusch_grant) {
-      ret = tti_alloc.alloc_dl_data(user, user_mask, has_pusch_grant);
+      ret = tti_alloc.alloc_dl_data(user, user_mask, has_pusch_grant, h.is_empty());
     }
   }
   if (ret != alloc_result::success) {
@@ -688,10 +748,20 @@ alloc_result sf_sched::alloc_phich(sched_ue* user)
     return alloc_result::no_cch_space;
   }
 
+  bool ack = true;
+  if (h->has_pending_crc(get_tti_rx())) {
+    // The PUSCH CRC is not yet known when scheduling ahead. PHICH hi=1 suspends the HARQ, which is resumed with an
+    // adaptive retx in case of a NACK.
+    h->pop_pending_phich();
+    h->request_pdcch();
+  } else {
+    ack = h->pop_pending_phich();
+  }
+
   /* Indicate PHICH acknowledgment if needed */
   ul_sf_result->phich.emplace_back();
   ul_sf_result->phich.back().rnti  = user->get_rnti();
-  ul_sf_result->phich.back().phich = h->pop_pending_phich() ? phich_t::ACK : phich_t::NACK;
+  ul_sf_result->phich.back().phich = ack ? phich_t::ACK : phich_t::NACK;
   return alloc_result::success;
 }
 
@@ -704,7 +774,8 @@ void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t&
     sched_interface::dl_sched_data_t* data = &dl_result->data.back();
 
     // Assign NCCE/L
-    data->dci.location = dci_result[data_alloc.dci_idx]->dci_pos;
+    data->dci.location     = dci_result[data_alloc.dci_idx]->dci_pos;
+    data->mu_mimo_rbg_mask = (uint32_t)(data_alloc.user_mask & tti_alloc.get_dl_paired_mask()).to_uint64();
 
     // Generate DCI Format1/2/2A
     auto ue_it = ue_list.find(data_alloc.rnti);
@@ -948,7 +1019,7 @@ void sf_sched::generate_sched_results(sched_ue_list& ue_db)
     auto&         ue   = *ue_pair.second;
     uint16_t      rnti = ue.get_rnti();
     ul_harq_proc* h    = ue.get_ul_harq(get_tti_tx_ul(), cc_cfg->enb_cc_idx);
-    if (h != nullptr and not h->is_empty() and not is_ul_alloc(rnti)) {
+    if (h != nullptr and not h->is_empty() and not h->has_pending_crc(get_tti_rx()) and not is_ul_alloc(rnti)) {
       // There was a missed UL harq retx. Halt+Resume the HARQ
       h->retx_skipped();
       auto     same_rnti = [rnti](const phich_t& p) { return p.rnti == rnti; };
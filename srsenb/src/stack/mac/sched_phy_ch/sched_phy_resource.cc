@@ -83,13 +83,12 @@ rbgmask_t find_available_rbgmask(const rbgmask_t& in_mask, uint32_t max_size)
     return localmask;
   }
 
-  uint32_t i = 0, nof_alloc = 0;
-  for (; i < localmask.size() and nof_alloc < max_size; ++i) {
-    if (localmask.test(i)) {
-      nof_alloc++;
-    }
+  // Keep the lowest "max_size" free RBGs. Skips over occupied RBGs a word at a time
+  int pos = -1;
+  for (uint32_t nof_alloc = 0; nof_alloc < max_size; ++nof_alloc) {
+    pos = localmask.find_lowest(pos + 1, localmask.size());
   }
-  localmask.fill(i, localmask.size(), false);
+  localmask.fill(pos + 1, localmask.size(), false);
   return localmask;
 }
 
@@ -40,6 +40,7 @@ void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
   dci_record_list.reserve(16);
   last_dci_dfs.reserve(16);
   temp_dci_dfs.reserve(16);
+  failed_record_list.reserve(2 * SRSENB_MAX_UES);
 }
 
 void sf_cch_allocator::new_tti(tti_point tti_rx_)
@@ -48,6 +49,9 @@ void sf_cch_allocator::new_tti(tti_point tti_rx_)
 
   dci_record_list.clear();
   last_dci_dfs.clear();
+  failed_record_list.clear();
+  nof_alloc_cces   = 0;
+  nof_search_nodes = 0;
   current_cfix     = cc_cfg->sched_cfg->min_nof_ctrl_symbols - 1;
   current_max_cfix = cc_cfg->sched_cfg->max_nof_ctrl_symbols - 1;
 }
@@ -72,9 +76,24 @@ sf_cch_allocator::get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uin
   return nullptr;
 }
 
+bool sf_cch_allocator::is_known_failure(const alloc_record& record) const
+{
+  return std::any_of(failed_record_list.begin(), failed_record_list.end(), [&record](const alloc_record& r) {
+    return r.user == record.user and r.alloc_type == record.alloc_type and r.aggr_idx == record.aggr_idx and
+           r.pusch_uci == record.pusch_uci;
+  });
+}
+
+bool sf_cch_allocator::search_budget_exceeded() const
+{
+  uint32_t max_nodes = cc_cfg->sched_cfg->max_pdcch_search_nodes;
+  return max_nodes > 0 and nof_search_nodes >= max_nodes;
+}
+
 bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sched_ue* user, bool has_pusch_grant)
 {
   temp_dci_dfs.clear();
+  nof_search_nodes    = 0;
   uint32_t start_cfix = current_cfix;
 
   alloc_record record;
@@ -83,6 +102,13 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
   record.alloc_type = alloc_type;
   record.pusch_uci  = has_pusch_grant;
 
+  // The CCEs occupied by the allocations do not depend on their positions. If they do not fit in the PDCCH with the
+  // highest allowed CFI, no permutation of the DCI positions will make room for the new allocation
+  uint32_t min_nof_cces = nof_alloc_cces + (1U << aggr_idx);
+  if (min_nof_cces > cc_cfg->nof_cce_table[current_max_cfix] or is_known_failure(record)) {
+    return false;
+  }
+
   if (is_dl_ctrl_alloc(alloc_type) and nof_allocs() == 0 and cc_cfg->nof_prb() <= 25 and
       current_max_cfix > current_cfix) {
     // Given that CFI is not currently dynamic for ctrl allocs, in case of SIB/RAR alloc and a low number of PRBs,
@@ -100,12 +126,14 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
   }
 
   // Try to allocate grant. If it fails, attempt the same grant, but using a different permutation of past grant DCI
-  // positions
+  // positions. The number of visited DFS nodes is capped, to bound the worst-case PDCCH allocation time
   do {
-    bool success = alloc_dfs_node(record, 0);
+    bool success = nof_alloc_cces + (1U << aggr_idx) <= nof_cces() and not search_budget_exceeded() and
+                   alloc_dfs_node(record, 0);
     if (success) {
       // DCI record allocation successful
       dci_record_list.push_back(record);
+      nof_alloc_cces += 1U << aggr_idx;
 
       if (is_dl_ctrl_alloc(alloc_type)) {
         // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
@@ -116,7 +144,15 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
     if (temp_dci_dfs.empty()) {
       temp_dci_dfs = last_dci_dfs;
     }
-  } while (get_next_dfs());
+  } while (get_next_dfs(min_nof_cces));
+
+  if (search_budget_exceeded()) {
+    logger.debug("SCHED: PDCCH allocation search for rnti=0x%x interrupted after %d nodes",
+                 user != nullptr ? user->get_rnti() : SRSRAN_INVALID_RNTI,
+                 nof_search_nodes);
+  } else {
+    failed_record_list.push_back(record);
+  }
 
   // Revert steps to initial state, before dci record allocation was attempted
   last_dci_dfs.swap(temp_dci_dfs);
@@ -124,22 +160,27 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
   return false;
 }
 
-bool sf_cch_allocator::get_next_dfs()
+bool sf_cch_allocator::get_next_dfs(uint32_t min_nof_cces)
 {
   do {
+    if (search_budget_exceeded()) {
+      return false;
+    }
     uint32_t start_child_idx = 0;
     if (last_dci_dfs.empty()) {
-      // If we reach root, increase CFI
-      current_cfix++;
-      if (current_cfix > current_max_cfix) {
-        return false;
-      }
+      // If we reach root, increase CFI. CFIs without enough CCEs for all the allocations are skipped
+      do {
+        current_cfix++;
+        if (current_cfix > current_max_cfix) {
+          return false;
+        }
+      } while (nof_cces() < min_nof_cces);
     } else {
       // Attempt to re-add last tree node, but with a higher node child index
       start_child_idx = last_dci_dfs.back().dci_pos_idx + 1;
       last_dci_dfs.pop_back();
     }
-    while (last_dci_dfs.size() < dci_record_list.size() and
+    while (last_dci_dfs.size() < dci_record_list.size() and not search_budget_exceeded() and
            alloc_dfs_node(dci_record_list[last_dci_dfs.size()], start_child_idx)) {
       start_child_idx = 0;
     }
@@ -160,6 +201,7 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
   if (start_dci_idx >= dci_pos_list.size()) {
     return false;
   }
+  nof_search_nodes++;
 
   tree_node node;
   node.dci_pos_idx = start_dci_idx;
@@ -203,14 +245,13 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
       }
     }
 
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
+    if (node.total_mask.any(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx))) {
       // there is a PDCCH collision. Try another CCE position
       continue;
     }
 
     // Allocation successful
+    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
     node.total_mask |= node.current_mask;
     if (node.pucch_n_prb >= 0) {
       node.total_pucch_mask.set(node.pucch_n_prb);
@@ -228,7 +269,11 @@ void sf_cch_allocator::rem_last_dci()
 
   // Remove DCI record
   last_dci_dfs.pop_back();
+  nof_alloc_cces -= 1U << dci_record_list.back().aggr_idx;
   dci_record_list.pop_back();
+
+  // The PDCCH got emptier, so previously failed allocations may now succeed
+  failed_record_list.clear();
 }
 
 void sf_cch_allocator::get_allocs(alloc_result_t* vec, pdcch_mask_t* tot_mask, size_t idx) const
@@ -0,0 +1,753 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include "srsenb/hdr/stack/mac/sched_grid.h"
+#include "srsran/srslog/srslog.h"
+#include <cstring>
+#include <type_traits>
+
+namespace srsenb {
+
+using sched_args_t   = sched_interface::sched_args_t;
+using cell_cfg_t     = sched_interface::cell_cfg_t;
+using ue_cfg_t       = sched_interface::ue_cfg_t;
+using cc_result_t    = sched_trace_result::cc_result_t;
+using rar_info_t     = sched_interface::dl_sched_rar_info_t;
+using pdcch_order_t  = sched_interface::dl_sched_po_info_t;
+using trace_header_t = std::array<uint32_t, 3>;
+
+/// Type (1 byte), version (1 byte) and payload length (4 bytes) of a record
+static const size_t record_header_len = 6;
+
+/// Version of the encoding of each record type, stored in every record. It must be bumped when the fields of the
+/// record, or of the structures that it copies in the host layout, change. Records of another version are rejected
+static const std::array<uint8_t, static_cast<size_t>(sched_trace_ev::nulltype)> record_versions = {
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}};
+
+/// Signature of the sizes of the structures that the trace copies in the host layout. A trace of a build where the
+/// layout differs (e.g. another compiler, platform or srsRAN version) is rejected instead of being decoded as garbage
+static uint32_t host_layout_signature()
+{
+  const uint32_t sizes[] = {sizeof(srsran_cell_t),
+                            sizeof(sched_interface::cell_cfg_sib_t),
+                            sizeof(srsran_pusch_hopping_cfg_t),
+                            sizeof(cell_cfg_t::scell_cfg_t),
+                            sizeof(srsran_pucch_cfg_t),
+                            sizeof(mac_lc_ch_cfg_t),
+                            sizeof(ue_cfg_t::cc_cfg_t),
+                            sizeof(sched_interface::ant_info_ded_t),
+                            sizeof(rar_info_t),
+                            sizeof(pdcch_order_t),
+                            sizeof(sched_trace_result::grant_t),
+                            sizeof(srsran::tti_point)};
+  // FNV-1a
+  uint32_t sig = 2166136261U;
+  for (uint32_t size : sizes) {
+    sig = (sig ^ size) * 16777619U;
+  }
+  return sig;
+}
+
+/// "SRST", the version of the trace format and the host layout signature. The magic also detects the byte order
+static const trace_header_t trace_header = {0x54535253, 2, host_layout_signature()};
+
+/*******************************************************
+ *          Serialization of the trace records
+ *******************************************************/
+
+// Fields of the structures that are not trivially copyable. Shared by the packer and unpacker
+
+template <typename Archive, typename T>
+void serialize_sched_args(Archive& ar, T& a)
+{
+  ar(a.sched_policy,
+     a.sched_policy_args,
+     a.pdsch_mcs,
+     a.pdsch_max_mcs,
+     a.pusch_mcs,
+     a.pusch_max_mcs,
+     a.min_nof_ctrl_symbols,
+     a.max_nof_ctrl_symbols,
+     a.min_aggr_level,
+     a.max_aggr_level,
+     a.adaptive_aggr_level,
+     a.pucch_mux_enabled,
+     a.pucch_harq_max_rb,
+     a.target_bler,
+     a.max_delta_dl_cqi,
+     a.max_delta_ul_snr,
+     a.adaptive_dl_mcs_step_size,
+     a.adaptive_ul_mcs_step_size,
+     a.min_tpc_tti_interval,
+     a.ul_snr_avg_alpha,
+     a.init_ul_snr_value,
+     a.init_dl_cqi,
+     a.max_sib_coderate,
+     a.pdcch_cqi_offset,
+     a.max_pdcch_search_nodes,
+     a.mu_mimo_enabled,
+     a.lookahead_ttis);
+}
+
+template <typename Archive, typename T>
+void serialize_cell_cfg(Archive& ar, T& c)
+{
+  ar(c.cell,
+     c.sibs,
+     c.si_window_ms,
+     c.target_pucch_ul_sinr,
+     c.pusch_hopping_cfg,
+     c.target_pusch_ul_sinr,
+     c.min_phr_thres,
+     c.enable_phr_handling,
+     c.enable_64qam,
+     c.prach_config,
+     c.prach_nof_preambles,
+     c.prach_freq_offset,
+     c.prach_rar_window,
+     c.prach_contention_resolution_timer,
+     c.maxharq_msg3tx,
+     c.n1pucch_an,
+     c.delta_pucch_shift,
+     c.nrb_pucch,
+     c.nrb_cqi,
+     c.ncs_an,
+     c.srs_subframe_config,
+     c.srs_subframe_offset,
+     c.srs_bw_config,
+     c.scell_list);
+}
+
+template <typename Archive, typename T>
+void serialize_ue_cfg(Archive& ar, T& u)
+{
+  ar(u.maxharq_tx,
+     u.continuous_pusch,
+     u.uci_offset,
+     u.pucch_cfg,
+     u.ue_bearers,
+     u.supported_cc_list,
+     u.dl_ant_info,
+     u.use_tbs_index_alt,
+     u.measgap_period,
+     u.measgap_offset,
+     u.support_ul64qam);
+}
+
+template <typename Archive, typename T>
+void serialize_cc_result(Archive& ar, T& r)
+{
+  ar(r.cfi, r.nof_bcch, r.nof_rar, r.nof_po, r.dl_grants, r.ul_grants, r.phich_nacks);
+}
+
+template <typename Archive, typename T>
+void serialize_result(Archive& ar, T& r)
+{
+  ar(r.tti_rx, r.cc_list);
+}
+
+class trace_packer
+{
+public:
+  explicit trace_packer(std::vector<uint8_t>& buffer_) : buffer(buffer_) {}
+
+  void operator()() {}
+  template <typename T, typename... Args>
+  void operator()(const T& v, const Args&... args)
+  {
+    pack(v);
+    (*this)(args...);
+  }
+
+private:
+  template <typename T>
+  typename std::enable_if<std::is_trivially_copyable<T>::value>::type pack(const T& v)
+  {
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&v);
+    buffer.insert(buffer.end(), ptr, ptr + sizeof(T));
+  }
+  void pack(const std::string& s)
+  {
+    pack(static_cast<uint32_t>(s.size()));
+    buffer.insert(buffer.end(), s.begin(), s.end());
+  }
+  template <typename T>
+  void pack(const std::vector<T>& vec)
+  {
+    pack(static_cast<uint32_t>(vec.size()));
+    for (const T& v : vec) {
+      pack(v);
+    }
+  }
+  void pack(const sched_args_t& a) { serialize_sched_args(*this, a); }
+  void pack(const cell_cfg_t& c) { serialize_cell_cfg(*this, c); }
+  void pack(const ue_cfg_t& u) { serialize_ue_cfg(*this, u); }
+  void pack(const cc_result_t& r) { serialize_cc_result(*this, r); }
+  void pack(const sched_trace_result& r) { serialize_result(*this, r); }
+
+  std::vector<uint8_t>& buffer;
+};
+
+class trace_unpacker
+{
+public:
+  trace_unpacker(const uint8_t* ptr_, size_t len) : ptr(ptr_), end(ptr_ + len) {}
+
+  /// Checks that all the fields were decoded and that the record had no trailing bytes
+  bool is_valid() const { return ok and ptr == end; }
+
+  void operator()() {}
+  template <typename T, typename... Args>
+  void operator()(T& v, Args&... args)
+  {
+    unpack(v);
+    (*this)(args...);
+  }
+
+private:
+  bool advance(size_t n)
+  {
+    if (not ok or static_cast<size_t>(end - ptr) < n) {
+      ok = false;
+      return false;
+    }
+    ptr += n;
+    return true;
+  }
+  template <typename T>
+  typename std::enable_if<std::is_trivially_copyable<T>::value>::type unpack(T& v)
+  {
+    const uint8_t* src = ptr;
+    if (advance(sizeof(T))) {
+      memcpy(&v, src, sizeof(T));
+    }
+  }
+  void unpack(std::string& s)
+  {
+    uint32_t len = 0;
+    unpack(len);
+    const uint8_t* src = ptr;
+    if (advance(len)) {
+      s.assign(reinterpret_cast<const char*>(src), len);
+    }
+  }
+  template <typename T>
+  void unpack(std::vector<T>& vec)
+  {
+    uint32_t len = 0;
+    unpack(len);
+    // Each element takes at least one byte. Avoids large allocations for corrupted lengths
+    if (not ok or len > static_cast<size_t>(end - ptr)) {
+      ok = false;
+      return;
+    }
+    vec.resize(len);
+    for (T& v : vec) {
+      unpack(v);
+    }
+  }
+  void unpack(sched_args_t& a) { serialize_sched_args(*this, a); }
+  void unpack(cell_cfg_t& c) { serialize_cell_cfg(*this, c); }
+  void unpack(ue_cfg_t& u) { serialize_ue_cfg(*this, u); }
+  void unpack(cc_result_t& r) { serialize_cc_result(*this, r); }
+  void unpack(sched_trace_result& r) { serialize_result(*this, r); }
+
+  const uint8_t* ptr;
+  const uint8_t* end;
+  bool           ok = true;
+};
+
+/*******************************************************
+ *                 Result summary
+ *******************************************************/
+
+sched_trace_result make_sched_trace_result(const sf_sched_result& sf_res)
+{
+  sched_trace_result ret;
+  ret.tti_rx = sf_res.tti_rx;
+  ret.cc_list.resize(sf_res.enb_cc_list.size());
+  for (size_t cc = 0; cc < sf_res.enb_cc_list.size(); ++cc) {
+    const sched_interface::dl_sched_res_t& dl_res = sf_res.enb_cc_list[cc].dl_sched_result;
+    const sched_interface::ul_sched_res_t& ul_res = sf_res.enb_cc_list[cc].ul_sched_result;
+    cc_result_t&                           cc_res = ret.cc_list[cc];
+
+    cc_res.cfi     = dl_res.cfi;
+    cc_res.nof_rar = dl_res.rar.size();
+    cc_res.nof_po  = dl_res.po.size();
+    // Paging depends on the RRC, which is not part of the trace
+    for (const sched_interface::dl_sched_bc_t& bc : dl_res.bc) {
+      cc_res.nof_bcch += bc.type == sched_interface::dl_sched_bc_t::BCCH ? 1 : 0;
+    }
+    for (const sched_interface::dl_sched_data_t& data : dl_res.data) {
+      sched_trace_result::grant_t g = {};
+      g.rnti                        = data.dci.rnti;
+      g.ncce                        = data.dci.location.ncce;
+      g.alloc                       = data.dci.alloc_type == SRSRAN_RA_ALLOC_TYPE0 ? data.dci.type0_alloc.rbg_bitmask
+                                                                                     : data.dci.type2_alloc.riv;
+      std::copy(std::begin(data.tbs), std::end(data.tbs), g.tbs.begin());
+      cc_res.dl_grants.push_back(g);
+    }
+    for (const sched_interface::ul_sched_data_t& pusch : ul_res.pusch) {
+      sched_trace_result::grant_t g = {};
+      g.rnti                        = pusch.dci.rnti;
+      g.ncce                        = pusch.needs_pdcch ? pusch.dci.location.ncce : 0;
+      g.alloc                       = pusch.dci.type2_alloc.riv;
+      g.tbs[0]                      = pusch.tbs;
+      cc_res.ul_grants.push_back(g);
+    }
+    for (const sched_interface::ul_sched_phich_t& phich : ul_res.phich) {
+      if (phich.phich == sched_interface::ul_sched_phich_t::NACK) {
+        cc_res.phich_nacks.push_back(phich.rnti);
+      }
+    }
+  }
+  return ret;
+}
+
+/*******************************************************
+ *                   Trace writer
+ *******************************************************/
+
+bool sched_trace_writer::open(const char* filename, const sched_args_t& sched_args)
+{
+  {
+    std::lock_guard<std::mutex> lock(file_mutex);
+    fd = fopen(filename, "wb");
+    if (fd == nullptr) {
+      srslog::fetch_basic_logger("MAC").error("SCHED: Failed to open scheduler trace file %s", filename);
+      return false;
+    }
+    fwrite(trace_header.data(), sizeof(trace_header), 1, fd);
+    srslog::fetch_basic_logger("MAC").info("SCHED: Recording scheduler trace to %s", filename);
+  }
+
+  // The trace starts with the configuration of the scheduler
+  write(sched_trace_ev::sched_args, sched_args);
+  flush();
+  return true;
+}
+
+void sched_trace_writer::close()
+{
+  flush();
+  std::lock_guard<std::mutex> lock(file_mutex);
+  if (fd != nullptr) {
+    fclose(fd);
+    fd = nullptr;
+  }
+}
+
+void sched_trace_writer::flush()
+{
+  if (not is_open()) {
+    return;
+  }
+  std::lock_guard<std::mutex> file_lock(file_mutex);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.swap(flushing);
+  }
+  if (fd != nullptr and not flushing.empty()) {
+    fwrite(flushing.data(), 1, flushing.size(), fd);
+  }
+  flushing.clear();
+}
+
+template <typename... Args>
+void sched_trace_writer::write(sched_trace_ev type, const Args&... args)
+{
+  if (not is_open()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  // Record header: type, version and length of the payload, which is filled in after packing it
+  size_t hdr_pos = pending.size();
+  pending.resize(hdr_pos + record_header_len);
+  trace_packer{pending}(args...);
+  uint32_t len         = pending.size() - hdr_pos - record_header_len;
+  pending[hdr_pos]     = static_cast<uint8_t>(type);
+  pending[hdr_pos + 1] = record_versions[static_cast<size_t>(type)];
+  memcpy(&pending[hdr_pos + 2], &len, sizeof(len));
+}
+
+void sched_trace_writer::cell_cfg(const std::vector<cell_cfg_t>& cell_cfg)
+{
+  write(sched_trace_ev::cell_cfg, cell_cfg);
+}
+
+void sched_trace_writer::reset()
+{
+  write(sched_trace_ev::reset);
+}
+
+void sched_trace_writer::ue_cfg(uint16_t rnti, const ue_cfg_t& ue_cfg)
+{
+  write(sched_trace_ev::ue_cfg, rnti, ue_cfg);
+}
+
+void sched_trace_writer::ue_rem(uint16_t rnti)
+{
+  write(sched_trace_ev::ue_rem, rnti);
+}
+
+void sched_trace_writer::phy_config_enabled(uint16_t rnti, bool enabled)
+{
+  write(sched_trace_ev::phy_cfg, rnti, enabled);
+}
+
+void sched_trace_writer::bearer_ue_cfg(uint16_t rnti, uint32_t lc_id, const mac_lc_ch_cfg_t& cfg)
+{
+  write(sched_trace_ev::bearer_cfg, rnti, lc_id, cfg);
+}
+
+void sched_trace_writer::bearer_ue_rem(uint16_t rnti, uint32_t lc_id)
+{
+  write(sched_trace_ev::bearer_rem, rnti, lc_id);
+}
+
+void sched_trace_writer::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t prio_tx_queue)
+{
+  write(sched_trace_ev::dl_rlc_buffer_state, rnti, lc_id, tx_queue, prio_tx_queue);
+}
+
+void sched_trace_writer::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
+{
+  write(sched_trace_ev::dl_mac_buffer_state, rnti, ce_code, nof_cmds);
+}
+
+void sched_trace_writer::dl_ack_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
+{
+  write(sched_trace_ev::dl_ack_info, tti, rnti, enb_cc_idx, tb_idx, ack);
+}
+
+void sched_trace_writer::ul_crc_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
+{
+  write(sched_trace_ev::ul_crc_info, tti, rnti, enb_cc_idx, crc);
+}
+
+void sched_trace_writer::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
+{
+  write(sched_trace_ev::dl_ri_info, tti, rnti, enb_cc_idx, ri_value);
+}
+
+void sched_trace_writer::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
+{
+  write(sched_trace_ev::dl_pmi_info, tti, rnti, enb_cc_idx, pmi_value);
+}
+
+void sched_trace_writer::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
+{
+  write(sched_trace_ev::dl_cqi_info, tti, rnti, enb_cc_idx, cqi_value);
+}
+
+void sched_trace_writer::dl_sb_cqi_info(uint32_t tti,
+                                        uint16_t rnti,
+                                        uint32_t enb_cc_idx,
+                                        uint32_t sb_idx,
+                                        uint32_t cqi_value)
+{
+  write(sched_trace_ev::dl_sb_cqi_info, tti, rnti, enb_cc_idx, sb_idx, cqi_value);
+}
+
+void sched_trace_writer::dl_rach_info(uint32_t enb_cc_idx, const rar_info_t& rar_info)
+{
+  write(sched_trace_ev::dl_rach_info, enb_cc_idx, rar_info);
+}
+
+void sched_trace_writer::ul_snr_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code)
+{
+  write(sched_trace_ev::ul_snr_info, tti, rnti, enb_cc_idx, snr, ul_ch_code);
+}
+
+void sched_trace_writer::ul_sr_info(uint32_t tti, uint16_t rnti)
+{
+  write(sched_trace_ev::ul_sr_info, tti, rnti);
+}
+
+void sched_trace_writer::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
+{
+  write(sched_trace_ev::ul_bsr, rnti, lcg_id, bsr);
+}
+
+void sched_trace_writer::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
+{
+  write(sched_trace_ev::ul_buffer_add, rnti, lcid, bytes);
+}
+
+void sched_trace_writer::ul_phr(uint16_t rnti, int phr, uint32_t ul_nof_prb)
+{
+  write(sched_trace_ev::ul_phr, rnti, phr, ul_nof_prb);
+}
+
+void sched_trace_writer::set_dl_tti_mask(const uint8_t* tti_mask, uint32_t nof_sfs)
+{
+  write(sched_trace_ev::dl_tti_mask, std::vector<uint8_t>(tti_mask, tti_mask + nof_sfs));
+}
+
+void sched_trace_writer::set_pdcch_order(uint32_t enb_cc_idx, const pdcch_order_t& pdcch_order_info)
+{
+  write(sched_trace_ev::pdcch_order, enb_cc_idx, pdcch_order_info);
+}
+
+void sched_trace_writer::tti_result(const sf_sched_result& sf_res)
+{
+  if (not is_open()) {
+    return;
+  }
+  write(sched_trace_ev::tti_result, make_sched_trace_result(sf_res));
+}
+
+/*******************************************************
+ *                   Trace reader
+ *******************************************************/
+
+bool sched_trace_reader::open(const char* filename)
+{
+  close();
+  fd = fopen(filename, "rb");
+  if (fd == nullptr) {
+    srslog::fetch_basic_logger("MAC").error("SCHED: Failed to open scheduler trace file %s", filename);
+    return false;
+  }
+  trace_header_t header = {};
+  if (fread(header.data(), sizeof(header), 1, fd) != 1 or header[0] != trace_header[0] or
+      header[1] != trace_header[1]) {
+    srslog::fetch_basic_logger("MAC").error("SCHED: %s is not a scheduler trace of version %d",
+                                            filename,
+                                            trace_header[1]);
+    close();
+    return false;
+  }
+  if (header[2] != trace_header[2]) {
+    srslog::fetch_basic_logger("MAC").error("SCHED: %s was recorded by a build with another layout of the scheduler "
+                                            "structures, and can't be replayed",
+                                            filename);
+    close();
+    return false;
+  }
+  return true;
+}
+
+void sched_trace_reader::close()
+{
+  if (fd != nullptr) {
+    fclose(fd);
+    fd = nullptr;
+  }
+}
+
+sched_trace_ev sched_trace_reader::read_next(sched_interface& sched, handler& h)
+{
+  std::array<uint8_t, record_header_len> hdr = {};
+  if (fd == nullptr or fread(hdr.data(), hdr.size(), 1, fd) != 1 or
+      hdr[0] >= static_cast<uint8_t>(sched_trace_ev::nulltype)) {
+    return sched_trace_ev::nulltype;
+  }
+  sched_trace_ev type = static_cast<sched_trace_ev>(hdr[0]);
+  uint32_t       len  = 0;
+  memcpy(&len, &hdr[2], sizeof(len));
+  if (hdr[1] != record_versions[hdr[0]]) {
+    srslog::fetch_basic_logger("MAC").error("SCHED: Record of type %d has version %d in scheduler trace, expected %d",
+                                            hdr[0],
+                                            hdr[1],
+                                            record_versions[hdr[0]]);
+    return sched_trace_ev::nulltype;
+  }
+  buffer.resize(len);
+  if (fread(buffer.data(), 1, len, fd) != len) {
+    return sched_trace_ev::nulltype;
+  }
+
+  trace_unpacker unpack{buffer.data(), buffer.size()};
+  uint16_t       rnti = 0;
+  uint32_t       tti = 0, enb_cc_idx = 0, a = 0, b = 0, c = 0;
+  bool           flag = false;
+  switch (type) {
+    case sched_trace_ev::sched_args: {
+      sched_args_t args{};
+      unpack(args);
+      if (unpack.is_valid()) {
+        h.on_sched_args(args);
+      }
+    } break;
+    case sched_trace_ev::cell_cfg: {
+      std::vector<cell_cfg_t> cell_cfg;
+      unpack(cell_cfg);
+      if (unpack.is_valid()) {
+        sched.cell_cfg(cell_cfg);
+      }
+    } break;
+    case sched_trace_ev::reset:
+      sched.reset();
+      break;
+    case sched_trace_ev::ue_cfg: {
+      ue_cfg_t ue_cfg{};
+      unpack(rnti, ue_cfg);
+      if (unpack.is_valid()) {
+        sched.ue_cfg(rnti, ue_cfg);
+      }
+    } break;
+    case sched_trace_ev::ue_rem:
+      unpack(rnti);
+      if (unpack.is_valid()) {
+        sched.ue_rem(rnti);
+      }
+      break;
+    case sched_trace_ev::phy_cfg:
+      unpack(rnti, flag);
+      if (unpack.is_valid()) {
+        h.on_phy_config_enabled(rnti, flag);
+      }
+      break;
+    case sched_trace_ev::bearer_cfg: {
+      mac_lc_ch_cfg_t cfg{};
+      unpack(rnti, a, cfg);
+      if (unpack.is_valid()) {
+        sched.bearer_ue_cfg(rnti, a, cfg);
+      }
+    } break;
+    case sched_trace_ev::bearer_rem:
+      unpack(rnti, a);
+      if (unpack.is_valid()) {
+        sched.bearer_ue_rem(rnti, a);
+      }
+      break;
+    case sched_trace_ev::dl_rlc_buffer_state:
+      unpack(rnti, a, b, c);
+      if (unpack.is_valid()) {
+        sched.dl_rlc_buffer_state(rnti, a, b, c);
+      }
+      break;
+    case sched_trace_ev::dl_mac_buffer_state:
+      unpack(rnti, a, b);
+      if (unpack.is_valid()) {
+        sched.dl_mac_buffer_state(rnti, a, b);
+      }
+      break;
+    case sched_trace_ev::dl_ack_info:
+      unpack(tti, rnti, enb_cc_idx, a, flag);
+      if (unpack.is_valid()) {
+        sched.dl_ack_info(tti, rnti, enb_cc_idx, a, flag);
+      }
+      break;
+    case sched_trace_ev::ul_crc_info:
+      unpack(tti, rnti, enb_cc_idx, flag);
+      if (unpack.is_valid()) {
+        sched.ul_crc_info(tti, rnti, enb_cc_idx, flag);
+      }
+      break;
+    case sched_trace_ev::dl_ri_info:
+      unpack(tti, rnti, enb_cc_idx, a);
+      if (unpack.is_valid()) {
+        sched.dl_ri_info(tti, rnti, enb_cc_idx, a);
+      }
+      break;
+    case sched_trace_ev::dl_pmi_info:
+      unpack(tti, rnti, enb_cc_idx, a);
+      if (unpack.is_valid()) {
+        sched.dl_pmi_info(tti, rnti, enb_cc_idx, a);
+      }
+      break;
+    case sched_trace_ev::dl_cqi_info:
+      unpack(tti, rnti, enb_cc_idx, a);
+      if (unpack.is_valid()) {
+        sched.dl_cqi_info(tti, rnti, enb_cc_idx, a);
+      }
+      break;
+    case sched_trace_ev::dl_sb_cqi_info:
+      unpack(tti, rnti, enb_cc_idx, a, b);
+      if (unpack.is_valid()) {
+        sched.dl_sb_cqi_info(tti, rnti, enb_cc_idx, a, b);
+      }
+      break;
+    case sched_trace_ev::dl_rach_info: {
+      rar_info_t rar_info{};
+      unpack(enb_cc_idx, rar_info);
+      if (unpack.is_valid()) {
+        sched.dl_rach_info(enb_cc_idx, rar_info);
+      }
+    } break;
+    case sched_trace_ev::ul_snr_info: {
+      float snr = 0;
+      unpack(tti, rnti, enb_cc_idx, snr, a);
+      if (unpack.is_valid()) {
+        sched.ul_snr_info(tti, rnti, enb_cc_idx, snr, a);
+      }
+    } break;
+    case sched_trace_ev::ul_sr_info:
+      unpack(tti, rnti);
+      if (unpack.is_valid()) {
+        sched.ul_sr_info(tti, rnti);
+      }
+      break;
+    case sched_trace_ev::ul_bsr:
+      unpack(rnti, a, b);
+      if (unpack.is_valid()) {
+        sched.ul_bsr(rnti, a, b);
+      }
+      break;
+    case sched_trace_ev::ul_buffer_add:
+      unpack(rnti, a, b);
+      if (unpack.is_valid()) {
+        sched.ul_buffer_add(rnti, a, b);
+      }
+      break;
+    case sched_trace_ev::ul_phr: {
+      int phr = 0;
+      unpack(rnti, phr, a);
+      if (unpack.is_valid()) {
+        sched.ul_phr(rnti, phr, a);
+      }
+    } break;
+    case sched_trace_ev::dl_tti_mask: {
+      std::vector<uint8_t> tti_mask;
+      unpack(tti_mask);
+      if (unpack.is_valid()) {
+        sched.set_dl_tti_mask(tti_mask.data(), tti_mask.size());
+      }
+    } break;
+    case sched_trace_ev::pdcch_order: {
+      pdcch_order_t po_info{};
+      unpack(enb_cc_idx, po_info);
+      if (unpack.is_valid()) {
+        sched.set_pdcch_order(enb_cc_idx, po_info);
+      }
+    } break;
+    case sched_trace_ev::tti_result: {
+      sched_trace_result result;
+      unpack(result);
+      if (unpack.is_valid()) {
+        h.on_tti_result(result);
+      }
+    } break;
+    default:
+      break;
+  }
+
+  if (not unpack.is_valid()) {
+    srslog::fetch_basic_logger("MAC").error("SCHED: Invalid record of type %d in scheduler trace", (int)type);
+    return sched_trace_ev::nulltype;
+  }
+  return type;
+}
+
+} // namespace srsenb
@@ -72,6 +72,7 @@ void sched_ue::set_cfg(const ue_cfg_t& cfg_)
   // update configuration
   std::vector<sched::ue_cfg_t::cc_cfg_t> prev_supported_cc_list = std::move(cfg.supported_cc_list);
   cfg                                                           = cfg_;
+  cfg_version++;
 
   // update bearer cfgs
   lch_handler.set_cfg(cfg_);
@@ -322,8 +323,10 @@ tbs_info sched_ue::allocate_new_dl_mac_pdu(sched::dl_sched_data_t* data,
                                            uint32_t                cfi,
                                            uint32_t                tb)
 {
-  srsran_dci_dl_t* dci     = &data->dci;
-  tbs_info         tb_info = compute_mcs_and_tbs(enb_cc_idx, tti_tx_dl, user_mask, cfi, *dci);
+  // The PDSCH power is halved in the RBGs shared in MU-MIMO
+  srsran_dci_dl_t* dci        = &data->dci;
+  int              cqi_offset = data->mu_mimo_rbg_mask != 0 ? mu_mimo_dl_cqi_offset : 0;
+  tbs_info         tb_info    = compute_mcs_and_tbs(enb_cc_idx, tti_tx_dl, user_mask, cfi, *dci, cqi_offset);
 
   // Allocate MAC PDU (subheaders, CEs, and SDUS)
   int rem_tbs = tb_info.tbs_bytes;
@@ -473,13 +476,15 @@ int sched_ue::generate_format1(uint32_t                          pid,
  * @param rbgs RBG mask
  * @param cfi Number of control symbols in Subframe
  * @param dci contains the RBG mask, and alloc type
+ * @param cqi_offset offset applied to the DL CQI, e.g. for MU-MIMO
  * @return pair with MCS and TBS (in bytes)
  */
 tbs_info sched_ue::compute_mcs_and_tbs(uint32_t               enb_cc_idx,
                                        tti_point              tti_tx_dl,
                                        const rbgmask_t&       rbg_mask,
                                        uint32_t               cfi,
-                                       const srsran_dci_dl_t& dci)
+                                       const srsran_dci_dl_t& dci,
+                                       int                    cqi_offset)
 {
   srsran_assert(cells[enb_cc_idx].configured(), "computation of MCS/TBS called for non-configured CC");
   srsran::interval<uint32_t> req_bytes = get_requested_dl_bytes(enb_cc_idx);
@@ -488,7 +493,7 @@ tbs_info sched_ue::compute_mcs_and_tbs(uint32_t               enb_cc_idx,
   uint32_t nof_re = cells[enb_cc_idx].cell_cfg->get_dl_nof_res(tti_tx_dl, dci, cfi);
 
   // Compute MCS+TBS
-  tbs_info tb = cqi_to_tbs_dl(cells[enb_cc_idx], rbg_mask, nof_re, dci.format, req_bytes.stop());
+  tbs_info tb = cqi_to_tbs_dl(cells[enb_cc_idx], rbg_mask, nof_re, dci.format, req_bytes.stop(), cqi_offset);
 
   if (tb.tbs_bytes > 0 and tb.tbs_bytes < (int)req_bytes.start()) {
     logger.info("SCHED: Could not get PRB allocation that avoids MAC CE or RLC SRB0 PDU segmentation");
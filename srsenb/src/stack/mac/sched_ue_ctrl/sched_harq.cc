@@ -38,9 +38,10 @@ namespace srsenb {
 
 harq_proc::harq_proc() : logger(&srslog::fetch_basic_logger("MAC")) {}
 
-void harq_proc::init(uint32_t id_)
+void harq_proc::init(uint32_t id_, uint32_t feedback_delay_)
 {
-  id = id_;
+  id             = id_;
+  feedback_delay = feedback_delay_;
 }
 
 void harq_proc::reset(uint32_t tb_idx)
@@ -211,7 +212,8 @@ rbgmask_t dl_harq_proc::get_rbgmask() const
 
 bool dl_harq_proc::has_pending_retx(uint32_t tb_idx, tti_point tti_tx_dl) const
 {
-  return (tti_tx_dl >= to_tx_dl_ack(tti)) and has_pending_retx_common(tb_idx);
+  // With scheduler look-ahead, the ACK is only known feedback_delay TTIs after the usual HARQ RTT
+  return (tti_tx_dl >= to_tx_dl_ack(tti) + feedback_delay) and has_pending_retx_common(tb_idx);
 }
 
 bool dl_harq_proc::has_pending_retx(tti_point tti_tx_dl) const
@@ -233,9 +235,9 @@ void dl_harq_proc::reset_pending_data()
  *                  UE::UL HARQ class                 *
  ******************************************************/
 
-void ul_harq_proc::new_tti()
+void ul_harq_proc::new_tti(tti_point tti_rx)
 {
-  if (has_pending_retx() and nof_retx(0) + 1 >= max_nof_retx()) {
+  if (has_pending_retx() and not has_pending_crc(tti_rx) and nof_retx(0) + 1 >= max_nof_retx()) {
     logger->info(
         "SCHED: discarding UL pid=%d, tti=%d, maximum number of retx exceeded (%d)", get_id(), tti.to_uint(), max_retx);
     active[0] = false;
@@ -255,6 +257,12 @@ bool ul_harq_proc::has_pending_retx() const
   return has_pending_retx_common(0);
 }
 
+bool ul_harq_proc::has_pending_crc(tti_point tti_rx) const
+{
+  // The CRC of the PUSCH at tti is only received by the PHY at tti, which the look-ahead scheduler may not have reached
+  return not is_empty(0) and tti + feedback_delay > tti_rx;
+}
+
 void ul_harq_proc::new_tx(tti_point tti_, int mcs, int tbs, prb_interval alloc, uint32_t max_retx_, bool is_msg3)
 {
   allocation = alloc;
@@ -340,13 +348,14 @@ uint32_t ul_harq_proc::get_pending_data() const
  *   Harq Entity
  *******************/
 
-harq_entity::harq_entity(size_t nof_dl_harqs, size_t nof_ul_harqs) : dl_harqs(nof_dl_harqs), ul_harqs(nof_ul_harqs)
+harq_entity::harq_entity(size_t nof_dl_harqs, size_t nof_ul_harqs, uint32_t feedback_delay) :
+  dl_harqs(nof_dl_harqs), ul_harqs(nof_ul_harqs)
 {
   for (uint32_t i = 0; i < dl_harqs.size(); ++i) {
-    dl_harqs[i].init(i);
+    dl_harqs[i].init(i, feedback_delay);
   }
   for (uint32_t i = 0; i < ul_harqs.size(); ++i) {
-    ul_harqs[i].init(i);
+    ul_harqs[i].init(i, feedback_delay);
   }
 }
 
@@ -370,7 +379,7 @@ void harq_entity::reset()
 void harq_entity::new_tti(tti_point tti_rx)
 {
   last_ttis[tti_rx.to_uint() % last_ttis.size()] = tti_rx;
-  get_ul_harq(to_tx_ul(tti_rx))->new_tti();
+  get_ul_harq(to_tx_ul(tti_rx))->new_tti(tti_rx);
   for (auto& hdl : dl_harqs) {
     hdl.new_tti(to_tx_dl(tti_rx));
   }
@@ -43,7 +43,7 @@ sched_ue_cell::sched_ue_cell(uint16_t rnti_, const sched_cell_params_t& cell_cfg
   rnti(rnti_),
   cell_cfg(&cell_cfg_),
   dci_locations(generate_cce_location_table(rnti_, cell_cfg_)),
-  harq_ent(SCHED_MAX_HARQ_PROC, SCHED_MAX_HARQ_PROC),
+  harq_ent(SCHED_MAX_HARQ_PROC, SCHED_MAX_HARQ_PROC, cell_cfg_.sched_cfg->lookahead_ttis),
   tpc_fsm(rnti_,
           cell_cfg->nof_prb(),
           cell_cfg->cfg.target_pucch_ul_sinr,
@@ -401,7 +401,8 @@ tbs_info cqi_to_tbs_dl(const sched_ue_cell& cell,
                        const rbgmask_t&     rbgs,
                        uint32_t             nof_re,
                        srsran_dci_format_t  dci_format,
-                       uint32_t             req_bytes)
+                       uint32_t             req_bytes,
+                       int                  cqi_offset)
 {
   bool     use_tbs_index_alt = cell.get_ue_cfg()->use_tbs_index_alt and dci_format != SRSRAN_DCI_FORMAT1A;
   uint32_t nof_prbs          = count_prb_per_tb(rbgs);
@@ -409,7 +410,7 @@ tbs_info cqi_to_tbs_dl(const sched_ue_cell& cell,
   tbs_info ret;
   if (cell.fixed_mcs_dl < 0 or not cell.dl_cqi().is_cqi_info_received()) {
     // Dynamic MCS configured or first Tx
-    uint32_t dl_cqi = cell.get_dl_cqi(rbgs);
+    uint32_t dl_cqi = std::max(cell.get_dl_cqi(rbgs) + cqi_offset, 0);
 
     ret = compute_min_mcs_and_tbs_from_required_bytes(
         nof_prbs, nof_re, dl_cqi, cell.max_mcs_dl, req_bytes, false, false, use_tbs_index_alt);
@@ -82,8 +82,8 @@ alloc_result try_dl_newtx_alloc_greedy(sf_sched& tti_sched, sched_ue& ue, const
     *result_mask = {};
   }
 
-  // If all RBGs are occupied, the next steps can be shortcut
-  const rbgmask_t& current_mask = tti_sched.get_dl_mask();
+  // If all RBGs are occupied, the next steps can be shortcut. RBGs pairable with the UE in MU-MIMO are not occupied
+  rbgmask_t current_mask = tti_sched.get_dl_mask(&ue);
   if (current_mask.all()) {
     return alloc_result::no_sch_space;
   }
@@ -140,7 +140,7 @@ const ul_harq_proc* get_ul_retx_harq(sched_ue& user, sf_sched* tti_sched)
     return nullptr;
   }
   const ul_harq_proc* h = user.get_ul_harq(tti_sched->get_tti_tx_ul(), tti_sched->get_enb_cc_idx());
-  return h->has_pending_retx() ? h : nullptr;
+  return (h->has_pending_retx() and not h->has_pending_crc(tti_sched->get_tti_rx())) ? h : nullptr;
 }
 const ul_harq_proc* get_ul_newtx_harq(sched_ue& user, sf_sched* tti_sched)
 {
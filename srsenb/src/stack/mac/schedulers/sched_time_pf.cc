@@ -20,65 +20,83 @@
  */
 
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
+#include <algorithm>
 #include <vector>
 
 namespace srsenb {
 
 using srsran::tti_point;
 
-sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args)
+sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args) :
+  ue_by_id(SRSENB_MAX_UES, nullptr), dl_heap(SRSENB_MAX_UES), ul_heap(SRSENB_MAX_UES)
 {
   cc_cfg = &cell_params_;
   if (not sched_args.sched_policy_args.empty()) {
     fairness_coeff = std::stof(sched_args.sched_policy_args);
   }
 
-  std::vector<ue_ctxt*> dl_storage;
-  dl_storage.reserve(SRSENB_MAX_UES);
-  dl_queue = ue_dl_queue_t(ue_dl_prio_compare{}, std::move(dl_storage));
-
-  std::vector<ue_ctxt*> ul_storage;
-  ul_storage.reserve(SRSENB_MAX_UES);
-  ul_queue = ue_ul_queue_t(ue_ul_prio_compare{}, std::move(ul_storage));
+  free_ids.reserve(SRSENB_MAX_UES);
+  for (uint32_t i = SRSENB_MAX_UES; i > 0; --i) {
+    free_ids.push_back(i - 1);
+  }
+  dl_retx_list.reserve(SRSENB_MAX_UES);
+  ul_retx_list.reserve(SRSENB_MAX_UES);
+  tti_allocs.reserve(SRSENB_MAX_UES);
 }
 
 void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
 {
-  while (not dl_queue.empty()) {
-    dl_queue.pop();
+  tti_point tti_rx = tti_sched->get_tti_rx();
+  if (current_tti_rx.is_valid() and tti_rx > current_tti_rx) {
+    tti_count += tti_rx - current_tti_rx;
   }
-  while (not ul_queue.empty()) {
-    ul_queue.pop();
-  }
-  current_tti_rx = tti_point{tti_sched->get_tti_rx()};
+  current_tti_rx = tti_rx;
+
   // remove deleted users from history
   for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
     if (not ue_db.contains(it->first)) {
+      uint32_t id = it->second.id;
+      dl_heap.erase(id);
+      ul_heap.erase(id);
+      ue_by_id[id] = nullptr;
+      free_ids.push_back(id);
       it = ue_history_db.erase(it);
     } else {
       ++it;
     }
   }
-  // add new users to history db, and update priority queues
+
+  // add new users to history db, and update the priorities that changed
+  dl_retx_list.clear();
+  ul_retx_list.clear();
   for (auto& u : ue_db) {
     auto it = ue_history_db.find(u.first);
     if (it == ue_history_db.end()) {
-      it = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
-    }
-    it->second.new_tti(*cc_cfg, *u.second, tti_sched);
-    if (it->second.dl_newtx_h != nullptr or it->second.dl_retx_h != nullptr) {
-      dl_queue.push(&it->second);
-    }
-    if (it->second.ul_h != nullptr) {
-      // Allocate only if UL carrier is enabled
-      for (auto& i : u.second->get_ue_cfg().supported_cc_list) {
-        if (i.enb_cc_idx == cc_cfg->enb_cc_idx and not i.ul_disabled) {
-          ul_queue.push(&it->second);
-          break;
-        }
-      }
+      uint32_t id = free_ids.back();
+      free_ids.pop_back();
+      it           = ue_history_db.insert(u.first, ue_ctxt{u.first, id, fairness_coeff, tti_count}).value();
+      ue_by_id[id] = &it->second;
+    }
+    ue_ctxt& ue = it->second;
+    ue.new_tti(*cc_cfg, *u.second, tti_sched, tti_count);
+    if (ue.dl_key_changed) {
+      dl_heap.set(ue.id, ue.dl.key());
+    }
+    if (ue.ul_key_changed) {
+      ul_heap.set(ue.id, ue.ul.key());
+    }
+    if (ue.dl_retx_h != nullptr) {
+      dl_retx_list.push_back(&ue);
+    }
+    if (ue.ul_h != nullptr and ue.ul_h->has_pending_retx()) {
+      ul_retx_list.push_back(&ue);
     }
   }
+
+  auto dl_prio_cmp = [](const ue_ctxt* lhs, const ue_ctxt* rhs) { return lhs->dl.key() > rhs->dl.key(); };
+  std::sort(dl_retx_list.begin(), dl_retx_list.end(), dl_prio_cmp);
+  auto ul_prio_cmp = [](const ue_ctxt* lhs, const ue_ctxt* rhs) { return lhs->ul.key() > rhs->ul.key(); };
+  std::sort(ul_retx_list.begin(), ul_retx_list.end(), ul_prio_cmp);
 }
 
 /*****************************************************************
@@ -92,13 +110,37 @@ void sched_time_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
-  while (not dl_queue.empty()) {
-    ue_ctxt& ue = *dl_queue.top();
-    ue.save_dl_alloc(try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    dl_queue.pop();
+  // Retransmissions first
+  tti_allocs.clear();
+  for (ue_ctxt* ue : dl_retx_list) {
+    tti_allocs.emplace_back(ue, try_dl_alloc(*ue, *ue_db[ue->rnti], tti_sched));
   }
+
+  // New transmissions in PF order, until there are no RBGs left
+  dl_heap.visit_in_order([this, &ue_db, tti_sched](uint32_t id) {
+    if (tti_sched->is_dl_full()) {
+      return false;
+    }
+    ue_ctxt& ue = *ue_by_id[id];
+    if (ue.dl_retx_h == nullptr and ue.dl_newtx_h != nullptr) {
+      tti_allocs.emplace_back(&ue, try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched));
+    }
+    return true;
+  });
+
+  save_dl_allocs();
 }
 
+void sched_time_pf::save_dl_allocs()
+{
+  // NOTE: The UEs without allocation keep their key, their average rate decays like all the others
+  for (const auto& alloc : tti_allocs) {
+    if (alloc.second > 0) {
+      alloc.first->dl.save_alloc(alloc.second, tti_count);
+      dl_heap.set(alloc.first->id, alloc.first->dl.key());
+    }
+  }
+}
 uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
 {
   alloc_result code = alloc_result::other_cause;
@@ -131,10 +173,48 @@ void sched_time_pf::sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
-  while (not ul_queue.empty()) {
-    ue_ctxt& ue = *ul_queue.top();
-    ue.save_ul_alloc(try_ul_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    ul_queue.pop();
+  // Retransmissions first
+  tti_allocs.clear();
+  for (ue_ctxt* ue : ul_retx_list) {
+    ue->ul_visit_tti = tti_count;
+    tti_allocs.emplace_back(ue, try_ul_alloc(*ue, *ue_db[ue->rnti], tti_sched));
+  }
+
+  // New transmissions in PF order, until there are no PRBs left
+  bool ul_full = false;
+  ul_heap.visit_in_order([this, &ue_db, tti_sched, &ul_full](uint32_t id) {
+    if (tti_sched->get_ul_mask().all()) {
+      ul_full = true;
+      return false;
+    }
+    ue_ctxt& ue = *ue_by_id[id];
+    if (ue.ul_h != nullptr and not ue.ul_h->has_pending_retx()) {
+      ue.ul_visit_tti = tti_count;
+      tti_allocs.emplace_back(&ue, try_ul_alloc(ue, *ue_db[ue.rnti], tti_sched));
+    }
+    return true;
+  });
+
+  // The UEs not visited may still have an UL grant allocated for UCI, which counts for their average rate
+  if (ul_full) {
+    for (auto& u : ue_history_db) {
+      ue_ctxt& ue = u.second;
+      if (ue.ul_h != nullptr and ue.ul_visit_tti != tti_count and tti_sched->is_ul_alloc(ue.rnti)) {
+        tti_allocs.emplace_back(&ue, ue.ul_h->get_pending_data());
+      }
+    }
+  }
+
+  save_ul_allocs();
+}
+
+void sched_time_pf::save_ul_allocs()
+{
+  for (const auto& alloc : tti_allocs) {
+    if (alloc.second > 0) {
+      alloc.first->ul.save_alloc(alloc.second, tti_count);
+      ul_heap.set(alloc.first->id, alloc.first->ul.key());
+    }
   }
 }
 
@@ -178,74 +258,62 @@ uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* t
  *                          UE history
  *****************************************************************/
 
-void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched)
+void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched, uint64_t now)
 {
-  dl_retx_h  = nullptr;
-  dl_newtx_h = nullptr;
-  ul_h       = nullptr;
-  dl_prio    = 0;
-  ue_cc_idx  = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
+  dl_retx_h      = nullptr;
+  dl_newtx_h     = nullptr;
+  ul_h           = nullptr;
+  dl_key_changed = false;
+  ul_key_changed = false;
+  ue_cc_idx      = ue.enb_to_ue_cc_idx(cell.enb_cc_idx);
   if (ue_cc_idx < 0) {
     // not active
     return;
   }
+  const sched_ue_cell* cc_ue = ue.find_ue_carrier(cell.enb_cc_idx);
 
-  // Calculate DL priority
-  dl_retx_h  = get_dl_retx_harq(ue, tti_sched);
-  dl_newtx_h = get_dl_newtx_harq(ue, tti_sched);
-  if (dl_retx_h != nullptr or dl_newtx_h != nullptr) {
-    // calculate DL PF priority
-    float r = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
-    float R = dl_avg_rate();
-    dl_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+  // Update DL priority, the expected rate is only derived again when the CQI, RI, PMI or the UE configuration change
+  bool cfg_changed = ue.get_cfg_version() != cfg_version;
+  cfg_version      = ue.get_cfg_version();
+  dl_retx_h        = get_dl_retx_harq(ue, tti_sched);
+  dl_newtx_h       = get_dl_newtx_harq(ue, tti_sched);
+  if (cfg_changed or cc_ue->get_dl_cqi() != dl_cqi or cc_ue->dl_ri != dl_ri or cc_ue->dl_pmi != dl_pmi) {
+    dl_cqi = cc_ue->get_dl_cqi();
+    dl_ri  = cc_ue->dl_ri;
+    dl_pmi = cc_ue->dl_pmi;
+    dl.set_expected_rate(ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8, now);
+    dl_key_changed = true;
+  } else if (dl.needs_refresh(now)) {
+    dl.refresh_key(now);
+    dl_key_changed = true;
   }
 
-  // Calculate UL priority
+  // Update UL priority
   ul_h = get_ul_retx_harq(ue, tti_sched);
   if (ul_h == nullptr) {
     ul_h = get_ul_newtx_harq(ue, tti_sched);
   }
   if (ul_h != nullptr) {
-    float r = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
-    float R = ul_avg_rate();
-    ul_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
-  }
-}
-
-void sched_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
-{
-  if (dl_nof_samples < 1 / exp_avg_alpha) {
-    // fast start
-    dl_avg_rate_ = dl_avg_rate_ + (alloc_bytes - dl_avg_rate_) / (dl_nof_samples + 1);
-  } else {
-    dl_avg_rate_ = (1 - exp_avg_alpha) * dl_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+    // Allocate only if UL carrier is enabled
+    bool ul_enabled = false;
+    for (auto& i : ue.get_ue_cfg().supported_cc_list) {
+      if (i.enb_cc_idx == cell.enb_cc_idx and not i.ul_disabled) {
+        ul_enabled = true;
+        break;
+      }
+    }
+    if (not ul_enabled) {
+      ul_h = nullptr;
+    }
   }
-  dl_nof_samples++;
-}
-
-void sched_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
-{
-  if (ul_nof_samples < 1 / exp_avg_alpha) {
-    // fast start
-    ul_avg_rate_ = ul_avg_rate_ + (alloc_bytes - ul_avg_rate_) / (ul_nof_samples + 1);
-  } else {
-    ul_avg_rate_ = (1 - exp_avg_alpha) * ul_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+  if (cfg_changed or cc_ue->get_ul_cqi() != ul_cqi) {
+    ul_cqi = cc_ue->get_ul_cqi();
+    ul.set_expected_rate(ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8, now);
+    ul_key_changed = true;
+  } else if (ul.needs_refresh(now)) {
+    ul.refresh_key(now);
+    ul_key_changed = true;
   }
-  ul_nof_samples++;
-}
-
-bool sched_time_pf::ue_dl_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
-{
-  bool is_retx1 = lhs->dl_retx_h != nullptr, is_retx2 = rhs->dl_retx_h != nullptr;
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->dl_prio < rhs->dl_prio);
-}
-
-bool sched_time_pf::ue_ul_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
-                                                   const sched_time_pf::ue_ctxt* rhs) const
-{
-  bool is_retx1 = lhs->ul_h->has_pending_retx(), is_retx2 = rhs->ul_h->has_pending_retx();
-  return (not is_retx1 and is_retx2) or (is_retx1 == is_retx2 and lhs->ul_prio < rhs->ul_prio);
 }
 
 } // namespace srsenb
@@ -44,9 +44,11 @@ namespace srsenb {
 
 gtpu_tunnel_manager::gtpu_tunnel_manager(srsran::task_sched_handle task_sched_,
                                          srslog::basic_logger&     logger,
-                                         srsran::srsran_rat_t      ran_type_) :
-  logger(logger), ran_type(ran_type_), task_sched(task_sched_), tunnels(1)
+                                         srsran::srsran_rat_t      ran_type_,
+                                         size_t                    max_tunnels) :
+  logger(logger), ran_type(ran_type_), task_sched(task_sched_), tunnels(max_tunnels)
 {
+  ue_teidin_db.reserve(tunnels.capacity());
 }
 
 void gtpu_tunnel_manager::init(const gtpu_args_t& args, pdcp_interface_gtpu* pdcp_)
@@ -57,14 +59,13 @@ void gtpu_tunnel_manager::init(const gtpu_args_t& args, pdcp_interface_gtpu* pdc
 
 const gtpu_tunnel_manager::tunnel* gtpu_tunnel_manager::find_tunnel(uint32_t teid)
 {
-  auto it = tunnels.find(teid);
-  return it != tunnels.end() ? &it->second : nullptr;
+  return tunnels.find(teid);
 }
 
 gtpu_tunnel_manager::ue_bearer_tunnel_list* gtpu_tunnel_manager::find_rnti_tunnels(uint16_t rnti)
 {
   auto it = ue_teidin_db.find(rnti);
-  return it != ue_teidin_db.end() ? &ue_teidin_db[rnti] : nullptr;
+  return it != ue_teidin_db.end() ? &it->second : nullptr;
 }
 
 srsran::span<gtpu_tunnel_manager::bearer_teid_pair>
@@ -225,8 +226,8 @@ bool gtpu_tunnel_manager::remove_rnti(uint16_t rnti)
 void gtpu_tunnel_manager::activate_tunnel(uint32_t teid)
 {
   tunnel& tun = tunnels[teid];
-  if (tun.state == tunnel_state::pdcp_active) {
-    // nothing happens
+  if (tun.state == tunnel_state::pdcp_active or tun.state == tunnel_state::congested) {
+    // nothing happens. A congested tunnel keeps forwarding its SDUs to PDCP as the congestion clears
     return;
   }
 
@@ -251,6 +252,11 @@ void gtpu_tunnel_manager::activate_tunnel(uint32_t teid)
 void gtpu_tunnel_manager::suspend_tunnel(uint32_t teid)
 {
   tunnel& tun = tunnels[teid];
+  if (tun.state == tunnel_state::congested) {
+    // The SDUs held back due to congestion stay in the buffer, ahead of the ones buffered from now on
+    tun.state = tunnel_state::buffering;
+    return;
+  }
   if (tun.state != tunnel_state::pdcp_active) {
     logger.error("Invalid TEID transition detected");
     return;
@@ -324,7 +330,8 @@ void gtpu_tunnel_manager::buffer_pdcp_sdu(uint32_t teid, uint32_t pdcp_sn, srsra
 {
   tunnel& rx_tun = tunnels[teid];
 
-  srsran_assert(rx_tun.state == tunnel_state::buffering, "Buffering of PDCP SDUs only enabled when PDCP is not active");
+  srsran_assert(rx_tun.state == tunnel_state::buffering or rx_tun.state == tunnel_state::congested,
+                "Buffering of PDCP SDUs only enabled when PDCP is not active or congested");
   if (not rx_tun.buffer->full()) {
     rx_tun.buffer->push_back(std::make_pair(pdcp_sn, std::move(sdu)));
   } else {
@@ -339,6 +346,53 @@ void gtpu_tunnel_manager::buffer_pdcp_sdu(uint32_t teid, uint32_t pdcp_sn, srsra
   }
 }
 
+void gtpu_tunnel_manager::set_tunnel_congested(uint32_t teid)
+{
+  tunnel& tun = tunnels[teid];
+  if (tun.state != tunnel_state::pdcp_active) {
+    return;
+  }
+  logger.info("Holding back the SDUs of GTPU tunnel rnti=0x%x, " TEID_IN_FMT " while PDCP is congested",
+              tun.rnti,
+              tun.teid_in);
+  tun.buffer.emplace();
+  tun.state = tunnel_state::congested;
+  if (not tun.congestion_timer.is_valid()) {
+    tun.congestion_timer = task_sched.get_unique_timer();
+    tun.congestion_timer.set(congestion_poll_period_ms, [this, teid](uint32_t tid) {
+      flush_congested_tunnel(teid);
+      if (tunnels[teid].state == tunnel_state::congested) {
+        tunnels[teid].congestion_timer.run();
+      }
+    });
+  }
+  tun.congestion_timer.run();
+}
+
+void gtpu_tunnel_manager::flush_congested_tunnel(uint32_t teid)
+{
+  tunnel& tun = tunnels[teid];
+  if (tun.state != tunnel_state::congested) {
+    return;
+  }
+
+  // Forward the SDUs held back in arrival order, for as long as PDCP accepts them
+  auto it = tun.buffer->begin();
+  for (; it != tun.buffer->end() and not pdcp->sdu_queue_is_congested(tun.rnti, tun.eps_bearer_id); ++it) {
+    uint32_t pdcp_sn = it->first;
+    pdcp->write_sdu(
+        tun.rnti, tun.eps_bearer_id, std::move(it->second), pdcp_sn == undefined_pdcp_sn ? -1 : pdcp_sn);
+  }
+  tun.buffer->erase(tun.buffer->begin(), it);
+
+  if (not tun.buffer->empty()) {
+    return;
+  }
+  logger.info("GTPU tunnel rnti=0x%x, " TEID_IN_FMT " is no longer congested", tun.rnti, tun.teid_in);
+  tun.buffer.reset();
+  tun.state = tunnel_state::pdcp_active;
+}
+
 void gtpu_tunnel_manager::setup_forwarding(uint32_t rx_teid, uint32_t tx_teid)
 {
   tunnel& rx_tun = tunnels[rx_teid];
@@ -430,7 +484,7 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
   auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
     handle_gtpu_s1u_rx_packet(std::move(pdu), from);
   };
-  rx_socket_handler->add_socket_handler(fd, srsran::make_sdu_handler(logger, gtpu_queue, rx_callback));
+  rx_socket_handler->add_socket_handler(fd, srsran::make_batched_sdu_handler(logger, gtpu_queue, rx_callback));
 
   // Start MCH socket if enabled
   if (args.embms_enable) {
@@ -707,7 +761,19 @@ void gtpu::handle_msg_data_pdu(const gtpu_header_t&         header,
       tunnels.buffer_pdcp_sdu(rx_tunnel.teid_in, pdcp_sn, std::move(pdu));
       break;
     }
+    case gtpu_tunnel_manager::tunnel_state::congested: {
+      // The new SDU goes after the ones held back. Under load, new SDUs are the fastest trigger to flush them
+      tunnels.buffer_pdcp_sdu(rx_tunnel.teid_in, pdcp_sn, std::move(pdu));
+      tunnels.flush_congested_tunnel(rx_tunnel.teid_in);
+      break;
+    }
     case gtpu_tunnel_manager::tunnel_state::pdcp_active: {
+      if (pdcp->sdu_queue_is_congested(rnti, eps_bearer_id)) {
+        // Hold the SDUs back until the RLC Tx queue drains, instead of letting PDCP drop them
+        tunnels.set_tunnel_congested(rx_tunnel.teid_in);
+        tunnels.buffer_pdcp_sdu(rx_tunnel.teid_in, pdcp_sn, std::move(pdu));
+        break;
+      }
       pdcp->write_sdu(rnti, eps_bearer_id, std::move(pdu), pdcp_sn == undefined_pdcp_sn ? -1 : (int)pdcp_sn);
       break;
     }
@@ -879,6 +945,9 @@ void gtpu::log_message(const gtpu_tunnel& tun, bool is_rx, srsran::span<uint8_t>
       case gtpu_tunnel_manager::tunnel_state::buffering:
         fmt::format_to(strbuf2, "DL (buffered), ");
         break;
+      case gtpu_tunnel_manager::tunnel_state::congested:
+        fmt::format_to(strbuf2, "DL (held back), ");
+        break;
       case gtpu_tunnel_manager::tunnel_state::forward_to: {
         addrbuf.clear();
         srsran::gtpu_ntoa(addrbuf, htonl(tun.fwd_tunnel->spgw_addr));
@@ -21,35 +21,119 @@
 
 #include "srsenb/hdr/stack/upper/pdcp.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/common/rwlock_guard.h"
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interface_pdcp.h"
+#include <algorithm>
+#include <future>
 
 namespace srsenb {
 
 pdcp::pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger_) :
   task_sched(task_sched_), logger(logger_)
-{}
+{
+  pthread_rwlock_init(&rwlock, nullptr);
+}
+
+pdcp::~pdcp()
+{
+  // The RLC, stopped after the PDCP, may still notify failures after stop()
+  pthread_rwlock_destroy(&rwlock);
+}
+
+pdcp::ue_shard::ue_shard(uint32_t idx) : worker("PDCP_UP" + std::to_string(idx), 4096) {}
 
-void pdcp::init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_)
+void pdcp::init(rlc_interface_pdcp*  rlc_,
+                rrc_interface_pdcp*  rrc_,
+                gtpu_interface_pdcp* gtpu_,
+                uint32_t             nof_workers)
 {
   rlc  = rlc_;
   rrc  = rrc_;
   gtpu = gtpu_;
+
+  for (uint32_t i = 0; i < nof_workers; ++i) {
+    shards.emplace_back(new ue_shard(i));
+  }
+  if (nof_workers > 0) {
+    logger.info("Processing the DRB SDUs in %d worker threads", nof_workers);
+  }
 }
 
 void pdcp::stop()
 {
+  // The workers may still be calling the RLC, so they have to finish before the RLC is stopped
+  for (auto& shard : shards) {
+    shard->worker.stop();
+  }
+
+  pthread_rwlock_wrlock(&rwlock);
   for (std::map<uint32_t, user_interface>::iterator iter = users.begin(); iter != users.end(); ++iter) {
     clear_user(&iter->second);
   }
   users.clear();
+  pthread_rwlock_unlock(&rwlock);
+
+  shards.clear();
+}
+
+void pdcp::tic()
+{
+  for (auto& shard : shards) {
+    ue_shard* s = shard.get();
+    s->worker.push_task([this, s]() {
+      srsran::rwlock_read_guard    lock(rwlock);
+      std::lock_guard<std::mutex> shard_lock(s->mutex);
+      s->task_sched.tic();
+    });
+  }
+}
+
+pdcp::ue_shard* pdcp::get_shard(uint16_t rnti)
+{
+  return shards.empty() ? nullptr : shards[rnti % shards.size()].get();
+}
+
+std::unique_lock<std::mutex> pdcp::lock_shard(uint16_t rnti)
+{
+  ue_shard* shard = get_shard(rnti);
+  return shard == nullptr ? std::unique_lock<std::mutex>() : std::unique_lock<std::mutex>(shard->mutex);
+}
+
+/// Runs a task on the PDCP entity of a UE, after all the DRB SDUs of the UE already queued to its worker. The caller
+/// waits for the task, which sees the COUNTs and buffered PDUs of every SDU received so far
+void pdcp::run_in_ue_worker(uint16_t rnti, const std::function<void()>& task)
+{
+  ue_shard* shard = get_shard(rnti);
+  if (shard == nullptr) {
+    srsran::rwlock_read_guard lock(rwlock);
+    task();
+    return;
+  }
+
+  // If the worker is stopped before running the task, the promise is destroyed and the wait returns
+  std::unique_ptr<std::promise<void> > done(new std::promise<void>());
+  std::future<void>                    done_future = done->get_future();
+  shard->worker.push_task([this, shard, &task, done = std::move(done)]() {
+    srsran::rwlock_read_guard   lock(rwlock);
+    std::lock_guard<std::mutex> shard_lock(shard->mutex);
+    task();
+    done->set_value();
+  });
+  done_future.wait();
 }
 
 void pdcp::add_user(uint16_t rnti)
 {
+  srsran::rwlock_write_guard lock(rwlock);
+  auto                       shard_lock = lock_shard(rnti);
   if (users.count(rnti) == 0) {
-    unique_rnti_ptr<srsran::pdcp> obj = make_rnti_obj<srsran::pdcp>(rnti, task_sched, logger.id().c_str());
+    // The timers of the UE are stepped by the worker that processes its SDUs
+    ue_shard*                 shard = get_shard(rnti);
+    srsran::task_sched_handle ue_task_sched =
+        shard == nullptr ? task_sched : srsran::task_sched_handle(&shard->task_sched);
+    unique_rnti_ptr<srsran::pdcp> obj = make_rnti_obj<srsran::pdcp>(rnti, ue_task_sched, logger.id().c_str());
     obj->init(&users[rnti].rlc_itf, &users[rnti].rrc_itf, &users[rnti].gtpu_itf);
     users[rnti].rlc_itf.rnti  = rnti;
     users[rnti].gtpu_itf.rnti = rnti;
@@ -71,14 +155,28 @@ void pdcp::clear_user(user_interface* ue)
 
 void pdcp::rem_user(uint16_t rnti)
 {
+  srsran::rwlock_write_guard lock(rwlock);
+  auto                       shard_lock = lock_shard(rnti);
   if (users.count(rnti)) {
     clear_user(&users[rnti]);
     users.erase(rnti);
   }
+
+  // The DRB SDUs not drained yet would otherwise be written into the next UE with the same RNTI
+  ue_shard* shard = get_shard(rnti);
+  if (shard != nullptr) {
+    std::lock_guard<std::mutex>         sdu_lock(shard->sdu_mutex);
+    std::vector<ue_shard::pending_sdu>& sdus = shard->pending_sdus;
+    sdus.erase(std::remove_if(
+                   sdus.begin(), sdus.end(), [rnti](const ue_shard::pending_sdu& sdu) { return sdu.rnti == rnti; }),
+               sdus.end());
+  }
 }
 
 void pdcp::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cfg)
 {
+  srsran::rwlock_read_guard lock(rwlock);
+  auto                      shard_lock = lock_shard(rnti);
   if (users.count(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       users[rnti].pdcp->add_bearer(lcid, cfg);
@@ -90,13 +188,30 @@ void pdcp::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t&
 
 void pdcp::del_bearer(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
-    users[rnti].pdcp->del_bearer(lcid);
-  }
+  run_in_ue_worker(rnti, [this, rnti, lcid]() {
+    if (users.count(rnti)) {
+      users[rnti].pdcp->del_bearer(lcid);
+    }
+
+    // The DRB SDUs not drained yet would otherwise be written into the next bearer with the same LCID
+    ue_shard* shard = get_shard(rnti);
+    if (shard != nullptr) {
+      std::lock_guard<std::mutex>         sdu_lock(shard->sdu_mutex);
+      std::vector<ue_shard::pending_sdu>& sdus = shard->pending_sdus;
+      sdus.erase(std::remove_if(sdus.begin(),
+                                sdus.end(),
+                                [rnti, lcid](const ue_shard::pending_sdu& sdu) {
+                                  return sdu.rnti == rnti and sdu.lcid == lcid;
+                                }),
+                 sdus.end());
+    }
+  });
 }
 
 void pdcp::set_enabled(uint16_t rnti, uint32_t lcid, bool enabled)
 {
+  srsran::rwlock_read_guard lock(rwlock);
+  auto                      shard_lock = lock_shard(rnti);
   if (users.count(rnti)) {
     users[rnti].pdcp->set_enabled(lcid, enabled);
   }
@@ -104,13 +219,17 @@ void pdcp::set_enabled(uint16_t rnti, uint32_t lcid, bool enabled)
 
 void pdcp::reset(uint16_t rnti)
 {
-  if (users.count(rnti)) {
-    users[rnti].pdcp->reset();
-  }
+  run_in_ue_worker(rnti, [this, rnti]() {
+    if (users.count(rnti)) {
+      users[rnti].pdcp->reset();
+    }
+  });
 }
 
 void pdcp::config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& sec_cfg)
 {
+  srsran::rwlock_read_guard lock(rwlock);
+  auto                      shard_lock = lock_shard(rnti);
   if (users.count(rnti)) {
     users[rnti].pdcp->config_security(lcid, sec_cfg);
   }
@@ -118,40 +237,57 @@ void pdcp::config_security(uint16_t rnti, uint32_t lcid, const srsran::as_securi
 
 void pdcp::enable_integrity(uint16_t rnti, uint32_t lcid)
 {
-  users[rnti].pdcp->enable_integrity(lcid, srsran::DIRECTION_TXRX);
+  srsran::rwlock_read_guard lock(rwlock);
+  auto                      shard_lock = lock_shard(rnti);
+  if (users.count(rnti)) {
+    users[rnti].pdcp->enable_integrity(lcid, srsran::DIRECTION_TXRX);
+  }
 }
 
 void pdcp::enable_encryption(uint16_t rnti, uint32_t lcid)
 {
-  users[rnti].pdcp->enable_encryption(lcid, srsran::DIRECTION_TXRX);
+  srsran::rwlock_read_guard lock(rwlock);
+  auto                      shard_lock = lock_shard(rnti);
+  if (users.count(rnti)) {
+    users[rnti].pdcp->enable_encryption(lcid, srsran::DIRECTION_TXRX);
+  }
 }
 
 bool pdcp::get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state_t* state)
 {
-  if (users.count(rnti) == 0) {
-    return false;
-  }
-  return users[rnti].pdcp->get_bearer_state(lcid, state);
+  bool ret = false;
+  run_in_ue_worker(rnti, [this, rnti, lcid, state, &ret]() {
+    if (users.count(rnti)) {
+      ret = users[rnti].pdcp->get_bearer_state(lcid, state);
+    }
+  });
+  return ret;
 }
 
 bool pdcp::set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte_state_t& state)
 {
-  if (users.count(rnti) == 0) {
-    return false;
-  }
-  return users[rnti].pdcp->set_bearer_state(lcid, state);
+  bool ret = false;
+  run_in_ue_worker(rnti, [this, rnti, lcid, &state, &ret]() {
+    if (users.count(rnti)) {
+      ret = users[rnti].pdcp->set_bearer_state(lcid, state);
+    }
+  });
+  return ret;
 }
 
 void pdcp::reestablish(uint16_t rnti)
 {
-  if (users.count(rnti) == 0) {
-    return;
-  }
-  users[rnti].pdcp->reestablish();
+  run_in_ue_worker(rnti, [this, rnti]() {
+    if (users.count(rnti)) {
+      users[rnti].pdcp->reestablish();
+    }
+  });
 }
 
 void pdcp::send_status_report(uint16_t rnti)
 {
+  srsran::rwlock_read_guard lock(rwlock);
+  auto                      shard_lock = lock_shard(rnti);
   if (users.count(rnti) == 0) {
     return;
   }
@@ -160,6 +296,8 @@ void pdcp::send_status_report(uint16_t rnti)
 
 void pdcp::notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
+  srsran::rwlock_read_guard lock(rwlock);
+  auto                      shard_lock = lock_shard(rnti);
   if (users.count(rnti)) {
     users[rnti].pdcp->notify_delivery(lcid, pdcp_sns);
   }
@@ -167,12 +305,86 @@ void pdcp::notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_v
 
 void pdcp::notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
+  ue_shard* shard = get_shard(rnti);
+  if (shard != nullptr) {
+    // The RLC notifies failures with its Tx mutex held, while the worker holds the shard mutex when writing SDUs
+    // into the RLC. Handing the notification to the worker avoids the lock inversion.
+    std::unique_ptr<srsran::pdcp_sn_vector_t> sns(new srsran::pdcp_sn_vector_t(pdcp_sns));
+    shard->worker.push_task([this, rnti, lcid, sns = std::move(sns)]() {
+      srsran::rwlock_read_guard   lock(rwlock);
+      std::lock_guard<std::mutex> shard_lock(get_shard(rnti)->mutex);
+      if (users.count(rnti)) {
+        users[rnti].pdcp->notify_failure(lcid, *sns);
+      }
+    });
+    return;
+  }
+
+  srsran::rwlock_read_guard lock(rwlock);
   if (users.count(rnti)) {
     users[rnti].pdcp->notify_failure(lcid, pdcp_sns);
   }
 }
 
 void pdcp::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn)
+{
+  ue_shard* shard = get_shard(rnti);
+  if (shard != nullptr and rnti != SRSRAN_MRNTI and srsran::is_lte_drb(lcid)) {
+    // DRB SDUs are ciphered and written into the RLC by the worker of the UE, in arrival order. The worker is only
+    // woken up by the first SDU since its last drain, the SDUs received meanwhile join the same drain
+    bool wake_worker;
+    {
+      std::lock_guard<std::mutex> lock(shard->sdu_mutex);
+      wake_worker = shard->pending_sdus.empty();
+      shard->pending_sdus.push_back({rnti, lcid, pdcp_sn, std::move(sdu)});
+    }
+    if (wake_worker) {
+      shard->worker.push_task([this, shard]() { write_pending_sdus(shard); });
+    }
+    return;
+  }
+
+  srsran::rwlock_read_guard lock(rwlock);
+  auto                      shard_lock = lock_shard(rnti);
+  write_sdu_unlocked(rnti, lcid, std::move(sdu), pdcp_sn);
+}
+
+void pdcp::write_pending_sdus(ue_shard* shard)
+{
+  // The SDUs are taken under the shard mutex, so that a removed UE or bearer can drop its pending SDUs before the
+  // worker sees them
+  srsran::rwlock_read_guard           lock(rwlock);
+  std::lock_guard<std::mutex>         shard_lock(shard->mutex);
+  std::vector<ue_shard::pending_sdu>& sdus = shard->worker_sdus;
+  {
+    std::lock_guard<std::mutex> sdu_lock(shard->sdu_mutex);
+    std::swap(sdus, shard->pending_sdus);
+  }
+
+  for (size_t i = 0; i < sdus.size();) {
+    uint16_t rnti = sdus[i].rnti;
+    uint32_t lcid = sdus[i].lcid;
+    if (sdus[i].pdcp_sn != -1) {
+      // SN forwarded by the source eNB in a handover
+      write_sdu_unlocked(rnti, lcid, std::move(sdus[i].sdu), sdus[i].pdcp_sn);
+      i++;
+      continue;
+    }
+
+    // Consecutive SDUs of the same bearer are numbered and ciphered together
+    shard->bearer_batch.clear();
+    for (; i < sdus.size() and sdus[i].rnti == rnti and sdus[i].lcid == lcid and sdus[i].pdcp_sn == -1; i++) {
+      shard->bearer_batch.push_back(std::move(sdus[i].sdu));
+    }
+    if (users.count(rnti)) {
+      users[rnti].pdcp->write_sdus(lcid, shard->bearer_batch);
+    }
+  }
+  sdus.clear();
+  shard->bearer_batch.clear();
+}
+
+void pdcp::write_sdu_unlocked(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn)
 {
   if (users.count(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
@@ -186,6 +398,8 @@ void pdcp::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t
 
 void pdcp::send_status_report(uint16_t rnti, uint32_t lcid)
 {
+  srsran::rwlock_read_guard lock(rwlock);
+  auto                      shard_lock = lock_shard(rnti);
   if (users.count(rnti)) {
     users[rnti].pdcp->send_status_report(lcid);
   }
@@ -193,14 +407,25 @@ void pdcp::send_status_report(uint16_t rnti, uint32_t lcid)
 
 std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
-    return users[rnti].pdcp->get_buffered_pdus(lcid);
-  }
-  return {};
+  std::map<uint32_t, srsran::unique_byte_buffer_t> ret;
+  run_in_ue_worker(rnti, [this, rnti, lcid, &ret]() {
+    if (users.count(rnti)) {
+      ret = users[rnti].pdcp->get_buffered_pdus(lcid);
+    }
+  });
+  return ret;
+}
+
+bool pdcp::sdu_queue_is_congested(uint16_t rnti, uint32_t lcid)
+{
+  // The Tx SDU queue of RLC keeps its own counters, so no PDCP lock is needed
+  return rlc->sdu_queue_is_congested(rnti, lcid);
 }
 
 void pdcp::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
+  srsran::rwlock_read_guard lock(rwlock);
+  auto                      shard_lock = lock_shard(rnti);
   if (users.count(rnti)) {
     users[rnti].pdcp->write_pdu(lcid, std::move(sdu));
   }
@@ -236,6 +461,11 @@ bool pdcp::user_interface_rlc::sdu_queue_is_full(uint32_t lcid)
   return rlc->sdu_queue_is_full(rnti, lcid);
 }
 
+uint32_t pdcp::user_interface_rlc::sdu_queue_free_slots(uint32_t lcid)
+{
+  return rlc->sdu_queue_free_slots(rnti, lcid);
+}
+
 void pdcp::user_interface_rrc::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
 {
   rrc->write_pdu(rnti, lcid, std::move(pdu));
@@ -268,9 +498,11 @@ const char* pdcp::user_interface_rrc::get_rb_name(uint32_t lcid)
 
 void pdcp::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti)
 {
+  srsran::rwlock_read_guard lock(rwlock);
   m.ues.resize(users.size());
   size_t count = 0;
   for (auto& user : users) {
+    auto shard_lock = lock_shard(user.first);
     user.second.pdcp->get_metrics(m.ues[count], nof_tti);
     count++;
   }
@@ -220,6 +220,19 @@ int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_b
   return ret;
 }
 
+int rlc::read_pdus(uint16_t rnti, uint32_t lcid, srsran::read_pdu_batch_interface& batch)
+{
+  int ret = SRSRAN_ERROR;
+
+  pthread_rwlock_rdlock(&rwlock);
+  auto user_it = users.find(rnti);
+  if (user_it != users.end() and rnti != SRSRAN_MRNTI) {
+    ret = user_it->second.rlc->read_pdus(lcid, batch);
+  }
+  pthread_rwlock_unlock(&rwlock);
+  return ret;
+}
+
 void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   pthread_rwlock_rdlock(&rwlock);
@@ -273,6 +286,28 @@ bool rlc::sdu_queue_is_full(uint16_t rnti, uint32_t lcid)
   return ret;
 }
 
+bool rlc::sdu_queue_is_congested(uint16_t rnti, uint32_t lcid)
+{
+  bool ret = false;
+  pthread_rwlock_rdlock(&rwlock);
+  if (users.count(rnti)) {
+    ret = users[rnti].rlc->sdu_queue_is_congested(lcid);
+  }
+  pthread_rwlock_unlock(&rwlock);
+  return ret;
+}
+
+uint32_t rlc::sdu_queue_free_slots(uint16_t rnti, uint32_t lcid)
+{
+  uint32_t ret = 0;
+  pthread_rwlock_rdlock(&rwlock);
+  if (users.count(rnti)) {
+    ret = users[rnti].rlc->sdu_queue_free_slots(lcid);
+  }
+  pthread_rwlock_unlock(&rwlock);
+  return ret;
+}
+
 void rlc::user_interface::max_retx_attempted()
 {
   rrc->max_retx_attempted(rnti);
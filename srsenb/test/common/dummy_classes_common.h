@@ -68,6 +68,7 @@ public:
   {
     return {};
   }
+  bool sdu_queue_is_congested(uint16_t rnti, uint32_t lcid) override { return false; }
 };
 
 } // namespace srsenb
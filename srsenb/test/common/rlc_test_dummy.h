@@ -29,6 +29,7 @@ namespace srsenb {
 class rlc_dummy : public rlc_interface_mac
 {
   int  read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) { return SRSRAN_SUCCESS; }
+  int  read_pdus(uint16_t rnti, uint32_t lcid, srsran::read_pdu_batch_interface& batch) { return SRSRAN_SUCCESS; }
   void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes) {}
 };
 
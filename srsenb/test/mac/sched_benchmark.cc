@@ -23,36 +23,60 @@
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsran/adt/accumulators.h"
 #include "srsran/common/common_lte.h"
+#include <atomic>
 #include <chrono>
+#include <thread>
 
 namespace srsenb {
 
 struct run_params {
   uint32_t    nof_prbs;
+  uint32_t    nof_ccs;
   uint32_t    nof_ues;
   uint32_t    nof_ttis;
   uint32_t    cqi;
   const char* sched_policy;
+  bool        feedback_thread; ///< Push buffer state updates from a separate thread, as the RLC and PHY do
+  uint32_t    max_pdcch_search_nodes;
+  uint32_t    lookahead_ttis;
+  bool        real_time; ///< Pace the TTIs at 1 msec, as the PHY does
 };
 
 struct run_params_range {
   std::vector<uint32_t>    nof_prbs{srsran::lte_cell_nof_prbs.begin(), srsran::lte_cell_nof_prbs.end()};
-  std::vector<uint32_t>    nof_ues      = {1, 2, 5, 32};
-  uint32_t                 nof_ttis     = 10000;
-  std::vector<uint32_t>    cqi          = {5, 10, 15};
-  std::vector<const char*> sched_policy = {"time_rr", "time_pf"};
-
-  size_t     nof_runs() const { return nof_prbs.size() * nof_ues.size() * cqi.size() * sched_policy.size(); }
+  std::vector<uint32_t>    nof_ccs                = {1};
+  std::vector<uint32_t>    nof_ues                = {1, 2, 5, 32};
+  uint32_t                 nof_ttis               = 10000;
+  std::vector<uint32_t>    cqi                    = {5, 10, 15};
+  std::vector<const char*> sched_policy           = {"time_rr", "time_pf"};
+  bool                     feedback_thread        = false;
+  std::vector<uint32_t>    max_pdcch_search_nodes = {sched_interface::sched_args_t{}.max_pdcch_search_nodes};
+  std::vector<uint32_t>    lookahead_ttis         = {0};
+  bool                     real_time              = false;
+
+  size_t nof_runs() const
+  {
+    return nof_prbs.size() * nof_ccs.size() * nof_ues.size() * cqi.size() * max_pdcch_search_nodes.size() *
+           lookahead_ttis.size() * sched_policy.size();
+  }
   run_params get_params(size_t idx) const
   {
-    run_params r = {};
-    r.nof_ttis   = nof_ttis;
-    r.nof_prbs   = nof_prbs[idx % nof_prbs.size()];
+    run_params r      = {};
+    r.nof_ttis        = nof_ttis;
+    r.feedback_thread = feedback_thread;
+    r.real_time       = real_time;
+    r.nof_prbs        = nof_prbs[idx % nof_prbs.size()];
     idx /= nof_prbs.size();
+    r.nof_ccs = nof_ccs[idx % nof_ccs.size()];
+    idx /= nof_ccs.size();
     r.nof_ues = nof_ues[idx % nof_ues.size()];
     idx /= nof_ues.size();
     r.cqi = cqi[idx % cqi.size()];
     idx /= cqi.size();
+    r.max_pdcch_search_nodes = max_pdcch_search_nodes[idx % max_pdcch_search_nodes.size()];
+    idx /= max_pdcch_search_nodes.size();
+    r.lookahead_ttis = lookahead_ttis[idx % lookahead_ttis.size()];
+    idx /= lookahead_ttis.size();
     r.sched_policy = sched_policy.at(idx);
     return r;
   }
@@ -95,12 +119,20 @@ public:
   };
   throughput_stats total_stats;
 
+  // When set, the TTIs are fetched at the PHY rate
+  std::chrono::steady_clock::time_point next_tti_tp = {};
+
   int advance_tti()
   {
     tti_point tti_rx = get_tti_rx().is_valid() ? get_tti_rx() + 1 : tti_point(0);
     mac_logger.set_context(tti_rx.to_uint());
     new_tti(tti_rx);
 
+    if (next_tti_tp != std::chrono::steady_clock::time_point{}) {
+      std::this_thread::sleep_until(next_tti_tp);
+      next_tti_tp += std::chrono::milliseconds(1);
+    }
+
     for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
       std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
       TESTASSERT(sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]) == SRSRAN_SUCCESS);
@@ -167,14 +199,23 @@ struct run_data {
   float                     avg_ul_mcs;
   std::chrono::microseconds avg_latency;
   std::chrono::microseconds q0_9_latency;
+  std::chrono::microseconds max_latency;
+  uint32_t                  nof_late_ttis;
 };
 
 int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results)
 {
-  std::vector<sched_interface::cell_cfg_t> cell_list(1, generate_default_cell_cfg(params.nof_prbs));
-  sched_interface::ue_cfg_t                ue_cfg_default = generate_default_ue_cfg();
-  sched_interface::sched_args_t            sched_args     = {};
-  sched_args.sched_policy                                 = params.sched_policy;
+  std::vector<sched_interface::cell_cfg_t> cell_list(params.nof_ccs, generate_default_cell_cfg(params.nof_prbs));
+  for (uint32_t cc = 0; cc < cell_list.size(); ++cc) {
+    cell_list[cc].cell.id = cc + 1;
+    // The TTIs generated ahead are no longer available for the RAR, so the RAR window has to span the look-ahead
+    cell_list[cc].prach_rar_window += params.lookahead_ttis;
+  }
+  sched_interface::ue_cfg_t     ue_cfg_default = generate_default_ue_cfg();
+  sched_interface::sched_args_t sched_args     = {};
+  sched_args.sched_policy                      = params.sched_policy;
+  sched_args.max_pdcch_search_nodes            = params.max_pdcch_search_nodes;
+  sched_args.lookahead_ttis                    = params.lookahead_ttis;
 
   sched     sched_obj;
   rrc_dummy rrc{};
@@ -186,14 +227,17 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
 
   for (uint32_t ue_idx = 0; ue_idx < params.nof_ues; ++ue_idx) {
     uint16_t rnti = 0x46 + ue_idx;
+    // Distribute the users across the carriers
+    sched_interface::ue_cfg_t ue_cfg       = ue_cfg_default;
+    ue_cfg.supported_cc_list[0].enb_cc_idx = ue_idx % params.nof_ccs;
     // Add user (first need to advance to a PRACH TTI)
     while (not srsran_prach_tti_opportunity_config_fdd(
-        tester.get_cell_params()[ue_cfg_default.supported_cc_list[0].enb_cc_idx].cfg.prach_config,
+        tester.get_cell_params()[ue_cfg.supported_cc_list[0].enb_cc_idx].cfg.prach_config,
         tester.get_tti_rx().to_uint(),
         -1)) {
       TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
     }
-    TESTASSERT(tester.add_user(rnti, ue_cfg_default, 16) == SRSRAN_SUCCESS);
+    TESTASSERT(tester.add_user(rnti, ue_cfg, 16) == SRSRAN_SUCCESS);
     TESTASSERT(tester.advance_tti() == SRSRAN_SUCCESS);
   }
 
@@ -206,12 +250,30 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
     ue_db_ctxt = tester.get_enb_ctxt().ue_db;
   }
 
+  // Start the thread that emulates the RLC and PHY updates, which compete with the TTI generation
+  std::atomic<bool> feedback_running{params.feedback_thread};
+  std::thread       feedback_thread([&sched_obj, &feedback_running, &tester, ue_db_ctxt]() {
+    while (feedback_running.load(std::memory_order_relaxed)) {
+      for (const auto& ue : ue_db_ctxt) {
+        sched_obj.dl_rlc_buffer_state(ue.first, 3, tester.dl_bytes_per_tti, 0);
+        sched_obj.ul_bsr(ue.first, 1, tester.ul_bytes_per_tti);
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  });
+
   // Run benchmark
   tester.total_stats = {};
-  tester.total_stats.latency_samples.reserve(params.nof_ttis);
+  tester.total_stats.latency_samples.reserve(params.nof_ttis * params.nof_ccs);
+  uint32_t nof_late_ttis = sched_obj.get_nof_late_results();
+  if (params.real_time) {
+    tester.next_tti_tp = std::chrono::steady_clock::now();
+  }
   for (uint32_t count = 0; count < params.nof_ttis; ++count) {
     tester.advance_tti();
   }
+  feedback_running = false;
+  feedback_thread.join();
   std::sort(tester.total_stats.latency_samples.begin(), tester.total_stats.latency_samples.end());
 
   run_data run_result          = {};
@@ -223,6 +285,8 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
   run_result.avg_latency  = std::chrono::microseconds(static_cast<int>(tester.total_stats.avg_latency.value() / 1000));
   run_result.q0_9_latency = std::chrono::microseconds(
       tester.total_stats.latency_samples[static_cast<size_t>(tester.total_stats.latency_samples.size() * 0.9)] / 1000);
+  run_result.max_latency = std::chrono::microseconds(tester.total_stats.latency_samples.back() / 1000);
+  run_result.nof_late_ttis = sched_obj.get_nof_late_results() - nof_late_ttis;
   run_results.push_back(run_result);
 
   return SRSRAN_SUCCESS;
@@ -264,10 +328,10 @@ run_data expected_run_result(run_params params)
 void print_benchmark_results(const std::vector<run_data>& run_results)
 {
   srslog::flush();
-  fmt::print("run | Nprb | cqi | sched pol | Nue | DL/UL [Mbps] | DL/UL mcs | DL/UL OH [%] | latency | latency q0.9 "
-             "[usec]\n");
+  fmt::print("run | Nprb | Ncc | cqi | sched pol | Nue | DL/UL [Mbps] | DL/UL mcs | DL/UL OH [%] | latency | latency "
+             "q0.9 | latency max [usec]\n");
   fmt::print("------------------------------------------------------------------------------------------------------"
-             "------\n");
+             "---------------------------\n");
   for (uint32_t i = 0; i < run_results.size(); ++i) {
     const run_data& r = run_results[i];
 
@@ -279,9 +343,10 @@ void print_benchmark_results(const std::vector<run_data>& run_results)
     tbs                     = srsran_ra_tbs_from_idx(tbs_idx, nof_pusch_prbs);
     float ul_rate_overhead  = 1.0F - r.avg_ul_throughput / (static_cast<float>(tbs) * 1e3F);
 
-    fmt::print("{:>3d}{:>6d}{:>6d}{:>12}{:>6d}{:>9.2}/{:>4.2}{:>9.1f}/{:>4.1f}{:9.1f}/{:>4.1f}{:>9d}{:12d}\n",
+    fmt::print("{:>3d}{:>6d}{:>6d}{:>6d}{:>12}{:>6d}{:>9.2}/{:>4.2}{:>9.1f}/{:>4.1f}{:9.1f}/{:>4.1f}{:>9d}{:12d}{:>15d}\n",
                i,
                r.params.nof_prbs,
+               r.params.nof_ccs,
                r.params.cqi,
                r.params.sched_policy,
                r.params.nof_ues,
@@ -292,7 +357,8 @@ void print_benchmark_results(const std::vector<run_data>& run_results)
                dl_rate_overhead * 100,
                ul_rate_overhead * 100,
                r.avg_latency.count(),
-               r.q0_9_latency.count());
+               r.q0_9_latency.count(),
+               r.max_latency.count());
   }
 }
 
@@ -368,6 +434,101 @@ int run_all()
   return SRSRAN_SUCCESS;
 }
 
+/// Measures how the TTI generation latency scales with the number of carriers while the buffer state updates arrive
+/// from another thread. The reported latency is per carrier.
+int run_multicarrier_benchmark(uint32_t nof_ttis)
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis        = nof_ttis;
+  run_param_list.nof_prbs        = {100};
+  run_param_list.nof_ccs         = {1, 2, 4};
+  run_param_list.cqi             = {15};
+  run_param_list.nof_ues         = {16};
+  run_param_list.sched_policy    = {"time_pf"};
+  run_param_list.feedback_thread = true;
+
+  std::vector<run_data> run_results;
+  size_t                nof_runs = run_param_list.nof_runs();
+  fmt::print("Running multi-carrier benchmark\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    run_params runparams = run_param_list.get_params(r);
+
+    mac_logger.info("\n### New run {} ###\n", r);
+    TESTASSERT(run_benchmark_scenario(runparams, run_results) == SRSRAN_SUCCESS);
+  }
+
+  print_benchmark_results(run_results);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Compares the TTI generation latency with and without a bound on the PDCCH DCI placement search, for small
+/// bandwidths, where the PDCCH becomes the scheduling bottleneck
+int run_pdcch_benchmark(uint32_t nof_ttis)
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis               = nof_ttis;
+  run_param_list.nof_prbs               = {6, 15, 25};
+  run_param_list.cqi                    = {5};
+  run_param_list.nof_ues                = {8};
+  run_param_list.sched_policy           = {"time_pf"};
+  run_param_list.max_pdcch_search_nodes = {0, 1024};
+
+  std::vector<run_data> run_results;
+  size_t                nof_runs = run_param_list.nof_runs();
+  fmt::print("Running PDCCH allocation benchmark\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    run_params runparams = run_param_list.get_params(r);
+
+    mac_logger.info("\n### New run {} ###\n", r);
+    TESTASSERT(run_benchmark_scenario(runparams, run_results) == SRSRAN_SUCCESS);
+  }
+
+  print_benchmark_results(run_results);
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Compares the latency of the scheduler calls made by the PHY, when the TTIs are generated synchronously and when
+/// they are generated ahead by the look-ahead worker. The TTIs are fetched at the PHY rate.
+int run_lookahead_benchmark(uint32_t nof_ttis)
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis       = nof_ttis;
+  run_param_list.nof_prbs       = {100};
+  run_param_list.cqi            = {15};
+  run_param_list.nof_ues        = {16};
+  run_param_list.sched_policy   = {"time_pf"};
+  run_param_list.lookahead_ttis = {0, 2};
+  run_param_list.real_time      = true;
+
+  std::vector<run_data> run_results;
+  size_t                nof_runs = run_param_list.nof_runs();
+  fmt::print("Running scheduler look-ahead benchmark\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    run_params runparams = run_param_list.get_params(r);
+
+    mac_logger.info("\n### New run {} ###\n", r);
+    TESTASSERT(run_benchmark_scenario(runparams, run_results) == SRSRAN_SUCCESS);
+  }
+
+  print_benchmark_results(run_results);
+  for (const run_data& r : run_results) {
+    fmt::print("look-ahead={} TTIs: {}/{} TTIs were not ready when fetched\n",
+               r.params.lookahead_ttis,
+               r.nof_late_ttis,
+               r.params.nof_ttis);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int run_benchmark()
 {
   run_params_range      run_param_list{};
@@ -424,6 +585,15 @@ int main(int argc, char* argv[])
     TESTASSERT(srsenb::run_rate_test() == SRSRAN_SUCCESS);
   } else if (strcmp(argv[1], "benchmark") == 0) {
     TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "multicarrier") == 0) {
+    uint32_t nof_ttis = argc > 2 ? strtol(argv[2], nullptr, 10) : 100000;
+    TESTASSERT(srsenb::run_multicarrier_benchmark(nof_ttis) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "pdcch") == 0) {
+    uint32_t nof_ttis = argc > 2 ? strtol(argv[2], nullptr, 10) : 100000;
+    TESTASSERT(srsenb::run_pdcch_benchmark(nof_ttis) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "lookahead") == 0) {
+    uint32_t nof_ttis = argc > 2 ? strtol(argv[2], nullptr, 10) : 10000;
+    TESTASSERT(srsenb::run_lookahead_benchmark(nof_ttis) == SRSRAN_SUCCESS);
   } else {
     TESTASSERT(srsenb::run_all() == SRSRAN_SUCCESS);
   }
@@ -251,6 +251,132 @@ int test_6prbs()
   return SRSRAN_SUCCESS;
 }
 
+int test_pdcch_search_bound()
+{
+  const uint32_t nof_prb = 15, nof_ues = 16, aggr_idx = 0;
+
+  for (uint32_t max_nodes : {0U, 8U}) {
+    std::vector<sched_cell_params_t> cell_params(1);
+    sched_interface::ue_cfg_t        ue_cfg   = generate_default_ue_cfg();
+    sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(nof_prb);
+    sched_interface::sched_args_t    sched_args{};
+    sched_args.max_pdcch_search_nodes = max_nodes;
+    TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+    std::vector<std::unique_ptr<sched_ue> > ues;
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      ues.emplace_back(new sched_ue{static_cast<uint16_t>(0x46 + i), cell_params, ue_cfg});
+    }
+
+    sf_cch_allocator pdcch;
+    pdcch.init(cell_params[PCell_IDX]);
+    for (uint32_t tti = 0; tti < 10; ++tti) {
+      pdcch.new_tti(tti_point{tti});
+
+      // TEST: The PDCCH search never exceeds the configured number of DFS nodes
+      for (auto& u : ues) {
+        bool success = pdcch.alloc_dci(alloc_type_t::DL_DATA, aggr_idx, u.get(), true);
+        TESTASSERT(max_nodes == 0 or pdcch.last_search_nof_nodes() <= max_nodes);
+
+        // TEST: An exhaustive search that failed is not repeated in the same TTI
+        if (not success and max_nodes == 0) {
+          TESTASSERT(not pdcch.alloc_dci(alloc_type_t::DL_DATA, aggr_idx, u.get(), true));
+          TESTASSERT(pdcch.last_search_nof_nodes() == 0);
+        }
+      }
+      TESTASSERT(pdcch.nof_allocs() > 0 and pdcch.nof_allocs() < nof_ues);
+
+      // TEST: The allocated DCIs do not collide
+      sf_cch_allocator::alloc_result_t dci_result;
+      pdcch_mask_t                     total_mask;
+      pdcch.get_allocs(&dci_result, &total_mask);
+      TESTASSERT(total_mask.count() == dci_result.size() * (1U << aggr_idx));
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_mu_mimo_pairing()
+{
+  const uint32_t nof_prb = 100;
+
+  for (bool mu_mimo_enabled : {false, true}) {
+    std::vector<sched_cell_params_t> cell_params(1);
+    sched_interface::ue_cfg_t        ue_cfg   = generate_default_ue_cfg();
+    sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(nof_prb);
+    sched_interface::sched_args_t    sched_args{};
+    cell_cfg.cell.nof_ports               = 2;
+    ue_cfg.dl_ant_info.tx_mode            = sched_interface::ant_info_ded_t::tx_mode_t::tm4;
+    ue_cfg.supported_cc_list[0].dl_cfg.tm = SRSRAN_TM4;
+    sched_args.mu_mimo_enabled            = mu_mimo_enabled;
+    TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+    // UEs reporting rank 1 and PMIs 0, 1, 0 and 2
+    tti_point                               tti_rx{0};
+    std::array<uint32_t, 4>                 pmis = {0, 1, 0, 2};
+    std::vector<std::unique_ptr<sched_ue> > ues;
+    for (uint32_t i = 0; i < pmis.size(); ++i) {
+      ues.emplace_back(new sched_ue{static_cast<uint16_t>(0x46 + i), cell_params, ue_cfg});
+      ues.back()->phy_config_enabled(tti_rx, true);
+      ues.back()->set_dl_cqi(tti_rx, 0, 15);
+      ues.back()->set_dl_ri(tti_rx, 0, 0);
+      ues.back()->set_dl_pmi(tti_rx, 0, pmis[i]);
+    }
+
+    sf_grid_t grid;
+    grid.init(cell_params[0]);
+    grid.new_tti(tti_rx);
+
+    rbgmask_t mask0(cell_params[0].nof_rbgs), mask1(cell_params[0].nof_rbgs);
+    mask0.fill(0, 4);
+    mask1.fill(2, 6);
+    TESTASSERT(grid.alloc_dl_data(ues[0].get(), mask0, true, true) == alloc_result::success);
+
+    // TEST: UEs with the same or a non-orthogonal PMI cannot reuse the allocated RBGs
+    TESTASSERT(grid.alloc_dl_data(ues[2].get(), mask0, true, true) == alloc_result::sch_collision);
+    TESTASSERT(grid.alloc_dl_data(ues[3].get(), mask0, true, true) == alloc_result::sch_collision);
+    TESTASSERT(grid.get_dl_mask(ues[3].get()) == grid.get_dl_mask());
+
+    if (not mu_mimo_enabled) {
+      // TEST: Without MU-MIMO, RBGs are never shared
+      TESTASSERT(grid.get_dl_mask(ues[1].get()) == grid.get_dl_mask());
+      TESTASSERT(grid.alloc_dl_data(ues[1].get(), mask1, true, true) == alloc_result::sch_collision);
+      continue;
+    }
+
+    // TEST: Retransmissions are not paired
+    TESTASSERT(grid.alloc_dl_data(ues[1].get(), mask1, true, false) == alloc_result::sch_collision);
+
+    // TEST: The UE with the orthogonal PMI is paired on the overlapping RBGs
+    TESTASSERT(grid.get_dl_mask(ues[1].get()).none());
+    TESTASSERT(grid.alloc_dl_data(ues[1].get(), mask1, true, true) == alloc_result::success);
+    TESTASSERT(grid.get_dl_mask().count() == 6);
+    TESTASSERT(grid.get_dl_paired_mask().count() == 2);
+    TESTASSERT(grid.get_dl_paired_mask().test(2) and grid.get_dl_paired_mask().test(3));
+
+    // TEST: The MCS of a paired PDSCH accounts for its halved power
+    const sched_ue_cell& ue_cc  = *ues[1]->find_ue_carrier(0);
+    uint32_t             nof_re = cell_params[0].get_dl_lb_nof_re(tti_rx + TX_ENB_DELAY, count_prb_per_tb(mask1));
+    tbs_info             tb     = cqi_to_tbs_dl(ue_cc, mask1, nof_re, SRSRAN_DCI_FORMAT2);
+    tbs_info             tb_mu  = cqi_to_tbs_dl(
+        ue_cc, mask1, nof_re, SRSRAN_DCI_FORMAT2, std::numeric_limits<uint32_t>::max(), mu_mimo_dl_cqi_offset);
+    TESTASSERT(tb_mu.mcs < tb.mcs and tb_mu.tbs_bytes < tb.tbs_bytes);
+
+    // TEST: Paired RBGs are not shared with a third UE
+    rbgmask_t mask2(cell_params[0].nof_rbgs);
+    mask2.fill(2, 3);
+    TESTASSERT(grid.alloc_dl_data(ues[2].get(), mask2, true, true) == alloc_result::sch_collision);
+    TESTASSERT(grid.get_dl_mask(ues[2].get()).count() == 4);
+
+    // TEST: The pairing state is cleared every TTI
+    grid.new_tti(tti_rx + 1);
+    TESTASSERT(grid.get_dl_paired_mask().none() and grid.get_dl_mask(ues[1].get()).none());
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -265,6 +391,8 @@ int main()
   TESTASSERT(test_pdcch_one_ue() == SRSRAN_SUCCESS);
   TESTASSERT(test_pdcch_ue_and_sibs() == SRSRAN_SUCCESS);
   TESTASSERT(test_6prbs() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcch_search_bound() == SRSRAN_SUCCESS);
+  TESTASSERT(test_mu_mimo_pairing() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
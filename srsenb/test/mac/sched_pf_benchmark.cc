@@ -0,0 +1,246 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/indexed_heap.h"
+#include "srsran/common/test_common.h"
+#include "srsran/mac/pf_metric.h"
+#include "srsran/srsran.h"
+#include <chrono>
+#include <cmath>
+#include <queue>
+#include <random>
+
+/**
+ * Compares the cost of sorting the UEs by PF priority when the priorities are recomputed and the priority queue is
+ * rebuilt every TTI, as sched_time_pf used to do, against the incrementally maintained heap used by sched_time_pf.
+ * The PF metric part (CQI to rate, average rate, heap) is isolated from the rest of the scheduler, which limits the
+ * number of UEs to SRSENB_MAX_UES.
+ */
+
+namespace srsenb {
+
+const uint32_t nof_allocs_per_tti = 4;  ///< UEs that get a grant in each TTI
+const uint32_t cqi_period         = 40; ///< Each UE reports its CQI every cqi_period TTIs
+const float    fairness_coeff     = 1;
+const uint32_t nof_re             = 12 * 11 * 100;
+
+float rate_from_cqi(uint32_t cqi)
+{
+  return srsran_cqi_to_coderate(std::min(cqi + 1u, 15u), false) * nof_re / 8;
+}
+
+struct sim_ue {
+  uint32_t cqi        = 1;
+  uint64_t nof_allocs = 0;
+};
+
+/// Previous implementation: the rate and PF metric of all the UEs is computed every TTI and the queue rebuilt
+class full_rebuild_pf
+{
+public:
+  explicit full_rebuild_pf(uint32_t nof_ues) : avg_rate(nof_ues, 0), nof_samples(nof_ues, 0) {}
+
+  void run_tti(std::vector<sim_ue>& ues)
+  {
+    using prio_t = std::pair<float, uint32_t>;
+    std::priority_queue<prio_t> queue;
+    for (uint32_t i = 0; i < ues.size(); ++i) {
+      float r = rate_from_cqi(ues[i].cqi);
+      float R = nof_samples[i] == 0 ? 0 : avg_rate[i];
+      queue.emplace((R != 0) ? r / std::pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max()), i);
+    }
+    uint32_t count = 0;
+    while (not queue.empty()) {
+      uint32_t i     = queue.top().second;
+      uint32_t bytes = 0;
+      if (count++ < nof_allocs_per_tti) {
+        bytes = rate_from_cqi(ues[i].cqi);
+        ues[i].nof_allocs++;
+      }
+      save_alloc(i, bytes);
+      queue.pop();
+    }
+  }
+
+private:
+  void save_alloc(uint32_t i, uint32_t bytes)
+  {
+    const float alpha = 0.01;
+    if (nof_samples[i] < 1 / alpha) {
+      avg_rate[i] = avg_rate[i] + (bytes - avg_rate[i]) / (nof_samples[i] + 1);
+    } else {
+      avg_rate[i] = (1 - alpha) * avg_rate[i] + alpha * bytes;
+    }
+    nof_samples[i]++;
+  }
+
+  std::vector<float>    avg_rate;
+  std::vector<uint32_t> nof_samples;
+};
+
+/// sched_time_pf implementation: keys only change on CQI reports and allocations
+class incremental_pf
+{
+public:
+  explicit incremental_pf(uint32_t nof_ues) : cqis(nof_ues, -1), heap(nof_ues) { metrics.reserve(nof_ues); }
+
+  void run_tti(std::vector<sim_ue>& ues, uint64_t now)
+  {
+    for (uint32_t i = 0; i < ues.size(); ++i) {
+      if (i >= metrics.size()) {
+        metrics.emplace_back(fairness_coeff, now);
+      }
+      srsran::pf_metric& m = metrics[i];
+      if (cqis[i] != (int)ues[i].cqi) {
+        cqis[i] = ues[i].cqi;
+        m.set_expected_rate(rate_from_cqi(ues[i].cqi), now);
+        heap.set(i, m.key());
+      } else if (m.needs_refresh(now)) {
+        m.refresh_key(now);
+        heap.set(i, m.key());
+      }
+    }
+
+    allocs.clear();
+    double last_key = std::numeric_limits<double>::infinity();
+    heap.visit_in_order([this, &last_key](uint32_t i) {
+      // The heap must be visited by decreasing key
+      TESTASSERT(heap.key(i) <= last_key);
+      last_key = heap.key(i);
+      allocs.push_back(i);
+      return allocs.size() < nof_allocs_per_tti;
+    });
+    for (uint32_t i : allocs) {
+      metrics[i].save_alloc(rate_from_cqi(ues[i].cqi), now);
+      heap.set(i, metrics[i].key());
+      ues[i].nof_allocs++;
+    }
+  }
+
+private:
+  std::vector<srsran::pf_metric> metrics;
+  std::vector<int>               cqis; ///< CQI used to derive the expected rate of each UE
+  srsran::indexed_heap<double>   heap;
+  std::vector<uint32_t>          allocs;
+};
+
+/// Updates the CQI of the UEs that report in this TTI
+void update_cqis(std::vector<sim_ue>& ues, uint64_t tti, std::mt19937& rgen)
+{
+  std::uniform_int_distribution<uint32_t> cqi_dist{1, 15};
+  for (uint32_t i = tti % cqi_period; i < ues.size(); i += cqi_period) {
+    ues[i].cqi = cqi_dist(rgen);
+  }
+}
+
+/// Jain's fairness index of the number of allocations of each UE
+double jain_index(const std::vector<sim_ue>& ues)
+{
+  double sum = 0, sum_sq = 0;
+  for (const sim_ue& ue : ues) {
+    sum += ue.nof_allocs;
+    sum_sq += static_cast<double>(ue.nof_allocs) * ue.nof_allocs;
+  }
+  return sum_sq == 0 ? 0 : sum * sum / (ues.size() * sum_sq);
+}
+
+template <typename Func>
+double measure_us_per_tti(uint32_t nof_ttis, Func&& run_tti)
+{
+  auto tp = std::chrono::steady_clock::now();
+  for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+    run_tti(tti);
+  }
+  auto dur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+  return dur.count() / 1000.0 / nof_ttis;
+}
+
+void run_benchmark(uint32_t nof_ues, uint32_t nof_ttis)
+{
+  std::mt19937 rgen(nof_ues);
+
+  std::vector<sim_ue> ues_full(nof_ues);
+  full_rebuild_pf     full(nof_ues);
+  double              full_us = measure_us_per_tti(nof_ttis, [&](uint32_t tti) {
+    update_cqis(ues_full, tti, rgen);
+    full.run_tti(ues_full);
+  });
+
+  rgen.seed(nof_ues);
+  std::vector<sim_ue> ues_inc(nof_ues);
+  incremental_pf      inc(nof_ues);
+  double              inc_us = measure_us_per_tti(nof_ttis, [&](uint32_t tti) {
+    update_cqis(ues_inc, tti, rgen);
+    inc.run_tti(ues_inc, tti);
+  });
+
+  // TEST: With enough TTIs, PF serves every UE
+  if (nof_ttis >= 20 * nof_ues / nof_allocs_per_tti) {
+    for (const sim_ue& ue : ues_inc) {
+      TESTASSERT(ue.nof_allocs > 0);
+    }
+    // TEST: Both implementations share the resources in the same way
+    TESTASSERT(std::abs(jain_index(ues_inc) - jain_index(ues_full)) < 0.1);
+  }
+
+  fmt::print("{:>6} UEs: full rebuild {:>8.2f} usec/TTI, incremental {:>8.2f} usec/TTI\n", nof_ues, full_us, inc_us);
+}
+
+/// The key of a UE stays finite after a long idle period, or without any allocation, and still favours it
+void test_idle_ue_key()
+{
+  srsran::pf_metric idle{fairness_coeff, 0}, active{fairness_coeff, 0}, never_served{fairness_coeff, 0};
+  idle.set_expected_rate(1000, 0);
+  active.set_expected_rate(1000, 0);
+  never_served.set_expected_rate(1000, 0);
+
+  uint64_t now = 0;
+  for (; now < 200; ++now) {
+    idle.save_alloc(1000, now);
+    active.save_alloc(1000, now);
+  }
+  // Much longer than the ~9 s after which a float average rate used to underflow to 0
+  for (; now < 60000; ++now) {
+    active.save_alloc(1000, now);
+  }
+  idle.refresh_key(now);
+  never_served.refresh_key(now);
+  TESTASSERT(std::isfinite(idle.key()));
+  TESTASSERT(std::isfinite(never_served.key()));
+  TESTASSERT(never_served.key() > idle.key());
+  TESTASSERT(idle.key() > active.key());
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srsran::test_init(argc, argv);
+
+  srsenb::test_idle_ue_key();
+
+  uint32_t nof_ttis = argc > 1 ? strtol(argv[1], nullptr, 10) : 10000;
+  for (uint32_t nof_ues : {100, 500, 1000}) {
+    srsenb::run_benchmark(nof_ues, nof_ttis);
+  }
+
+  return SRSRAN_SUCCESS;
+}
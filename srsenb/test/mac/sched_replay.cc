@@ -0,0 +1,323 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/sched_trace.h"
+#include <chrono>
+
+namespace srsenb {
+
+/// Maximum number of differences between the recorded and replayed decisions that are printed
+const uint32_t max_printed_diffs = 10;
+
+std::string describe_grant_diff(const char*                                     dir,
+                                const std::vector<sched_trace_result::grant_t>& recorded,
+                                const std::vector<sched_trace_result::grant_t>& replayed)
+{
+  if (recorded.size() != replayed.size()) {
+    return fmt::format("{} nof grants: {}!={}", dir, recorded.size(), replayed.size());
+  }
+  for (size_t i = 0; i < recorded.size(); ++i) {
+    const sched_trace_result::grant_t& a = recorded[i];
+    const sched_trace_result::grant_t& b = replayed[i];
+    if (a != b) {
+      return fmt::format("{} grant {}: rnti=0x{:x}, ncce={}, alloc=0x{:x}, tbs={} != "
+                         "rnti=0x{:x}, ncce={}, alloc=0x{:x}, tbs={}",
+                         dir,
+                         i,
+                         a.rnti,
+                         a.ncce,
+                         a.alloc,
+                         a.tbs[0] + a.tbs[1],
+                         b.rnti,
+                         b.ncce,
+                         b.alloc,
+                         b.tbs[0] + b.tbs[1]);
+    }
+  }
+  return "";
+}
+
+/// Describes the first difference between two carrier decisions, as "field: recorded!=replayed"
+std::string describe_cc_diff(const sched_trace_result::cc_result_t& recorded,
+                             const sched_trace_result::cc_result_t& replayed)
+{
+  if (recorded.cfi != replayed.cfi) {
+    return fmt::format("cfi: {}!={}", recorded.cfi, replayed.cfi);
+  }
+  if (recorded.nof_bcch != replayed.nof_bcch or recorded.nof_rar != replayed.nof_rar or
+      recorded.nof_po != replayed.nof_po) {
+    return fmt::format("nof bcch/rar/po: {}/{}/{}!={}/{}/{}",
+                       recorded.nof_bcch,
+                       recorded.nof_rar,
+                       recorded.nof_po,
+                       replayed.nof_bcch,
+                       replayed.nof_rar,
+                       replayed.nof_po);
+  }
+  std::string ret = describe_grant_diff("DL", recorded.dl_grants, replayed.dl_grants);
+  if (ret.empty()) {
+    ret = describe_grant_diff("UL", recorded.ul_grants, replayed.ul_grants);
+  }
+  if (ret.empty() and recorded.phich_nacks != replayed.phich_nacks) {
+    ret = fmt::format("nof PHICH NACKs: {}!={}", recorded.phich_nacks.size(), replayed.phich_nacks.size());
+  }
+  return ret;
+}
+
+/// Scheduler that regenerates the TTIs recorded in a trace, measuring the decision time of each TTI and comparing the
+/// decisions with the recorded ones. The TTIs are generated in the order of the trace, without look-ahead thread.
+class sched_replayer final : public sched, public sched_trace_reader::handler
+{
+public:
+  struct tti_diff {
+    tti_point   tti_rx;
+    uint32_t    enb_cc_idx;
+    std::string description;
+  };
+
+  void on_sched_args(const sched_interface::sched_args_t& args) override { init(&rrc, args); }
+  void on_phy_config_enabled(uint16_t rnti, bool enabled) override { phy_config_enabled(rnti, enabled); }
+  void on_tti_result(const sched_trace_result& recorded) override
+  {
+    std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
+    generate_tti(recorded.tti_rx);
+    std::chrono::time_point<std::chrono::steady_clock> tp2 = std::chrono::steady_clock::now();
+    latency_samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp).count());
+
+    if (not sched_results.has_sf(recorded.tti_rx)) {
+      diffs.push_back(tti_diff{recorded.tti_rx, 0, "TTI was not generated"});
+      return;
+    }
+    sched_trace_result replayed = make_sched_trace_result(*sched_results.get_sf(recorded.tti_rx));
+    if (recorded.cc_list.size() != replayed.cc_list.size()) {
+      diffs.push_back(tti_diff{
+          recorded.tti_rx,
+          0,
+          fmt::format("nof carriers: {}!={}", recorded.cc_list.size(), replayed.cc_list.size())});
+      return;
+    }
+    for (uint32_t cc = 0; cc < recorded.cc_list.size(); ++cc) {
+      if (recorded.cc_list[cc] != replayed.cc_list[cc]) {
+        diffs.push_back(tti_diff{recorded.tti_rx, cc, describe_cc_diff(recorded.cc_list[cc], replayed.cc_list[cc])});
+      }
+    }
+  }
+
+  std::vector<uint64_t> latency_samples;
+  std::vector<tti_diff> diffs;
+
+private:
+  rrc_dummy rrc;
+};
+
+struct replay_results {
+  uint32_t nof_records = 0;
+  uint32_t nof_ttis    = 0;
+  uint32_t nof_diffs   = 0;
+};
+
+/// Replays the trace in filename and prints the TTI decision time percentiles and the decision differences
+int replay_trace(const char* filename, replay_results& results)
+{
+  sched_trace_reader reader;
+  if (not reader.open(filename)) {
+    return SRSRAN_ERROR;
+  }
+
+  sched_replayer replayer;
+  results = {};
+  while (reader.read_next(replayer, replayer) != sched_trace_ev::nulltype) {
+    results.nof_records++;
+  }
+  results.nof_ttis  = replayer.latency_samples.size();
+  results.nof_diffs = replayer.diffs.size();
+
+  srslog::flush();
+  fmt::print("Replayed {} records and {} TTIs of {}\n", results.nof_records, results.nof_ttis, filename);
+  if (results.nof_ttis == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  std::vector<uint64_t>& samples = replayer.latency_samples;
+  std::sort(samples.begin(), samples.end());
+  auto quantile = [&samples](double q) {
+    return samples[std::min(static_cast<size_t>(samples.size() * q), samples.size() - 1)] / 1000;
+  };
+  fmt::print("TTI decision time [usec]: q0.5={} | q0.9={} | q0.99={} | q0.999={} | max={}\n",
+             quantile(0.5),
+             quantile(0.9),
+             quantile(0.99),
+             quantile(0.999),
+             samples.back() / 1000);
+
+  fmt::print("{}/{} TTI decisions differ from the recorded ones\n", results.nof_diffs, results.nof_ttis);
+  for (uint32_t i = 0; i < std::min(results.nof_diffs, max_printed_diffs); ++i) {
+    const sched_replayer::tti_diff& d = replayer.diffs[i];
+    fmt::print("  tti={}, cc={}: {}\n", d.tti_rx.to_uint(), d.enb_cc_idx, d.description);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Random simulation, which also pushes random DL and UL buffer states for the connected UEs
+class sched_sim_trace : public sched_sim_random
+{
+public:
+  using sched_sim_random::sched_sim_random;
+
+  void set_external_tti_events(const sim_ue_ctxt_t& ue_ctxt, ue_tti_events& pending_events) override
+  {
+    sched_sim_random::set_external_tti_events(ue_ctxt, pending_events);
+    if (ue_ctxt.conres_rx) {
+      std::uniform_int_distribution<uint32_t> buffer_dist{0, 50000};
+      if (randf() < 0.2) {
+        get_sched()->dl_rlc_buffer_state(ue_ctxt.rnti, 3, buffer_dist(get_rand_gen()), 0);
+      }
+      if (randf() < 0.1) {
+        get_sched()->ul_bsr(ue_ctxt.rnti, 1, buffer_dist(get_rand_gen()));
+      }
+    }
+  }
+};
+
+/// Records the trace of a random simulation with several UEs and carriers
+int record_sim_trace(const char* filename, uint32_t nof_ttis)
+{
+  const uint32_t                           nof_ccs = 2, nof_ues = 8;
+  std::vector<sched_interface::cell_cfg_t> cell_list(nof_ccs, generate_default_cell_cfg(25));
+  for (uint32_t cc = 0; cc < cell_list.size(); ++cc) {
+    cell_list[cc].cell.id = cc + 1;
+  }
+  sched_interface::sched_args_t sched_args = {};
+  sched_args.sched_policy                  = "time_pf";
+  sched_args.trace_filename                = filename;
+
+  sched     sched_obj;
+  rrc_dummy rrc{};
+  sched_obj.init(&rrc, sched_args);
+  sched_sim_trace sim(&sched_obj, sched_args, cell_list);
+
+  std::vector<sched_interface::dl_sched_res_t> dl_result(nof_ccs);
+  std::vector<sched_interface::ul_sched_res_t> ul_result(nof_ccs);
+  uint32_t                                     nof_added_ues = 0;
+  for (uint32_t count = 0; count < nof_ttis; ++count) {
+    tti_point tti_rx = sim.get_tti_rx().is_valid() ? sim.get_tti_rx() + 1 : tti_point(0);
+    srslog::fetch_basic_logger("MAC").set_context(tti_rx.to_uint());
+    sim.new_tti(tti_rx);
+
+    // Add the users in PRACH TTIs, distributed across the carriers
+    if (nof_added_ues < nof_ues) {
+      ue_ctxt_test_cfg ue_sim_cfg{};
+      ue_sim_cfg.ue_cfg.supported_cc_list[0].enb_cc_idx = nof_added_ues % nof_ccs;
+      if (srsran_prach_tti_opportunity_config_fdd(
+              cell_list[ue_sim_cfg.ue_cfg.supported_cc_list[0].enb_cc_idx].prach_config, tti_rx.to_uint(), -1)) {
+        uint16_t rnti            = 0x46 + nof_added_ues;
+        sim.ue_sim_cfg_map[rnti] = ue_sim_cfg;
+        TESTASSERT(sim.add_user(rnti, ue_sim_cfg.ue_cfg, nof_added_ues) == SRSRAN_SUCCESS);
+        nof_added_ues++;
+      }
+    }
+
+    for (uint32_t cc = 0; cc < nof_ccs; ++cc) {
+      TESTASSERT(sched_obj.dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]) == SRSRAN_SUCCESS);
+      TESTASSERT(sched_obj.ul_sched(to_tx_ul(tti_rx).to_uint(), cc, ul_result[cc]) == SRSRAN_SUCCESS);
+    }
+    sf_output_res_t sf_out{sim.get_cell_params(), tti_rx, ul_result, dl_result};
+    sim.update(sf_out);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/// Checks that the replay of a recorded simulation reproduces all the recorded decisions
+int test_record_and_replay()
+{
+  const char*    filename = "sched_replay_test.trace";
+  const uint32_t nof_ttis = 2000;
+
+  TESTASSERT(record_sim_trace(filename, nof_ttis) == SRSRAN_SUCCESS);
+
+  replay_results results;
+  TESTASSERT(replay_trace(filename, results) == SRSRAN_SUCCESS);
+  TESTASSERT(results.nof_ttis == nof_ttis);
+  TESTASSERT(results.nof_diffs == 0);
+
+  remove(filename);
+  return SRSRAN_SUCCESS;
+}
+
+/// Overwrites one byte of the file at offset
+void patch_byte(const char* filename, long offset, uint8_t value)
+{
+  FILE* fd = fopen(filename, "r+b");
+  TESTASSERT(fd != nullptr);
+  fseek(fd, offset, SEEK_SET);
+  fputc(value, fd);
+  fclose(fd);
+}
+
+/// Checks that traces recorded with another layout of the structures, or records of another version, are rejected
+int test_reject_other_versions()
+{
+  const char* filename = "sched_replay_version_test.trace";
+  TESTASSERT(record_sim_trace(filename, 10) == SRSRAN_SUCCESS);
+
+  // The header is "SRST", the format version and the layout signature (3 x 4 bytes). A record starts with its type
+  // and version
+  const long layout_offset = 8, first_record_version_offset = 13;
+  replay_results results;
+  patch_byte(filename, layout_offset, 0xff);
+  TESTASSERT(replay_trace(filename, results) == SRSRAN_ERROR);
+
+  TESTASSERT(record_sim_trace(filename, 10) == SRSRAN_SUCCESS);
+  patch_byte(filename, first_record_version_offset, 0xff);
+  TESTASSERT(replay_trace(filename, results) == SRSRAN_SUCCESS);
+  TESTASSERT(results.nof_records == 0);
+
+  remove(filename);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char* argv[])
+{
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::warning);
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::warning);
+
+  // Start the log backend.
+  srslog::init();
+
+  if (argc == 1) {
+    srsenb::set_randseed(1234);
+    TESTASSERT(srsenb::test_record_and_replay() == SRSRAN_SUCCESS);
+    TESTASSERT(srsenb::test_reject_other_versions() == SRSRAN_SUCCESS);
+  } else {
+    srsenb::replay_results results;
+    TESTASSERT(srsenb::replay_trace(argv[1], results) == SRSRAN_SUCCESS);
+  }
+
+  return 0;
+}
@@ -135,6 +135,42 @@ void test_interferer_subband_cqi_scenario()
   TESTASSERT(grant_mask == test_mask);
 }
 
+/**
+ * Test HARQ feedback handling when the scheduler generates the TTIs ahead of the PHY
+ * - DL retxs are only considered once the DL ACK had time to reach the scheduler
+ * - The CRC of an UL HARQ stays pending until the PHY received its PUSCH, and the HARQ is not discarded meanwhile
+ */
+void test_lookahead_harq_feedback()
+{
+  const uint32_t lookahead = 2;
+  harq_entity    harq_ent(SRSRAN_FDD_NOF_HARQ, SRSRAN_FDD_NOF_HARQ, lookahead);
+  tti_point      tti_rx{10};
+
+  // DL HARQ RTT is extended by the look-ahead
+  dl_harq_proc& h_dl = harq_ent.dl_harq_procs()[0];
+  h_dl.new_tx(rbgmask_t(13), 0, to_tx_dl(tti_rx), 10, 100, 0, 4);
+  TESTASSERT(not h_dl.has_pending_retx(0, to_tx_dl_ack(to_tx_dl(tti_rx))));
+  TESTASSERT(not h_dl.has_pending_retx(0, to_tx_dl_ack(to_tx_dl(tti_rx)) + lookahead - 1));
+  TESTASSERT(h_dl.has_pending_retx(0, to_tx_dl_ack(to_tx_dl(tti_rx)) + lookahead));
+  TESTASSERT(h_dl.set_ack(0, true) == SRSRAN_SUCCESS);
+  TESTASSERT(not h_dl.has_pending_retx(0, to_tx_dl_ack(to_tx_dl(tti_rx)) + lookahead));
+
+  // UL HARQ CRC is unknown until the PUSCH TTI is reached by the PHY
+  tti_point     tti_pusch = to_tx_ul(tti_rx);
+  ul_harq_proc* h_ul      = harq_ent.get_ul_harq(tti_pusch);
+  h_ul->new_tx(tti_pusch, 10, 100, prb_interval{0, 2}, 1, false);
+  TESTASSERT(h_ul->has_pending_crc(tti_pusch));
+  TESTASSERT(h_ul->has_pending_crc(tti_pusch + lookahead - 1));
+  TESTASSERT(not h_ul->has_pending_crc(tti_pusch + lookahead));
+  harq_ent.new_tti(tti_pusch);
+  TESTASSERT(not h_ul->is_empty());
+
+  // Once the NACK is received, the HARQ reaching max retxs is discarded
+  TESTASSERT(h_ul->set_ack(0, false));
+  harq_ent.new_tti(tti_pusch + SRSRAN_FDD_NOF_HARQ);
+  TESTASSERT(h_ul->is_empty(0));
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -148,6 +184,7 @@ int main()
 
   test_neg_phr_scenario();
   test_interferer_subband_cqi_scenario();
+  test_lookahead_harq_feedback();
 
   srslog::flush();
 
@@ -28,6 +28,7 @@
 #include <boost/program_options/parsers.hpp>
 #include <iostream>
 #include <mutex>
+#include <srsenb/hdr/phy/lte/worker_pool.h>
 #include <srsenb/hdr/phy/phy.h>
 #include <srsran/common/string_helpers.h>
 #include <srsran/common/test_common.h>
@@ -1175,6 +1176,10 @@ public:
     uint32_t              period_pcell_rotate = 0;
     srsran_tm_t           tm                  = SRSRAN_TM1;
     bool                  extended_cp         = false;
+    bool                  pipeline            = false;
+    uint32_t              pipeline_depth      = 2;
+    uint32_t              nof_cc_threads      = 0;
+    bool                  stop_queued_ttis    = false;
     args_t()
     {
       cell.nof_prb   = 6;
@@ -1241,8 +1246,11 @@ public:
     logger.set_level(srslog::str_to_basic_level(args.log_level));
 
     // PHY arguments
-    phy_args.log.phy_level   = args.log_level;
-    phy_args.nof_phy_threads = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
+    phy_args.log.phy_level      = args.log_level;
+    phy_args.nof_phy_threads    = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
+    phy_args.lte_pipeline       = args.pipeline;
+    phy_args.lte_pipeline_depth = args.pipeline_depth;
+    phy_args.nof_phy_cc_threads = args.nof_cc_threads;
 
     // Create cell configuration
     phy_cfg.phy_cell_cfg.resize(args.nof_enb_cells);
@@ -1359,6 +1367,48 @@ public:
     enb_phy->stop();
   }
 
+  /// Starts TTIs in the LTE workers without a UE, and stops the workers while their MAC and DL stages still have
+  /// subframes queued. All the started subframes must still be transmitted
+  int run_stop_with_queued_ttis()
+  {
+    radio = unique_dummy_radio_t(
+        new dummy_radio(args.nof_enb_cells * args.cell.nof_ports, args.cell.nof_prb, args.log_level));
+    radio->stop(); // Nobody reads the transmitted subframes
+
+    phy_rrc_cfg.resize(1);
+    phy_rrc_cfg[0].configured = true;
+    stack = unique_dummy_stack_t(new dummy_stack(phy_cfg, phy_rrc_cfg, args.log_level, args.rnti));
+    stack->set_active_cell_list(args.ue_cell_list);
+
+    srsenb::phy_common common;
+    common.params = phy_args;
+    TESTASSERT(common.init(phy_cfg.phy_cell_cfg, {}, radio.get(), stack.get()));
+
+    srsenb::lte::worker_pool workers(phy_args.nof_phy_threads);
+    TESTASSERT(workers.init(phy_args, &common, srslog::get_default_sink(), -1));
+    for (uint32_t tti = 0; tti < args.duration; tti++) {
+      srsenb::lte::sf_worker* w = workers.wait_worker(tti);
+      TESTASSERT(w != nullptr);
+
+      srsran::phy_common_interface::worker_context_t context;
+      context.sf_idx     = tti;
+      context.worker_ptr = w;
+      context.last       = true;
+      w->set_context(context);
+      common.semaphore.push(w);
+      workers.start_worker(w);
+    }
+
+    // Once the UL stage of the last TTI is done, the following stages may still have up to the pipeline depth of
+    // subframes queued
+    TESTASSERT(workers.wait_worker(args.duration) != nullptr);
+    workers.stop();
+
+    // Returns once every subframe has been transmitted
+    common.stop();
+    return SRSRAN_SUCCESS;
+  }
+
   virtual ~phy_test_bench() = default;
 
   int run_tti()
@@ -1462,6 +1512,10 @@ int parse_args(int argc, char** argv, phy_test_bench::args_t& args)
       ("cell.cp",        bpo::value<bool>(&args.extended_cp)->default_value(false),                      "use extended CP")
       ("tm", bpo::value<uint32_t>(&args.tm_u32)->default_value(args.tm_u32),                             "Transmission mode")
       ("rotation", bpo::value<uint32_t>(&args.period_pcell_rotate),                      "Serving cells rotation period in ms, set to zero to disable")
+      ("pipeline", bpo::value<bool>(&args.pipeline)->default_value(false),                 "Pipeline the UL processing, MAC scheduling and DL processing in different threads")
+      ("pipeline_depth", bpo::value<uint32_t>(&args.pipeline_depth)->default_value(2),     "Maximum number of subframes in flight in the pipeline")
+      ("cc_threads", bpo::value<uint32_t>(&args.nof_cc_threads)->default_value(0),         "Number of threads for processing the carriers in parallel")
+      ("stop_queued_ttis", bpo::value<bool>(&args.stop_queued_ttis)->default_value(false), "Stop the LTE workers with subframes queued in the pipeline, instead of running the UE")
       ;
   options.add(common).add_options()("help", "Show this message");
   // clang-format on
@@ -1511,6 +1565,12 @@ int main(int argc, char** argv)
 
   // Create Test Bench
   unique_phy_test_bench test_bench = unique_phy_test_bench(new phy_test_bench(test_args, srslog::get_default_sink()));
+  if (test_args.stop_queued_ttis) {
+    TESTASSERT(test_bench->run_stop_with_queued_ttis() == SRSRAN_SUCCESS);
+    srslog::flush();
+    std::cout << "Ok" << std::endl;
+    return SRSRAN_SUCCESS;
+  }
   int                   err_code   = test_bench->init();
   bool                  valid_cfg  = test_args.nof_enb_cells <= SRSRAN_MAX_CARRIERS;
   if (not valid_cfg) {
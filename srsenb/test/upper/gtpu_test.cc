@@ -44,6 +44,7 @@ public:
     last_pdcp_sn       = pdcp_sn;
     last_rnti          = rnti;
     last_eps_bearer_id = eps_bearer_id;
+    nof_sdus++;
   }
   std::map<uint32_t, srsran::unique_byte_buffer_t> get_buffered_pdus(uint16_t rnti, uint32_t eps_bearer_id) override
   {
@@ -51,6 +52,7 @@ public:
   }
   void send_status_report(uint16_t rnti) override {}
   void send_status_report(uint16_t rnti, uint32_t eps_bearer_id) override {}
+  bool sdu_queue_is_congested(uint16_t rnti, uint32_t eps_bearer_id) override { return congested; }
 
   void push_buffered_pdu(uint32_t sn, srsran::unique_byte_buffer_t pdu) { buffered_pdus[sn] = std::move(pdu); }
 
@@ -67,6 +69,8 @@ public:
   int                                              last_pdcp_sn       = -1;
   uint16_t                                         last_rnti          = SRSRAN_INVALID_RNTI;
   uint32_t                                         last_eps_bearer_id = 0;
+  uint32_t                                         nof_sdus           = 0;
+  bool                                             congested          = false;
 };
 
 struct dummy_socket_manager : public srsran::socket_manager_itf {
@@ -215,6 +219,67 @@ void test_gtpu_tunnel_manager()
   TESTASSERT(after_tun->state == gtpu_tunnel_manager::tunnel_state::pdcp_active);
 }
 
+int test_gtpu_congestion()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TEST");
+  logger.info("\n\n**** Test GTPU Congestion ****\n");
+  uint16_t           rnti = 0x46, drb1_bearer_id = 5;
+  const char *       sgw_addr_str = "127.0.0.1", *enb_addr_str = "127.0.2.1";
+  struct sockaddr_in enb_sockaddr = {}, sgw_sockaddr = {};
+  srsran::net_utils::set_sockaddr(&enb_sockaddr, enb_addr_str, GTPU_PORT);
+  srsran::net_utils::set_sockaddr(&sgw_sockaddr, sgw_addr_str, GTPU_PORT);
+
+  srsran::task_scheduler task_sched;
+  dummy_socket_manager   rx_sockets;
+  srsenb::gtpu           gtpu(&task_sched, srslog::fetch_basic_logger("GTPU"), srsran::srsran_rat_t::lte, &rx_sockets);
+  pdcp_tester            pdcp;
+  gtpu_args_t            gtpu_args;
+  gtpu_args.gtp_bind_addr = enb_addr_str;
+  gtpu_args.mme_addr      = sgw_addr_str;
+  TESTASSERT(gtpu.init(gtpu_args, &pdcp) == SRSRAN_SUCCESS);
+  uint32_t addr_in;
+  uint32_t teid_in = gtpu.add_bearer(rnti, drb1_bearer_id, ntohl(sgw_sockaddr.sin_addr.s_addr), 1, addr_in).value();
+
+  auto send_sdu = [&](uint8_t val) {
+    std::vector<uint8_t> data(10, val);
+    gtpu.handle_gtpu_s1u_rx_packet(encode_gtpu_packet(data, teid_in, sgw_sockaddr, enb_sockaddr), sgw_sockaddr);
+  };
+  auto last_sdu_val = [&pdcp]() { return pdcp.last_sdu->msg[pdcp.last_sdu->N_bytes - 1]; };
+
+  send_sdu(0);
+  TESTASSERT(pdcp.nof_sdus == 1);
+
+  // TEST: While PDCP is congested, the SDUs are held back instead of being passed to PDCP
+  pdcp.congested = true;
+  for (uint8_t val = 1; val < 4; ++val) {
+    send_sdu(val);
+  }
+  task_sched.tic();
+  TESTASSERT(pdcp.nof_sdus == 1);
+
+  // TEST: Once the congestion clears, the SDUs held back are passed in order, even if no new SDUs arrive
+  pdcp.congested = false;
+  for (uint32_t i = 0; i < gtpu_tunnel_manager::congestion_poll_period_ms; ++i) {
+    task_sched.tic();
+  }
+  TESTASSERT(pdcp.nof_sdus == 4);
+  TESTASSERT(last_sdu_val() == 3);
+  send_sdu(4);
+  TESTASSERT(pdcp.nof_sdus == 5);
+
+  // TEST: A new SDU flushes the SDUs held back ahead of it, once the congestion clears
+  pdcp.congested = true;
+  send_sdu(5);
+  send_sdu(6);
+  TESTASSERT(pdcp.nof_sdus == 5);
+  pdcp.congested = false;
+  send_sdu(7);
+  TESTASSERT(pdcp.nof_sdus == 8);
+  TESTASSERT(last_sdu_val() == 7);
+
+  return SRSRAN_SUCCESS;
+}
+
 enum class tunnel_test_event { success, wait_end_marker_timeout, ue_removal_no_marker, reest_senb };
 
 int test_gtpu_direct_tunneling(tunnel_test_event event)
@@ -395,6 +460,7 @@ int main(int argc, char** argv)
   srsran::test_init(argc, argv);
 
   srsenb::test_gtpu_tunnel_manager();
+  TESTASSERT(srsenb::test_gtpu_congestion() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::success) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::wait_end_marker_timeout) == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_gtpu_direct_tunneling(srsenb::tunnel_test_event::ue_removal_no_marker) == SRSRAN_SUCCESS);
@@ -0,0 +1,158 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Benchmark of the GTP-U tunnel manager lookups with a large number of tunnels. Measures the per-packet TEID lookup
+ * of the DL path, the (rnti, eps-BearerID) lookup of the UL path and the tunnel creation/removal rate.
+ */
+
+#include "srsenb/hdr/stack/upper/gtpu.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+#include <random>
+
+namespace srsenb {
+
+static uint32_t nof_tunnels = 10000;
+static uint32_t nof_lookups = 10000000;
+
+const uint32_t nof_bearers_per_ue = 4;
+const uint32_t first_eps_bearer   = 5;
+const uint16_t first_rnti         = 0x46;
+
+using steady_clock = std::chrono::steady_clock;
+
+double elapsed_ns(steady_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(steady_clock::now() - start).count();
+}
+
+int run_benchmark()
+{
+  srsran::task_scheduler task_sched;
+  gtpu_args_t            gtpu_args = {};
+  std::mt19937           rgen(0);
+
+  gtpu_tunnel_manager tunnels(&task_sched, srslog::fetch_basic_logger("GTPU"), srsran::srsran_rat_t::lte, nof_tunnels);
+  tunnels.init(gtpu_args, nullptr);
+
+  // Create tunnels of nof_tunnels / nof_bearers_per_ue UEs
+  std::vector<uint32_t> teids;
+  auto                  start = steady_clock::now();
+  for (uint32_t i = 0; i < nof_tunnels; ++i) {
+    uint16_t           rnti = first_rnti + i / nof_bearers_per_ue;
+    const gtpu_tunnel* tun  = tunnels.add_tunnel(rnti, first_eps_bearer + i % nof_bearers_per_ue, i, 0x7f000001);
+    TESTASSERT(tun != nullptr);
+    teids.push_back(tun->teid_in);
+  }
+  double add_ns = elapsed_ns(start) / nof_tunnels;
+
+  // Random order of access, so that the lookups do not benefit from the tunnel creation order
+  std::vector<uint32_t> order(1U << 16U);
+  for (uint32_t& idx : order) {
+    idx = std::uniform_int_distribution<uint32_t>{0, nof_tunnels - 1}(rgen);
+  }
+
+  // DL: TEID In of the GTP-U header -> tunnel
+  uint64_t checksum = 0;
+  start             = steady_clock::now();
+  for (uint32_t i = 0; i < nof_lookups; ++i) {
+    const gtpu_tunnel* tun = tunnels.find_tunnel(teids[order[i % order.size()]]);
+    checksum += tun->teid_out;
+  }
+  double dl_ns = elapsed_ns(start) / nof_lookups;
+
+  // UL: (rnti, eps-BearerID) of the PDCP PDU -> tunnel
+  start = steady_clock::now();
+  for (uint32_t i = 0; i < nof_lookups; ++i) {
+    uint32_t idx  = order[i % order.size()];
+    auto     tuns = tunnels.find_rnti_bearer_tunnels(first_rnti + idx / nof_bearers_per_ue,
+                                                 first_eps_bearer + idx % nof_bearers_per_ue);
+    checksum += tunnels.find_tunnel(tuns[0].teid)->teid_out;
+  }
+  double ul_ns = elapsed_ns(start) / nof_lookups;
+
+  // Churn: remove and re-create tunnels. The TEIDs of removed tunnels must not be found anymore
+  uint32_t nof_churn = std::min(nof_tunnels, 1000u);
+  start              = steady_clock::now();
+  for (uint32_t i = 0; i < nof_churn; ++i) {
+    uint32_t idx  = order[i];
+    uint16_t rnti = first_rnti + idx / nof_bearers_per_ue;
+    TESTASSERT(tunnels.remove_tunnel(teids[idx]));
+    TESTASSERT(tunnels.find_tunnel(teids[idx]) == nullptr);
+    const gtpu_tunnel* tun = tunnels.add_tunnel(rnti, first_eps_bearer + idx % nof_bearers_per_ue, idx, 0x7f000001);
+    TESTASSERT(tun != nullptr and tun->teid_in != teids[idx]);
+    teids[idx] = tun->teid_in;
+  }
+  double churn_ns = elapsed_ns(start) / nof_churn;
+
+  printf("%d tunnels, %d lookups (checksum=%" PRIu64 ")\n", nof_tunnels, nof_lookups, checksum);
+  printf("DL TEID lookup:               %6.1f ns\n", dl_ns);
+  printf("UL rnti/bearer lookup:        %6.1f ns\n", ul_ns);
+  printf("Tunnel creation:              %6.1f ns\n", add_ns);
+  printf("Tunnel removal and creation:  %6.1f ns\n", churn_ns);
+
+  for (uint32_t i = 0; i < nof_tunnels / nof_bearers_per_ue; ++i) {
+    TESTASSERT(tunnels.remove_rnti(first_rnti + i));
+  }
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+void usage(char* prog)
+{
+  printf("Usage: %s [tn]\n", prog);
+  printf("\t-t number of tunnels [Default %d]\n", srsenb::nof_tunnels);
+  printf("\t-n number of lookups [Default %d]\n", srsenb::nof_lookups);
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "tn")) != -1) {
+    switch (opt) {
+      case 't':
+        srsenb::nof_tunnels = std::max(srsenb::nof_bearers_per_ue, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      case 'n':
+        srsenb::nof_lookups = std::max(1U, (uint32_t)strtol(argv[optind], NULL, 10));
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+
+  srslog::fetch_basic_logger("GTPU").set_level(srslog::basic_levels::warning);
+  srsran::test_init(argc, argv);
+
+  TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
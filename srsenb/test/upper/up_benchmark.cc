@@ -0,0 +1,295 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Benchmark of the eNB DL user plane without PHY and MAC. GTP-U packets of several UEs are pushed through
+ * gtpu -> pdcp -> rlc, and the RLC is drained the way the MAC would do it.
+ */
+
+#include "srsenb/hdr/stack/upper/gtpu.h"
+#include "srsenb/hdr/stack/upper/gtpu_pdcp_adapter.h"
+#include "srsenb/hdr/stack/upper/pdcp.h"
+#include "srsenb/hdr/stack/upper/rlc.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/enb_mac_interfaces.h"
+#include "srsran/interfaces/enb_rrc_interface_pdcp.h"
+#include "srsran/interfaces/enb_rrc_interface_rlc.h"
+#include "srsran/upper/gtpu.h"
+#include <chrono>
+#include <linux/ip.h>
+#include <random>
+#include <thread>
+
+namespace srsenb {
+
+struct up_bench_params {
+  uint32_t nof_ues            = 16;
+  uint32_t nof_workers        = 0;
+  uint32_t nof_pkts_per_ue    = 2000;
+  uint32_t pkt_size           = 1400; ///< IP packet size in bytes
+  uint32_t burst_size         = 8;    ///< Packets received per UE between two RLC drains
+  uint32_t max_sdus_in_flight = 1024; ///< SDUs received by the GTP-U and not yet written into the RLC
+  bool     ciphering          = true;
+};
+
+class rrc_up_dummy : public rrc_interface_pdcp, public rrc_interface_rlc
+{
+public:
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override {}
+  void notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid) override {}
+  void max_retx_attempted(uint16_t rnti) override {}
+  void protocol_failure(uint16_t rnti) override {}
+};
+
+class mac_up_dummy : public mac_interface_rlc
+{
+public:
+  int rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue) override
+  {
+    return SRSRAN_SUCCESS;
+  }
+};
+
+/// The packets are passed to the GTP-U directly, so no socket is ever read
+class rx_socket_dummy : public srsran::socket_manager_itf
+{
+public:
+  rx_socket_dummy() : srsran::socket_manager_itf(srslog::fetch_basic_logger("TEST")) {}
+  bool add_socket_handler(int fd, recv_callback_t handler) override { return true; }
+  bool remove_socket(int fd) override { return true; }
+};
+
+srsran::unique_byte_buffer_t make_gtpu_pdu(uint32_t teid, uint32_t pkt_size)
+{
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu == nullptr) {
+    return nullptr;
+  }
+
+  struct iphdr ip_pkt = {};
+  ip_pkt.version      = 4;
+  ip_pkt.tot_len      = htons(pkt_size);
+  pdu->append_bytes((uint8_t*)&ip_pkt, sizeof(struct iphdr));
+  memset(pdu->msg + pdu->N_bytes, 0xab, pkt_size - sizeof(struct iphdr));
+  pdu->N_bytes = pkt_size;
+
+  srsran::gtpu_header_t header = {};
+  header.flags                 = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+  header.message_type          = GTPU_MSG_DATA_PDU;
+  header.length                = pdu->N_bytes;
+  header.teid                  = teid;
+  gtpu_write_header(&header, pdu.get(), srslog::fetch_basic_logger("GTPU"));
+  return pdu;
+}
+
+int run_up_benchmark(const up_bench_params& params)
+{
+  const uint32_t drb_lcid      = 3;
+  const uint32_t eps_bearer_id = 5;
+  const char*    sgw_addr_str  = "127.0.3.2";
+
+  srsran::task_scheduler task_sched;
+  enb_bearer_manager     bearers;
+  rx_socket_dummy        rx_sockets;
+  rrc_up_dummy           rrc;
+  mac_up_dummy           mac;
+  rlc                    rlc_obj(srslog::fetch_basic_logger("RLC"));
+  pdcp                   pdcp_obj(&task_sched, srslog::fetch_basic_logger("PDCP"));
+  gtpu gtpu_obj(&task_sched, srslog::fetch_basic_logger("GTPU"), srsran::srsran_rat_t::lte, &rx_sockets);
+  gtpu_pdcp_adapter adapter(srslog::fetch_basic_logger("STCK"), &pdcp_obj, nullptr, &gtpu_obj, bearers);
+
+  rlc_obj.init(&pdcp_obj, &rrc, &mac, task_sched.get_timer_handler());
+  pdcp_obj.init(&rlc_obj, &rrc, &adapter, params.nof_workers);
+  gtpu_args_t gtpu_args   = {};
+  gtpu_args.gtp_bind_addr = "127.0.3.1";
+  gtpu_args.mme_addr      = sgw_addr_str;
+  TESTASSERT(gtpu_obj.init(gtpu_args, &adapter) == SRSRAN_SUCCESS);
+
+  struct sockaddr_in sgw_sockaddr = {};
+  srsran::net_utils::set_sockaddr(&sgw_sockaddr, sgw_addr_str, 2152);
+
+  std::mt19937                 rand_gen(0);
+  srsran::as_security_config_t sec_cfg = {};
+  sec_cfg.integ_algo                   = srsran::INTEGRITY_ALGORITHM_ID_EIA0;
+  sec_cfg.cipher_algo = params.ciphering ? srsran::CIPHERING_ALGORITHM_ID_128_EEA2 : srsran::CIPHERING_ALGORITHM_ID_EEA0;
+  for (uint8_t& k : sec_cfg.k_up_enc) {
+    k = rand_gen();
+  }
+
+  // Create the UEs, each with a single UM DRB
+  std::vector<uint16_t>                     rntis;
+  std::vector<srsran::unique_byte_buffer_t> pkt_templates;
+  for (uint32_t i = 0; i < params.nof_ues; ++i) {
+    uint16_t rnti = 0x46 + i;
+    rlc_obj.add_user(rnti);
+    pdcp_obj.add_user(rnti);
+    rlc_obj.add_bearer(rnti, drb_lcid, srsran::rlc_config_t::default_rlc_um_config());
+    srsran::pdcp_config_t pdcp_cfg(drb_lcid,
+                                   srsran::PDCP_RB_IS_DRB,
+                                   srsran::SECURITY_DIRECTION_DOWNLINK,
+                                   srsran::SECURITY_DIRECTION_UPLINK,
+                                   srsran::PDCP_SN_LEN_12,
+                                   srsran::pdcp_t_reordering_t::ms500,
+                                   srsran::pdcp_discard_timer_t::infinity,
+                                   false,
+                                   srsran::srsran_rat_t::lte);
+    pdcp_obj.add_bearer(rnti, drb_lcid, pdcp_cfg);
+    pdcp_obj.config_security(rnti, drb_lcid, sec_cfg);
+    pdcp_obj.enable_encryption(rnti, drb_lcid);
+    bearers.add_eps_bearer(rnti, eps_bearer_id, srsran::srsran_rat_t::lte, drb_lcid);
+
+    uint32_t addr_in;
+    uint32_t teid_in = gtpu_obj.add_bearer(rnti, eps_bearer_id, ntohl(sgw_sockaddr.sin_addr.s_addr), i + 1, addr_in)
+                           .value();
+    rntis.push_back(rnti);
+    pkt_templates.push_back(make_gtpu_pdu(teid_in, params.pkt_size));
+    TESTASSERT(pkt_templates.back() != nullptr);
+  }
+
+  // Reads all the pending data of the UEs, as the MAC would do when building the TBs
+  std::vector<uint8_t> tb(16384);
+  uint64_t             nof_tb_bytes = 0;
+  auto                 drain_rlc    = [&]() {
+    for (uint16_t rnti : rntis) {
+      int n;
+      while ((n = rlc_obj.read_pdu(rnti, drb_lcid, tb.data(), tb.size())) > 0) {
+        nof_tb_bytes += n;
+      }
+    }
+  };
+  // The PDCP Tx counters are never reset, so they give the number of SDUs already written into the RLC
+  uint64_t nof_pdcp_pdus = 0;
+  auto     update_metrics = [&]() {
+    pdcp_metrics_t m;
+    pdcp_obj.get_metrics(m, 1);
+    nof_pdcp_pdus = 0;
+    for (const auto& ue : m.ues) {
+      nof_pdcp_pdus += ue.bearer[drb_lcid].num_tx_pdus;
+    }
+  };
+
+  auto     tp_start = std::chrono::high_resolution_clock::now();
+  uint64_t nof_sdus = 0;
+  for (uint32_t n = 0; n < params.nof_pkts_per_ue; n += params.burst_size) {
+    uint32_t burst = std::min(params.burst_size, params.nof_pkts_per_ue - n);
+    for (uint32_t ue_idx = 0; ue_idx < rntis.size(); ++ue_idx) {
+      for (uint32_t i = 0; i < burst; ++i) {
+        srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+        TESTASSERT(pdu != nullptr);
+        *pdu = *pkt_templates[ue_idx];
+        gtpu_obj.handle_gtpu_s1u_rx_packet(std::move(pdu), sgw_sockaddr);
+        nof_sdus++;
+      }
+    }
+    task_sched.tic();
+    pdcp_obj.tic();
+    drain_rlc();
+    update_metrics();
+
+    // Slow down the S1-U when the workers fall behind, so the byte buffer pool is not exhausted
+    while (nof_sdus - nof_pdcp_pdus > params.max_sdus_in_flight) {
+      std::this_thread::yield();
+      drain_rlc();
+      update_metrics();
+    }
+  }
+
+  // The bearer state is read after the SDUs still queued to the workers, so the COUNT covers all the SDUs sent
+  for (uint16_t rnti : rntis) {
+    srsran::pdcp_lte_state_t state = {};
+    TESTASSERT(pdcp_obj.get_bearer_state(rnti, drb_lcid, &state));
+    TESTASSERT(state.tx_hfn * 4096 + state.next_pdcp_tx_sn == params.nof_pkts_per_ue);
+  }
+
+  // Wait for the workers to hand the remaining SDUs to the RLC
+  auto tp_last_progress = std::chrono::high_resolution_clock::now();
+  while (nof_pdcp_pdus < nof_sdus) {
+    uint64_t prev_pdus = nof_pdcp_pdus;
+    drain_rlc();
+    update_metrics();
+    auto tp_now = std::chrono::high_resolution_clock::now();
+    if (nof_pdcp_pdus > prev_pdus) {
+      tp_last_progress = tp_now;
+    } else if (tp_now - tp_last_progress > std::chrono::milliseconds(100)) {
+      // SDUs dropped by the PDCP never reach the RLC
+      break;
+    }
+    std::this_thread::yield();
+  }
+  drain_rlc();
+  auto tp_end = std::chrono::high_resolution_clock::now();
+
+  double elapsed_sec = std::chrono::duration_cast<std::chrono::microseconds>(tp_end - tp_start).count() * 1e-6;
+  fmt::print("nof_ues={}, nof_workers={}, pkt_size={}, ciphering={}: {} SDUs in {:.3f} sec, {:.1f} kpps, {:.1f} Mbps "
+             "({} SDUs not delivered to the RLC)\n",
+             params.nof_ues,
+             params.nof_workers,
+             params.pkt_size,
+             params.ciphering ? "EEA2" : "EEA0",
+             nof_sdus,
+             elapsed_sec,
+             nof_pdcp_pdus / elapsed_sec / 1000.0,
+             nof_tb_bytes * 8 / elapsed_sec / 1e6,
+             nof_sdus - std::min(nof_sdus, nof_pdcp_pdus));
+
+  gtpu_obj.stop();
+  pdcp_obj.stop();
+  rlc_obj.stop();
+
+  TESTASSERT(nof_pdcp_pdus == nof_sdus);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("GTPU").set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("PDCP").set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("RLC").set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  srsenb::up_bench_params params;
+  if (argc == 1 or strcmp(argv[1], "test") == 0) {
+    // Short run, to check the sharded and the single-threaded paths deliver the same traffic
+    params.nof_ues         = 4;
+    params.nof_pkts_per_ue = 256;
+    TESTASSERT(srsenb::run_up_benchmark(params) == SRSRAN_SUCCESS);
+    params.nof_workers = 2;
+    TESTASSERT(srsenb::run_up_benchmark(params) == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "benchmark") == 0) {
+    // up_benchmark benchmark [nof_ues] [nof_pkts_per_ue] [pkt_size]
+    params.nof_ues         = argc > 2 ? strtol(argv[2], nullptr, 10) : params.nof_ues;
+    params.nof_pkts_per_ue = argc > 3 ? strtol(argv[3], nullptr, 10) : params.nof_pkts_per_ue;
+    params.pkt_size        = argc > 4 ? strtol(argv[4], nullptr, 10) : params.pkt_size;
+    for (uint32_t nof_workers : {0, 1, 2, 4}) {
+      params.nof_workers = nof_workers;
+      TESTASSERT(srsenb::run_up_benchmark(params) == SRSRAN_SUCCESS);
+    }
+  } else {
+    fmt::print("Usage: {} [test|benchmark [nof_ues] [nof_pkts_per_ue] [pkt_size]]\n", argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -125,6 +125,11 @@ public:
     // TODO: make it thread-safe. For now, this function is unused
     return pdcp.get_buffered_pdus(rnti, lcid);
   }
+  bool sdu_queue_is_congested(uint16_t rnti, uint32_t lcid) final
+  {
+    // Thread-safe, as it only reads the atomic counters of the RLC Tx queue under the RLC user lock
+    return pdcp.sdu_queue_is_congested(rnti, lcid);
+  }
 
 private:
   void run_thread() final;
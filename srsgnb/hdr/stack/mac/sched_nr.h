@@ -27,7 +27,9 @@
 #include "sched_nr_ue.h"
 #include "srsran/adt/pool/cached_alloc.h"
 #include "srsran/adt/pool/circular_stack_pool.h"
+#include "srsran/common/futex_word.h"
 #include "srsran/common/slot_point.h"
+#include "srsran/common/thread_pool.h"
 #include <array>
 extern "C" {
 #include "srsran/config.h"
@@ -73,6 +75,9 @@ private:
   int ue_cfg_impl(uint16_t rnti, const ue_cfg_t& cfg);
   int add_ue_impl(uint16_t rnti, sched_nr_impl::unique_ue_ptr u);
 
+  /// Process the feedback of cell \c cc and generate its DL/UL results for the current slot
+  dl_res_t* generate_cc_result(uint32_t cc);
+
   // args
   sched_nr_impl::sched_params_t cfg;
   srslog::basic_logger*         logger = nullptr;
@@ -84,6 +89,14 @@ private:
   using slot_cc_worker = sched_nr_impl::cc_worker;
   std::vector<std::unique_ptr<sched_nr_impl::cc_worker> > cc_workers;
 
+  // Cell results generated in parallel, when more than one cell and cc worker threads are configured
+  struct cc_slot_result {
+    dl_res_t*          dl_res = nullptr;
+    srsran::futex_word done{1};
+  };
+  std::unique_ptr<cc_slot_result[]>         cc_results;
+  std::unique_ptr<srsran::task_thread_pool> cc_thread_pool;
+
   // UE Database
   std::unique_ptr<srsran::circular_stack_pool<SRSENB_MAX_UES> > ue_pool;
   using ue_map_t = sched_nr_impl::ue_map_t;
@@ -123,6 +123,14 @@ public:
     int         fixed_dl_mcs       = 28;
     int         fixed_ul_mcs       = 28;
     std::string logger_name        = "MAC-NR";
+    /// Number of threads used to generate the results of multiple cells in parallel (0 = caller thread)
+    uint32_t nof_cc_workers = 0;
+    /// Maximum number of DCI placements explored per PDCCH allocation attempt (0 = unlimited)
+    uint32_t max_pdcch_search_nodes = 1024;
+    /// Data scheduling policy, "time_rr" (round-robin) or "time_pf" (proportional fair with QoS weights)
+    std::string policy = "time_rr";
+    /// Policy arguments, the fairness coefficient for "time_pf"
+    std::string policy_args;
   };
 
   using ue_cc_cfg_t = sched_nr_ue_cc_cfg_t;
@@ -60,13 +60,18 @@ public:
   uint32_t nof_cces() const { return nof_freq_res * get_td_symbols(); }
   size_t   nof_allocs() const { return dfs_tree.size(); }
 
+  /// Number of DFS nodes visited in the last call to alloc_pdcch
+  uint32_t last_search_nof_nodes() const { return nof_search_nodes; }
+
   void print_allocations(fmt::memory_buffer& fmtbuf) const;
 
 private:
   const srsran_coreset_t* coreset_cfg;
   uint32_t                coreset_id;
   uint32_t                slot_idx;
-  uint32_t                nof_freq_res = 0;
+  uint32_t                nof_freq_res     = 0;
+  uint32_t                max_search_nodes = 0;
+  srslog::basic_logger&   logger;
 
   const bwp_cce_pos_list&                          rar_cce_list;
   const srsran::optional_vector<bwp_cce_pos_list>& common_cce_list;
@@ -88,12 +93,20 @@ private:
     uint32_t              dci_pos_idx = 0;
     srsran_dci_location_t dci_pos     = {0, 0};
     /// Accumulation of all PDCCH masks for the current solution (DFS path)
-    coreset_bitmap total_mask, current_mask;
+    coreset_bitmap total_mask;
   };
   using alloc_tree_dfs_t = std::vector<tree_node>;
   alloc_tree_dfs_t dfs_tree, saved_dfs_tree;
 
+  uint32_t nof_alloc_cces = 0; ///< Sum of the CCEs occupied by the allocations in dci_list
+  /// Candidate tables for which an allocation failed after an exhaustive search. Given that the CORESET only gets
+  /// fuller during the slot, a request with the same candidates is bound to fail again
+  srsran::bounded_vector<srsran::span<const uint32_t>, 2 * MAX_GRANTS> failed_cce_locs;
+  uint32_t nof_search_nodes = 0; ///< DFS nodes visited by the ongoing/last alloc_pdcch call
+
   srsran::span<const uint32_t> get_cce_loc_table(const alloc_record& record) const;
+  bool                         is_known_failure(srsran::span<const uint32_t> cce_locs) const;
+  bool                         search_budget_exceeded() const;
   bool                         alloc_dfs_node(const alloc_record& record, uint32_t dci_idx);
   bool                         get_next_dfs();
 };
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_TIME_PF_H
+#define SRSRAN_SCHED_NR_TIME_PF_H
+
+#include "sched_nr_time_rr.h"
+#include "srsenb/hdr/common/common_enb.h"
+#include "srsran/adt/circular_map.h"
+#include "srsran/adt/indexed_heap.h"
+#include "srsran/mac/pf_metric.h"
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/**
+ * Proportional fair scheduler with QoS weights. The UEs with pending retxs go first, then the UEs whose GBR bearers
+ * are below their prioritised bit rate, and finally the remaining UEs in the order of their weighted PF metric, until
+ * there are no PRBs left. Several UEs can be allocated in the same slot.
+ */
+class sched_nr_time_pf : public sched_nr_base
+{
+public:
+  explicit sched_nr_time_pf(const bwp_params_t& bwp_cfg_);
+
+  void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+  void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+
+private:
+  struct ue_ctxt {
+    ue_ctxt(uint16_t rnti_, uint32_t id_, float fairness_coeff_, uint64_t now) :
+      rnti(rnti_), id(id_), dl(fairness_coeff_, now), ul(fairness_coeff_, now)
+    {}
+    void new_slot(const bwp_params_t& bwp_cfg, const slot_ue& ue, slot_point slot_rx, uint64_t now);
+
+    const uint16_t rnti;
+    const uint32_t id; ///< index in the priority heaps
+
+    bool     dl_retx        = false;
+    bool     ul_retx        = false;
+    bool     dl_key_changed = false;
+    bool     ul_key_changed = false;
+    uint64_t dl_visit_slot  = UINT64_MAX;
+    uint64_t ul_visit_slot  = UINT64_MAX;
+    float    dl_se          = 0;  ///< spectral efficiency of a DL newtx, in bits per RE
+    float    ul_se          = 0;  ///< spectral efficiency of an UL newtx, in bits per RE
+    int      prio           = -1; ///< priority of the highest priority DRB (1 is highest)
+    float    gbr            = 0;  ///< sum of the prioritised bit rates of the DRBs, in bytes per slot
+
+    srsran::pf_metric dl;
+    srsran::pf_metric ul;
+  };
+
+  void new_slot(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc);
+
+  uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, slot_ue& ue, bwp_slot_allocator& slot_alloc);
+  uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, slot_ue& ue, bwp_slot_allocator& slot_alloc);
+
+  const bwp_params_t* bwp_cfg        = nullptr;
+  float               fairness_coeff = 1;
+
+  slot_point current_slot;
+  uint64_t   slot_count = 0; ///< slots elapsed since the scheduler was created
+
+  rnti_map_t<ue_ctxt>   ue_history_db;
+  std::vector<ue_ctxt*> ue_by_id;
+  std::vector<uint32_t> free_ids;
+
+  // UEs with new transmissions ordered by PF key, the retransmissions and the GBR UEs go first
+  srsran::indexed_heap<double> dl_heap;
+  srsran::indexed_heap<double> ul_heap;
+  std::vector<ue_ctxt*>        dl_retx_list;
+  std::vector<ue_ctxt*>        ul_retx_list;
+  std::vector<ue_ctxt*>        gbr_list;
+
+  std::vector<std::pair<ue_ctxt*, uint32_t> > slot_allocs;
+};
+
+} // namespace sched_nr_impl
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_TIME_PF_H
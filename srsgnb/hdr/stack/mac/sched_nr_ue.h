@@ -63,9 +63,13 @@ public:
   struct ce_t {
     uint32_t lcid;
     uint32_t cc;
+    bool     allocated = false; ///< set by the carrier that allocated it, removed at the next slot
   };
   srsran::deque<ce_t> pending_ces;
 
+  /// Remove the CEs that were allocated by the UE carriers in the previous slot
+  void clear_allocated_ces();
+
   /// Protected, thread-safe interface of "ue_buffer_manager" for "slot_ue"
   struct pdu_builder {
     pdu_builder() = default;
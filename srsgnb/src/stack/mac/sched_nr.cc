@@ -26,6 +26,7 @@
 #include "srsgnb/hdr/stack/mac/sched_nr_worker.h"
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/string_helpers.h"
+#include "srsran/adt/mpsc_queue.h"
 #include "srsran/common/thread_pool.h"
 
 namespace srsenb {
@@ -80,7 +81,9 @@ public:
   };
 
   explicit event_manager(sched_params_t& params) :
-    sched_logger(srslog::fetch_basic_logger(params.sched_cfg.logger_name)), carriers(params.cells.size())
+    sched_logger(srslog::fetch_basic_logger(params.sched_cfg.logger_name)),
+    carriers(params.cells.size()),
+    carrier_ue_events(params.cells.size())
   {
   }
 
@@ -101,6 +104,7 @@ public:
   }
 
   /// Enqueue feedback directed at a given UE in a given cell (e.g. ACKs, CQI)
+  /// Note: the PHY threads push cell feedback without locking, as the cells may be scheduled in parallel
   void enqueue_ue_cc_feedback(const char*                                       event_name,
                               uint16_t                                          rnti,
                               uint32_t                                          cc,
@@ -108,8 +112,7 @@ public:
   {
     srsran_assert(rnti != SRSRAN_INVALID_RNTI, "Invalid rnti=0x%x passed to event manager", rnti);
     srsran_assert(cc < carriers.size(), "Invalid cc=%d passed to event manager", cc);
-    std::lock_guard<std::mutex> lock(carriers[cc].event_cc_mutex);
-    carriers[cc].next_slot_ue_events.emplace_back(rnti, cc, event_name, std::move(callback));
+    carriers[cc].emplace(rnti, cc, event_name, std::move(callback));
   }
 
   /// Process all events that are not specific to a carrier or that are directed at CA-enabled UEs
@@ -132,15 +135,17 @@ public:
       ev.callback(evlogger);
     }
 
+    // The events of non-CA UEs are handed to their carrier here, before the carrier workers start, so that each worker
+    // only accesses its own list
     for (ue_event_t& ev : current_slot_ue_events) {
       auto ue_it = ues.find(ev.rnti);
       if (ue_it == ues.end()) {
         sched_logger.warning("SCHED: \"%s\" called for unknown rnti=0x%x.", ev.event_name, ev.rnti);
-        ev.rnti = SRSRAN_INVALID_RNTI;
       } else if (ue_it->second->has_ca()) {
         // events specific to existing UEs with CA
         ev.callback(*ue_it->second, evlogger);
-        ev.rnti = SRSRAN_INVALID_RNTI;
+      } else if (ue_it->second->carriers[ue_it->second->pcell_cc()] != nullptr) {
+        carrier_ue_events[ue_it->second->pcell_cc()].push_back(std::move(ev));
       }
     }
   }
@@ -150,35 +155,24 @@ public:
   {
     logger evlogger(cc, sched_logger);
 
-    {
-      carriers[cc].current_slot_ue_events.clear();
-      std::lock_guard<std::mutex> lock(carriers[cc].event_cc_mutex);
-      carriers[cc].current_slot_ue_events.swap(carriers[cc].next_slot_ue_events);
-    }
-
-    for (ue_event_t& ev : current_slot_ue_events) {
-      if (ev.rnti == SRSRAN_INVALID_RNTI) {
-        // events already processed
-        continue;
-      }
+    for (ue_event_t& ev : carrier_ue_events[cc]) {
       auto ue_it = ues.find(ev.rnti);
       if (ue_it == ues.end()) {
         sched_logger.warning("SCHED: \"%s\" called for unknown rnti=0x%x.", ev.event_name, ev.rnti);
-        ev.rnti = SRSRAN_INVALID_RNTI;
-      } else if (not ue_it->second->has_ca() and ue_it->second->carriers[cc] != nullptr) {
+      } else {
         ev.callback(*ue_it->second, evlogger);
-        ev.rnti = SRSRAN_INVALID_RNTI;
       }
     }
+    carrier_ue_events[cc].clear();
 
-    for (ue_cc_event_t& ev : carriers[cc].current_slot_ue_events) {
+    carriers[cc].pop_all([this, &ues, &evlogger, cc](ue_cc_event_t& ev) {
       auto ue_it = ues.find(ev.rnti);
       if (ue_it != ues.end() and ue_it->second->carriers[cc] != nullptr) {
         ev.callback(*ue_it->second->carriers[cc], evlogger);
       } else {
         sched_logger.warning("SCHED: \"%s\" called for unknown rnti=0x%x,cc=%d.", ev.event_name, ev.rnti, ev.cc);
       }
-    }
+    });
   }
 
 private:
@@ -218,11 +212,10 @@ private:
   std::mutex             event_mutex;
   std::deque<event_t>    next_slot_events, current_slot_events;
   std::deque<ue_event_t> next_slot_ue_events, current_slot_ue_events;
-  struct cc_events {
-    std::mutex                   event_cc_mutex;
-    srsran::deque<ue_cc_event_t> next_slot_ue_events, current_slot_ue_events;
-  };
-  std::vector<cc_events> carriers;
+  std::vector<srsran::mpsc_queue<ue_cc_event_t> > carriers;
+  /// Events of non-CA UEs of the current slot, per carrier. Only filled by process_common() before the carrier workers
+  /// run, and only accessed by the worker of the carrier afterwards
+  std::vector<std::deque<ue_event_t> > carrier_ue_events;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -302,6 +295,9 @@ sched_nr::~sched_nr()
 void sched_nr::stop()
 {
   metrics_handler->stop();
+  if (cc_thread_pool != nullptr) {
+    cc_thread_pool->stop();
+  }
 }
 
 int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_cell_cfg_t> cell_list)
@@ -326,6 +322,13 @@ int sched_nr::config(const sched_args_t& sched_cfg, srsran::const_span<sched_nr_
     cc_workers[cc].reset(new slot_cc_worker{cfg.cells[cc]});
   }
 
+  // Initiate threads that generate the cell results in parallel
+  cc_results.reset(new cc_slot_result[cfg.cells.size()]);
+  if (cfg.sched_cfg.nof_cc_workers > 0 and cfg.cells.size() > 1) {
+    cc_thread_pool.reset(
+        new srsran::task_thread_pool{std::min(cfg.sched_cfg.nof_cc_workers, (uint32_t)cfg.cells.size())});
+  }
+
   return SRSRAN_SUCCESS;
 }
 
@@ -390,6 +393,17 @@ void sched_nr::slot_indication(slot_point slot_tx)
 
   // If UE metrics were externally requested, store the current UE state
   metrics_handler->save_metrics();
+
+  // Generate the results of all cells in parallel. get_dl_sched(slot, cc) only waits for the respective cell
+  if (cc_thread_pool != nullptr) {
+    for (uint32_t cc = 0; cc < cfg.cells.size(); ++cc) {
+      cc_results[cc].done.store(0);
+      cc_thread_pool->push_task([this, cc]() {
+        cc_results[cc].dl_res = generate_cc_result(cc);
+        cc_results[cc].done.store(1);
+      });
+    }
+  }
 }
 
 /// Generate {pdcch_slot,cc} scheduling decision
@@ -397,19 +411,15 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
 {
   srsran_assert(pdsch_tti == current_slot_tx, "Unexpected pdsch_tti slot received");
 
-  // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for non-CA UEs
-  pending_events->process_cc_events(ue_db, cc);
-
-  // prepare non-CA UEs internal state for new slot
-  for (auto& u : ue_db) {
-    if (not u.second->has_ca() and u.second->carriers[cc] != nullptr) {
-      u.second->new_slot(current_slot_tx);
-    }
+  sched_nr::dl_res_t* ret;
+  if (cc_thread_pool != nullptr) {
+    // Wait for the cell worker thread to finish
+    cc_results[cc].done.wait_while(0);
+    ret = cc_results[cc].dl_res;
+  } else {
+    ret = generate_cc_result(cc);
   }
 
-  // Process pending CC-specific feedback, generate {slot_idx,cc} scheduling decision
-  sched_nr::dl_res_t* ret = cc_workers[cc]->run_slot(pdsch_tti, ue_db);
-
   // decrement the number of active workers
   int rem_workers = worker_count.fetch_sub(1, std::memory_order_release) - 1;
   srsran_assert(rem_workers >= 0, "invalid number of calls to get_dl_sched(slot, cc)");
@@ -421,6 +431,22 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
   return ret;
 }
 
+sched_nr::dl_res_t* sched_nr::generate_cc_result(uint32_t cc)
+{
+  // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for non-CA UEs
+  pending_events->process_cc_events(ue_db, cc);
+
+  // prepare non-CA UEs internal state for new slot
+  for (auto& u : ue_db) {
+    if (not u.second->has_ca() and u.second->carriers[cc] != nullptr) {
+      u.second->new_slot(current_slot_tx);
+    }
+  }
+
+  // Process pending CC-specific feedback, generate {slot_idx,cc} scheduling decision
+  return cc_workers[cc]->run_slot(current_slot_tx, ue_db);
+}
+
 /// Fetch {ul_slot,cc} UL scheduling decision
 sched_nr::ul_res_t* sched_nr::get_ul_sched(slot_point slot_ul, uint32_t cc)
 {
@@ -70,6 +70,8 @@ coreset_region::coreset_region(const bwp_params_t& bwp_cfg_, uint32_t coreset_id
   coreset_cfg(&bwp_cfg_.cfg.pdcch.coreset[coreset_id_]),
   coreset_id(coreset_id_),
   slot_idx(slot_idx_),
+  max_search_nodes(bwp_cfg_.sched_cfg.max_pdcch_search_nodes),
+  logger(bwp_cfg_.logger),
   rar_cce_list(bwp_cfg_.rar_cce_list),
   common_cce_list(bwp_cfg_.common_cce_list)
 {
@@ -89,6 +91,21 @@ void coreset_region::reset()
   dfs_tree.clear();
   saved_dfs_tree.clear();
   dci_list.clear();
+  failed_cce_locs.clear();
+  nof_alloc_cces   = 0;
+  nof_search_nodes = 0;
+}
+
+bool coreset_region::is_known_failure(srsran::span<const uint32_t> cce_locs) const
+{
+  return std::any_of(failed_cce_locs.begin(), failed_cce_locs.end(), [cce_locs](srsran::span<const uint32_t> locs) {
+    return locs.data() == cce_locs.data() and locs.size() == cce_locs.size();
+  });
+}
+
+bool coreset_region::search_budget_exceeded() const
+{
+  return max_search_nodes > 0 and nof_search_nodes >= max_search_nodes;
 }
 
 bool coreset_region::alloc_pdcch(srsran_rnti_type_t         rnti_type,
@@ -99,6 +116,7 @@ bool coreset_region::alloc_pdcch(srsran_rnti_type_t         rnti_type,
                                  srsran_dci_ctx_t&          dci)
 {
   saved_dfs_tree.clear();
+  nof_search_nodes = 0;
 
   alloc_record record;
   record.dci            = &dci;
@@ -108,13 +126,21 @@ bool coreset_region::alloc_pdcch(srsran_rnti_type_t         rnti_type,
   record.is_dl          = is_dl;
   record.dci->rnti_type = rnti_type;
 
+  // The CCEs occupied by the allocations do not depend on their positions. If they do not fit in the CORESET, no
+  // permutation of the DCI positions will make room for the new allocation
+  srsran::span<const uint32_t> cce_locs = get_cce_loc_table(record);
+  if (nof_alloc_cces + (1U << aggr_idx) > nof_cces() or is_known_failure(cce_locs)) {
+    return false;
+  }
+
   // Try to allocate grant. If it fails, attempt the same grant, but using a different permutation of past grant DCI
-  // positions
+  // positions. The number of visited DFS nodes is capped, to bound the worst-case PDCCH allocation time
   do {
-    bool success = alloc_dfs_node(record, 0);
+    bool success = not search_budget_exceeded() and alloc_dfs_node(record, 0);
     if (success) {
       // DCI record allocation successful
       dci_list.push_back(record);
+      nof_alloc_cces += 1U << aggr_idx;
       return true;
     }
     if (saved_dfs_tree.empty()) {
@@ -122,8 +148,18 @@ bool coreset_region::alloc_pdcch(srsran_rnti_type_t         rnti_type,
     }
   } while (get_next_dfs());
 
-  // Revert steps to initial state, before dci record allocation was attempted
+  if (search_budget_exceeded()) {
+    logger.debug("SCHED: PDCCH allocation search in CORESET#%d interrupted after %d nodes", coreset_id, nof_search_nodes);
+  } else if (not failed_cce_locs.full()) {
+    failed_cce_locs.push_back(cce_locs);
+  }
+
+  // Revert steps to initial state, before dci record allocation was attempted. The DCI positions of the past grants
+  // were overwritten while exploring other permutations
   dfs_tree.swap(saved_dfs_tree);
+  for (uint32_t i = 0; i < dfs_tree.size(); ++i) {
+    dci_list[i].dci->location = dfs_tree[i].dci_pos;
+  }
   return false;
 }
 
@@ -133,20 +169,25 @@ void coreset_region::rem_last_pdcch()
 
   // Remove DCI record
   dfs_tree.pop_back();
+  nof_alloc_cces -= 1U << dci_list.back().aggr_idx;
   dci_list.pop_back();
+
+  // The CORESET got emptier, so previously failed allocations may now succeed
+  failed_cce_locs.clear();
 }
 
 bool coreset_region::get_next_dfs()
 {
   do {
-    if (dfs_tree.empty()) {
-      // If we reach root, the allocation failed
+    if (dfs_tree.empty() or search_budget_exceeded()) {
+      // If we reach root or the search budget is exhausted, the allocation failed
       return false;
     }
     // Attempt to re-add last tree node, but with a higher node child index
     uint32_t start_child_idx = dfs_tree.back().dci_pos_idx + 1;
     dfs_tree.pop_back();
-    while (dfs_tree.size() < dci_list.size() and alloc_dfs_node(dci_list[dfs_tree.size()], start_child_idx)) {
+    while (dfs_tree.size() < dci_list.size() and not search_budget_exceeded() and
+           alloc_dfs_node(dci_list[dfs_tree.size()], start_child_idx)) {
       start_child_idx = 0;
     }
   } while (dfs_tree.size() < dci_list.size());
@@ -163,12 +204,12 @@ bool coreset_region::alloc_dfs_node(const alloc_record& record, uint32_t start_d
   if (start_dci_idx >= cce_locs.size()) {
     return false;
   }
+  nof_search_nodes++;
 
   tree_node node;
   node.dci_pos_idx = start_dci_idx;
   node.dci_pos.L   = record.aggr_idx;
   node.rnti        = record.ue != nullptr ? record.ue->rnti : SRSRAN_INVALID_RNTI;
-  node.current_mask.resize(nof_cces());
   // get cumulative pdcch bitmap
   if (not alloc_dfs.empty()) {
     node.total_mask = alloc_dfs.back().total_mask;
@@ -179,15 +220,14 @@ bool coreset_region::alloc_dfs_node(const alloc_record& record, uint32_t start_d
   for (; node.dci_pos_idx < cce_locs.size(); ++node.dci_pos_idx) {
     node.dci_pos.ncce = cce_locs[node.dci_pos_idx];
 
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
+    // Note: the collision check is done directly on the accumulated mask, without building a mask per candidate
+    if (node.total_mask.any(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx))) {
       // there is a PDCCH collision. Try another CCE position
       continue;
     }
 
     // Allocation successful
-    node.total_mask |= node.current_mask;
+    node.total_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
     alloc_dfs.push_back(node);
     record.dci->location = node.dci_pos;
     return true;
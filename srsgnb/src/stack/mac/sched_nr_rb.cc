@@ -76,15 +76,17 @@ uint32_t bwp_rb_bitmap::prb_to_rbg_idx(uint32_t prb_idx) const
 
 void bwp_rb_bitmap::add_prbs_to_rbgs(const prb_bitmap& grant)
 {
+  // Each contiguous run of PRBs is converted to RBGs at once
   int idx = 0;
   do {
     idx = grant.find_lowest(idx, grant.size(), true);
     if (idx < 0) {
       return;
     }
-    uint32_t rbg_idx = prb_to_rbg_idx(idx);
-    rbgs_.set(rbg_idx, true);
-    idx++;
+    int stop = grant.find_lowest(idx + 1, grant.size(), false);
+    stop     = stop < 0 ? grant.size() : stop;
+    add_prbs_to_rbgs(prb_interval{(uint32_t)idx, (uint32_t)stop});
+    idx = stop;
   } while (idx != (int)prbs_.size());
 }
 
@@ -0,0 +1,366 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/mac/sched_nr_time_pf.h"
+#include "srsran/common/common_nr.h"
+#include "srsran/phy/phch/ra_nr.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/// Approximate number of data bytes of a PRB in a slot per bit/RE of spectral efficiency (12 subcarriers x 12 symbols)
+static const float bytes_per_prb_x_se = 18;
+
+/// Spectral efficiency (bits per RE) of a new transmission of the UE, derived from the fixed MCS or the CQI
+static float get_newtx_spectral_eff(const slot_ue& ue, bool is_dl)
+{
+  int fixed_mcs = is_dl ? ue->fixed_pdsch_mcs() : ue->fixed_pusch_mcs();
+  if (fixed_mcs >= 0) {
+    const srsran_sch_hl_cfg_nr_t& sch     = is_dl ? ue->phy().pdsch : ue->phy().pusch;
+    srsran_dci_format_nr_t        dci_fmt = is_dl ? srsran_dci_format_nr_1_0 : srsran_dci_format_nr_0_0;
+    double                        R       = srsran_ra_nr_R_from_mcs(
+        sch.mcs_table, dci_fmt, srsran_search_space_type_ue, srsran_rnti_type_c, fixed_mcs);
+    srsran_mod_t mod = srsran_ra_nr_mod_from_mcs(
+        sch.mcs_table, dci_fmt, srsran_search_space_type_ue, srsran_rnti_type_c, fixed_mcs);
+    if (std::isnan(R) or mod == SRSRAN_MOD_NITEMS) {
+      return 0;
+    }
+    return R * srsran_mod_bits_x_symbol(mod);
+  }
+  uint32_t cqi = std::max(is_dl ? ue.dl_cqi() : ue.ul_cqi(), 1U);
+  double   se  = srsran_ra_nr_cqi_to_se(cqi, ue->phy().csi.reports[0].cqi_table);
+  return se < 0 ? 0 : se;
+}
+
+/// Number of PRBs required to transmit the pending bytes with the given spectral efficiency
+static uint32_t get_required_prbs(uint32_t pending_bytes, float spectral_eff, uint32_t max_prbs)
+{
+  if (spectral_eff <= 0) {
+    return max_prbs;
+  }
+  auto nof_prbs = static_cast<uint32_t>(std::ceil(pending_bytes / (spectral_eff * bytes_per_prb_x_se)));
+  return std::min(std::max(nof_prbs, 1U), max_prbs);
+}
+
+sched_nr_time_pf::sched_nr_time_pf(const bwp_params_t& bwp_cfg_) :
+  bwp_cfg(&bwp_cfg_), ue_by_id(SRSENB_MAX_UES, nullptr), dl_heap(SRSENB_MAX_UES), ul_heap(SRSENB_MAX_UES)
+{
+  if (not bwp_cfg->sched_cfg.policy_args.empty()) {
+    fairness_coeff = std::stof(bwp_cfg->sched_cfg.policy_args);
+  }
+
+  free_ids.reserve(SRSENB_MAX_UES);
+  for (uint32_t i = SRSENB_MAX_UES; i > 0; --i) {
+    free_ids.push_back(i - 1);
+  }
+  dl_retx_list.reserve(SRSENB_MAX_UES);
+  ul_retx_list.reserve(SRSENB_MAX_UES);
+  gbr_list.reserve(SRSENB_MAX_UES);
+  slot_allocs.reserve(SRSENB_MAX_UES);
+}
+
+void sched_nr_time_pf::new_slot(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  slot_point pdcch_slot = slot_alloc.get_pdcch_tti();
+  if (current_slot.valid() and pdcch_slot > current_slot) {
+    slot_count += pdcch_slot - current_slot;
+  }
+  current_slot = pdcch_slot;
+
+  // remove deleted users from history
+  for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
+    if (not ue_db.contains(it->first)) {
+      uint32_t id = it->second.id;
+      dl_heap.erase(id);
+      ul_heap.erase(id);
+      ue_by_id[id] = nullptr;
+      free_ids.push_back(id);
+      it = ue_history_db.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // add new users to history db, and update the priorities that changed
+  dl_retx_list.clear();
+  ul_retx_list.clear();
+  for (auto& u : ue_db) {
+    auto it = ue_history_db.find(u.first);
+    if (it == ue_history_db.end()) {
+      uint32_t id = free_ids.back();
+      free_ids.pop_back();
+      it           = ue_history_db.insert(u.first, ue_ctxt{u.first, id, fairness_coeff, slot_count}).value();
+      ue_by_id[id] = &it->second;
+    }
+    ue_ctxt& ue = it->second;
+    ue.new_slot(*bwp_cfg, u.second, slot_alloc.get_tti_rx(), slot_count);
+    if (ue.dl_key_changed) {
+      dl_heap.set(ue.id, ue.dl.key());
+    }
+    if (ue.ul_key_changed) {
+      ul_heap.set(ue.id, ue.ul.key());
+    }
+    if (ue.dl_retx) {
+      dl_retx_list.push_back(&ue);
+    }
+    if (ue.ul_retx) {
+      ul_retx_list.push_back(&ue);
+    }
+  }
+
+  auto dl_prio_cmp = [](const ue_ctxt* lhs, const ue_ctxt* rhs) { return lhs->dl.key() > rhs->dl.key(); };
+  std::sort(dl_retx_list.begin(), dl_retx_list.end(), dl_prio_cmp);
+  auto ul_prio_cmp = [](const ue_ctxt* lhs, const ue_ctxt* rhs) { return lhs->ul.key() > rhs->ul.key(); };
+  std::sort(ul_retx_list.begin(), ul_retx_list.end(), ul_prio_cmp);
+}
+
+/*****************************************************************
+ *                         Downlink
+ *****************************************************************/
+
+void sched_nr_time_pf::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  if (current_slot != slot_alloc.get_pdcch_tti()) {
+    new_slot(ue_db, slot_alloc);
+  }
+
+  // Retransmissions first
+  slot_allocs.clear();
+  for (ue_ctxt* ue : dl_retx_list) {
+    slot_allocs.emplace_back(ue, try_dl_alloc(*ue, ue_db[ue->rnti], slot_alloc));
+  }
+
+  // UEs below their prioritised bit rate, the most starved first
+  gbr_list.clear();
+  for (auto& u : ue_history_db) {
+    ue_ctxt& ue = u.second;
+    if (not ue.dl_retx and ue.gbr > 0 and ue.dl.avg_rate(slot_count) < ue.gbr) {
+      gbr_list.push_back(&ue);
+    }
+  }
+  std::sort(gbr_list.begin(), gbr_list.end(), [this](const ue_ctxt* lhs, const ue_ctxt* rhs) {
+    return lhs->dl.avg_rate(slot_count) / lhs->gbr < rhs->dl.avg_rate(slot_count) / rhs->gbr;
+  });
+  for (ue_ctxt* ue : gbr_list) {
+    ue->dl_visit_slot = slot_count;
+    slot_allocs.emplace_back(ue, try_dl_alloc(*ue, ue_db[ue->rnti], slot_alloc));
+  }
+
+  // New transmissions in PF order, until there are no PRBs left
+  dl_heap.visit_in_order([this, &ue_db, &slot_alloc](uint32_t id) {
+    ue_ctxt& ue = *ue_by_id[id];
+    if (ue.dl_retx or ue.dl_visit_slot == slot_count) {
+      return true;
+    }
+    slot_ue& u = ue_db[ue.rnti];
+    if (u.dl_bytes == 0 or u.h_dl == nullptr) {
+      return true;
+    }
+    int ss_id = u->find_ss_id(srsran_dci_format_nr_1_0);
+    if (ss_id >= 0 and slot_alloc.occupied_dl_prbs(u.pdsch_slot, ss_id, srsran_dci_format_nr_1_0).all()) {
+      return false;
+    }
+    slot_allocs.emplace_back(&ue, try_dl_alloc(ue, u, slot_alloc));
+    return true;
+  });
+
+  // NOTE: The UEs without allocation keep their key, their average rate decays like all the others
+  for (const auto& alloc : slot_allocs) {
+    if (alloc.second > 0) {
+      alloc.first->dl.save_alloc(alloc.second, slot_count);
+      dl_heap.set(alloc.first->id, alloc.first->dl.key());
+    }
+  }
+}
+
+uint32_t sched_nr_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, slot_ue& ue, bwp_slot_allocator& slot_alloc)
+{
+  if (ue.h_dl == nullptr) {
+    return 0;
+  }
+  int ss_id = ue->find_ss_id(srsran_dci_format_nr_1_0);
+  if (ss_id < 0) {
+    return 0;
+  }
+
+  alloc_result code;
+  if (ue_ctxt.dl_retx) {
+    code = slot_alloc.alloc_pdsch(ue, ss_id, ue.h_dl->prbs());
+  } else {
+    if (ue.dl_bytes == 0 or not ue.h_dl->empty()) {
+      return 0;
+    }
+    prb_bitmap   used_prbs = slot_alloc.occupied_dl_prbs(ue.pdsch_slot, ss_id, srsran_dci_format_nr_1_0);
+    uint32_t     nof_prbs  = get_required_prbs(ue.dl_bytes, ue_ctxt.dl_se, used_prbs.size());
+    prb_interval prbs      = find_empty_interval_of_length(used_prbs, nof_prbs);
+    if (prbs.empty()) {
+      return 0;
+    }
+    code = slot_alloc.alloc_pdsch(ue, ss_id, prbs);
+  }
+  // NOTE: The HARQ TBS is in bits
+  return code == alloc_result::success ? ue.h_dl->tbs() / 8 : 0;
+}
+
+/*****************************************************************
+ *                         Uplink
+ *****************************************************************/
+
+void sched_nr_time_pf::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  if (current_slot != slot_alloc.get_pdcch_tti()) {
+    new_slot(ue_db, slot_alloc);
+  }
+
+  // Retransmissions first
+  slot_allocs.clear();
+  for (ue_ctxt* ue : ul_retx_list) {
+    slot_allocs.emplace_back(ue, try_ul_alloc(*ue, ue_db[ue->rnti], slot_alloc));
+  }
+
+  // UEs below their prioritised bit rate, the most starved first
+  gbr_list.clear();
+  for (auto& u : ue_history_db) {
+    ue_ctxt& ue = u.second;
+    if (not ue.ul_retx and ue.gbr > 0 and ue.ul.avg_rate(slot_count) < ue.gbr) {
+      gbr_list.push_back(&ue);
+    }
+  }
+  std::sort(gbr_list.begin(), gbr_list.end(), [this](const ue_ctxt* lhs, const ue_ctxt* rhs) {
+    return lhs->ul.avg_rate(slot_count) / lhs->gbr < rhs->ul.avg_rate(slot_count) / rhs->gbr;
+  });
+  for (ue_ctxt* ue : gbr_list) {
+    ue->ul_visit_slot = slot_count;
+    slot_allocs.emplace_back(ue, try_ul_alloc(*ue, ue_db[ue->rnti], slot_alloc));
+  }
+
+  // New transmissions in PF order, until there are no PRBs left
+  ul_heap.visit_in_order([this, &ue_db, &slot_alloc](uint32_t id) {
+    ue_ctxt& ue = *ue_by_id[id];
+    if (ue.ul_retx or ue.ul_visit_slot == slot_count) {
+      return true;
+    }
+    slot_ue& u = ue_db[ue.rnti];
+    if (u.ul_bytes == 0 or u.h_ul == nullptr) {
+      return true;
+    }
+    if (slot_alloc.occupied_ul_prbs(u.pusch_slot).all()) {
+      return false;
+    }
+    slot_allocs.emplace_back(&ue, try_ul_alloc(ue, u, slot_alloc));
+    return true;
+  });
+
+  for (const auto& alloc : slot_allocs) {
+    if (alloc.second > 0) {
+      alloc.first->ul.save_alloc(alloc.second, slot_count);
+      ul_heap.set(alloc.first->id, alloc.first->ul.key());
+    }
+  }
+}
+
+uint32_t sched_nr_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, slot_ue& ue, bwp_slot_allocator& slot_alloc)
+{
+  if (ue.h_ul == nullptr) {
+    return 0;
+  }
+
+  alloc_result code;
+  if (ue_ctxt.ul_retx) {
+    code = slot_alloc.alloc_pusch(ue, ue.h_ul->prbs());
+  } else {
+    if (ue.ul_bytes == 0 or not ue.h_ul->empty()) {
+      return 0;
+    }
+    const prb_bitmap& used_prbs = slot_alloc.occupied_ul_prbs(ue.pusch_slot);
+    uint32_t          nof_prbs  = get_required_prbs(ue.ul_bytes, ue_ctxt.ul_se, used_prbs.size());
+    prb_interval      prbs      = find_empty_interval_of_length(used_prbs, nof_prbs);
+    if (prbs.empty()) {
+      return 0;
+    }
+    code = slot_alloc.alloc_pusch(ue, prbs);
+  }
+  // NOTE: The HARQ TBS is in bits
+  return code == alloc_result::success ? ue.h_ul->tbs() / 8 : 0;
+}
+
+/*****************************************************************
+ *                          UE history
+ *****************************************************************/
+
+void sched_nr_time_pf::ue_ctxt::new_slot(const bwp_params_t& bwp_cfg,
+                                         const slot_ue&      ue,
+                                         slot_point          slot_rx,
+                                         uint64_t            now)
+{
+  dl_retx        = ue.h_dl != nullptr and ue.h_dl->has_pending_retx(slot_rx);
+  ul_retx        = ue.h_ul != nullptr and ue.h_ul->has_pending_retx(slot_rx);
+  dl_key_changed = false;
+  ul_key_changed = false;
+
+  // QoS parameters of the DRBs, read from the LCH priority and prioritised bit rate of their logical channel config
+  int      new_prio = -1;
+  uint32_t pbr_sum  = 0; // kBps
+  for (uint32_t lcid = srsran::MAX_NR_SRB_ID + 1; lcid < ue->ue_cfg().ue_bearers.size(); ++lcid) {
+    const mac_lc_ch_cfg_t& lch = ue->ue_cfg().ue_bearers[lcid];
+    if (not lch.is_active()) {
+      continue;
+    }
+    if (new_prio < 0 or lch.priority < new_prio) {
+      new_prio = lch.priority;
+    }
+    if (lch.pbr > 0 and lch.pbr != std::numeric_limits<uint32_t>::max()) {
+      pbr_sum += lch.pbr;
+    }
+  }
+  gbr = static_cast<float>(pbr_sum) / (1U << bwp_cfg.cfg.numerology_idx);
+
+  // Update the priorities, the expected rates are only derived again when the MCS, CQI or QoS weight change
+  float new_dl_se = get_newtx_spectral_eff(ue, true);
+  float new_ul_se = get_newtx_spectral_eff(ue, false);
+  if (new_prio != prio or new_dl_se != dl_se or new_ul_se != ul_se) {
+    prio  = new_prio;
+    dl_se = new_dl_se;
+    ul_se = new_ul_se;
+    // LCH priorities go from 1 (highest) to 16
+    float weight   = prio < 0 ? 1 : std::max(17 - prio, 1);
+    float max_rate = bytes_per_prb_x_se * bwp_cfg.cfg.rb_width;
+    dl.set_expected_rate(dl_se * max_rate, now, weight);
+    ul.set_expected_rate(ul_se * max_rate, now, weight);
+    dl_key_changed = true;
+    ul_key_changed = true;
+    return;
+  }
+  if (dl.needs_refresh(now)) {
+    dl.refresh_key(now);
+    dl_key_changed = true;
+  }
+  if (ul.needs_refresh(now)) {
+    ul.refresh_key(now);
+    ul_key_changed = true;
+  }
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
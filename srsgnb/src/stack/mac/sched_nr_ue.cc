@@ -23,6 +23,7 @@
 #include "srsgnb/hdr/stack/mac/sched_nr_helpers.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/mac/mac_sch_pdu_nr.h"
+#include <algorithm>
 
 namespace srsenb {
 namespace sched_nr_impl {
@@ -36,6 +37,12 @@ int ue_buffer_manager::get_dl_tx_total() const
   return total_bytes;
 }
 
+void ue_buffer_manager::clear_allocated_ces()
+{
+  pending_ces.erase(std::remove_if(pending_ces.begin(), pending_ces.end(), [](const ce_t& ce) { return ce.allocated; }),
+                    pending_ces.end());
+}
+
 /**
  * @brief Allocates LCIDs and update US buffer states depending on available resources and checks if there is SRB0/CCCH
  MAC PDU segmentation
@@ -48,17 +55,17 @@ int ue_buffer_manager::get_dl_tx_total() const
 bool ue_buffer_manager::pdu_builder::alloc_subpdus(uint32_t rem_bytes, sched_nr_interface::dl_pdu_t& pdu)
 {
   // First step: allocate MAC CEs until resources allow
-  srsran::deque<ce_t> restore_ces;
-  for (ce_t ce : parent->pending_ces) {
-    if (ce.cc == cc) {
-      // Note: This check also avoids thread collisions across UE carriers
+  // Note: The CEs are only marked as allocated, as the UE carriers may be scheduled in parallel. The deque is only
+  //       modified at the slot boundary (see ue::new_slot)
+  for (ce_t& ce : parent->pending_ces) {
+    if (ce.cc == cc and not ce.allocated) {
       uint32_t size_ce = srsran::mac_sch_subpdu_nr::sizeof_ce(ce.lcid, false);
       if (size_ce > rem_bytes) {
         break;
       }
       rem_bytes -= size_ce;
       pdu.subpdus.push_back(ce.lcid);
-      parent->pending_ces.pop_front();
+      ce.allocated = true;
     }
   }
 
@@ -218,6 +225,9 @@ void ue::new_slot(slot_point pdcch_slot)
 {
   last_tx_slot = pdcch_slot;
 
+  // Commit the CEs allocated by the UE carriers in the previous slot
+  buffers.clear_allocated_ces();
+
   for (std::unique_ptr<ue_carrier>& cc : carriers) {
     if (cc != nullptr) {
       cc->harq_ent.new_slot(pdcch_slot - TX_ENB_DELAY);
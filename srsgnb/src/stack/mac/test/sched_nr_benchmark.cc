@@ -0,0 +1,121 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsran/common/test_common.h"
+
+namespace srsenb {
+
+/// Records the latency of each slot, measured until the results of all cells are available
+class sched_nr_bench_tester : public sched_nr_base_test_bench
+{
+public:
+  using sched_nr_base_test_bench::sched_nr_base_test_bench;
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& slot_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    std::chrono::nanoseconds slot_latency{0};
+    for (const cc_result_t& cc_out : cc_list) {
+      slot_latency = std::max(slot_latency, cc_out.cc_latency_ns);
+      pdsch_count += cc_out.res.dl->phy.pdcch_dl.size();
+    }
+    // Skip the slots where the UEs are created and the scheduler pools are still being filled
+    if (++nof_slots > nof_warmup_slots) {
+      tot_latency_ns += slot_latency;
+      max_latency_ns = std::max(max_latency_ns, slot_latency);
+    }
+  }
+
+  std::chrono::nanoseconds tot_latency_ns{0};
+  std::chrono::nanoseconds max_latency_ns{0};
+  uint32_t                 nof_slots        = 0;
+  uint32_t                 pdsch_count      = 0;
+  const uint32_t           nof_warmup_slots = 100;
+};
+
+struct run_params {
+  uint32_t nof_cells;
+  uint32_t nof_ues;
+  uint32_t nof_cc_workers;
+  uint32_t nof_slots;
+};
+
+void run_sched_nr_benchmark(const run_params& params)
+{
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer = true;
+  cfg.nof_cc_workers     = params.nof_cc_workers;
+
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(params.nof_cells);
+  sched_nr_bench_tester            tester(cfg, cells_cfg, "Benchmark", 1);
+
+  for (uint32_t nof_slots = 0; nof_slots < params.nof_slots; ++nof_slots) {
+    slot_point slot_rx(0, nof_slots % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+    if (nof_slots == 9) {
+      // The UEs are configured with all cells as carriers
+      for (uint32_t i = 0; i < params.nof_ues; ++i) {
+        sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(params.nof_cells);
+        uecfg.lc_ch_to_add.emplace_back();
+        uecfg.lc_ch_to_add.back().lcid          = 1;
+        uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+        tester.user_cfg(0x4601 + i, uecfg);
+      }
+    }
+    tester.run_slot(slot_tx);
+  }
+  tester.stop();
+  TESTASSERT(tester.pdsch_count > 0);
+
+  uint32_t nof_measured_slots = std::max(tester.nof_slots, tester.nof_warmup_slots + 1) - tester.nof_warmup_slots;
+  double   avg_usec           = tester.tot_latency_ns.count() / 1000.0 / nof_measured_slots;
+  fmt::print("{:>6} {:>6} {:>12} {:>16.2f} {:>16.2f}\n",
+             params.nof_cells,
+             params.nof_ues,
+             params.nof_cc_workers,
+             avg_usec,
+             tester.max_latency_ns.count() / 1000.0);
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  srslog::fetch_basic_logger("TEST").set_level(srslog::basic_levels::warning);
+  srslog::fetch_basic_logger("MAC-NR").set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  uint32_t nof_slots = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000;
+
+  // Compare the slot latency when the cells are generated by the caller thread and by one thread per cell
+  fmt::print("{:>6} {:>6} {:>12} {:>16} {:>16}\n", "cells", "ues", "cc workers", "avg latency [us]", "max latency [us]");
+  for (uint32_t nof_cells : {1, 2, 4}) {
+    for (uint32_t nof_ues : {4, 16}) {
+      srsenb::run_sched_nr_benchmark({nof_cells, nof_ues, 0, nof_slots});
+      if (nof_cells > 1) {
+        srsenb::run_sched_nr_benchmark({nof_cells, nof_ues, nof_cells, nof_slots});
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
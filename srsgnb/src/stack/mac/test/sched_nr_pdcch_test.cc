@@ -300,6 +300,83 @@ void test_invalid_params()
   TESTASSERT(pdcch_sched.nof_allocations() == 1);
 }
 
+/**
+ * Test for the bound on the PDCCH allocation search.
+ * Many UEs with few candidates fill the CORESET, which forces the allocator to search for alternative DCI positions.
+ * The number of visited DFS nodes must stay within the configured budget, and allocations that cannot fit or that
+ * previously failed after an exhaustive search must be rejected without searching
+ */
+void test_pdcch_search_bound()
+{
+  const uint32_t aggr_idx = 0, nof_ues = 16;
+
+  srsran::test_delimit_logger delimiter{"Test PDCCH Allocation Search Bound"};
+
+  sched_nr_cell_cfg_t cell_cfg                   = get_default_sa_cell_cfg_common();
+  cell_cfg.bwps[0].pdcch.search_space_present[2] = true;
+  cell_cfg.bwps[0].pdcch.search_space[2]         = get_default_ue_specific_search_space(2, 2);
+  cell_cfg.bwps[0].pdcch.coreset_present[2]      = true;
+  cell_cfg.bwps[0].pdcch.coreset[2]              = get_default_ue_specific_coreset(2, cell_cfg.pci);
+
+  // UE config
+  ue_cfg_manager uecfg{get_rach_ue_cfg(0)};
+  uecfg.phy_cfg       = get_common_ue_phy_cfg(cell_cfg);
+  uecfg.phy_cfg.pdcch = cell_cfg.bwps[0].pdcch;
+
+  for (uint32_t max_nodes : {0U, 8U}) {
+    sched_nr_interface::sched_args_t sched_args;
+    sched_args.max_pdcch_search_nodes = max_nodes;
+    sched_nr_impl::cell_config_manager cellparams{0, cell_cfg, sched_args};
+    bwp_params_t&                      bwp_params = cellparams.bwps[0];
+
+    std::vector<ue_carrier_params_t> ues;
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      ues.emplace_back(0x46 + i, bwp_params, uecfg);
+    }
+
+    coreset_region                        coreset{bwp_params, 2, 0};
+    std::array<srsran_dci_ctx_t, nof_ues> dcis = {};
+    std::array<bool, nof_ues>             success;
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      success[i] = coreset.alloc_pdcch(srsran_rnti_type_c, true, aggr_idx, 2, &ues[i], dcis[i]);
+      if (max_nodes > 0) {
+        TESTASSERT(coreset.last_search_nof_nodes() <= max_nodes);
+      }
+    }
+    TESTASSERT(coreset.nof_allocs() > 0 and coreset.nof_allocs() <= coreset.nof_cces());
+    TESTASSERT_EQ(coreset.nof_allocs(), (size_t)std::count(success.begin(), success.end(), true));
+
+    // Verify there are no CCE collisions
+    coreset_bitmap total_mask(coreset.nof_cces());
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      if (success[i]) {
+        TESTASSERT(not total_mask.test(dcis[i].location.ncce));
+        total_mask.set(dcis[i].location.ncce);
+      }
+    }
+
+    if (max_nodes == 0) {
+      // Repeating an allocation that failed after an exhaustive search fails without searching
+      uint32_t ue_idx = std::find(success.begin(), success.end(), false) - success.begin();
+      TESTASSERT(ue_idx < nof_ues);
+      srsran_dci_ctx_t dci = {};
+      TESTASSERT(not coreset.alloc_pdcch(srsran_rnti_type_c, true, aggr_idx, 2, &ues[ue_idx], dci));
+      TESTASSERT_EQ(0, coreset.last_search_nof_nodes());
+    }
+
+    // Removing the last allocation makes room for a new one
+    coreset.rem_last_pdcch();
+    uint32_t nof_allocs = coreset.nof_allocs();
+    bool     realloc    = false;
+    for (uint32_t i = 0; i < nof_ues and not realloc; ++i) {
+      srsran_dci_ctx_t dci = {};
+      realloc              = coreset.alloc_pdcch(srsran_rnti_type_c, true, aggr_idx, 2, &ues[i], dci);
+    }
+    TESTASSERT(realloc);
+    TESTASSERT_EQ(nof_allocs + 1, coreset.nof_allocs());
+  }
+}
+
 } // namespace srsenb
 
 int main()
@@ -317,4 +394,5 @@ int main()
   srsenb::test_coreset0_cfg();
   srsenb::test_coreset2_cfg();
   srsenb::test_invalid_params();
+  srsenb::test_pdcch_search_bound();
 }
\ No newline at end of file
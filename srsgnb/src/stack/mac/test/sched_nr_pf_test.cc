@@ -0,0 +1,213 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsran/common/test_common.h"
+#include <numeric>
+#include <random>
+
+namespace srsenb {
+
+const uint16_t first_rnti  = 0x4601;
+const uint32_t drb_lcid    = 4;
+const uint32_t nof_slots   = 3000;
+const uint32_t warmup_slot = 200; ///< The DL bytes are only counted after the first slots
+
+/// QoS and channel of a simulated UE
+struct pf_test_ue {
+  int      drb_prio = 11;
+  uint32_t drb_pbr  = -1; ///< kBps, -1 for infinity
+  uint32_t min_cqi  = 15;
+  uint32_t max_cqi  = 15;
+};
+
+/// Reports a CQI every slot, drawn uniformly in the range of each UE, and accounts the DL bytes of each UE
+class sched_nr_pf_tester : public sched_nr_base_test_bench
+{
+public:
+  sched_nr_pf_tester(const sched_nr_interface::sched_args_t& sched_args,
+                     const std::vector<sched_nr_cell_cfg_t>& cells_cfg,
+                     std::vector<pf_test_ue>                 ues_) :
+    sched_nr_base_test_bench(sched_args, cells_cfg, "PF test"), ues(std::move(ues_)), dl_bytes(ues.size(), 0)
+  {}
+
+  void set_external_slot_events(const sim_nr_ue_ctxt_t& ue_ctxt, ue_nr_slot_events& pending_events) override
+  {
+    const pf_test_ue& ue = ues[ue_ctxt.rnti - first_rnti];
+    for (auto& cc : pending_events.cc_list) {
+      if (cc.configured) {
+        cc.cqi = std::uniform_int_distribution<uint32_t>{ue.min_cqi, ue.max_cqi}(rgen);
+      }
+    }
+  }
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& enb_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    if (++slot_count <= warmup_slot) {
+      return;
+    }
+    for (const cc_result_t& cc_out : cc_list) {
+      for (const auto& pdsch : cc_out.res.dl->phy.pdsch) {
+        uint32_t ue_idx = pdsch.sch.grant.rnti - first_rnti;
+        if (ue_idx < ues.size()) {
+          dl_bytes[ue_idx] += pdsch.sch.grant.tb[0].tbs / 8;
+        }
+      }
+    }
+  }
+
+  std::vector<pf_test_ue> ues;
+  std::vector<uint64_t>   dl_bytes;
+  uint32_t                slot_count = 0;
+  std::mt19937            rgen{0};
+};
+
+/// Runs a cell with full buffer UEs and returns the DL bytes of each UE
+std::vector<uint64_t> run_sched_nr_pf(const std::string& policy, const std::vector<pf_test_ue>& ues)
+{
+  sched_nr_interface::sched_args_t cfg;
+  cfg.auto_refill_buffer = true;
+  cfg.fixed_dl_mcs       = -1;
+  cfg.policy             = policy;
+
+  sched_nr_pf_tester tester(cfg, get_default_cells_cfg(1), ues);
+  for (uint32_t count = 0; count < nof_slots; ++count) {
+    slot_point slot_rx(0, count % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+    if (count == 9) {
+      for (uint32_t i = 0; i < ues.size(); ++i) {
+        sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(1);
+        uecfg.lc_ch_to_add.emplace_back();
+        uecfg.lc_ch_to_add.back().lcid          = 1;
+        uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+        uecfg.lc_ch_to_add.emplace_back();
+        uecfg.lc_ch_to_add.back().lcid          = drb_lcid;
+        uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+        uecfg.lc_ch_to_add.back().cfg.priority  = ues[i].drb_prio;
+        uecfg.lc_ch_to_add.back().cfg.pbr       = ues[i].drb_pbr;
+        tester.user_cfg(first_rnti + i, uecfg);
+      }
+    }
+    tester.run_slot(slot_tx);
+  }
+  tester.stop();
+  return tester.dl_bytes;
+}
+
+/// Jain's fairness index of the UE throughputs
+double jain_index(const std::vector<uint64_t>& dl_bytes)
+{
+  double sum = 0, sum_sq = 0;
+  for (uint64_t b : dl_bytes) {
+    sum += b;
+    sum_sq += static_cast<double>(b) * b;
+  }
+  return sum_sq == 0 ? 0 : sum * sum / (dl_bytes.size() * sum_sq);
+}
+
+uint64_t total_bytes(const std::vector<uint64_t>& dl_bytes)
+{
+  return std::accumulate(dl_bytes.begin(), dl_bytes.end(), uint64_t{0});
+}
+
+void print_results(const char* test, const char* policy, const std::vector<uint64_t>& dl_bytes)
+{
+  fmt::print("{:<10} {:<8} total={:>9.1f} kB, jain={:.3f}, per UE [bytes]: [{}]\n",
+             test,
+             policy,
+             total_bytes(dl_bytes) / 1000.0,
+             jain_index(dl_bytes),
+             fmt::join(dl_bytes.begin(), dl_bytes.end(), ", "));
+}
+
+/// With fading channels, PF schedules the UEs on their peaks and gets more throughput than RR, while staying fair
+void test_pf_fading()
+{
+  std::vector<pf_test_ue> ues(8);
+  for (pf_test_ue& ue : ues) {
+    ue.min_cqi = 3;
+  }
+
+  std::vector<uint64_t> rr = run_sched_nr_pf("time_rr", ues);
+  std::vector<uint64_t> pf = run_sched_nr_pf("time_pf", ues);
+  print_results("fading", "time_rr", rr);
+  print_results("fading", "time_pf", pf);
+
+  for (uint64_t b : pf) {
+    TESTASSERT(b > 0);
+  }
+  TESTASSERT(total_bytes(pf) > total_bytes(rr) * 1.1);
+  TESTASSERT(jain_index(pf) > 0.95);
+}
+
+/// The UEs whose DRB has a higher priority get a larger share of the resources
+void test_pf_priority()
+{
+  std::vector<pf_test_ue> ues(4);
+  ues[0].drb_prio = 1;
+
+  std::vector<uint64_t> pf = run_sched_nr_pf("time_pf", ues);
+  print_results("priority", "time_pf", pf);
+
+  for (uint32_t i = 1; i < ues.size(); ++i) {
+    TESTASSERT(pf[i] > 0);
+    TESTASSERT(pf[0] > 2 * pf[i]);
+  }
+}
+
+/// A UE with bad channel gets at least the prioritised bit rate of its DRB, which PF alone would not give it
+void test_pf_gbr()
+{
+  std::vector<pf_test_ue> ues(4);
+  ues[0].min_cqi = ues[0].max_cqi = 3;
+
+  std::vector<uint64_t> pf = run_sched_nr_pf("time_pf", ues);
+  print_results("no gbr", "time_pf", pf);
+  uint64_t target_bytes = 2 * pf[0];
+
+  // The PBR in kBps is the same as the number of bytes per slot, with 15 kHz SCS
+  ues[0].drb_pbr = target_bytes / (nof_slots - warmup_slot);
+  pf             = run_sched_nr_pf("time_pf", ues);
+  print_results("gbr", "time_pf", pf);
+
+  TESTASSERT(pf[0] >= target_bytes * 0.9);
+  for (uint64_t b : pf) {
+    TESTASSERT(b > 0);
+  }
+}
+
+} // namespace srsenb
+
+int main(int argc, char** argv)
+{
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  mac_nr_logger.set_level(srslog::basic_levels::error);
+  srslog::init();
+
+  srsenb::test_pf_fading();
+  srsenb::test_pf_priority();
+  srsenb::test_pf_gbr();
+
+  return SRSRAN_SUCCESS;
+}
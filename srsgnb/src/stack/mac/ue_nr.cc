@@ -43,8 +43,7 @@ ue_nr::ue_nr(uint16_t                rnti_,
   rrc(rrc_),
   rlc(rlc_),
   phy(phy_),
-  logger(logger_),
-  ue_rlc_buffer(srsran::make_byte_buffer())
+  logger(logger_)
 {}
 
 ue_nr::~ue_nr() {}
@@ -84,9 +83,7 @@ int ue_nr::generate_pdu(srsran::byte_buffer_t* pdu, uint32_t grant_size, srsran:
 
   bool drb_activity = false; // inform RRC about user activity if true
 
-  int32_t remaining_len = mac_pdu_dl.get_remaing_len();
-
-  logger.debug("0x%x Generating MAC PDU (%d B)", rnti, remaining_len);
+  logger.debug("0x%x Generating MAC PDU (%d B)", rnti, mac_pdu_dl.get_remaing_len());
 
   // First, add CEs as indicated by scheduler
   for (const auto& lcid : subpdu_lcids) {
@@ -104,43 +101,20 @@ int ue_nr::generate_pdu(srsran::byte_buffer_t* pdu, uint32_t grant_size, srsran:
       }
     } else {
       // add SDUs for given LCID
-      while (remaining_len >= MIN_RLC_PDU_LEN) {
-        // clear read buffer
-        ue_rlc_buffer->clear();
-
-        // Determine space for RLC
-        remaining_len -= remaining_len >= srsran::mac_sch_subpdu_nr::MAC_SUBHEADER_LEN_THRESHOLD ? 3 : 2;
-
-        // read RLC PDU
-        int pdu_len = rlc->read_pdu(rnti, lcid, ue_rlc_buffer->msg, remaining_len);
-
-        if (pdu_len > remaining_len) {
-          logger.error("Can't add SDU of %d B. Available space %d B", pdu_len, remaining_len);
-          break;
-        } else {
-          // Add SDU if RLC has something to tx
-          if (pdu_len > 0) {
-            ue_rlc_buffer->N_bytes = pdu_len;
-            logger.debug(ue_rlc_buffer->msg, ue_rlc_buffer->N_bytes, "Read %d B from RLC", ue_rlc_buffer->N_bytes);
-
-            // add to MAC PDU and pack
-            if (mac_pdu_dl.add_sdu(lcid, ue_rlc_buffer->msg, ue_rlc_buffer->N_bytes) != SRSRAN_SUCCESS) {
-              logger.error("Error packing MAC PDU");
-              break;
-            }
-
-            // set DRB activity flag but only notify RRC once
-            if (lcid > 3) {
-              drb_activity = true;
-            }
-          } else {
-            break;
-          }
-
-          remaining_len -= pdu_len;
-          logger.debug("%d B remaining PDU", remaining_len);
-        }
+      // RLC writes all the PDUs of the LCID straight after their subheaders in the TB, in a single call
+      srsran::mac_sch_sdu_batch_nr batch(mac_pdu_dl, lcid, mac_pdu_dl.get_remaing_len(), MIN_RLC_PDU_LEN);
+      if (rlc->read_pdus(rnti, lcid, batch) < 0) {
+        logger.warning("0x%x Can't read RLC PDUs of LCID=%d", rnti, lcid);
+      }
+
+      // set DRB activity flag but only notify RRC once
+      if (batch.get_nof_sdus() > 0 and lcid > 3) {
+        drb_activity = true;
       }
+      logger.debug("Read %d RLC PDUs of LCID=%d, %d B remaining PDU",
+                   batch.get_nof_sdus(),
+                   lcid,
+                   mac_pdu_dl.get_remaing_len());
     }
   }
 
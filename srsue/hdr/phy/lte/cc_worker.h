@@ -55,6 +55,12 @@ public:
   void set_uci_periodic_cqi(srsran_uci_data_t* uci_data);
 
   bool work_dl_regular();
+  /**
+   * The regular DL processing is split in two phases so that the PDSCH of all carriers can be decoded in parallel
+   * once the PDCCH of every carrier, which may carry cross-carrier grants, has been searched.
+   */
+  bool work_dl_pdcch();
+  bool work_dl_pdsch();
   bool work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg);
   bool work_ul(srsran_uci_data_t* uci_data);
 
@@ -42,7 +42,10 @@ namespace lte {
 class sf_worker : public srsran::thread_pool::worker
 {
 public:
-  sf_worker(uint32_t max_prb, phy_common* phy_, srslog::basic_logger& logger);
+  sf_worker(uint32_t                  max_prb,
+            phy_common*               phy_,
+            srslog::basic_logger&     logger,
+            srsran::task_thread_pool* pdsch_pool_ = nullptr);
   virtual ~sf_worker();
 
   void reset_cell_nolock(uint32_t cc_idx);
@@ -78,6 +81,9 @@ private:
   /* Inherited from thread_pool::worker. Function called every subframe to run the DL/UL processing */
   void work_imp() final;
 
+  /* Searches the PDCCH of all carriers and then decodes their PDSCH in the PDSCH pool, returns the signal status */
+  bool work_dl_parallel(uint32_t tti);
+
   void update_measurements();
   void reset_uci(srsran_uci_data_t* uci_data);
 
@@ -98,6 +104,12 @@ private:
   float prach_power = 0;
 
   srsran::phy_common_interface::worker_context_t context = {};
+
+  // Pool shared by all workers for decoding the PDSCH of the component carriers in parallel
+  srsran::task_thread_pool* pdsch_pool        = nullptr;
+  uint32_t                  pdsch_nof_pending = 0;
+  std::mutex                pdsch_mutex;
+  std::condition_variable   pdsch_cvar;
 };
 
 } // namespace lte
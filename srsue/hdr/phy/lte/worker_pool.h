@@ -33,6 +33,7 @@ class worker_pool
 private:
   srsran::thread_pool                      pool;
   std::vector<std::unique_ptr<sf_worker> > workers;
+  srsran::task_thread_pool                 pdsch_pool; ///< Shared by all workers to decode the carriers PDSCH
 
   class phy_cfg_stash_t
   {
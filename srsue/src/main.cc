@@ -314,6 +314,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
      bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3),
      "Number of PHY threads")
 
+    ("phy.nof_pdsch_threads",
+     bpo::value<uint32_t>(&args->phy.nof_pdsch_threads)->default_value(0),
+     "Number of threads decoding the PDSCH of the LTE carriers in parallel (0 for serial decoding)")
+
     ("phy.equalizer_mode",
      bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"),
      "Equalizer mode")
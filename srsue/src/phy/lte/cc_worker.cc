@@ -213,10 +213,11 @@ void cc_worker::set_tdd_config_nolock(srsran_tdd_config_t config)
 
 bool cc_worker::work_dl_regular()
 {
-  bool dl_ack[SRSRAN_MAX_CODEWORDS] = {};
-
-  mac_interface_phy_lte::tb_action_dl_t dl_action = {};
+  return work_dl_pdcch() and work_dl_pdsch();
+}
 
+bool cc_worker::work_dl_pdcch()
+{
   bool found_dl_grant = false;
 
   if (!cell_initiated) {
@@ -261,6 +262,19 @@ bool cc_worker::work_dl_regular()
     }
   }
 
+  return true;
+}
+
+bool cc_worker::work_dl_pdsch()
+{
+  bool dl_ack[SRSRAN_MAX_CODEWORDS] = {};
+
+  mac_interface_phy_lte::tb_action_dl_t dl_action = {};
+
+  if (!cell_initiated) {
+    return false;
+  }
+
   srsran_dci_dl_t dci_dl       = {};
   uint32_t        grant_cc_idx = 0;
   bool            has_dl_grant = phy->get_dl_pending_grant(CURRENT_TTI, cc_idx, &grant_cc_idx, &dci_dl);
@@ -56,7 +56,11 @@ static bool      plot_nr_enable = false;
 namespace srsue {
 namespace lte {
 
-sf_worker::sf_worker(uint32_t max_prb, phy_common* phy_, srslog::basic_logger& logger) : logger(logger)
+sf_worker::sf_worker(uint32_t                  max_prb,
+                     phy_common*               phy_,
+                     srslog::basic_logger&     logger,
+                     srsran::task_thread_pool* pdsch_pool_) :
+  logger(logger), pdsch_pool(pdsch_pool_)
 {
   phy = phy_;
 
@@ -170,8 +174,14 @@ void sf_worker::work_imp()
 
   /***** Downlink Processing *******/
 
+  // Decode the PDSCH of all carriers in parallel, the HARQ ACKs are joined before the UL generation
+  bool parallel_dl = pdsch_pool != nullptr and cc_workers.size() > 1;
+  if (parallel_dl) {
+    rx_signal_ok = work_dl_parallel(tti);
+  }
+
   // Loop through all carriers. carrier_idx=0 is PCell
-  for (uint32_t carrier_idx = 0; carrier_idx < cc_workers.size(); carrier_idx++) {
+  for (uint32_t carrier_idx = 0; carrier_idx < cc_workers.size() and not parallel_dl; carrier_idx++) {
     // Process all DL and special subframes
     if (srsran_sfidx_tdd_type(tdd_config, tti % 10) != SRSRAN_TDD_SF_U || cell.frame_type == SRSRAN_FDD) {
       srsran_mbsfn_cfg_t mbsfn_cfg;
@@ -254,6 +264,67 @@ void sf_worker::reset_uci(srsran_uci_data_t* uci_data)
 
 /**************************** Measurements **************************/
 
+bool sf_worker::work_dl_parallel(uint32_t tti)
+{
+  if (srsran_sfidx_tdd_type(tdd_config, tti % 10) == SRSRAN_TDD_SF_U and cell.frame_type != SRSRAN_FDD) {
+    return false;
+  }
+
+  std::array<bool, SRSRAN_MAX_CARRIERS> pdsch_pending = {};
+  std::array<bool, SRSRAN_MAX_CARRIERS> dl_ok         = {};
+  int                                   last_dl_idx   = -1;
+
+  // Search the PDCCH of all carriers first, the PCell may carry grants for the SCells
+  for (uint32_t carrier_idx = 0; carrier_idx < cc_workers.size(); carrier_idx++) {
+    srsran_mbsfn_cfg_t mbsfn_cfg;
+    ZERO_OBJECT(mbsfn_cfg);
+
+    if (carrier_idx == 0 && phy->is_mbsfn_sf(&mbsfn_cfg, tti)) {
+      dl_ok[0]    = cc_workers[0]->work_dl_mbsfn(mbsfn_cfg);
+      last_dl_idx = 0;
+    } else if (phy->cell_state.is_configured(carrier_idx)) {
+      pdsch_pending[carrier_idx] = cc_workers[carrier_idx]->work_dl_pdcch();
+      last_dl_idx                = carrier_idx;
+    }
+  }
+
+  // Fan out the SCells PDSCH decoding, the PCell is decoded in this thread
+  {
+    std::lock_guard<std::mutex> lock(pdsch_mutex);
+    pdsch_nof_pending = 0;
+  }
+  for (uint32_t carrier_idx = 1; carrier_idx < cc_workers.size(); carrier_idx++) {
+    if (not pdsch_pending[carrier_idx]) {
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> lock(pdsch_mutex);
+      pdsch_nof_pending++;
+    }
+    pdsch_pool->push_task([this, carrier_idx, &dl_ok]() {
+      dl_ok[carrier_idx] = cc_workers[carrier_idx]->work_dl_pdsch();
+
+      std::lock_guard<std::mutex> lock(pdsch_mutex);
+      pdsch_nof_pending--;
+      if (pdsch_nof_pending == 0) {
+        pdsch_cvar.notify_one();
+      }
+    });
+  }
+  if (pdsch_pending[0]) {
+    dl_ok[0] = cc_workers[0]->work_dl_pdsch();
+  }
+
+  // All HARQ ACKs must be available before generating the UL for TTI+4
+  std::unique_lock<std::mutex> lock(pdsch_mutex);
+  while (pdsch_nof_pending > 0) {
+    pdsch_cvar.wait(lock);
+  }
+
+  // Keep the serial behaviour, the signal status is given by the last processed carrier
+  return last_dl_idx >= 0 and dl_ok[last_dl_idx];
+}
+
 void sf_worker::update_measurements()
 {
   std::vector<phy_meas_t> serving_cells = {};
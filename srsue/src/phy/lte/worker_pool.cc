@@ -49,18 +49,26 @@ const srsran::phy_cfg_t& worker_pool::phy_cfg_stash_t::get_cfg(uint32_t sf_idx)
 }
 
 worker_pool::worker_pool(uint32_t max_workers) :
-  pool(max_workers), phy_cfg_stash{{max_workers, max_workers, max_workers, max_workers, max_workers}}
+  pool(max_workers), pdsch_pool(0, true), phy_cfg_stash{{max_workers, max_workers, max_workers, max_workers, max_workers}}
 {}
 
 bool worker_pool::init(phy_common* common, int prio)
 {
+  // Start the PDSCH decoding pool when carriers are decoded in parallel
+  srsran::task_thread_pool* pdsch_pool_ptr = nullptr;
+  if (common->args->nof_pdsch_threads > 0 and common->args->nof_lte_carriers > 1) {
+    pdsch_pool.set_nof_workers(common->args->nof_pdsch_threads);
+    pdsch_pool.start(prio, common->args->worker_cpu_mask);
+    pdsch_pool_ptr = &pdsch_pool;
+  }
+
   // Add workers to workers pool and start threads
   for (uint32_t i = 0; i < common->args->nof_phy_threads; i++) {
     srslog::basic_logger& log = srslog::fetch_basic_logger(fmt::format("PHY{}", i));
     log.set_level(srslog::str_to_basic_level(common->args->log.phy_level));
     log.set_hex_dump_max_size(common->args->log.phy_hex_limit);
 
-    auto w = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log));
+    auto w = std::unique_ptr<lte::sf_worker>(new lte::sf_worker(SRSRAN_MAX_PRB, common, log, pdsch_pool_ptr));
     pool.init_worker(i, w.get(), prio, common->args->worker_cpu_mask);
     workers.push_back(std::move(w));
   }
@@ -102,6 +110,7 @@ sf_worker* worker_pool::wait_worker_id(uint32_t id)
 void worker_pool::stop()
 {
   pool.stop();
+  pdsch_pool.stop();
 }
 
 void worker_pool::set_config(uint32_t cc_idx, const srsran::phy_cfg_t& phy_cfg)
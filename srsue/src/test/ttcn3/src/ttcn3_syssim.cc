@@ -36,6 +36,7 @@
 #include "ttcn3_ue.h"
 #include "ttcn3_ut_interface.h"
 #include <functional>
+#include <limits>
 
 ttcn3_syssim::ttcn3_syssim(ttcn3_ue* ue_) :
   logger(srslog::fetch_basic_logger("SS")),
@@ -1200,6 +1201,11 @@ bool ttcn3_syssim::sdu_queue_is_full(uint32_t lcid)
   return false;
 }
 
+uint32_t ttcn3_syssim::sdu_queue_free_slots(uint32_t lcid)
+{
+  return std::numeric_limits<uint32_t>::max();
+}
+
 bool ttcn3_syssim::is_suspended(uint32_t lcid)
 {
   return false;